@@ -0,0 +1,29 @@
+//
+//	main.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Google Benchmark headers
+#include <benchmark/benchmark.h>
+
+/**
+ * This application runs every benchmark registered by the benchmark sources linked into it.
+ * All the Google Benchmark command line flags are supported, for example use
+ * --benchmark_filter=<regex> to select benchmarks and --benchmark_format=json or
+ * --benchmark_out=<file> --benchmark_out_format=json to save machine readable results.
+ */
+int main(int argc, char** argv)
+{
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+	{
+		return 1;
+	}
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
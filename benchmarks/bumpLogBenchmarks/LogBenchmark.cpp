@@ -0,0 +1,544 @@
+//
+//	LogBenchmark.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <ostream>
+#include <streambuf>
+
+// Boost headers
+#include <boost/atomic.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/thread/mutex.hpp>
+
+// Google Benchmark headers
+#include <benchmark/benchmark.h>
+
+// Bump headers
+#include <bump/FileDescriptorLogSink.h>
+#include <bump/Log.h>
+
+namespace bumpBenchmark {
+
+//====================================================================================
+//                                  Helper Functions
+//====================================================================================
+
+// Registers the thread counts from 1 to 32
+void allThreadCounts(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ThreadRange(1, 32)->UseRealTime();
+}
+
+// Registers the thread counts from 1 to 64
+void producerThreadCounts(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ThreadRange(1, 64)->UseRealTime();
+}
+
+// The destinations of the log matrix benchmarks
+enum MatrixSink
+{
+	NULL_MATRIX_SINK,
+	FILE_MATRIX_SINK,
+	CONSOLE_MATRIX_SINK
+};
+
+// The log functions of the log matrix benchmarks
+enum MatrixVariant
+{
+	PLAIN_MATRIX_VARIANT,
+	PREFIX_MATRIX_VARIANT,
+	FLUSH_MATRIX_VARIANT,
+	PREFIX_FLUSH_MATRIX_VARIANT
+};
+
+// Registers every sink, variant and timestamping combination of emitted messages, and every
+// variant of filtered out ones, which never reach a sink or a timestamp
+void logMatrix(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgNames({"sink", "variant", "emitted", "timestamps"});
+	for (int variant = PLAIN_MATRIX_VARIANT; variant <= PREFIX_FLUSH_MATRIX_VARIANT; ++variant)
+	{
+		benchmark->Args({NULL_MATRIX_SINK, variant, 0, 0});
+		for (int sink = NULL_MATRIX_SINK; sink <= CONSOLE_MATRIX_SINK; ++sink)
+		{
+			benchmark->Args({sink, variant, 1, 0});
+			benchmark->Args({sink, variant, 1, 1});
+		}
+	}
+	producerThreadCounts(benchmark);
+}
+
+// A histogram of call latencies in nanoseconds with 8 buckets per power of two, so the
+// percentiles read from it are within 12.5% of the real ones
+class LatencyHistogram
+{
+public:
+
+	LatencyHistogram() { clear(); }
+
+	void clear()
+	{
+		std::memset(_counts, 0, sizeof(_counts));
+		_count = 0;
+		_max = 0;
+	}
+
+	void add(unsigned long long nanoseconds)
+	{
+		++_counts[bucketIndex(nanoseconds)];
+		++_count;
+		_max = nanoseconds > _max ? nanoseconds : _max;
+	}
+
+	void merge(const LatencyHistogram& histogram)
+	{
+		for (unsigned int i = 0; i < BUCKET_COUNT; ++i)
+		{
+			_counts[i] += histogram._counts[i];
+		}
+		_count += histogram._count;
+		_max = histogram._max > _max ? histogram._max : _max;
+	}
+
+	// Returns the upper bound of the bucket the given percentile falls in
+	double percentile(double percent) const
+	{
+		unsigned long long rank = static_cast<unsigned long long>(_count * percent / 100.0);
+		unsigned long long seen = 0;
+		for (unsigned int i = 0; i < BUCKET_COUNT; ++i)
+		{
+			seen += _counts[i];
+			if (seen > rank)
+			{
+				return static_cast<double>(bucketEnd(i));
+			}
+		}
+		return static_cast<double>(_max);
+	}
+
+	double max() const { return static_cast<double>(_max); }
+
+protected:
+
+	static const unsigned int BUCKET_COUNT = 8 + 61 * 8;
+
+	static unsigned int bucketIndex(unsigned long long value)
+	{
+		if (value < 8)
+		{
+			return static_cast<unsigned int>(value);
+		}
+
+		unsigned int exponent = 63 - __builtin_clzll(value);
+		return (exponent - 2) * 8 + static_cast<unsigned int>((value >> (exponent - 3)) & 7);
+	}
+
+	static unsigned long long bucketEnd(unsigned int index)
+	{
+		if (index < 8)
+		{
+			return index + 1;
+		}
+
+		unsigned int exponent = index / 8 + 2;
+		return (8ULL + index % 8 + 1) << (exponent - 3);
+	}
+
+	unsigned long long		_counts[BUCKET_COUNT];
+	unsigned long long		_count;
+	unsigned long long		_max;
+};
+
+// The latencies of every thread of the running matrix benchmark, merged as each one finishes
+static boost::mutex gLatencyMutex;
+static LatencyHistogram gLatencyHistogram;
+static int gMergedThreadCount = 0;
+
+// A stream buffer that throws away everything written to it
+class NullBuffer : public std::streambuf
+{
+protected:
+
+	int overflow(int character) { return traits_type::not_eof(character); }
+	std::streamsize xsputn(const char* /*characters*/, std::streamsize count) { return count; }
+};
+
+// The locks every filtered out log call used to take, which the locked level check replays
+static boost::mutex gSingletonMutex;
+static boost::mutex gConvenienceFunctionMutex;
+static boost::mutex gLogMutex;
+
+// Checks the level the way the log did before the level check was lock-free
+bool lockedIsLogLevelEnabled(bump::Log::LogLevel logLevel)
+{
+	{
+		boost::mutex::scoped_lock singleton_lock(gSingletonMutex);
+	}
+	boost::mutex::scoped_lock convenience_lock(gConvenienceFunctionMutex);
+	{
+		boost::mutex::scoped_lock singleton_lock(gSingletonMutex);
+	}
+	boost::mutex::scoped_lock log_lock(gLogMutex);
+	return logLevel <= bump::Log::WARNING_LVL;
+}
+
+// Formats the current time the way the log did before timestamps were cached
+bump::String legacyTimestamp()
+{
+	boost::posix_time::ptime now = boost::posix_time::second_clock::local_time();
+	bump::String year = static_cast<long>(now.date().year());
+	bump::String month = static_cast<long>(now.date().month());
+	bump::String day = static_cast<long>(now.date().day());
+	bump::String hours = static_cast<long>(now.time_of_day().hours());
+	bump::String minutes = static_cast<long>(now.time_of_day().minutes());
+	bump::String seconds = static_cast<long>(now.time_of_day().seconds());
+	bump::String am_pm = hours.toInt() < 13 ? "AM" : "PM";
+	if (hours.toInt() > 12)
+	{
+		hours = hours.toInt() - 12;
+	}
+
+	month.padWithString("0", 2);
+	day.padWithString("0", 2);
+	hours.padWithString("0", 2);
+	minutes.padWithString("0", 2);
+	seconds.padWithString("0", 2);
+	return bump::String("%1-%2-%3 %4:%5:%6 %7:").arg(year, month, day, hours, minutes, seconds, am_pm);
+}
+
+//====================================================================================
+//                              Level Check Benchmarks
+//====================================================================================
+
+// Logs a filtered out debug message from every thread
+static void BM_LogFilteredDebug(benchmark::State& state)
+{
+	if (state.thread_index() == 0)
+	{
+		bump::Log::instance()->setLogLevel(bump::Log::WARNING_LVL);
+	}
+
+	bump::String message = "filtered out";
+	for (auto _ : state)
+	{
+		bumpDEBUG(message);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogFilteredDebug)->Apply(allThreadCounts);
+
+// Checks whether debug messages are enabled from every thread
+static void BM_LogIsLogLevelEnabled(benchmark::State& state)
+{
+	bump::Log* log = bump::Log::instance();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(log->isLogLevelEnabled(bump::Log::DEBUG_LVL));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogIsLogLevelEnabled)->Apply(allThreadCounts);
+
+// Replays the locks the filtered out debug message used to take from every thread
+static void BM_LogLockedIsLogLevelEnabled(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(lockedIsLogLevelEnabled(bump::Log::DEBUG_LVL));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogLockedIsLogLevelEnabled)->Apply(allThreadCounts);
+
+//====================================================================================
+//                            Deferred Argument Benchmarks
+//====================================================================================
+
+// Builds a filtered out debug message with String::arg() like callers had to before
+static void BM_LogFilteredDebugArg(benchmark::State& state)
+{
+	bump::Log::instance()->setLogLevel(bump::Log::WARNING_LVL);
+	int index = 0;
+	for (auto _ : state)
+	{
+		bumpDEBUG(bump::String("Copying file %1 of %2: %3").arg(++index, 1000, "filename.txt"));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogFilteredDebugArg);
+
+// Logs a filtered out debug message with the deferred-argument macro
+static void BM_LogFilteredDebugDeferred(benchmark::State& state)
+{
+	bump::Log::instance()->setLogLevel(bump::Log::WARNING_LVL);
+	int index = 0;
+	for (auto _ : state)
+	{
+		BUMP_LOG_DEBUG("Copying file %1 of %2: %3", ++index, 1000, "filename.txt");
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogFilteredDebugDeferred);
+
+// Builds and writes a warning message with String::arg() to a null stream
+static void BM_LogEmittedWarningArg(benchmark::State& state)
+{
+	static NullBuffer null_buffer;
+	static std::ostream null_stream(&null_buffer);
+
+	bump::Log* log = bump::Log::instance();
+	log->setLogStream(null_stream);
+	log->setLogLevel(bump::Log::WARNING_LVL);
+	int index = 0;
+	for (auto _ : state)
+	{
+		bumpWARNING(bump::String("Copying file %1 of %2: %3").arg(++index, 1000, "filename.txt"));
+	}
+	state.SetItemsProcessed(state.iterations());
+	log->setLogStream(std::cout);
+}
+BENCHMARK(BM_LogEmittedWarningArg);
+
+// Formats and writes a warning message with the deferred-argument macro to a null stream
+static void BM_LogEmittedWarningDeferred(benchmark::State& state)
+{
+	static NullBuffer null_buffer;
+	static std::ostream null_stream(&null_buffer);
+
+	bump::Log* log = bump::Log::instance();
+	log->setLogStream(null_stream);
+	log->setLogLevel(bump::Log::WARNING_LVL);
+	int index = 0;
+	for (auto _ : state)
+	{
+		BUMP_LOG_WARNING("Copying file %1 of %2: %3", ++index, 1000, "filename.txt");
+	}
+	state.SetItemsProcessed(state.iterations());
+	log->setLogStream(std::cout);
+}
+BENCHMARK(BM_LogEmittedWarningDeferred);
+
+// Records a warning message with the deferred-argument macro in a binary log in /tmp
+static void BM_LogBinaryWarningDeferred(benchmark::State& state)
+{
+	bump::Log* log = bump::Log::instance();
+	log->setLogLevel(bump::Log::WARNING_LVL);
+	log->enableBinaryLogging("/tmp/bumpLogBenchmarks.binlog");
+	int index = 0;
+	for (auto _ : state)
+	{
+		BUMP_LOG_WARNING("Copying file %1 of %2: %3", ++index, 1000, "filename.txt");
+	}
+	state.SetItemsProcessed(state.iterations());
+	log->disableBinaryLogging();
+	std::remove("/tmp/bumpLogBenchmarks.binlog");
+}
+BENCHMARK(BM_LogBinaryWarningDeferred);
+
+//====================================================================================
+//                              Emitted Message Benchmarks
+//====================================================================================
+
+// Writes warning messages to a null stream from every thread, either synchronously or
+// through the asynchronous writer thread depending on the argument
+static void BM_LogEmittedWarning(benchmark::State& state)
+{
+	static NullBuffer null_buffer;
+	static std::ostream null_stream(&null_buffer);
+
+	bump::Log* log = bump::Log::instance();
+	if (state.thread_index() == 0)
+	{
+		log->setLogStream(null_stream);
+		log->setLogLevel(bump::Log::WARNING_LVL);
+		if (state.range(0) == 1)
+		{
+			log->enableAsynchronousLogging(8192, bump::Log::BLOCK_OVERFLOW);
+		}
+	}
+
+	bump::String message = "emitted warning message";
+	for (auto _ : state)
+	{
+		bumpWARNING(message);
+	}
+	state.SetItemsProcessed(state.iterations());
+
+	if (state.thread_index() == 0)
+	{
+		log->flush();
+		log->disableAsynchronousLogging();
+		log->setLogStream(std::cout);
+	}
+}
+BENCHMARK(BM_LogEmittedWarning)->ArgName("async")->Arg(0)->Arg(1)->Apply(allThreadCounts);
+
+// Writes warning messages to /dev/null through a file descriptor sink from every thread, either
+// one write per message or through the per-thread buffers depending on the argument
+static void BM_LogFileDescriptorSinkWarning(benchmark::State& state)
+{
+	static bump::FileDescriptorLogSink null_sink("/dev/null");
+
+	bump::Log* log = bump::Log::instance();
+	if (state.thread_index() == 0)
+	{
+		log->setLogSink(null_sink);
+		log->setLogLevel(bump::Log::WARNING_LVL);
+		if (state.range(0) == 1)
+		{
+			log->enableBufferedLogging();
+		}
+	}
+
+	bump::String message = "emitted warning message";
+	for (auto _ : state)
+	{
+		bumpWARNING(message);
+	}
+	state.SetItemsProcessed(state.iterations());
+
+	if (state.thread_index() == 0)
+	{
+		log->disableBufferedLogging();
+		log->setLogStream(std::cout);
+	}
+}
+BENCHMARK(BM_LogFileDescriptorSinkWarning)->ArgName("buffered")->Arg(0)->Arg(1)->Apply(allThreadCounts);
+
+//====================================================================================
+//                                Timestamp Benchmarks
+//====================================================================================
+
+// Formats the current time with the uncached String::arg() approach
+static void BM_LogLegacyTimestamp(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(legacyTimestamp());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogLegacyTimestamp);
+
+// Writes timestamped warning messages to a null stream with the precision given by the argument
+static void BM_LogEmittedTimestampedWarning(benchmark::State& state)
+{
+	static NullBuffer null_buffer;
+	static std::ostream null_stream(&null_buffer);
+
+	bump::Log* log = bump::Log::instance();
+	log->setLogStream(null_stream);
+	log->setLogLevel(bump::Log::WARNING_LVL);
+	log->setTimestampPrecision(static_cast<bump::Log::TimestampPrecision>(state.range(0)));
+	log->setIsTimestampingEnabled(true);
+
+	bump::String message = "emitted warning message";
+	for (auto _ : state)
+	{
+		bumpWARNING(message);
+	}
+	state.SetItemsProcessed(state.iterations());
+
+	log->setIsTimestampingEnabled(false);
+	log->setTimestampPrecision(bump::Log::SECONDS_PRECISION);
+	log->setLogStream(std::cout);
+}
+BENCHMARK(BM_LogEmittedTimestampedWarning)->ArgName("precision")->DenseRange(0, 2);
+
+//====================================================================================
+//                                 Log Matrix Benchmarks
+//====================================================================================
+
+// Logs warning messages from every thread through one of the bumpWARNING functions, timing
+// each call, and reports the call latency percentiles of all the threads in nanoseconds
+// along with the throughput. The console runs are best combined with --benchmark_out so the
+// results don't get lost among the messages.
+static void BM_LogMatrix(benchmark::State& state)
+{
+	static NullBuffer null_buffer;
+	static std::ostream null_stream(&null_buffer);
+	static bump::FileDescriptorLogSink* file_sink = NULL;
+	static const char* file_path = "/tmp/bumpLogBenchmarks.log";
+
+	MatrixSink sink = static_cast<MatrixSink>(state.range(0));
+	MatrixVariant variant = static_cast<MatrixVariant>(state.range(1));
+	bump::Log* log = bump::Log::instance();
+	if (state.thread_index() == 0)
+	{
+		if (sink == FILE_MATRIX_SINK)
+		{
+			file_sink = new bump::FileDescriptorLogSink(file_path, false);
+			log->setLogSink(*file_sink);
+		}
+		else
+		{
+			log->setLogStream(sink == CONSOLE_MATRIX_SINK ? std::cout : null_stream);
+		}
+		log->setLogLevel(state.range(2) == 1 ? bump::Log::WARNING_LVL : bump::Log::ERROR_LVL);
+		log->setIsTimestampingEnabled(state.range(3) == 1);
+
+		gLatencyHistogram.clear();
+		gMergedThreadCount = 0;
+	}
+
+	LatencyHistogram histogram;
+	bump::String prefix = "[benchmark] ";
+	bump::String message = "emitted warning message";
+	for (auto _ : state)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		switch (variant)
+		{
+			case PLAIN_MATRIX_VARIANT:			bumpWARNING(message);				break;
+			case PREFIX_MATRIX_VARIANT:			bumpWARNING_P(prefix, message);		break;
+			case FLUSH_MATRIX_VARIANT:			bumpWARNING_F(message);				break;
+			case PREFIX_FLUSH_MATRIX_VARIANT:	bumpWARNING_PF(prefix, message);	break;
+		}
+		std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+		histogram.add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+	}
+	state.SetItemsProcessed(state.iterations());
+
+	// The last thread to finish reports for all of them since the counters of the threads are summed
+	boost::mutex::scoped_lock lock(gLatencyMutex);
+	gLatencyHistogram.merge(histogram);
+	if (++gMergedThreadCount == state.threads())
+	{
+		state.counters["p50_ns"] = gLatencyHistogram.percentile(50.0);
+		state.counters["p99_ns"] = gLatencyHistogram.percentile(99.0);
+		state.counters["p99.9_ns"] = gLatencyHistogram.percentile(99.9);
+		state.counters["max_ns"] = gLatencyHistogram.max();
+	}
+	lock.unlock();
+
+	if (state.thread_index() == 0)
+	{
+		// End the line the flushing functions built up
+		if (variant == FLUSH_MATRIX_VARIANT || variant == PREFIX_FLUSH_MATRIX_VARIANT)
+		{
+			bumpNEWLINE();
+		}
+		log->setIsTimestampingEnabled(false);
+		log->setLogLevel(bump::Log::WARNING_LVL);
+		log->setLogStream(std::cout);
+		if (file_sink)
+		{
+			delete file_sink;
+			file_sink = NULL;
+			std::remove(file_path);
+		}
+	}
+}
+BENCHMARK(BM_LogMatrix)->Apply(logMatrix);
+
+}	// End of bumpBenchmark namespace
@@ -0,0 +1,1110 @@
+//
+//	StringBenchmark.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+// Google Benchmark headers
+#include <benchmark/benchmark.h>
+
+// Bump headers
+#include <bump/String.h>
+
+/**
+ * Every bump::String benchmark is named BM_String<Method> and is paired with a BM_StdString<Method>
+ * baseline doing the same work with the std::string API, so the two can be compared directly in
+ * the output. Sized benchmarks run from 16 B up to 64 MB, except for the methods whose cost grows
+ * with the square of the input which stop at 64 KB. Methods that modify the string work on a copy
+ * of the input made inside the timed loop, in both the bump and the baseline versions.
+ *
+ * Use --benchmark_format=json (or --benchmark_out=<file> --benchmark_out_format=json) to get
+ * machine readable results that can be compared between releases.
+ */
+namespace bumpBenchmark {
+
+//====================================================================================
+//                                  Helper Functions
+//====================================================================================
+
+// The sentence repeated to build the inputs, which contains an arg() marker and mixed case
+static const char* const SENTENCE = "The Quick brown fox jumps over the lazy dog %1. ";
+
+// A search string that never occurs in the inputs so every search scans the whole input
+static const char* const NEEDLE = "needle";
+
+// Registers the sizes from 16 B to 64 MB
+void allSizes(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->RangeMultiplier(16)->Range(16, 64 << 20);
+}
+
+// Registers the sizes from 16 B to 64 KB for methods that are quadratic in the input size
+void quadraticSizes(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->RangeMultiplier(16)->Range(16, 64 << 10);
+}
+
+// Creates a text of the given size by repeating the sentence
+std::string createText(int64_t size)
+{
+	std::string sentence = SENTENCE;
+	std::string text;
+	text.reserve(size_t(size));
+	while (int64_t(text.size()) < size)
+	{
+		text.append(sentence, 0, std::min(sentence.size(), size_t(size) - text.size()));
+	}
+
+	return text;
+}
+
+// Creates a text of the given size with two, three and four byte UTF-8 sequences
+std::string createUtf8Text(int64_t size)
+{
+	std::string sentence = "Gr\xC3\xBC\xC3\x9F" "e \xE2\x82\xAC" "10 \xF0\x9F\x98\x80 caf\xC3\xA9. ";
+	std::string text;
+	text.reserve(size_t(size) + sentence.size());
+	while (int64_t(text.size() + sentence.size()) <= size)
+	{
+		text += sentence;
+	}
+	text.append(size_t(size) - text.size(), 'a');
+
+	return text;
+}
+
+// Runs an operation that only reads the input
+template <typename Input, typename Operation>
+void runReadOnly(benchmark::State& state, const Input& input, Operation operation)
+{
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(operation(input));
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+
+// Runs an operation that modifies a copy of the input
+template <typename Input, typename Operation>
+void runOnCopy(benchmark::State& state, const Input& input, Operation operation)
+{
+	for (auto _ : state)
+	{
+		Input copy = input;
+		operation(copy);
+		benchmark::DoNotOptimize(copy.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+
+// Lowers the case of a std::string with the standard library
+std::string& stdToLower(std::string& string)
+{
+	std::transform(string.begin(), string.end(), string.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+	return string;
+}
+
+// Uppers the case of a std::string with the standard library
+std::string& stdToUpper(std::string& string)
+{
+	std::transform(string.begin(), string.end(), string.begin(), [](unsigned char c) { return char(std::toupper(c)); });
+	return string;
+}
+
+// Replaces every occurrence of before with after in a std::string
+void stdReplaceAll(std::string& string, const std::string& before, const std::string& after)
+{
+	size_t found = string.find(before);
+	while (found != std::string::npos)
+	{
+		string.replace(found, before.size(), after);
+		found = string.find(before, found + after.size());
+	}
+}
+
+//====================================================================================
+//                                Accessor Benchmarks
+//====================================================================================
+
+// Member function pointer types of the accessors
+typedef const char& (bump::String::*AtFunction)(int) const;
+typedef int (bump::String::*LengthFunction)() const;
+
+// The accessors called through volatile pointers so the compiler can neither inline nor
+// hoist them, which is how every call behaved when they were only exported from the library
+static AtFunction volatile gOutOfLineAt = &bump::String::at;
+static LengthFunction volatile gOutOfLineLength = &bump::String::length;
+
+// Sums every character with at() and length() called out of line as before
+static void BM_StringAtLengthLoopOutOfLine(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	AtFunction at = gOutOfLineAt;
+	LengthFunction length = gOutOfLineLength;
+	runReadOnly(state, string, [at, length](const bump::String& s)
+	{
+		int sum = 0;
+		for (int i = 0; i < (s.*length)(); ++i)
+		{
+			sum += (s.*at)(i);
+		}
+		return sum;
+	});
+}
+BENCHMARK(BM_StringAtLengthLoopOutOfLine)->Arg(16)->Arg(1024)->Arg(64 << 10);
+
+// Sums every character with the inline at() and length()
+static void BM_StringAtLengthLoop(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s)
+	{
+		int sum = 0;
+		for (int i = 0; i < s.length(); ++i)
+		{
+			sum += s.at(i);
+		}
+		return sum;
+	});
+}
+BENCHMARK(BM_StringAtLengthLoop)->Arg(16)->Arg(1024)->Arg(64 << 10);
+
+static void BM_StdStringAtLengthLoop(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s)
+	{
+		int sum = 0;
+		for (size_t i = 0; i < s.length(); ++i)
+		{
+			sum += s.at(i);
+		}
+		return sum;
+	});
+}
+BENCHMARK(BM_StdStringAtLengthLoop)->Arg(16)->Arg(1024)->Arg(64 << 10);
+
+// Checks isEmpty() and reads c_str() and data() once per iteration
+static void BM_StringTrivialAccessors(benchmark::State& state)
+{
+	bump::String string = createText(16);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(string.isEmpty());
+		benchmark::DoNotOptimize(string.c_str());
+		benchmark::DoNotOptimize(string.data());
+	}
+}
+BENCHMARK(BM_StringTrivialAccessors);
+
+static void BM_StdStringTrivialAccessors(benchmark::State& state)
+{
+	std::string string = createText(16);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(string.empty());
+		benchmark::DoNotOptimize(string.c_str());
+		benchmark::DoNotOptimize(string.data());
+	}
+}
+BENCHMARK(BM_StdStringTrivialAccessors);
+
+//====================================================================================
+//                                 Search Benchmarks
+//====================================================================================
+
+static void BM_StringCompare(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	bump::String other = string;
+	runReadOnly(state, string, [&other](const bump::String& s) { return s.compare(other); });
+}
+BENCHMARK(BM_StringCompare)->Apply(allSizes);
+
+static void BM_StdStringCompare(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	std::string other = string;
+	runReadOnly(state, string, [&other](const std::string& s) { return s.compare(other) == 0; });
+}
+BENCHMARK(BM_StdStringCompare)->Apply(allSizes);
+
+static void BM_StringCompareNotCaseSensitive(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	bump::String other = string;
+	other.toUpperCase();
+	runReadOnly(state, string, [&other](const bump::String& s) { return s.compare(other, bump::String::NotCaseSensitive); });
+}
+BENCHMARK(BM_StringCompareNotCaseSensitive)->Apply(allSizes);
+
+static void BM_StdStringCompareNotCaseSensitive(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	std::string other = string;
+	stdToUpper(other);
+	runReadOnly(state, string, [&other](const std::string& s)
+	{
+		return std::equal(s.begin(), s.end(), other.begin(), other.end(),
+			[](unsigned char a, unsigned char b) { return std::tolower(a) == std::tolower(b); });
+	});
+}
+BENCHMARK(BM_StdStringCompareNotCaseSensitive)->Apply(allSizes);
+
+static void BM_StringContains(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.contains(NEEDLE); });
+}
+BENCHMARK(BM_StringContains)->Apply(allSizes);
+
+static void BM_StdStringContains(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s) { return s.find(NEEDLE) != std::string::npos; });
+}
+BENCHMARK(BM_StdStringContains)->Apply(allSizes);
+
+static void BM_StringContainsNotCaseSensitive(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.contains("NEEDLE", bump::String::NotCaseSensitive); });
+}
+BENCHMARK(BM_StringContainsNotCaseSensitive)->Apply(allSizes);
+
+static void BM_StdStringContainsNotCaseSensitive(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s)
+	{
+		std::string lowered = s;
+		return stdToLower(lowered).find(NEEDLE) != std::string::npos;
+	});
+}
+BENCHMARK(BM_StdStringContainsNotCaseSensitive)->Apply(allSizes);
+
+static void BM_StringCount(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.count("fox"); });
+}
+BENCHMARK(BM_StringCount)->Apply(quadraticSizes);
+
+static void BM_StdStringCount(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s)
+	{
+		int count = 0;
+		for (size_t found = s.find("fox"); found != std::string::npos; found = s.find("fox", found + 1))
+		{
+			++count;
+		}
+		return count;
+	});
+}
+BENCHMARK(BM_StdStringCount)->Apply(quadraticSizes);
+
+static void BM_StringEndsWith(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.endsWith(NEEDLE); });
+}
+BENCHMARK(BM_StringEndsWith)->Apply(allSizes);
+
+static void BM_StdStringEndsWith(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	std::string needle = NEEDLE;
+	runReadOnly(state, string, [&needle](const std::string& s)
+	{
+		return s.size() >= needle.size() && s.compare(s.size() - needle.size(), needle.size(), needle) == 0;
+	});
+}
+BENCHMARK(BM_StdStringEndsWith)->Apply(allSizes);
+
+static void BM_StringIndexOf(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.indexOf(NEEDLE); });
+}
+BENCHMARK(BM_StringIndexOf)->Apply(allSizes);
+
+static void BM_StdStringIndexOf(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s) { return s.find(NEEDLE); });
+}
+BENCHMARK(BM_StdStringIndexOf)->Apply(allSizes);
+
+static void BM_StringIndexOfNotCaseSensitive(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.indexOf("NEEDLE", 0, bump::String::NotCaseSensitive); });
+}
+BENCHMARK(BM_StringIndexOfNotCaseSensitive)->Apply(allSizes);
+
+static void BM_StdStringIndexOfNotCaseSensitive(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s)
+	{
+		std::string lowered = s;
+		return stdToLower(lowered).find(NEEDLE);
+	});
+}
+BENCHMARK(BM_StdStringIndexOfNotCaseSensitive)->Apply(allSizes);
+
+static void BM_StringLastIndexOf(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.lastIndexOf(NEEDLE); });
+}
+BENCHMARK(BM_StringLastIndexOf)->Apply(allSizes);
+
+static void BM_StdStringLastIndexOf(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s) { return s.rfind(NEEDLE); });
+}
+BENCHMARK(BM_StdStringLastIndexOf)->Apply(allSizes);
+
+static void BM_StringStartsWith(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.startsWith(NEEDLE); });
+}
+BENCHMARK(BM_StringStartsWith)->Apply(allSizes);
+
+static void BM_StdStringStartsWith(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s) { return s.compare(0, 6, NEEDLE) == 0; });
+}
+BENCHMARK(BM_StdStringStartsWith)->Apply(allSizes);
+
+//====================================================================================
+//                              Substring Benchmarks
+//====================================================================================
+
+static void BM_StringLeft(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.left(s.length() / 2); });
+}
+BENCHMARK(BM_StringLeft)->Apply(allSizes);
+
+static void BM_StdStringLeft(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s) { return s.substr(0, s.size() / 2); });
+}
+BENCHMARK(BM_StdStringLeft)->Apply(allSizes);
+
+static void BM_StringRight(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.right(s.length() / 2); });
+}
+BENCHMARK(BM_StringRight)->Apply(allSizes);
+
+static void BM_StdStringRight(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s) { return s.substr(s.size() - s.size() / 2); });
+}
+BENCHMARK(BM_StdStringRight)->Apply(allSizes);
+
+static void BM_StringSection(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.section(s.length() / 4, s.length() / 2); });
+}
+BENCHMARK(BM_StringSection)->Apply(allSizes);
+
+static void BM_StdStringSection(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s) { return s.substr(s.size() / 4, s.size() / 2); });
+}
+BENCHMARK(BM_StdStringSection)->Apply(allSizes);
+
+static void BM_StringTrimmed(benchmark::State& state)
+{
+	bump::String string = "  \t" + createText(state.range(0)) + " \n";
+	runReadOnly(state, string, [](const bump::String& s) { return s.trimmed(); });
+}
+BENCHMARK(BM_StringTrimmed)->Apply(allSizes);
+
+static void BM_StdStringTrimmed(benchmark::State& state)
+{
+	std::string string = "  \t" + createText(state.range(0)) + " \n";
+	runReadOnly(state, string, [](const std::string& s)
+	{
+		size_t first = s.find_first_not_of(" \t\n\v\f\r");
+		size_t last = s.find_last_not_of(" \t\n\v\f\r");
+		return first == std::string::npos ? std::string() : s.substr(first, last - first + 1);
+	});
+}
+BENCHMARK(BM_StdStringTrimmed)->Apply(allSizes);
+
+//====================================================================================
+//                             Modification Benchmarks
+//====================================================================================
+
+static void BM_StringAppend(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	bump::String suffix = SENTENCE;
+	runOnCopy(state, string, [&suffix](bump::String& s) { s.append(suffix); });
+}
+BENCHMARK(BM_StringAppend)->Apply(allSizes);
+
+static void BM_StdStringAppend(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	std::string suffix = SENTENCE;
+	runOnCopy(state, string, [&suffix](std::string& s) { s.append(suffix); });
+}
+BENCHMARK(BM_StdStringAppend)->Apply(allSizes);
+
+static void BM_StringArg(benchmark::State& state)
+{
+	bump::String string = "%1" + createText(state.range(0) - 2);
+	runReadOnly(state, string, [](const bump::String& s) { return s.arg("cat"); });
+}
+BENCHMARK(BM_StringArg)->Apply(quadraticSizes);
+
+static void BM_StdStringArg(benchmark::State& state)
+{
+	std::string string = "%1" + createText(state.range(0) - 2);
+	runReadOnly(state, string, [](const std::string& s)
+	{
+		std::string replaced = s;
+		stdReplaceAll(replaced, "%1", "cat");
+		return replaced;
+	});
+}
+BENCHMARK(BM_StdStringArg)->Apply(quadraticSizes);
+
+static void BM_StringCapitalize(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runOnCopy(state, string, [](bump::String& s) { s.capitalize(); });
+}
+BENCHMARK(BM_StringCapitalize)->Apply(allSizes);
+
+static void BM_StdStringCapitalize(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runOnCopy(state, string, [](std::string& s) { s[0] = char(std::toupper((unsigned char)s[0])); });
+}
+BENCHMARK(BM_StdStringCapitalize)->Apply(allSizes);
+
+static void BM_StringChop(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runOnCopy(state, string, [](bump::String& s) { s.chop(8); });
+}
+BENCHMARK(BM_StringChop)->Apply(allSizes);
+
+static void BM_StdStringChop(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runOnCopy(state, string, [](std::string& s) { s.resize(s.size() - 8); });
+}
+BENCHMARK(BM_StdStringChop)->Apply(allSizes);
+
+static void BM_StringFill(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runOnCopy(state, string, [](bump::String& s) { s.fill("x"); });
+}
+BENCHMARK(BM_StringFill)->Apply(allSizes);
+
+static void BM_StdStringFill(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runOnCopy(state, string, [](std::string& s) { s.assign(s.size(), 'x'); });
+}
+BENCHMARK(BM_StdStringFill)->Apply(allSizes);
+
+static void BM_StringInsert(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runOnCopy(state, string, [](bump::String& s) { s.insert("inserted", s.length() / 2); });
+}
+BENCHMARK(BM_StringInsert)->Apply(allSizes);
+
+static void BM_StdStringInsert(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runOnCopy(state, string, [](std::string& s) { s.insert(s.size() / 2, "inserted"); });
+}
+BENCHMARK(BM_StdStringInsert)->Apply(allSizes);
+
+static void BM_StringPadWithString(benchmark::State& state)
+{
+	bump::String string = "1";
+	int padded_length = int(state.range(0));
+	for (auto _ : state)
+	{
+		bump::String padded = string;
+		padded.padWithString("0", padded_length);
+		benchmark::DoNotOptimize(padded.data());
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StringPadWithString)->Apply(quadraticSizes);
+
+static void BM_StdStringPadWithString(benchmark::State& state)
+{
+	std::string string = "1";
+	size_t padded_length = size_t(state.range(0));
+	for (auto _ : state)
+	{
+		std::string padded = string;
+		padded.insert(0, padded_length - padded.size(), '0');
+		benchmark::DoNotOptimize(padded.data());
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StdStringPadWithString)->Apply(quadraticSizes);
+
+static void BM_StringPrepend(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	bump::String prefix = SENTENCE;
+	runOnCopy(state, string, [&prefix](bump::String& s) { s.prepend(prefix); });
+}
+BENCHMARK(BM_StringPrepend)->Apply(allSizes);
+
+static void BM_StdStringPrepend(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	std::string prefix = SENTENCE;
+	runOnCopy(state, string, [&prefix](std::string& s) { s.insert(0, prefix); });
+}
+BENCHMARK(BM_StdStringPrepend)->Apply(allSizes);
+
+static void BM_StringRemovePosition(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runOnCopy(state, string, [](bump::String& s) { s.remove(s.length() / 2, 8); });
+}
+BENCHMARK(BM_StringRemovePosition)->Apply(allSizes);
+
+static void BM_StdStringRemovePosition(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runOnCopy(state, string, [](std::string& s) { s.erase(s.size() / 2, 8); });
+}
+BENCHMARK(BM_StdStringRemovePosition)->Apply(allSizes);
+
+static void BM_StringRemoveString(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runOnCopy(state, string, [](bump::String& s) { s.remove("fox"); });
+}
+BENCHMARK(BM_StringRemoveString)->Apply(quadraticSizes);
+
+static void BM_StdStringRemoveString(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runOnCopy(state, string, [](std::string& s) { stdReplaceAll(s, "fox", ""); });
+}
+BENCHMARK(BM_StdStringRemoveString)->Apply(quadraticSizes);
+
+static void BM_StringRepeated(benchmark::State& state)
+{
+	bump::String string = SENTENCE;
+	unsigned int times = (unsigned int)(state.range(0) / string.size() + 1);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(string.repeated(times));
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StringRepeated)->Apply(allSizes);
+
+static void BM_StdStringRepeated(benchmark::State& state)
+{
+	std::string string = SENTENCE;
+	size_t times = size_t(state.range(0)) / string.size() + 1;
+	for (auto _ : state)
+	{
+		std::string repeated;
+		repeated.reserve(string.size() * times);
+		for (size_t i = 0; i < times; ++i)
+		{
+			repeated += string;
+		}
+		benchmark::DoNotOptimize(repeated.data());
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StdStringRepeated)->Apply(allSizes);
+
+static void BM_StringReplacePosition(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runOnCopy(state, string, [](bump::String& s) { s.replace(s.length() / 2, 8, "replaced"); });
+}
+BENCHMARK(BM_StringReplacePosition)->Apply(allSizes);
+
+static void BM_StdStringReplacePosition(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runOnCopy(state, string, [](std::string& s) { s.replace(s.size() / 2, 8, "replaced"); });
+}
+BENCHMARK(BM_StdStringReplacePosition)->Apply(allSizes);
+
+static void BM_StringReplaceString(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runOnCopy(state, string, [](bump::String& s) { s.replace("fox", "cat"); });
+}
+BENCHMARK(BM_StringReplaceString)->Apply(quadraticSizes);
+
+static void BM_StdStringReplaceString(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runOnCopy(state, string, [](std::string& s) { stdReplaceAll(s, "fox", "cat"); });
+}
+BENCHMARK(BM_StdStringReplaceString)->Apply(quadraticSizes);
+
+static void BM_StringReplaceStringNotCaseSensitive(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runOnCopy(state, string, [](bump::String& s) { s.replace("FOX", "cat", bump::String::NotCaseSensitive); });
+}
+BENCHMARK(BM_StringReplaceStringNotCaseSensitive)->Apply(quadraticSizes);
+
+static void BM_StdStringReplaceStringNotCaseSensitive(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runOnCopy(state, string, [](std::string& s)
+	{
+		std::string lowered = s;
+		stdToLower(lowered);
+		size_t found = lowered.rfind("fox");
+		while (found != std::string::npos)
+		{
+			s.replace(found, 3, "cat");
+			found = found == 0 ? std::string::npos : lowered.rfind("fox", found - 1);
+		}
+	});
+}
+BENCHMARK(BM_StdStringReplaceStringNotCaseSensitive)->Apply(quadraticSizes);
+
+static void BM_StringStreamOperator(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runOnCopy(state, string, [](bump::String& s) { s << "value: " << 42 << ' ' << 3.14 << true; });
+}
+BENCHMARK(BM_StringStreamOperator)->Apply(allSizes);
+
+static void BM_StdStringStreamOperator(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runOnCopy(state, string, [](std::string& s)
+	{
+		std::ostringstream stream;
+		stream << 3.14;
+		s += "value: ";
+		s += std::to_string(42);
+		s += ' ';
+		s += stream.str();
+		s += "true";
+	});
+}
+BENCHMARK(BM_StdStringStreamOperator)->Apply(allSizes);
+
+//====================================================================================
+//                                  Case Benchmarks
+//====================================================================================
+
+static void BM_StringToLowerCase(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runOnCopy(state, string, [](bump::String& s) { s.toLowerCase(); });
+}
+BENCHMARK(BM_StringToLowerCase)->Apply(allSizes);
+
+static void BM_StdStringToLowerCase(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runOnCopy(state, string, [](std::string& s) { stdToLower(s); });
+}
+BENCHMARK(BM_StdStringToLowerCase)->Apply(allSizes);
+
+static void BM_StringToUpperCase(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runOnCopy(state, string, [](bump::String& s) { s.toUpperCase(); });
+}
+BENCHMARK(BM_StringToUpperCase)->Apply(allSizes);
+
+static void BM_StdStringToUpperCase(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runOnCopy(state, string, [](std::string& s) { stdToUpper(s); });
+}
+BENCHMARK(BM_StdStringToUpperCase)->Apply(allSizes);
+
+static void BM_StringTitle(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.title(); });
+}
+BENCHMARK(BM_StringTitle)->Apply(allSizes);
+
+static void BM_StdStringTitle(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s)
+	{
+		std::string title = s;
+		bool word_start = true;
+		for (size_t i = 0; i < title.size(); ++i)
+		{
+			unsigned char c = (unsigned char)title[i];
+			title[i] = char(word_start ? std::toupper(c) : std::tolower(c));
+			word_start = c == ' ';
+		}
+		return title;
+	});
+}
+BENCHMARK(BM_StdStringTitle)->Apply(allSizes);
+
+//====================================================================================
+//                             Split and Join Benchmarks
+//====================================================================================
+
+static void BM_StringSplit(benchmark::State& state)
+{
+	bump::String string = createText(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.split(" "); });
+}
+BENCHMARK(BM_StringSplit)->Apply(allSizes);
+
+static void BM_StdStringSplit(benchmark::State& state)
+{
+	std::string string = createText(state.range(0));
+	runReadOnly(state, string, [](const std::string& s)
+	{
+		std::vector<std::string> parts;
+		size_t start = 0;
+		for (size_t found = s.find(' '); found != std::string::npos; found = s.find(' ', start))
+		{
+			parts.push_back(s.substr(start, found - start));
+			start = found + 1;
+		}
+		parts.push_back(s.substr(start));
+		return parts;
+	});
+}
+BENCHMARK(BM_StdStringSplit)->Apply(allSizes);
+
+static void BM_StringJoin(benchmark::State& state)
+{
+	bump::StringList words = bump::String(createText(state.range(0))).split(" ");
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(bump::String::join(words, " "));
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StringJoin)->Apply(quadraticSizes);
+
+static void BM_StdStringJoin(benchmark::State& state)
+{
+	bump::StringList split_words = bump::String(createText(state.range(0))).split(" ");
+	std::vector<std::string> words(split_words.begin(), split_words.end());
+	for (auto _ : state)
+	{
+		std::string joined;
+		for (size_t i = 0; i < words.size(); ++i)
+		{
+			if (i > 0)
+			{
+				joined += ' ';
+			}
+			joined += words[i];
+		}
+		benchmark::DoNotOptimize(joined.data());
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StdStringJoin)->Apply(quadraticSizes);
+
+//====================================================================================
+//                                UTF-8 Benchmarks
+//====================================================================================
+
+// The standard library has no non-deprecated UTF-8 API, so the baselines for these are
+// the plain byte loops that do the least possible work on the same data.
+
+static void BM_StringIsValidUtf8(benchmark::State& state)
+{
+	bump::String string = createUtf8Text(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.isValidUtf8(); });
+}
+BENCHMARK(BM_StringIsValidUtf8)->Apply(allSizes);
+
+static void BM_StringCodePointCount(benchmark::State& state)
+{
+	bump::String string = createUtf8Text(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.codePointCount(); });
+}
+BENCHMARK(BM_StringCodePointCount)->Apply(allSizes);
+
+static void BM_StdStringCodePointCount(benchmark::State& state)
+{
+	std::string string = createUtf8Text(state.range(0));
+	runReadOnly(state, string, [](const std::string& s)
+	{
+		return std::count_if(s.begin(), s.end(), [](unsigned char c) { return (c & 0xC0) != 0x80; });
+	});
+}
+BENCHMARK(BM_StdStringCodePointCount)->Apply(allSizes);
+
+static void BM_StringToUtf16(benchmark::State& state)
+{
+	bump::String string = createUtf8Text(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.toUtf16(); });
+}
+BENCHMARK(BM_StringToUtf16)->Apply(allSizes);
+
+static void BM_StringToUtf32(benchmark::State& state)
+{
+	bump::String string = createUtf8Text(state.range(0));
+	runReadOnly(state, string, [](const bump::String& s) { return s.toUtf32(); });
+}
+BENCHMARK(BM_StringToUtf32)->Apply(allSizes);
+
+static void BM_StringFromUtf16(benchmark::State& state)
+{
+	std::u16string string = bump::String(createUtf8Text(state.range(0))).toUtf16();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(bump::String::fromUtf16(string));
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StringFromUtf16)->Apply(allSizes);
+
+static void BM_StringFromUtf32(benchmark::State& state)
+{
+	std::u32string string = bump::String(createUtf8Text(state.range(0))).toUtf32();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(bump::String::fromUtf32(string));
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StringFromUtf32)->Apply(allSizes);
+
+//====================================================================================
+//                           Numeric Conversion Benchmarks
+//====================================================================================
+
+// Numbers are short, so these run on fixed inputs instead of the input sizes
+
+static void BM_StringFromInt(benchmark::State& state)
+{
+	int number = 1234567;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(bump::String(number));
+	}
+}
+BENCHMARK(BM_StringFromInt);
+
+static void BM_StdStringFromInt(benchmark::State& state)
+{
+	int number = 1234567;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::to_string(number));
+	}
+}
+BENCHMARK(BM_StdStringFromInt);
+
+static void BM_StringFromDouble(benchmark::State& state)
+{
+	double number = 98.047384;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(bump::String(number, 4));
+	}
+}
+BENCHMARK(BM_StringFromDouble);
+
+static void BM_StdStringFromDouble(benchmark::State& state)
+{
+	double number = 98.047384;
+	for (auto _ : state)
+	{
+		std::ostringstream stream;
+		stream.setf(std::ios::fixed, std::ios::floatfield);
+		stream.precision(4);
+		stream << number;
+		benchmark::DoNotOptimize(stream.str());
+	}
+}
+BENCHMARK(BM_StdStringFromDouble);
+
+static void BM_StringToBool(benchmark::State& state)
+{
+	bump::String string = "True";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(string.toBool());
+	}
+}
+BENCHMARK(BM_StringToBool);
+
+static void BM_StdStringToBool(benchmark::State& state)
+{
+	std::string string = "True";
+	for (auto _ : state)
+	{
+		std::string lowered = string;
+		benchmark::DoNotOptimize(stdToLower(lowered) == "true");
+	}
+}
+BENCHMARK(BM_StdStringToBool);
+
+static void BM_StringToDouble(benchmark::State& state)
+{
+	bump::String string = "98.047384";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(string.toDouble());
+	}
+}
+BENCHMARK(BM_StringToDouble);
+
+static void BM_StdStringToDouble(benchmark::State& state)
+{
+	std::string string = "98.047384";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::strtod(string.c_str(), NULL));
+	}
+}
+BENCHMARK(BM_StdStringToDouble);
+
+static void BM_StringToFloat(benchmark::State& state)
+{
+	bump::String string = "98.0473";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(string.toFloat());
+	}
+}
+BENCHMARK(BM_StringToFloat);
+
+static void BM_StdStringToFloat(benchmark::State& state)
+{
+	std::string string = "98.0473";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::strtof(string.c_str(), NULL));
+	}
+}
+BENCHMARK(BM_StdStringToFloat);
+
+static void BM_StringToInt(benchmark::State& state)
+{
+	bump::String string = "-1234567";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(string.toInt());
+	}
+}
+BENCHMARK(BM_StringToInt);
+
+static void BM_StdStringToInt(benchmark::State& state)
+{
+	std::string string = "-1234567";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::strtol(string.c_str(), NULL, 10));
+	}
+}
+BENCHMARK(BM_StdStringToInt);
+
+static void BM_StringToLongLong(benchmark::State& state)
+{
+	bump::String string = "-1234567890123";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(string.toLongLong());
+	}
+}
+BENCHMARK(BM_StringToLongLong);
+
+static void BM_StdStringToLongLong(benchmark::State& state)
+{
+	std::string string = "-1234567890123";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::strtoll(string.c_str(), NULL, 10));
+	}
+}
+BENCHMARK(BM_StdStringToLongLong);
+
+static void BM_StringToUInt(benchmark::State& state)
+{
+	bump::String string = "1234567";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(string.toUInt());
+	}
+}
+BENCHMARK(BM_StringToUInt);
+
+static void BM_StdStringToUInt(benchmark::State& state)
+{
+	std::string string = "1234567";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::strtoul(string.c_str(), NULL, 10));
+	}
+}
+BENCHMARK(BM_StdStringToUInt);
+
+static void BM_StringIsNumber(benchmark::State& state)
+{
+	bump::String string = "98.047384";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(string.isNumber());
+	}
+}
+BENCHMARK(BM_StringIsNumber);
+
+static void BM_StdStringIsNumber(benchmark::State& state)
+{
+	std::string string = "98.047384";
+	for (auto _ : state)
+	{
+		char* end = NULL;
+		std::strtod(string.c_str(), &end);
+		benchmark::DoNotOptimize(end != string.c_str() && *end == '\0');
+	}
+}
+BENCHMARK(BM_StdStringIsNumber);
+
+}	// End of bumpBenchmark namespace
@@ -0,0 +1,157 @@
+//
+//	BinaryLogReader.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_BINARY_LOG_READER_H
+#define BUMP_BINARY_LOG_READER_H
+
+// C++ headers
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/Log.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * A message read back from a binary log.
+ */
+struct BinaryLogMessage
+{
+	Log::LogLevel	level;		/**< The log level of the message. */
+	long long		time;		/**< The microseconds since the Unix epoch the message was logged. */
+	String			file;		/**< The source file of the call site, empty for the convenience functions. */
+	unsigned int	line;		/**< The source line of the call site, 0 for the convenience functions. */
+	String			text;		/**< The prefix followed by the formatted message. */
+};
+
+/**
+ * The BinaryLogReader class turns a binary log written by Log::enableBinaryLogging() back into text.
+ *
+ * A binary log starts with the "BUMPLOG1" magic, the counter ticks per microsecond as an
+ * 8 byte double and an initial calibration laid out like a CALIBRATION_ENTRY payload. The
+ * rest of the file is a sequence of entries. Each entry is a 1 byte EntryType and a 4 byte payload size
+ * followed by the payload. All numbers are in the byte order of the machine that wrote
+ * the log:
+ *   - CALL_SITE_ENTRY: 4 byte id, 1 byte level, 4 byte line, then the file and the
+ *     format, each as a 4 byte length followed by the characters.
+ *   - RECORD_ENTRY: 4 byte call site id, 8 byte counter value, the prefix as a 4 byte
+ *     length and characters, a 1 byte argument count and the arguments written by
+ *     LogArgument::encodeTo().
+ *   - CALIBRATION_ENTRY: 8 byte counter value and the 8 byte microseconds since the epoch
+ *     it was read at.
+ *
+ * Records are formatted with Log::formatMessage(), so they read exactly like the text
+ * log would have. A truncated entry at the end of the file, as left behind by a crash,
+ * simply ends the log.
+ */
+class BUMP_EXPORT BinaryLogReader
+{
+public:
+
+	/** The kinds of entries in a binary log. */
+	enum EntryType
+	{
+		CALL_SITE_ENTRY = 'S',		/**< The format, level and location of a call site. */
+		RECORD_ENTRY = 'R',			/**< A logged message. */
+		CALIBRATION_ENTRY = 'C'		/**< A counter value and the time it was read at. */
+	};
+
+	/** The magic bytes every binary log starts with. */
+	static const char MAGIC[8];
+
+	/**
+	 * Constructor.
+	 *
+	 * @param filepath The binary log to read.
+	 * @throw bump::FileSystemError When the file cannot be opened or is not a binary log.
+	 */
+	explicit BinaryLogReader(const String& filepath);
+
+	/**
+	 * Destructor.
+	 */
+	~BinaryLogReader();
+
+	/**
+	 * Reads the next message.
+	 *
+	 * @param message Set to the next message.
+	 * @return True if a message was read, false at the end of the log.
+	 */
+	bool readMessage(BinaryLogMessage& message);
+
+protected:
+
+	/** @internal A call site registered in the binary log. */
+	struct CallSite
+	{
+		Log::LogLevel	level;		/**< @internal The log level of the messages. */
+		unsigned int	line;		/**< @internal The source line. */
+		String			file;		/**< @internal The source file. */
+		String			format;		/**< @internal The message format. */
+	};
+
+	/**
+	 * @internal
+	 * Reads the payload of the next entry.
+	 *
+	 * @param type Set to the type of the entry.
+	 * @return True if a whole entry was read, false at the end of the log.
+	 */
+	bool readEntry(unsigned char& type);
+
+	/**
+	 * @internal
+	 * Registers the call site in the current payload.
+	 */
+	void readCallSite();
+
+	/**
+	 * @internal
+	 * Formats the record in the current payload.
+	 *
+	 * @param message Set to the formatted message.
+	 * @return True if the record is valid, false otherwise.
+	 */
+	bool readRecord(BinaryLogMessage& message);
+
+	// Instance member variables
+	std::ifstream				_file;					/**< @internal The binary log. */
+	std::string					_payload;				/**< @internal The payload of the current entry. */
+	std::vector<CallSite>		_callSites;				/**< @internal The call sites indexed by id minus one. */
+	std::vector<LogArgument>	_arguments;				/**< @internal The arguments of the current record. */
+	double						_ticksPerMicrosecond;	/**< @internal The counter frequency. */
+	unsigned long long			_baseTicks;				/**< @internal The counter value of the latest calibration. */
+	long long					_baseTime;				/**< @internal The time of the latest calibration. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since the reader can't be copied.
+	 */
+	BinaryLogReader(const BinaryLogReader& reader);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since the reader can't be copied.
+	 */
+	void operator=(const BinaryLogReader& reader);
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_BINARY_LOG_READER_H
@@ -0,0 +1,157 @@
+//
+//	Cpu.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_CPU_H
+#define BUMP_CPU_H
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/String.h>
+
+// Environment variable name definitions
+#define BUMP_CPU_KERNEL_LEVEL	"BUMP_CPU_KERNEL_LEVEL"
+
+// Defines whether x86 kernels can be compiled for runtime dispatch
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+	#define BUMP_CPU_X86
+#endif
+
+// Function attributes that enable an instruction set for a single kernel. MSVC does not
+// need them since all of its intrinsics are available regardless of the /arch setting.
+#if defined(BUMP_CPU_X86) && (defined(__GNUC__) || defined(__clang__))
+	#define BUMP_TARGET_SSE42	__attribute__((target("sse4.2")))
+	#define BUMP_TARGET_AVX2	__attribute__((target("avx2")))
+	#define BUMP_TARGET_AVX512	__attribute__((target("avx512f,avx512bw,avx512vl")))
+	#define BUMP_TARGET_SHA		__attribute__((target("sha,sse4.1")))
+#else
+	#define BUMP_TARGET_SSE42
+	#define BUMP_TARGET_AVX2
+	#define BUMP_TARGET_AVX512
+	#define BUMP_TARGET_SHA
+#endif
+
+// Expands to the kernel on x86 builds and to NULL everywhere else so the kernel tables
+// can be written once for every platform
+#ifdef BUMP_CPU_X86
+	#define BUMP_CPU_KERNEL(kernel) kernel
+#else
+	#define BUMP_CPU_KERNEL(kernel) NULL
+#endif
+
+namespace bump {
+
+/**
+ * The Cpu namespace detects the instruction set extensions of the host processor and
+ * selects the best kernel for each of the SIMD-friendly hot spots inside Bump. This
+ * allows a single binary to run vectorized code on new processors while still running
+ * on old ones.
+ *
+ * The features are detected once, the first time they are queried, and never change
+ * for the lifetime of the process. Each module keeps a table of function pointers
+ * filled in by selectKernel() the first time it is used.
+ *
+ * The following environment variable can be used to limit the kernels at runtime:
+ *	  - BUMP_CPU_KERNEL_LEVEL: Defines the highest kernel level that can be selected:
+ *		  * [ SCALAR_KERNEL | SSE42_KERNEL | AVX2_KERNEL | AVX512_KERNEL ]
+ *
+ * Setting it to SCALAR_KERNEL disables all the features which is useful for testing
+ * the portable code paths on a modern machine.
+ */
+namespace Cpu {
+
+/** The instruction set extensions Bump has kernels for. */
+enum Feature
+{
+	SSE42_FEATURE	= 1 << 0,	/**< SSE4.2 (including SSSE3 and SSE4.1). */
+	AVX2_FEATURE	= 1 << 1,	/**< AVX2 with operating system support for the YMM registers. */
+	AVX512_FEATURE	= 1 << 2,	/**< AVX-512 F, BW and VL with operating system support for the ZMM registers. */
+	SHA_FEATURE		= 1 << 3,	/**< The SHA extensions (SHA-NI). */
+	BMI2_FEATURE	= 1 << 4	/**< The BMI2 bit manipulation instructions. */
+};
+
+/** The kernel levels in increasing order of preference. */
+enum KernelLevel
+{
+	SCALAR_KERNEL,	/**< Portable C++ that runs everywhere. */
+	SSE42_KERNEL,	/**< 128-bit vector kernels. */
+	AVX2_KERNEL,	/**< 256-bit vector kernels. */
+	AVX512_KERNEL	/**< 512-bit vector kernels. */
+};
+
+/**
+ * Returns whether the host processor supports the given feature.
+ *
+ * Features above the BUMP_CPU_KERNEL_LEVEL limit are reported as unsupported.
+ *
+ * @param feature The feature to check for.
+ * @return True if the feature can be used, false otherwise.
+ */
+BUMP_EXPORT bool hasFeature(Feature feature);
+
+/**
+ * Returns a bitmask of all the supported features.
+ *
+ * @return A bitmask of Feature values that can be used.
+ */
+BUMP_EXPORT unsigned int features();
+
+/**
+ * Returns the highest kernel level supported by the host processor.
+ *
+ * @return The highest kernel level that can be selected.
+ */
+BUMP_EXPORT KernelLevel kernelLevel();
+
+/**
+ * Returns a human readable list of the supported features (i.e. "SSE4.2 AVX2 SHA").
+ *
+ * @return A space separated list of the supported features.
+ */
+BUMP_EXPORT String featureString();
+
+/**
+ * Selects the best kernel for the host processor from the given candidates.
+ *
+ * Candidates can be NULL when a module does not have a kernel for that level.
+ *
+ * @code
+ *   static const CountKernel count = bump::Cpu::selectKernel<CountKernel>(countScalar,
+ *       BUMP_CPU_KERNEL(countSse42), BUMP_CPU_KERNEL(countAvx2), NULL);
+ * @endcode
+ *
+ * @param scalarKernel The portable kernel, must not be NULL.
+ * @param sse42Kernel The SSE4.2 kernel.
+ * @param avx2Kernel The AVX2 kernel.
+ * @param avx512Kernel The AVX-512 kernel.
+ * @return The kernel for the highest supported level.
+ */
+template <typename Kernel>
+inline Kernel selectKernel(Kernel scalarKernel, Kernel sse42Kernel, Kernel avx2Kernel, Kernel avx512Kernel)
+{
+	KernelLevel level = kernelLevel();
+	if (avx512Kernel && level >= AVX512_KERNEL)
+	{
+		return avx512Kernel;
+	}
+	else if (avx2Kernel && level >= AVX2_KERNEL)
+	{
+		return avx2Kernel;
+	}
+	else if (sse42Kernel && level >= SSE42_KERNEL)
+	{
+		return sse42Kernel;
+	}
+
+	return scalarKernel;
+}
+
+}	// End of Cpu namespace
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_CPU_H
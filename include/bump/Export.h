@@ -32,6 +32,15 @@
 	#define BUMP_EXPORT BOOST_SYMBOL_IMPORT
 #endif
 
+// Marks a table holding the addresses of member functions that used to be defined in a source
+// file and are now inline in a header. Keeping the table makes the compiler emit the functions
+// into the library, so binaries built against earlier versions still find the exported symbols.
+#if defined(__GNUC__) || defined(__clang__)
+	#define BUMP_KEEP_INLINE_SYMBOLS __attribute__((used))
+#else
+	#define BUMP_KEEP_INLINE_SYMBOLS
+#endif
+
 // Set up define for whether member templates are supported by VisualStudio compilers
 #ifdef _MSC_VER
 	#if (_MSC_VER >= 1300)
@@ -0,0 +1,119 @@
+//
+//	FileDescriptorLogSink.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_FILE_DESCRIPTOR_LOG_SINK_H
+#define BUMP_FILE_DESCRIPTOR_LOG_SINK_H
+
+// Boost headers
+#include <boost/atomic.hpp>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/LogIndexWriter.h>
+#include <bump/LogSink.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * The FileDescriptorLogSink class writes the log output straight to a file descriptor.
+ *
+ * There is no stdio or iostream buffering in between. Each call to write() hands all of
+ * its buffers to a single writev() call, only looping when the kernel accepts part of
+ * them, so a buffered batch of thousands of messages costs a handful of system calls.
+ *
+ * Write errors are ignored since there is nowhere left to report them to.
+ *
+ * Sinks writing to a file can keep a sparse time index next to it, see LogIndexWriter,
+ * so a LogReader can pull a time range out of the file without reading all of it.
+ */
+class BUMP_EXPORT FileDescriptorLogSink : public LogSink
+{
+public:
+
+	/**
+	 * Constructor writing to an already open file descriptor such as 1 for stdout.
+	 *
+	 * @param fileDescriptor The file descriptor to write to.
+	 * @param closeOnDestruction Whether to close the file descriptor when the sink is destroyed.
+	 */
+	explicit FileDescriptorLogSink(int fileDescriptor, bool closeOnDestruction = false);
+
+	/**
+	 * Constructor opening the given file for writing, creating it if necessary.
+	 *
+	 * @param filepath The file to write the log output to.
+	 * @param append Whether to append to an existing file, otherwise it is truncated.
+	 * @param indexInterval The number of bytes between the entries of the time index, 0 for no index.
+	 * @throw bump::FileSystemError When the file or its index cannot be opened.
+	 */
+	explicit FileDescriptorLogSink(const String& filepath, bool append = true, unsigned long long indexInterval = 0);
+
+	/**
+	 * Destructor.
+	 */
+	~FileDescriptorLogSink();
+
+	/**
+	 * Writes the given buffers in order with as few system calls as possible, then adds them to the time index.
+	 *
+	 * @param buffers The buffers to write.
+	 * @param bufferCount The number of buffers.
+	 */
+	void write(const Buffer* buffers, unsigned int bufferCount);
+
+	/**
+	 * Returns the writer of the time index of the file.
+	 *
+	 * @return The writer of the time index, NULL when the sink keeps no index.
+	 */
+	const LogIndexWriter* indexWriter() const;
+
+	/**
+	 * Returns the file descriptor the sink writes to.
+	 *
+	 * @return The file descriptor the sink writes to.
+	 */
+	int fileDescriptor() const;
+
+	/**
+	 * Returns the number of system calls made writing to the file descriptor.
+	 *
+	 * @return The number of system calls made writing to the file descriptor.
+	 */
+	unsigned long long writeCallCount() const;
+
+protected:
+
+	/**
+	 * @internal
+	 * Closes the file descriptor if the sink owns it.
+	 */
+	void close();
+
+	/**
+	 * @internal
+	 * Writes the given buffers in order with as few system calls as possible.
+	 *
+	 * Implemented in the platform specific source files.
+	 *
+	 * @param buffers The buffers to write.
+	 * @param bufferCount The number of buffers.
+	 */
+	void writeBuffers(const Buffer* buffers, unsigned int bufferCount);
+
+	// Instance member variables
+	int									_fileDescriptor;		/**< @internal The file descriptor to write to. */
+	bool								_closeOnDestruction;	/**< @internal Whether the sink owns the file descriptor. */
+	boost::atomic<unsigned long long>	_writeCallCount;		/**< @internal The number of system calls made writing. */
+	LogIndexWriter*						_indexWriter;			/**< @internal The writer of the time index, NULL for none. */
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_FILE_DESCRIPTOR_LOG_SINK_H
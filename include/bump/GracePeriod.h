@@ -0,0 +1,197 @@
+//
+//	GracePeriod.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_GRACE_PERIOD_H
+#define BUMP_GRACE_PERIOD_H
+
+// Boost headers
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+// Bump headers
+#include <bump/Export.h>
+
+namespace bump {
+
+/**
+ * The GracePeriod class tells a thread changing shared state when every thread that
+ * could still be using the old state has moved on.
+ *
+ * Readers bracket their use of the state with enter() and leave(), which are a single
+ * atomic increment and decrement on a counter spread over cache lines by thread. A writer
+ * first makes the old state unreachable, for example by clearing a flag or swapping a
+ * pointer, then calls retire() and waits for the grace period with waitFor(), or polls it
+ * with hasElapsed() when it must not block.
+ *
+ * The readers are counted in one of two phases. The generation only moves on once every
+ * reader of the previous phase has left, and a grace period ends two generations after it
+ * started. New readers always join the current phase, so a writer only ever waits for the
+ * readers that were already there and never for a moment without any readers at all.
+ * A reader that enters after the writer checked its phase is guaranteed to see the new
+ * state, since every operation is sequentially consistent.
+ *
+ * A thread must never wait for a grace period from within enter() and leave(), since
+ * it would be waiting for itself.
+ */
+class BUMP_EXPORT GracePeriod
+{
+public:
+
+	/**
+	 * Constructor.
+	 */
+	GracePeriod();
+
+	/**
+	 * Destructor.
+	 */
+	~GracePeriod();
+
+	/**
+	 * Counts the calling thread as a reader until leave() is called.
+	 *
+	 * @return The token to pass to leave().
+	 */
+	unsigned int enter();
+
+	/**
+	 * Stops counting the calling thread as a reader.
+	 *
+	 * @param token The token returned by enter().
+	 */
+	void leave(unsigned int token);
+
+	/**
+	 * Starts a grace period, which must be done after the old state was made unreachable.
+	 *
+	 * @return The stamp to pass to hasElapsed() and waitFor().
+	 */
+	unsigned long long retire();
+
+	/**
+	 * Returns whether the grace period has ended, moving the generation on where possible.
+	 *
+	 * Never blocks, so it can be called from within enter() and leave().
+	 *
+	 * @param stamp The stamp returned by retire().
+	 * @return True if every reader that entered before retire() has left, false otherwise.
+	 */
+	bool hasElapsed(unsigned long long stamp);
+
+	/**
+	 * Blocks until the grace period has ended.
+	 *
+	 * @param stamp The stamp returned by retire().
+	 */
+	void waitFor(unsigned long long stamp);
+
+	/**
+	 * Blocks until every reader that entered before the call has left.
+	 */
+	void wait();
+
+	/**
+	 * The Reader class counts the calling thread as a reader for as long as it's in scope.
+	 */
+	class Reader
+	{
+	public:
+
+		/**
+		 * Constructor entering the grace period.
+		 *
+		 * @param gracePeriod The grace period to enter.
+		 */
+		explicit Reader(GracePeriod& gracePeriod) : _gracePeriod(gracePeriod), _token(gracePeriod.enter()) {}
+
+		/**
+		 * Destructor leaving the grace period.
+		 */
+		~Reader() { _gracePeriod.leave(_token); }
+
+	protected:
+
+		// Instance member variables
+		GracePeriod&		_gracePeriod;	/**< @internal The grace period entered. */
+		unsigned int		_token;			/**< @internal The token returned by enter(). */
+
+	private:
+
+		/**
+		 * @internal
+		 * Copy constructor.
+		 *
+		 * No-op since the reader can't be copied.
+		 */
+		Reader(const Reader& reader);
+
+		/**
+		 * @internal
+		 * Overloaded assignment operator.
+		 *
+		 * No-op since the reader can't be copied.
+		 */
+		void operator=(const Reader& reader);
+	};
+
+protected:
+
+	/** @internal The readers of both phases on the threads sharing a slot, alone on its cache line. */
+	struct Slot
+	{
+		boost::atomic<unsigned int>		counts[2];		/**< @internal The number of readers of each phase. */
+		char							padding[56];	/**< @internal Padding up to the next cache line. */
+	};
+
+	/** @internal The number of slots the readers are spread over. */
+	static const unsigned int SLOT_COUNT = 16;
+
+	/**
+	 * @internal
+	 * Moves the generation on as far as the readers allow. The mutex must be locked.
+	 */
+	void advanceLocked();
+
+	/**
+	 * @internal
+	 * Returns whether any reader of the given phase is left.
+	 *
+	 * @param phase The phase to check.
+	 * @return True if a reader of the phase is left, false otherwise.
+	 */
+	bool hasReaders(unsigned int phase) const;
+
+	// Instance member variables
+	Slot								_slots[SLOT_COUNT];		/**< @internal The reader counts. */
+	boost::atomic<unsigned long long>	_generation;			/**< @internal The generation, whose lowest bit is the current phase. */
+	boost::atomic<unsigned int>			_waiterCount;			/**< @internal The number of threads waiting for a grace period. */
+	boost::mutex						_mutex;					/**< @internal A boost mutex serializing moving the generation on. */
+	boost::condition_variable			_condition;				/**< @internal Signaled when the readers of a slot and phase have all left. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since the grace period can't be copied.
+	 */
+	GracePeriod(const GracePeriod& gracePeriod);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since the grace period can't be copied.
+	 */
+	void operator=(const GracePeriod& gracePeriod);
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_GRACE_PERIOD_H
@@ -0,0 +1,152 @@
+//
+//	LockFreeQueue.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_LOCK_FREE_QUEUE_H
+#define BUMP_LOCK_FREE_QUEUE_H
+
+// C++ headers
+#include <cstddef>
+
+// Boost headers
+#include <boost/atomic.hpp>
+
+namespace bump {
+
+/**
+ * The LockFreeQueue class is a bounded multi-producer, multi-consumer FIFO queue.
+ *
+ * The values live inside the queue cells and are filled and consumed in place through
+ * the function objects passed to tryPush() and tryPop(). Values are never destroyed
+ * between uses, so types like bump::String keep their capacity and a queue that has
+ * warmed up stops allocating altogether.
+ *
+ * Each cell carries a sequence number telling whether it is ready to be written or read
+ * for the current lap around the ring, so producers and consumers only ever contend on
+ * their own position counter. Neither operation blocks: tryPush() returns false when
+ * the queue is full and tryPop() returns false when it is empty.
+ *
+ * When a function object throws, the cell it was given is still released before the
+ * exception is passed on. A cell whose fill threw is marked as skipped and is passed over
+ * by the consumers, so a failed push never stalls the queue.
+ */
+template <class T>
+class LockFreeQueue
+{
+public:
+
+	/**
+	 * Constructor.
+	 *
+	 * @param capacity The maximum number of values, rounded up to the next power of two.
+	 */
+	inline explicit LockFreeQueue(unsigned int capacity);
+
+	/**
+	 * Destructor.
+	 */
+	inline ~LockFreeQueue();
+
+	/**
+	 * Returns the maximum number of values the queue can hold.
+	 *
+	 * @return The maximum number of values the queue can hold.
+	 */
+	inline unsigned int capacity() const;
+
+	/**
+	 * Returns whether the queue is empty.
+	 *
+	 * The result is only a snapshot when other threads are using the queue.
+	 *
+	 * @return True if no values are queued, false otherwise.
+	 */
+	inline bool isEmpty() const;
+
+	/**
+	 * Returns the number of queued values.
+	 *
+	 * The result is only a snapshot when other threads are using the queue.
+	 *
+	 * @return The number of queued values.
+	 */
+	inline unsigned int size() const;
+
+	/**
+	 * Claims the next free cell and passes its value to the given function to fill in.
+	 *
+	 * @param fill A function object called as fill(T& value).
+	 * @return True if the value was pushed, false if the queue was full.
+	 * @throw Whatever fill throws, in which case nothing is pushed.
+	 */
+	template <class Function>
+	inline bool tryPush(Function fill);
+
+	/**
+	 * Claims the oldest value and passes it to the given function before releasing its cell.
+	 *
+	 * @param consume A function object called as consume(T& value).
+	 * @return True if a value was popped, false if the queue was empty.
+	 * @throw Whatever consume throws, in which case the value is still popped.
+	 */
+	template <class Function>
+	inline bool tryPop(Function consume);
+
+	/**
+	 * Pops the oldest value without looking at it.
+	 *
+	 * @return True if a value was discarded, false if the queue was empty.
+	 */
+	inline bool tryDiscard();
+
+protected:
+
+	/** @internal A value along with the sequence number telling who may use it next. */
+	struct Cell
+	{
+		boost::atomic<size_t>	sequence;	/**< @internal The position the cell is ready for. */
+		bool					isSkipped;	/**< @internal Whether the fill threw, leaving nothing to consume. */
+		T						value;		/**< @internal The queued value. */
+	};
+
+	/** @internal The size of a cache line, used to keep the positions apart. */
+	static const size_t CACHE_LINE_SIZE = 64;
+
+	// Instance member variables
+	Cell*					_cells;												/**< @internal The ring of cells. */
+	size_t					_mask;												/**< @internal The capacity minus one, used to wrap positions. */
+	char					_enqueuePadding[CACHE_LINE_SIZE];					/**< @internal Keeps the producers off the cells line. */
+	boost::atomic<size_t>	_enqueuePosition;									/**< @internal The position of the next push. */
+	char					_dequeuePadding[CACHE_LINE_SIZE - sizeof(size_t)];	/**< @internal Keeps the producers off the consumers line. */
+	boost::atomic<size_t>	_dequeuePosition;									/**< @internal The position of the next pop. */
+	char					_endPadding[CACHE_LINE_SIZE - sizeof(size_t)];		/**< @internal Keeps the consumers off the next object. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since the queue can't be copied.
+	 */
+	LockFreeQueue(const LockFreeQueue& queue);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since the queue can't be copied.
+	 */
+	void operator=(const LockFreeQueue& queue);
+};
+
+}	// End of bump namespace
+
+// Pull in the template implementations
+#include <bump/LockFreeQueue_impl.h>
+
+#endif	// End of BUMP_LOCK_FREE_QUEUE_H
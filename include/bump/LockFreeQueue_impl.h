@@ -0,0 +1,187 @@
+//
+//	LockFreeQueue_impl.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_LOCK_FREE_QUEUE_IMPL_H
+#define BUMP_LOCK_FREE_QUEUE_IMPL_H
+
+namespace bump {
+
+//====================================================================================
+//                                   LockFreeQueue
+//====================================================================================
+
+template <class T>
+inline LockFreeQueue<T>::LockFreeQueue(unsigned int capacity) :
+	_cells(NULL),
+	_mask(0),
+	_enqueuePosition(0),
+	_dequeuePosition(0)
+{
+	// Round the capacity up to a power of two so positions wrap with a mask
+	size_t cell_count = 2;
+	while (cell_count < capacity)
+	{
+		cell_count <<= 1;
+	}
+
+	// Every cell starts out ready to be written on the first lap
+	_cells = new Cell[cell_count];
+	_mask = cell_count - 1;
+	for (size_t i = 0; i < cell_count; ++i)
+	{
+		_cells[i].sequence.store(i, boost::memory_order_relaxed);
+		_cells[i].isSkipped = false;
+	}
+}
+
+template <class T>
+inline LockFreeQueue<T>::~LockFreeQueue()
+{
+	delete [] _cells;
+}
+
+template <class T>
+inline unsigned int LockFreeQueue<T>::capacity() const
+{
+	return static_cast<unsigned int>(_mask + 1);
+}
+
+template <class T>
+inline bool LockFreeQueue<T>::isEmpty() const
+{
+	return size() == 0;
+}
+
+template <class T>
+inline unsigned int LockFreeQueue<T>::size() const
+{
+	size_t dequeue_position = _dequeuePosition.load(boost::memory_order_seq_cst);
+	size_t enqueue_position = _enqueuePosition.load(boost::memory_order_seq_cst);
+	return enqueue_position > dequeue_position ? static_cast<unsigned int>(enqueue_position - dequeue_position) : 0;
+}
+
+template <class T>
+template <class Function>
+inline bool LockFreeQueue<T>::tryPush(Function fill)
+{
+	Cell* cell = NULL;
+	size_t position = _enqueuePosition.load(boost::memory_order_relaxed);
+	while (true)
+	{
+		cell = &_cells[position & _mask];
+		size_t sequence = cell->sequence.load(boost::memory_order_acquire);
+		std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+		// The cell is free for this lap, so try to claim it
+		if (difference == 0)
+		{
+			if (_enqueuePosition.compare_exchange_weak(position, position + 1, boost::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+
+		// The cell still holds the value from the previous lap, so the queue is full
+		else if (difference < 0)
+		{
+			return false;
+		}
+
+		// Another producer claimed the cell first
+		else
+		{
+			position = _enqueuePosition.load(boost::memory_order_relaxed);
+		}
+	}
+
+	// Fill the value and hand the cell over to the consumers, who pass over it if the fill threw
+	try
+	{
+		fill(cell->value);
+	}
+	catch (...)
+	{
+		cell->isSkipped = true;
+		cell->sequence.store(position + 1, boost::memory_order_release);
+		throw;
+	}
+
+	cell->isSkipped = false;
+	cell->sequence.store(position + 1, boost::memory_order_release);
+	return true;
+}
+
+template <class T>
+template <class Function>
+inline bool LockFreeQueue<T>::tryPop(Function consume)
+{
+	Cell* cell = NULL;
+	size_t position = _dequeuePosition.load(boost::memory_order_relaxed);
+	while (true)
+	{
+		cell = &_cells[position & _mask];
+		size_t sequence = cell->sequence.load(boost::memory_order_acquire);
+		std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+		// The cell has been filled for this lap, so try to claim it
+		if (difference == 0)
+		{
+			if (_dequeuePosition.compare_exchange_weak(position, position + 1, boost::memory_order_relaxed))
+			{
+				// A cell whose fill threw is released and passed over
+				if (!cell->isSkipped)
+				{
+					break;
+				}
+				cell->sequence.store(position + _mask + 1, boost::memory_order_release);
+				position = _dequeuePosition.load(boost::memory_order_relaxed);
+			}
+		}
+
+		// The cell hasn't been filled yet, so the queue is empty
+		else if (difference < 0)
+		{
+			return false;
+		}
+
+		// Another consumer claimed the cell first
+		else
+		{
+			position = _dequeuePosition.load(boost::memory_order_relaxed);
+		}
+	}
+
+	// Consume the value and hand the cell back to the producers for the next lap
+	try
+	{
+		consume(cell->value);
+	}
+	catch (...)
+	{
+		cell->sequence.store(position + _mask + 1, boost::memory_order_release);
+		throw;
+	}
+
+	cell->sequence.store(position + _mask + 1, boost::memory_order_release);
+	return true;
+}
+
+template <class T>
+inline bool LockFreeQueue<T>::tryDiscard()
+{
+	struct Discard
+	{
+		void operator()(T& /*value*/) const {}
+	};
+
+	return tryPop(Discard());
+}
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_LOCK_FREE_QUEUE_IMPL_H
@@ -9,11 +9,25 @@
 #ifndef BUMP_LOG_H
 #define BUMP_LOG_H
 
+// C++ headers
+#include <algorithm>
+#include <map>
+#include <vector>
+
 // Boost headers
+#include <boost/atomic.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 
 // Bump headers
 #include <bump/Export.h>
+#include <bump/GracePeriod.h>
+#include <bump/LogArgument.h>
+#include <bump/LogCallSite.h>
+#include <bump/LogField.h>
+#include <bump/LogLimiter.h>
+#include <bump/LogSink.h>
 #include <bump/String.h>
 
 // Environment variable name definitions
@@ -24,8 +38,23 @@
 // Defines the bump prefix for logging
 #define bumpPrefix			"[bump] "
 
+// The most verbose log level compiled in, see the compile-time level stripping below
+#ifndef BUMP_LOG_MIN_LEVEL
+	#define BUMP_LOG_MIN_LEVEL	4
+#endif
+
 namespace bump {
 
+// Forward declarations
+class FileDescriptorLogSink;
+class LogFlightRecorder;
+class Logger;
+template <class T> class LockFreeQueue;
+struct LogRecord;
+struct LogSinkEntry;
+struct LogThreadBuffer;
+struct LogThreadStatistics;
+
 /**
  * The Log class handles all logging.
  *
@@ -33,7 +62,15 @@ namespace bump {
  *	  - Five different log levels
  *	  - Output redirection to files (a custom std::ofstream)
  *	  - Thread-safe access to the stream buffer and thread-safe logging functions
- *    - Timestamp formatting
+ *	  - Lock-free level checks so filtered out messages cost a single atomic load
+ *	  - Asynchronous logging through a lock-free queue drained by a writer thread
+ *	  - Buffered logging through per-thread buffers written to a LogSink in batches
+ *	  - Binary logging of unformatted arguments, decoded offline with bumpLogDecode
+ *	  - Fan-out to additional sinks, each with its own level, prefix filter and optional thread
+ *	  - Per call site rate limiting, sampling and repeat suppression
+ *	  - A flight recorder keeping the last records of every thread in memory for crash dumps
+ *	  - Named loggers with inherited levels, each checked with a single atomic load
+ *	  - Cached timestamp formatting down to the microsecond, in local time or UTC
  *	  - Disabling the log altogether
  *
  * The following environment variables can be used to configure the log at runtime:
@@ -43,6 +80,7 @@ namespace bump {
  *		  * /home/username/output.txt
  *	  - BUMP_LOG_LEVEL: Defines the maximum output level for the log:
  *		  * [ ALWAYS_LVL | ERROR_LVL | WARNING_LVL | INFO_LVL | DEBUG_LVL ]
+ *		  * followed by comma separated name=LEVEL entries for named loggers, see setLogLevels()
  *
  * Using the log is straight-forward. There are several different convenience functions
  * provided to make this as simple as possible. The easiest way to use the log is with
@@ -73,9 +111,103 @@ namespace bump {
  * @endcode
  *
  * As you can see, it is just like using std::cout, except with a bunch of extra benefits!
+ *
+ * Building a message with bump::String::arg() costs the same whether or not it ends up being
+ * logged. The BUMP_LOG_* macros take the format and its arguments separately instead and only
+ * look at the arguments once the log level is known to be enabled:
+ *
+ * @code
+ *   BUMP_LOG_DEBUG("Copying file %1 of %2: %3", index, count, path);
+ *   BUMP_LOG_ERROR_P("[bump] ", "Could not open %1", path);
+ * @endcode
+ *
+ * By default every message is written to the log stream by the thread logging it. When a
+ * slow disk or a blocked terminal must not stall the logging threads, turn on asynchronous
+ * logging. The convenience functions then copy each message into a bounded lock-free queue
+ * and a dedicated writer thread writes them out in batches:
+ *
+ * @code
+ *   bump::Log::instance()->enableAsynchronousLogging(8192, bump::Log::DROP_NEWEST_OVERFLOW);
+ *   bumpWARNING("Written by the writer thread");
+ *   bump::Log::instance()->flush();
+ * @endcode
+ *
+ * Queued messages are always written out when asynchronous logging is disabled and when
+ * the log is destroyed at exit. Writing to logStream() directly bypasses the queue.
+ *
+ * Buffered logging skips the writer thread altogether. Each thread appends its messages to
+ * a buffer of its own and every buffer is written in a single batch once the flush policy
+ * asks for it. Together with a FileDescriptorLogSink, a burst of messages becomes a handful
+ * of writev() calls:
+ *
+ * @code
+ *   bump::FileDescriptorLogSink sink("/tmp/app.log");
+ *   bump::Log::FlushPolicy policy;
+ *   policy.byteThreshold = 1 << 20;
+ *   bump::Log::instance()->setLogSink(sink);
+ *   bump::Log::instance()->enableBufferedLogging(policy);
+ * @endcode
+ *
+ * Each thread's messages keep their order, but messages from different threads are only
+ * ordered by the batch they were written in.
+ *
+ * When even formatting is too slow, binary logging skips it. Every message is written to
+ * a binary file as the id of its call site, a CPU counter timestamp and the raw bytes of
+ * its arguments. The format, level and location of each BUMP_LOG_* call site are only
+ * written once, and the bumpLogDecode tool or a BinaryLogReader turns the file back into
+ * text later:
+ *
+ * @code
+ *   bump::Log::instance()->enableBinaryLogging("/tmp/app.binlog");
+ *   BUMP_LOG_WARNING("Copying file %1 of %2: %3", index, count, path);
+ *
+ *   $ bumpLogDecode /tmp/app.binlog
+ * @endcode
+ *
+ * Besides the log stream, messages can go to any number of additional sinks. Each one
+ * takes the messages up to its own log level whose prefix starts with its prefix filter,
+ * so a console at WARNING_LVL, a file at DEBUG_LVL and an in-memory ring buffer can all
+ * be fed at once. The log level checks let through whatever the most verbose of them
+ * wants. A message is formatted once and the same text is handed to every sink taking
+ * it, and slow sinks can be written on a worker thread of their own so they never hold
+ * up the logging threads or the other sinks:
+ *
+ * @code
+ *   bump::RotatingFileLogSink file("/tmp/app.log");
+ *   bump::RingBufferLogSink ring(1 << 20);
+ *   bump::Log::SinkOptions file_options;
+ *   file_options.isThreaded = true;
+ *   bump::Log::instance()->addLogSink(file, file_options);
+ *   bump::Log::instance()->addLogSink(ring);
+ * @endcode
+ *
+ * Structured messages carry key/value fields next to the message for log collectors to
+ * index. A sink can take its messages as JSON objects instead of text lines, and the
+ * fields are then encoded straight into its buffer without building any strings or maps:
+ *
+ * @code
+ *   bump::Log::SinkOptions json_options;
+ *   json_options.format = bump::Log::JSON_SINK_FORMAT;
+ *   bump::Log::instance()->addLogSink(file, json_options);
+ *   BUMP_LOG_WARNING_FIELDS("Slow request", BUMP_LOG_FIELD("path", path), BUMP_LOG_FIELD("ms", elapsed));
+ * @endcode
+ *
+ * The flight recorder keeps the context a crash report is missing when the log level is
+ * too quiet to have written it. Every thread copies its messages, verbose ones included,
+ * unformatted into a small ring of its own, and nothing is written until the process
+ * receives a fatal signal or dumpFlightRecorder() is called:
+ *
+ * @code
+ *   bump::Log::instance()->setLogLevel(bump::Log::WARNING_LVL);
+ *   bump::Log::instance()->enableFlightRecorder("/tmp/app.crash.log");
+ *   BUMP_LOG_DEBUG("Opening %1", path);
+ * @endcode
  */
 class BUMP_EXPORT Log
 {
+	// Loggers write through the protected functions taking the level of the logger
+	friend class Logger;
+
 public:
 
 	/** The various levels of log message verbosity. */
@@ -91,15 +223,127 @@ public:
 	/** The various timestamp formats. */
 	enum TimestampFormat
 	{
-		DATE_TIME_TIMESTAMP,				/**< Date and time with format: 2013-01-14 10:51:33. */
-		DATE_TIME_WITH_AM_PM_TIMESTAMP,		/**< Date and time with format: 2013-01-14 10:51:33 AM. */
-		TIME_TIMESTAMP,						/**< Time with format: 2013-01-14 10:51:33. */
-		TIME_WITHOUT_AM_PM_TIMESTAMP		/**< Time with format: 2013-01-14 10:51:33 AM. */
+		DATE_TIME_TIMESTAMP,				/**< Date and 24-hour time with format: 2013-01-14 22:51:33. */
+		DATE_TIME_WITH_AM_PM_TIMESTAMP,		/**< Date and time with format: 2013-01-14 10:51:33 PM. */
+		TIME_TIMESTAMP,						/**< Time with format: 10:51:33 PM. */
+		TIME_WITHOUT_AM_PM_TIMESTAMP,		/**< 24-hour time with format: 22:51:33. */
+		ISO_8601_TIMESTAMP					/**< ISO 8601 date and time with the UTC offset: 2013-01-14T22:51:33+01:00. */
+	};
+
+	/** The fractions of a second written after the seconds of a timestamp. */
+	enum TimestampPrecision
+	{
+		SECONDS_PRECISION,			/**< Whole seconds: 10:51:33. */
+		MILLISECONDS_PRECISION,		/**< Milliseconds: 10:51:33.123. */
+		MICROSECONDS_PRECISION		/**< Microseconds: 10:51:33.123456. */
+	};
+
+	/** The ways a full asynchronous logging queue can be handled. */
+	enum OverflowPolicy
+	{
+		BLOCK_OVERFLOW,			/**< The logging thread waits until the writer thread frees up space. */
+		DROP_NEWEST_OVERFLOW,	/**< The new message is dropped. */
+		DROP_OLDEST_OVERFLOW	/**< The oldest queued message is dropped to make room for the new one. */
+	};
+
+	/** The ways messages are encoded for a sink. */
+	enum SinkFormat
+	{
+		TEXT_SINK_FORMAT,		/**< The same lines as the log stream, with the fields of structured messages as name=value. */
+		JSON_SINK_FORMAT		/**< One JSON object per line with the time, level, prefix, message and fields. */
+	};
+
+	/** When the per-thread buffers of buffered logging are written to the log stream. */
+	struct FlushPolicy
+	{
+		size_t			byteThreshold;			/**< Write once a thread has buffered this many bytes. */
+		unsigned int	intervalMilliseconds;	/**< Write every this many milliseconds, 0 to only write on the other triggers. */
+		LogLevel		immediateLevel;			/**< Write as soon as a message at this level or a more severe one is buffered. */
+
+		/** Constructor setting the defaults of 64 KB, 100 ms and ERROR_LVL. */
+		FlushPolicy() : byteThreshold(65536), intervalMilliseconds(100), immediateLevel(ERROR_LVL) {}
+	};
+
+	/** Which messages a sink added with addLogSink() receives and how they are written to it. */
+	struct SinkOptions
+	{
+		LogLevel		logLevel;			/**< The most verbose level written to the sink. */
+		String			prefixFilter;		/**< Only messages with a prefix starting with this are written, empty for all of them. */
+		bool			isThreaded;			/**< Whether the sink is written by a worker thread of its own. */
+		unsigned int	queueCapacity;		/**< The number of messages a threaded sink can fall behind by. */
+		OverflowPolicy	overflowPolicy;		/**< How a message is handled when a threaded sink has fallen behind too far. */
+		SinkFormat		format;				/**< How the messages are encoded for the sink. */
+
+		/** Constructor taking every message as text on the logging threads. */
+		SinkOptions() : logLevel(DEBUG_LVL), prefixFilter(), isThreaded(false), queueCapacity(8192), overflowPolicy(BLOCK_OVERFLOW),
+			format(TEXT_SINK_FORMAT) {}
+	};
+
+	/** How long writes took, counted in power of two buckets of microseconds. */
+	struct LatencyHistogram
+	{
+		/** The number of buckets. */
+		enum { BUCKET_COUNT = 20 };
+
+		unsigned long long	bucketCounts[BUCKET_COUNT];		/**< Bucket 0 counts writes under 1 us, bucket i those under 2^i us, the last one all slower ones. */
+		unsigned long long	count;							/**< The number of writes. */
+		unsigned long long	totalNanoseconds;				/**< The time taken by all the writes. */
+		unsigned long long	maxNanoseconds;					/**< The time taken by the slowest write. */
+
+		/** Constructor for a histogram without any writes. */
+		LatencyHistogram() : count(0), totalNanoseconds(0), maxNanoseconds(0)
+		{
+			std::fill(bucketCounts, bucketCounts + BUCKET_COUNT, 0ULL);
+		}
+
+		/**
+		 * Returns the time the given fraction of the writes took at most, rounded up to the bucket limit.
+		 *
+		 * @param percentile The fraction of the writes between 0.0 and 1.0, 0.99 for the 99th percentile.
+		 * @return The time in microseconds, 0 without any writes.
+		 */
+		double percentileMicroseconds(double percentile) const;
+	};
+
+	/** The statistics of a sink added with addLogSink(). */
+	struct SinkStatistics
+	{
+		LogSink*				sink;					/**< The sink. */
+		unsigned long long		writtenByteCount;		/**< The number of bytes written to the sink. */
+		unsigned long long		queuedRecordCount;		/**< The number of messages waiting for the worker thread of a threaded sink. */
+		LatencyHistogram		writeLatency;			/**< How long the writes to the sink took. */
+
+		/** Constructor for a sink without any writes. */
+		SinkStatistics() : sink(NULL), writtenByteCount(0), queuedRecordCount(0), writeLatency() {}
+	};
+
+	/** A snapshot of what the log has done since it was created, returned by statistics(). */
+	struct Statistics
+	{
+		unsigned long long				recordCounts[5];		/**< The number of messages logged at each level, indexed by LogLevel. */
+		unsigned long long				filteredRecordCount;	/**< The number of messages neither the log stream nor a sink took, or suppressed as repeats. */
+		unsigned long long				droppedRecordCount;		/**< The number of messages dropped by an overflow policy. */
+		unsigned long long				writtenByteCount;		/**< The number of bytes written to the log stream or the binary log. */
+		unsigned long long				blockedCount;			/**< The number of times a logging thread had to wait for a lock or a full queue. */
+		unsigned long long				blockedNanoseconds;		/**< The time the logging threads spent waiting. */
+		unsigned long long				queuedRecordCount;		/**< The number of messages waiting for the asynchronous writer thread. */
+		LatencyHistogram				streamWriteLatency;		/**< How long the writes to the log stream took, a batch counting as one write. */
+		std::vector<SinkStatistics>		sinks;					/**< The statistics of every added sink. */
+
+		/** Constructor for a log that has not done anything yet. */
+		Statistics() : filteredRecordCount(0), droppedRecordCount(0), writtenByteCount(0), blockedCount(0),
+			blockedNanoseconds(0), queuedRecordCount(0), streamWriteLatency(), sinks()
+		{
+			std::fill(recordCounts, recordCounts + 5, 0ULL);
+		}
 	};
 
 	/**
 	 * Creates a thread-safe singleton instance of the Log object.
 	 *
+	 * The instance is created the first time this is called and is returned without
+	 * locking afterwards.
+	 *
 	 * @return The singleton instance.
 	 */
 	static Log* instance();
@@ -121,6 +365,9 @@ public:
 	/**
 	 * Returns whether the log level is enabled.
 	 *
+	 * This is a single relaxed atomic load, so it is safe to call on every log message
+	 * from any number of threads without contention.
+	 *
 	 * @param logLevel The log level to determine if enabled.
 	 * @return Whether the given logLevel is enabled.
 	 */
@@ -140,6 +387,48 @@ public:
 	 */
 	LogLevel logLevel();
 
+	/**
+	 * Returns the named logger, creating it the first time the name is asked for.
+	 *
+	 * The logger is never destroyed, so the reference can be kept in a static.
+	 *
+	 * @param name The dot separated name of the logger, such as "bump.fs".
+	 * @return The logger.
+	 */
+	Logger& logger(const String& name);
+
+	/**
+	 * Sets the log level of the named logger and of its descendants without a level of their own.
+	 *
+	 * The logger does not have to exist yet, it picks the level up once it is created.
+	 *
+	 * @param name The dot separated name of the logger.
+	 * @param logLevel The log level to set the logger to.
+	 */
+	void setLoggerLevel(const String& name, LogLevel logLevel);
+
+	/**
+	 * Makes the named logger inherit the log level of its closest ancestor with a level of its own again.
+	 *
+	 * @param name The dot separated name of the logger.
+	 */
+	void clearLoggerLevel(const String& name);
+
+	/**
+	 * Sets the log level and the logger levels from the BUMP_LOG_LEVEL environment variable syntax.
+	 *
+	 * The levels are separated by commas. A level on its own sets the log level, a name=LEVEL
+	 * entry sets the level of the named logger. Levels of loggers not mentioned are left alone.
+	 *
+	 * @code
+	 *   bump::Log::instance()->setLogLevels("WARNING_LVL,bump.fs=DEBUG_LVL,app.ingest=INFO_LVL");
+	 * @endcode
+	 *
+	 * @param levels The comma separated levels.
+	 * @return True if every entry was understood, false otherwise. The valid entries are set either way.
+	 */
+	bool setLogLevels(const String& levels);
+
 	/**
 	 * Sets whether the timestamp display is enabled.
 	 *
@@ -168,9 +457,57 @@ public:
 	 */
 	TimestampFormat timestampFormat();
 
+	/**
+	 * Sets the fractions of a second written in the timestamps.
+	 *
+	 * @param precision The timestamp precision to set the Log instance to.
+	 */
+	void setTimestampPrecision(TimestampPrecision precision);
+
+	/**
+	 * Returns the fractions of a second written in the timestamps.
+	 *
+	 * @return The timestamp precision.
+	 */
+	TimestampPrecision timestampPrecision();
+
+	/**
+	 * Sets whether the timestamps are written in UTC instead of the local time.
+	 *
+	 * ISO 8601 timestamps end with a Z rather than the UTC offset when enabled.
+	 *
+	 * @param enabled Whether to write the timestamps in UTC.
+	 */
+	void setIsUtcTimestampingEnabled(bool enabled);
+
+	/**
+	 * Returns whether the timestamps are written in UTC instead of the local time.
+	 *
+	 * @return True if the timestamps are written in UTC, false otherwise.
+	 */
+	bool isUtcTimestampingEnabled();
+
+	/**
+	 * Returns the given time formatted with the current timestamp settings.
+	 *
+	 * @param microseconds The time in microseconds since the Unix epoch.
+	 * @return The formatted timestamp.
+	 */
+	String formatTimestamp(long long microseconds);
+
+	/**
+	 * Returns the current time in microseconds since the Unix epoch.
+	 *
+	 * @return The current time in microseconds since the Unix epoch.
+	 */
+	static long long currentTimestamp();
+
 	/**
 	 * Sets the output stream to a std::ofstream created from the provided filepath.
 	 *
+	 * The log owns the file and closes it once the output is switched elsewhere. Use a
+	 * RotatingFileLogSink with setLogSink() for log files that should not grow forever.
+	 *
 	 * NOTE: This will not change the current log stream if the file cannot be opened successfully.
 	 *
 	 * @param filepath The filepath of the file to write all the log output to.
@@ -185,6 +522,36 @@ public:
 	 */
 	void setLogStream(std::ostream& stream);
 
+	/**
+	 * Switches the output to the provided sink.
+	 *
+	 * The log stream becomes the sink's stream, and buffered logging hands its batches
+	 * straight to the sink. The sink must outlive its use by the log.
+	 *
+	 * @param sink The sink to start using for the Log instance.
+	 */
+	void setLogSink(LogSink& sink);
+
+	/**
+	 * Adds a sink receiving the log messages alongside the log stream.
+	 *
+	 * The log level of the log stream stays as it is, while the log level checks let through
+	 * anything up to the most verbose level of the log stream and the sinks. Adding a sink
+	 * that was already added replaces its options. The sink must outlive its use by the log.
+	 *
+	 * @param sink The sink to add.
+	 * @param options Which messages the sink receives and whether it gets its own thread.
+	 */
+	void addLogSink(LogSink& sink, const SinkOptions& options = SinkOptions());
+
+	/**
+	 * Writes out everything still waiting for the sink and stops writing to it.
+	 *
+	 * @param sink The sink to remove.
+	 * @return True if the sink was removed, false if it wasn't added.
+	 */
+	bool removeLogSink(LogSink& sink);
+
 	/**
 	 * Returns the log output stream (use like std::cout).
 	 *
@@ -193,6 +560,268 @@ public:
 	 */
 	std::ostream& logStream(const String& prefix = "");
 
+	/**
+	 * Starts writing the log messages on a dedicated writer thread.
+	 *
+	 * The convenience functions copy their messages into a bounded lock-free queue and return
+	 * without touching the log stream. If asynchronous logging is already enabled, the queued
+	 * messages are written out before switching to the new settings.
+	 *
+	 * @param queueCapacity The number of messages the queue can hold, rounded up to a power of two.
+	 * @param overflowPolicy How a message is handled when the queue is full.
+	 */
+	void enableAsynchronousLogging(unsigned int queueCapacity = 8192, OverflowPolicy overflowPolicy = BLOCK_OVERFLOW);
+
+	/**
+	 * Writes out all the queued messages, stops the writer thread and goes back to writing
+	 * the log messages on the logging threads.
+	 */
+	void disableAsynchronousLogging();
+
+	/**
+	 * Returns whether the log messages are written on a dedicated writer thread.
+	 *
+	 * @return True if asynchronous logging is enabled, false otherwise.
+	 */
+	bool isAsynchronousLoggingEnabled();
+
+	/**
+	 * Returns the number of messages dropped because the asynchronous logging queue or the
+	 * queue of a threaded sink was full.
+	 *
+	 * @return The number of dropped messages since the log was created.
+	 */
+	unsigned long long droppedMessageCount();
+
+	/**
+	 * Returns a snapshot of the log statistics.
+	 *
+	 * Every thread counts into statistics of its own with relaxed atomics, so counting
+	 * never contends and is cheap enough to leave on. The snapshot adds them up, so the
+	 * numbers of threads logging at the same time may be a few messages apart.
+	 *
+	 * @return The statistics since the log was created.
+	 */
+	Statistics statistics();
+
+	/**
+	 * Starts appending the log messages to per-thread buffers written out in batches.
+	 *
+	 * Asynchronous logging takes precedence while it is enabled. If buffered logging is
+	 * already enabled, the buffered messages are written out before switching to the new
+	 * policy.
+	 *
+	 * @param policy When the buffered messages are written.
+	 */
+	void enableBufferedLogging(const FlushPolicy& policy = FlushPolicy());
+
+	/**
+	 * Writes out all the buffered messages and goes back to writing each message as it is logged.
+	 */
+	void disableBufferedLogging();
+
+	/**
+	 * Returns whether the log messages are appended to per-thread buffers.
+	 *
+	 * @return True if buffered logging is enabled, false otherwise.
+	 */
+	bool isBufferedLoggingEnabled();
+
+	/**
+	 * Starts writing the log messages to a binary log instead of the log stream.
+	 *
+	 * Binary logging takes precedence over asynchronous and buffered logging. Records are
+	 * collected in a buffer and written once it holds 64 KB, as soon as an error is logged,
+	 * on flush() and when binary logging is disabled. If binary logging is already enabled,
+	 * the previous file is finished first.
+	 *
+	 * @param filepath The file to write the binary log to, replacing any existing file.
+	 * @throw bump::FileSystemError When the file cannot be opened.
+	 */
+	void enableBinaryLogging(const String& filepath);
+
+	/**
+	 * Writes out the buffered records, closes the binary log and goes back to writing text.
+	 */
+	void disableBinaryLogging();
+
+	/**
+	 * Returns whether the log messages are written to a binary log.
+	 *
+	 * @return True if binary logging is enabled, false otherwise.
+	 */
+	bool isBinaryLoggingEnabled();
+
+	/**
+	 * Starts keeping the last few records of every thread in memory for dumping after a crash.
+	 *
+	 * Every message up to the given level is copied unformatted into a ring of the logging
+	 * thread, even when no other output takes it, and only formatted when the recorder is
+	 * dumped. The log level checks let those levels through, so filtered out messages then
+	 * cost a copy of their arguments instead of a single atomic load. If the flight recorder
+	 * is already enabled, the records kept so far are discarded.
+	 *
+	 * @param filepath The file the records are dumped to.
+	 * @param recordCount The number of records kept for each thread.
+	 * @param logLevel The most verbose level recorded.
+	 * @param isHandlingSignals Whether to dump the records on SIGSEGV, SIGABRT and the other fatal signals.
+	 */
+	void enableFlightRecorder(const String& filepath, unsigned int recordCount = 256, LogLevel logLevel = DEBUG_LVL,
+		bool isHandlingSignals = true);
+
+	/**
+	 * Stops recording, discards the records and puts back the previous signal handlers.
+	 */
+	void disableFlightRecorder();
+
+	/**
+	 * Returns whether the last few records of every thread are kept in memory.
+	 *
+	 * @return True if the flight recorder is enabled, false otherwise.
+	 */
+	bool isFlightRecorderEnabled();
+
+	/**
+	 * Writes the records kept by the flight recorder to its file, replacing the contents.
+	 *
+	 * @return True if the file was written, false if it couldn't be or the flight recorder isn't enabled.
+	 */
+	bool dumpFlightRecorder();
+
+	/**
+	 * Waits until every message logged before the call has been written, then flushes the log stream and the sinks.
+	 */
+	void flush();
+
+	/**
+	 * Writes a message to the log stream, or queues it when asynchronous logging is enabled.
+	 *
+	 * This is what the convenience functions call once they know the log level is enabled.
+	 * Since that level can be more verbose than the log stream's own when sinks are added,
+	 * the message is handed to the sinks taking it and only written to the log stream when
+	 * its level is enabled for the log stream as well.
+	 *
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param message The message to write.
+	 * @param newline Whether to end the line after the message, otherwise the stream is only flushed.
+	 */
+	void writeMessage(LogLevel logLevel, const String& prefix, const String& message, bool newline);
+
+	/**
+	 * Formats a message into a per-thread buffer and writes it like writeMessage() with a newline.
+	 *
+	 * This is what the BUMP_LOG_* macros call once they know the log level is enabled. The
+	 * %1 - %99 markers in the format are replaced by the matching arguments. With binary
+	 * logging enabled, the arguments are written unformatted along with the call site.
+	 *
+	 * The format is taken as a const array and the overload taking a non-const one is deleted,
+	 * so pointers and stack buffers don't compile, since the call site and the flight recorder
+	 * keep pointing at the format for the life of the process.
+	 *
+	 * @param callSite The call site of the message.
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param format The message with %1 - %99 markers for the arguments, a string literal.
+	 * @param argument The argument replacing the %1 markers.
+	 * @param arguments The arguments replacing the %2 - %99 markers.
+	 */
+	template <size_t FormatSize, typename Argument, typename... Arguments>
+	inline void writeFormattedMessage(LogCallSite& callSite, LogLevel logLevel, const String& prefix,
+		const char (&format)[FormatSize], const Argument& argument, const Arguments&... arguments);
+
+	/**
+	 * Writes a message without arguments like writeMessage() with a newline.
+	 *
+	 * @param callSite The call site of the message.
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param format The message, a string literal.
+	 */
+	template <size_t FormatSize>
+	inline void writeFormattedMessage(LogCallSite& callSite, LogLevel logLevel, const String& prefix,
+		const char (&format)[FormatSize]);
+
+	/** Deleted so formats in buffers that can change or go away don't compile. */
+	template <size_t FormatSize, typename... Arguments>
+	void writeFormattedMessage(LogCallSite& callSite, LogLevel logLevel, const String& prefix,
+		char (&format)[FormatSize], const Arguments&... arguments) = delete;
+
+	/**
+	 * Formats a message and writes it like writeFormattedMessage() unless it repeats the last
+	 * message of the call site.
+	 *
+	 * This is what the BUMP_LOG_*_NO_REPEATS macros call. The repeats the suppressor asks to
+	 * report are written as "Last message repeated K times" first.
+	 *
+	 * @param suppressor The repeat suppressor of the call site.
+	 * @param callSite The call site of the message.
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param format The message with %1 - %99 markers for the arguments, a string literal.
+	 * @param argument The argument replacing the %1 markers.
+	 * @param arguments The arguments replacing the %2 - %99 markers.
+	 */
+	template <size_t FormatSize, typename Argument, typename... Arguments>
+	inline void writeUnrepeatedMessage(LogRepeatSuppressor& suppressor, LogCallSite& callSite, LogLevel logLevel,
+		const String& prefix, const char (&format)[FormatSize], const Argument& argument, const Arguments&... arguments);
+
+	/**
+	 * Writes a message without arguments like writeUnrepeatedMessage().
+	 *
+	 * @param suppressor The repeat suppressor of the call site.
+	 * @param callSite The call site of the message.
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param format The message, a string literal.
+	 */
+	template <size_t FormatSize>
+	inline void writeUnrepeatedMessage(LogRepeatSuppressor& suppressor, LogCallSite& callSite, LogLevel logLevel,
+		const String& prefix, const char (&format)[FormatSize]);
+
+	/** Deleted so formats in buffers that can change or go away don't compile. */
+	template <size_t FormatSize, typename... Arguments>
+	void writeUnrepeatedMessage(LogRepeatSuppressor& suppressor, LogCallSite& callSite, LogLevel logLevel,
+		const String& prefix, char (&format)[FormatSize], const Arguments&... arguments) = delete;
+
+	/**
+	 * Writes "K messages suppressed by the rate limit" when messages were refused by a call site's rate limiter.
+	 *
+	 * @param logLevel The log level of the refused messages.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param suppressedCount The number of refused messages, nothing is written when 0.
+	 */
+	void writeSuppressedMessageCount(LogLevel logLevel, const String& prefix, unsigned long long suppressedCount);
+
+	/**
+	 * Writes a message along with key/value fields like writeMessage() with a newline.
+	 *
+	 * This is what the BUMP_LOG_*_FIELDS macros call once they know the log level is enabled.
+	 * Sinks using JSON_SINK_FORMAT get the fields as members of the JSON object, encoded
+	 * straight into the sink buffer, while the log stream and the text sinks get the message
+	 * followed by the fields as name=value.
+	 *
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param message The message.
+	 * @param fields The fields of the message.
+	 * @param fieldCount The number of fields.
+	 */
+	void writeFields(LogLevel logLevel, const String& prefix, const char* message, const LogField* fields,
+		unsigned int fieldCount);
+
+	/**
+	 * Appends the format to the buffer with the %1 - %99 markers replaced by the arguments.
+	 *
+	 * Markers without a matching argument are left as they are.
+	 *
+	 * @param buffer The buffer to append the formatted message to.
+	 * @param format The message with %1 - %99 markers for the arguments.
+	 * @param arguments The arguments replacing the markers.
+	 * @param argumentCount The number of arguments.
+	 */
+	static void formatMessage(String& buffer, const char* format, const LogArgument* arguments, unsigned int argumentCount);
+
 	/**
 	 * Returns the convenience function mutex used to lock all the convenience functions.
 	 *
@@ -210,21 +839,407 @@ protected:
 
 	/**
 	 * @internal
-	 * Returns the current time as a formatted string.
+	 * Switches the log output with the mutex already locked, closing the file opened by
+	 * setLogFile() if there is one.
+	 *
+	 * @param stream The stream to write to.
+	 * @param sink The sink behind the stream, NULL for other streams.
+	 * @param file The file behind the stream if the log owns it, NULL otherwise.
+	 */
+	void replaceLogStreamLocked(std::ostream* stream, LogSink* sink, std::ofstream* file);
+
+	/**
+	 * @internal
+	 * Formats the given time into the calling thread's timestamp cache.
+	 *
+	 * The date and time are only formatted again when the second or the timestamp settings
+	 * change, otherwise just the fraction of a second is patched in place, so formatting
+	 * never allocates.
+	 *
+	 * @param microseconds The time in microseconds since the Unix epoch.
+	 * @param length Set to the number of characters in the timestamp.
+	 * @return The formatted timestamp, valid until the thread formats another one.
+	 */
+	const char* cachedTimestamp(long long microseconds, size_t& length);
+
+	/**
+	 * @internal
+	 * Writes the timestamp of the given time followed by a space to the stream.
+	 *
+	 * @param stream The stream to write to.
+	 * @param microseconds The time in microseconds since the Unix epoch.
+	 */
+	void writeTimestamp(std::ostream& stream, long long microseconds);
+
+	/**
+	 * @internal
+	 * Records the message for the flight recorder, then formats it into the calling thread's buffer and
+	 * writes it, or writes it to the binary log.
+	 *
+	 * @param callSite The call site of the message.
+	 * @param logLevel The log level of the message.
+	 * @param streamLogLevel The most verbose level written to the log stream, the log level or a logger's.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param format The message with %1 - %99 markers for the arguments.
+	 * @param arguments The arguments replacing the markers.
+	 * @param argumentCount The number of arguments.
+	 */
+	void writeArguments(LogCallSite& callSite, LogLevel logLevel, LogLevel streamLogLevel, const String& prefix,
+		const char* format, const LogArgument* arguments, unsigned int argumentCount);
+
+	/**
+	 * @internal
+	 * Formats the message into the calling thread's buffer and writes it unless the suppressor finds it repeated.
+	 *
+	 * @param suppressor The repeat suppressor of the call site.
+	 * @param callSite The call site of the message.
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param format The message with %1 - %99 markers for the arguments.
+	 * @param arguments The arguments replacing the markers.
+	 * @param argumentCount The number of arguments.
+	 */
+	void writeUnrepeatedArguments(LogRepeatSuppressor& suppressor, LogCallSite& callSite, LogLevel logLevel,
+		const String& prefix, const char* format, const LogArgument* arguments, unsigned int argumentCount);
+
+	/**
+	 * @internal
+	 * Writes a message like writeMessage() to the log stream if it takes the level of a logger.
+	 *
+	 * @param logLevel The log level of the message.
+	 * @param streamLogLevel The most verbose level written to the log stream, the log level or a logger's.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param message The message to write.
+	 * @param newline Whether to end the line after the message, otherwise the stream is only flushed.
+	 */
+	void writeMessage(LogLevel logLevel, LogLevel streamLogLevel, const String& prefix, const String& message,
+		bool newline);
+
+	/**
+	 * @internal
+	 * Writes a message like writeMessage() without recording it for the flight recorder.
+	 *
+	 * @param logLevel The log level of the message.
+	 * @param streamLogLevel The most verbose level written to the log stream, the log level or a logger's.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param message The message to write.
+	 * @param newline Whether to end the line after the message, otherwise the stream is only flushed.
+	 */
+	void writeUnrecordedMessage(LogLevel logLevel, LogLevel streamLogLevel, const String& prefix, const String& message,
+		bool newline);
+
+	/**
+	 * @internal
+	 * Writes a message to the log stream only, through the binary log, the writer thread or the thread buffers when enabled.
+	 *
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param message The message to write.
+	 * @param newline Whether to end the line after the message, otherwise the stream is only flushed.
+	 */
+	void writeToStream(LogLevel logLevel, const String& prefix, const String& message, bool newline);
+
+	/**
+	 * @internal
+	 * Copies the message into the calling thread's flight recorder ring if the flight recorder takes its level.
+	 *
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param format The message with %1 - %99 markers for the arguments.
+	 * @param arguments The arguments replacing the markers.
+	 * @param argumentCount The number of arguments.
+	 */
+	void recordFlight(LogLevel logLevel, const String& prefix, const char* format, const LogArgument* arguments,
+		unsigned int argumentCount);
+
+	/**
+	 * @internal
+	 * Stops recording, puts back the previous signal handlers and deletes the flight recorder. The mutex must be locked.
+	 */
+	void disableFlightRecorderLocked();
+
+	/**
+	 * @internal
+	 * Appends the timestamp if enabled, the prefix, the message and the newline if requested to the output.
+	 *
+	 * @param output The string to append the line to.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param message The message.
+	 * @param newline Whether to end the line after the message.
+	 */
+	void appendLine(String& output, const String& prefix, const String& message, bool newline);
+
+	/**
+	 * @internal
+	 * Appends the message and its fields to the output as a JSON object on a line of its own.
+	 *
+	 * @param output The string to append the object to.
+	 * @param logLevel The log level of the message.
+	 * @param prefix The prefix of the message, left out when empty.
+	 * @param message The message.
+	 * @param fields The fields of the message.
+	 * @param fieldCount The number of fields.
+	 */
+	void appendJsonLine(String& output, LogLevel logLevel, const String& prefix, const String& message,
+		const LogField* fields, unsigned int fieldCount);
+
+	/**
+	 * @internal
+	 * Formats the message once per sink format and hands it to every added sink taking it.
+	 *
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param message The message.
+	 * @param newline Whether to end the line after the message. JSON lines always end.
+	 * @param fields The fields of the message, NULL for a plain message.
+	 * @param fieldCount The number of fields.
+	 * @return True if a sink took the message, false otherwise.
+	 */
+	bool writeToSinks(LogLevel logLevel, const String& prefix, const String& message, bool newline,
+		const LogField* fields, unsigned int fieldCount);
+
+	/**
+	 * @internal
+	 * Writes the queued messages of a threaded sink until it is removed. Runs on the sink's worker thread.
+	 *
+	 * @param entry The sink to write to.
+	 */
+	void runSinkThread(LogSinkEntry* entry);
+
+	/**
+	 * @internal
+	 * Switches to the given list of sinks, waits for the threads still writing to the old
+	 * list and deletes it. The sink mutex must be locked.
+	 *
+	 * @param entries The new list of sinks, NULL for none.
+	 */
+	void replaceSinkEntriesLocked(std::vector<LogSinkEntry*>* entries);
+
+	/**
+	 * @internal
+	 * Writes out everything queued for a sink, stops its worker thread and deletes it.
+	 *
+	 * @param entry The sink to stop writing to.
+	 */
+	void destroySinkEntry(LogSinkEntry* entry);
+
+	/**
+	 * @internal
+	 * Encodes a record with the raw arguments and appends it to the binary log buffer.
+	 *
+	 * @param callSite The call site of the message, registered first if necessary.
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param format The message with %1 - %99 markers for the arguments.
+	 * @param arguments The arguments replacing the markers.
+	 * @param argumentCount The number of arguments.
+	 */
+	void writeBinaryRecord(LogCallSite& callSite, LogLevel logLevel, const String& prefix, const char* format,
+		const LogArgument* arguments, unsigned int argumentCount);
+
+	/**
+	 * @internal
+	 * Assigns the call site its id and appends its definition to the binary log buffer.
+	 *
+	 * @param callSite The call site to register.
+	 * @param logLevel The log level of the messages.
+	 * @param format The message format.
+	 * @return The id of the call site.
+	 */
+	unsigned int registerCallSite(LogCallSite& callSite, LogLevel logLevel, const char* format);
+
+	/**
+	 * @internal
+	 * Appends a calibration entry and writes the binary log buffer. The binary buffer mutex must be locked.
+	 */
+	void writeBinaryBufferLocked();
+
+	/**
+	 * @internal
+	 * Pushes the message onto the asynchronous logging queue, applying the overflow policy when full.
 	 *
-	 * @return The current time as a formatted string.
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param message The message to queue.
+	 * @param newline Whether to end the line after the message.
+	 */
+	void enqueueMessage(LogLevel logLevel, const String& prefix, const String& message, bool newline);
+
+	/**
+	 * @internal
+	 * Writes the queued messages until asynchronous logging is disabled. Runs on the writer thread.
 	 */
-	String convertTimeToString();
+	void runWriterThread();
+
+	/**
+	 * @internal
+	 * Writes out a batch of queued messages and flushes the log stream.
+	 *
+	 * @param record The record each message is swapped into before being written.
+	 * @return The number of messages written.
+	 */
+	unsigned int writeQueuedMessages(LogRecord& record);
+
+	/**
+	 * @internal
+	 * Writes a log record to the given stream.
+	 *
+	 * @param stream The stream to write to.
+	 * @param record The log record to write.
+	 */
+	void writeRecord(std::ostream& stream, const LogRecord& record);
+
+	/**
+	 * @internal
+	 * Wakes up the writer thread if it is waiting for messages.
+	 */
+	void wakeWriterThread();
+
+	/**
+	 * @internal
+	 * Appends the message to the calling thread's buffer and writes the buffers if the flush policy says so.
+	 *
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param message The message to append.
+	 * @param newline Whether to end the line after the message.
+	 */
+	void appendToThreadBuffer(LogLevel logLevel, const String& prefix, const String& message, bool newline);
+
+	/**
+	 * @internal
+	 * Returns the calling thread's buffer, taking over a released one or creating it on first use.
+	 *
+	 * @return The calling thread's buffer.
+	 */
+	LogThreadBuffer* threadBuffer();
+
+	/**
+	 * @internal
+	 * Returns the calling thread's statistics, taking over released ones or creating them on first use.
+	 *
+	 * @return The calling thread's statistics.
+	 */
+	LogThreadStatistics* threadStatistics();
+
+	/**
+	 * @internal
+	 * Locks the mutex, counting the time spent waiting in the calling thread's statistics if it was locked.
+	 *
+	 * @param lock The lock of the mutex, constructed with boost::defer_lock.
+	 */
+	void lockCounted(boost::mutex::scoped_lock& lock);
+
+	/**
+	 * @internal
+	 * Writes the contents of every thread's buffer to the log stream in one batch.
+	 */
+	void writeThreadBuffers();
+
+	/**
+	 * @internal
+	 * Writes the contents of every thread's buffer to the log stream with the mutex already locked.
+	 */
+	void writeThreadBuffersLocked();
+
+	/**
+	 * @internal
+	 * Writes the thread buffers on the flush policy interval until buffered logging is disabled.
+	 */
+	void runFlusherThread();
+
+	/**
+	 * @internal
+	 * Updates the enabled log level from the enabled flag, the log level, the sink log levels and
+	 * the flight recorder level.
+	 *
+	 * Must be called with the mutex locked so concurrent setters can't publish a stale combination.
+	 * The levels of the loggers are updated along with it.
+	 */
+	void updateEnabledLogLevel();
+
+	/**
+	 * @internal
+	 * Returns the log level of the named logger, its own or the one of its closest ancestor
+	 * with a level of its own, the log level without any. The mutex must be locked.
+	 *
+	 * @param name The dot separated name of the logger.
+	 * @return The log level of the logger.
+	 */
+	LogLevel loggerLevelLocked(const String& name);
 
 	// Instance member variables
-	bool					_isEnabled;					/**< @internal Whether the log is enabled for output. */
-	LogLevel				_logLevel;					/**< @internal The log level the log instance is set to. */
-	bool					_isDateTimeFormatEnabled;	/**< @internal Whether the date/time are tacked onto the log output. */
-	TimestampFormat			_timestampFormat;			/**< @internal The timestamp format when enabled. */
+	boost::atomic<bool>		_isEnabled;					/**< @internal Whether the log is enabled for output. */
+	boost::atomic<LogLevel>	_logLevel;					/**< @internal The log level the log instance is set to. */
+	boost::atomic<int>		_enabledLogLevel;			/**< @internal The most verbose level to output, -1 when the log is disabled. */
+	boost::atomic<bool>					_isDateTimeFormatEnabled;	/**< @internal Whether the date/time are tacked onto the log output. */
+	boost::atomic<TimestampFormat>		_timestampFormat;			/**< @internal The timestamp format when enabled. */
+	boost::atomic<TimestampPrecision>	_timestampPrecision;		/**< @internal The fractions of a second written in the timestamps. */
+	boost::atomic<bool>					_isUtcTimestampingEnabled;	/**< @internal Whether the timestamps are written in UTC. */
 	std::ostream*			_logStream;					/**< @internal The log stream to output to. */
+	LogSink*				_logSink;					/**< @internal The sink behind the log stream, NULL for other streams. */
+	std::ofstream*			_logFile;					/**< @internal The file opened by setLogFile(), NULL for other streams. */
 	boost::mutex			_mutex;						/**< @internal A boost mutex used to make the log stream access thread-safe. */
 	boost::mutex			_convenienceFunctionMutex;		/**< @internal A boost mutex used to lock all the convenience functions making them thread-safe. */
 
+	// Asynchronous logging member variables
+	boost::atomic<bool>					_isAsynchronous;			/**< @internal Whether messages are queued for the writer thread. */
+	LockFreeQueue<LogRecord>*			_queue;						/**< @internal The queue of messages waiting for the writer thread. */
+	OverflowPolicy						_overflowPolicy;			/**< @internal How a message is handled when the queue is full. */
+	boost::thread*						_writerThread;				/**< @internal The thread writing the queued messages. */
+	boost::mutex						_asynchronousMutex;			/**< @internal A boost mutex serializing enabling, disabling and flushing. */
+	boost::mutex						_writerMutex;				/**< @internal A boost mutex used with the writer and flush conditions. */
+	boost::condition_variable			_writerCondition;			/**< @internal Signaled when messages are queued for a waiting writer thread. */
+	boost::condition_variable			_flushCondition;			/**< @internal Signaled when the writer thread has written a batch, waking flushes and blocked producers. */
+	boost::atomic<bool>					_isWriterThreadWaiting;		/**< @internal Whether the writer thread is waiting for messages. */
+	boost::atomic<bool>					_isWriterThreadStopping;	/**< @internal Whether the writer thread should exit once the queue is empty. */
+	GracePeriod							_producerGracePeriod;		/**< @internal Counts the threads currently pushing onto the queue. */
+	boost::atomic<unsigned long long>	_enqueuedMessageCount;		/**< @internal The number of messages pushed onto the queue. */
+	boost::atomic<unsigned long long>	_completedMessageCount;		/**< @internal The number of queued messages written or dropped. */
+	boost::atomic<unsigned long long>	_droppedMessageCount;		/**< @internal The number of messages dropped by the overflow policy. */
+
+	// Buffered logging member variables
+	boost::atomic<bool>					_isBuffered;					/**< @internal Whether messages are appended to the thread buffers. */
+	FlushPolicy							_flushPolicy;					/**< @internal When the thread buffers are written. */
+	LogThreadBuffer*					_threadBuffers;					/**< @internal The list of every thread buffer ever created. */
+	std::vector<LogSink::Buffer>		_sinkBuffers;					/**< @internal The batch handed to the sink, reused between writes. */
+	boost::thread*						_flusherThread;					/**< @internal The thread writing the buffers on the policy interval. */
+	boost::mutex						_bufferedMutex;					/**< @internal A boost mutex serializing enabling and disabling. */
+	boost::mutex						_flusherMutex;					/**< @internal A boost mutex used with the flusher condition. */
+	boost::condition_variable			_flusherCondition;				/**< @internal Signaled to stop the flusher thread. */
+	bool								_isFlusherThreadStopping;		/**< @internal Whether the flusher thread should exit. */
+	GracePeriod							_bufferedWriterGracePeriod;		/**< @internal Counts the threads currently appending to their buffers. */
+
+	// Binary logging member variables
+	boost::atomic<bool>					_isBinary;					/**< @internal Whether messages are written to the binary log. */
+	FileDescriptorLogSink*				_binarySink;				/**< @internal The binary log file. */
+	String								_binaryBuffer;				/**< @internal The encoded entries waiting to be written. */
+	std::vector<LogCallSite*>			_callSites;					/**< @internal Every registered call site, indexed by id minus one. */
+	double								_ticksPerMicrosecond;		/**< @internal The measured counter frequency. */
+	boost::mutex						_binaryMutex;				/**< @internal A boost mutex serializing enabling and disabling. */
+	boost::mutex						_binaryBufferMutex;			/**< @internal A boost mutex guarding the buffer, sink and call sites. */
+	GracePeriod							_binaryWriterGracePeriod;	/**< @internal Counts the threads currently writing records. */
+
+	// Sink member variables
+	boost::atomic<std::vector<LogSinkEntry*>*>	_sinkEntries;				/**< @internal The added sinks, NULL when there are none. */
+	boost::atomic<int>							_sinkLogLevel;				/**< @internal The most verbose level of the added sinks, -1 without any. */
+	boost::mutex								_sinkMutex;					/**< @internal A boost mutex serializing adding, removing and flushing sinks. */
+	GracePeriod									_sinkWriterGracePeriod;		/**< @internal Counts the threads currently writing to the sinks. */
+
+	// Flight recorder member variables
+	boost::atomic<LogFlightRecorder*>	_flightRecorder;				/**< @internal The flight recorder, NULL when disabled. */
+	boost::atomic<int>					_flightRecorderLogLevel;		/**< @internal The most verbose level recorded, -1 when disabled. */
+	bool								_isFlightRecorderHandlingSignals;	/**< @internal Whether the signal handlers dump the flight recorder. */
+	GracePeriod							_flightRecorderGracePeriod;		/**< @internal Counts the threads currently using the flight recorder. */
+
+	// Statistics member variables
+	boost::atomic<LogThreadStatistics*>	_threadStatistics;		/**< @internal The list of every thread's statistics, only ever pushed onto. */
+	boost::mutex						_statisticsMutex;		/**< @internal A boost mutex serializing handing out thread statistics. */
+
+	// Logger member variables, guarded by the mutex
+	std::map<String, Logger*>			_loggers;				/**< @internal Every logger asked for, by name. */
+	std::map<String, LogLevel>			_loggerLevels;			/**< @internal The log levels set for logger names. */
+
 private:
 
 	/**
@@ -254,14 +1269,30 @@ private:
 	void operator=(const Log& log);
 };
 
+/**
+ * A log message waiting in the asynchronous logging queue for the writer thread.
+ */
+struct LogRecord
+{
+	Log::LogLevel	level;		/**< The log level of the message. */
+	long long		time;		/**< The microseconds since the Unix epoch the message was logged, -1 without timestamping. */
+	String			prefix;		/**< The string to tack onto the front of the message. */
+	String			message;	/**< The message. */
+	bool			newline;	/**< Whether to end the line after the message. */
+};
+
 }	// End of bump namespace
 
+// Pull in the inline level check implementations
+#include <bump/Log_impl.h>
+
 /**
  * Default log functions.
  *
  * These are the most commonly used logging functions. They automatically use the
  * appropriate log level for the message. The log stream is retrieved, then the message
  * is appended into it, then std::endl is appended onto the stream flushing the buffer.
+ * Nothing is locked when the log level of the message is not enabled.
  */
 BUMP_EXPORT void bumpALWAYS(const bump::String& message);
 BUMP_EXPORT void bumpERROR(const bump::String& message);
@@ -317,4 +1348,204 @@ BUMP_EXPORT void bumpWARNING_PF(const bump::String& prefix, const bump::String&
 BUMP_EXPORT void bumpINFO_PF(const bump::String& prefix, const bump::String& message);
 BUMP_EXPORT void bumpDEBUG_PF(const bump::String& prefix, const bump::String& message);
 
+/**
+ * Compile-time level stripping.
+ *
+ * Defining BUMP_LOG_MIN_LEVEL as the number of a log level, from 0 for ALWAYS_LVL to 4 for
+ * DEBUG_LVL, compiles out the BUMP_LOG_* macros of every more verbose level at the call site.
+ * Their arguments are never evaluated and no code is generated for them, whatever the log
+ * level is set to at runtime, although they are still compiled so they cannot go stale.
+ * The bumpDEBUG() style functions above are ordinary exported functions and only check the
+ * runtime log level, so use the macros for messages that must vanish from release builds.
+ * The library and its tools get it from the Bump_LOG_MIN_LEVEL CMake cache variable,
+ * projects using an installed Bump define it themselves. The default of 4 keeps every level.
+ *
+ * @code
+ *   // With -DBUMP_LOG_MIN_LEVEL=2 only ALWAYS_LVL, ERROR_LVL and WARNING_LVL are compiled in
+ *   BUMP_LOG_DEBUG("%1", expensiveDump());		// Compiles to nothing
+ *   BUMP_LOG_INFO("Loaded %1", count());		// Compiles to nothing
+ * @endcode
+ */
+#define BUMP_LOG_IS_COMPILED(level)				(static_cast<int>(level) <= BUMP_LOG_MIN_LEVEL)
+
+/**
+ * Deferred-argument log macros.
+ *
+ * These check the log level before evaluating any of their arguments, so a filtered out
+ * message costs a single atomic load however expensive its arguments are to compute.
+ * Enabled messages are formatted straight into a per-thread buffer by replacing the
+ * %1 - %99 markers in the format with the arguments, the same way bump::String::arg()
+ * does. The arguments can be any number, bool, C string, std::string or bump::String.
+ * Levels more verbose than BUMP_LOG_MIN_LEVEL are a constant false branch the compiler drops.
+ */
+#define BUMP_LOG_MESSAGE(level, prefix, ...)													\
+	do																							\
+	{																							\
+		if (BUMP_LOG_IS_COMPILED(level))														\
+		{																						\
+			bump::Log* bump_log_instance = bump::Log::instance();								\
+			if (bump_log_instance->isLogLevelEnabled(level))									\
+			{																					\
+				static bump::LogCallSite bump_log_call_site(__FILE__, __LINE__);				\
+				bump_log_instance->writeFormattedMessage(bump_log_call_site, level, prefix,		\
+					__VA_ARGS__);																\
+			}																					\
+		}																						\
+	} while (0)
+
+#define BUMP_LOG_ALWAYS(...)				BUMP_LOG_MESSAGE(bump::Log::ALWAYS_LVL, bump::String(), __VA_ARGS__)
+#define BUMP_LOG_ERROR(...)					BUMP_LOG_MESSAGE(bump::Log::ERROR_LVL, bump::String(), __VA_ARGS__)
+#define BUMP_LOG_WARNING(...)				BUMP_LOG_MESSAGE(bump::Log::WARNING_LVL, bump::String(), __VA_ARGS__)
+#define BUMP_LOG_INFO(...)					BUMP_LOG_MESSAGE(bump::Log::INFO_LVL, bump::String(), __VA_ARGS__)
+#define BUMP_LOG_DEBUG(...)					BUMP_LOG_MESSAGE(bump::Log::DEBUG_LVL, bump::String(), __VA_ARGS__)
+
+/** Deferred-argument log macros that append a prefix to the output message. */
+#define BUMP_LOG_ALWAYS_P(prefix, ...)		BUMP_LOG_MESSAGE(bump::Log::ALWAYS_LVL, prefix, __VA_ARGS__)
+#define BUMP_LOG_ERROR_P(prefix, ...)		BUMP_LOG_MESSAGE(bump::Log::ERROR_LVL, prefix, __VA_ARGS__)
+#define BUMP_LOG_WARNING_P(prefix, ...)		BUMP_LOG_MESSAGE(bump::Log::WARNING_LVL, prefix, __VA_ARGS__)
+#define BUMP_LOG_INFO_P(prefix, ...)		BUMP_LOG_MESSAGE(bump::Log::INFO_LVL, prefix, __VA_ARGS__)
+#define BUMP_LOG_DEBUG_P(prefix, ...)		BUMP_LOG_MESSAGE(bump::Log::DEBUG_LVL, prefix, __VA_ARGS__)
+
+/**
+ * Deferred-argument log macros limiting how much a single call site can log.
+ *
+ * Each expansion keeps its own lock-free limiter, so a message logged in a tight loop
+ * during an outage cannot flood the output:
+ *	  - *_RATE_LIMITED(messagesPerSecond, burst, ...) logs at most the sustained rate after an
+ *	    initial burst, see bump::LogRateLimiter. The number of refused messages is written
+ *	    before the next message that gets through.
+ *	  - *_EVERY_N(n, ...) logs the first message and one in every n after it, see bump::LogSampler.
+ *	  - *_NO_REPEATS(...) collapses identical consecutive messages into "Last message repeated
+ *	    K times", see bump::LogRepeatSuppressor.
+ *
+ * Rate limiting and sampling are decided before any of the arguments are evaluated. Repeats
+ * can only be spotted once the message is formatted, but they are never written.
+ *
+ * @code
+ *   BUMP_LOG_WARNING_RATE_LIMITED(10.0, 20, "Could not reach %1", host);
+ *   BUMP_LOG_DEBUG_EVERY_N(1000, "Processed packet %1", packet_id);
+ *   BUMP_LOG_ERROR_NO_REPEATS("Lost connection to %1", host);
+ * @endcode
+ */
+#define BUMP_LOG_MESSAGE_RATE_LIMITED(level, prefix, messagesPerSecond, burst, ...)			\
+	do																							\
+	{																							\
+		if (BUMP_LOG_IS_COMPILED(level))														\
+		{																						\
+			bump::Log* bump_log_instance = bump::Log::instance();								\
+			if (bump_log_instance->isLogLevelEnabled(level))									\
+			{																					\
+				static bump::LogRateLimiter bump_log_limiter(messagesPerSecond, burst);			\
+				unsigned long long bump_log_suppressed_count = 0;								\
+				if (bump_log_limiter.tryAcquire(bump_log_suppressed_count))						\
+				{																				\
+					static bump::LogCallSite bump_log_call_site(__FILE__, __LINE__);			\
+					bump_log_instance->writeSuppressedMessageCount(level, prefix,				\
+						bump_log_suppressed_count);												\
+					bump_log_instance->writeFormattedMessage(bump_log_call_site, level, prefix,	\
+						__VA_ARGS__);															\
+				}																				\
+			}																					\
+		}																						\
+	} while (0)
+
+#define BUMP_LOG_MESSAGE_EVERY_N(level, prefix, n, ...)										\
+	do																							\
+	{																							\
+		if (BUMP_LOG_IS_COMPILED(level))														\
+		{																						\
+			bump::Log* bump_log_instance = bump::Log::instance();								\
+			if (bump_log_instance->isLogLevelEnabled(level))									\
+			{																					\
+				static bump::LogSampler bump_log_sampler(n);									\
+				if (bump_log_sampler.sample())													\
+				{																				\
+					static bump::LogCallSite bump_log_call_site(__FILE__, __LINE__);			\
+					bump_log_instance->writeFormattedMessage(bump_log_call_site, level, prefix,	\
+						__VA_ARGS__);															\
+				}																				\
+			}																					\
+		}																						\
+	} while (0)
+
+#define BUMP_LOG_MESSAGE_NO_REPEATS(level, prefix, ...)										\
+	do																							\
+	{																							\
+		if (BUMP_LOG_IS_COMPILED(level))														\
+		{																						\
+			bump::Log* bump_log_instance = bump::Log::instance();								\
+			if (bump_log_instance->isLogLevelEnabled(level))									\
+			{																					\
+				static bump::LogRepeatSuppressor bump_log_suppressor;							\
+				static bump::LogCallSite bump_log_call_site(__FILE__, __LINE__);				\
+				bump_log_instance->writeUnrepeatedMessage(bump_log_suppressor, bump_log_call_site,	\
+					level, prefix, __VA_ARGS__);												\
+			}																					\
+		}																						\
+	} while (0)
+
+#define BUMP_LOG_ALWAYS_RATE_LIMITED(messagesPerSecond, burst, ...)		BUMP_LOG_MESSAGE_RATE_LIMITED(bump::Log::ALWAYS_LVL, bump::String(), messagesPerSecond, burst, __VA_ARGS__)
+#define BUMP_LOG_ERROR_RATE_LIMITED(messagesPerSecond, burst, ...)		BUMP_LOG_MESSAGE_RATE_LIMITED(bump::Log::ERROR_LVL, bump::String(), messagesPerSecond, burst, __VA_ARGS__)
+#define BUMP_LOG_WARNING_RATE_LIMITED(messagesPerSecond, burst, ...)	BUMP_LOG_MESSAGE_RATE_LIMITED(bump::Log::WARNING_LVL, bump::String(), messagesPerSecond, burst, __VA_ARGS__)
+#define BUMP_LOG_INFO_RATE_LIMITED(messagesPerSecond, burst, ...)		BUMP_LOG_MESSAGE_RATE_LIMITED(bump::Log::INFO_LVL, bump::String(), messagesPerSecond, burst, __VA_ARGS__)
+#define BUMP_LOG_DEBUG_RATE_LIMITED(messagesPerSecond, burst, ...)		BUMP_LOG_MESSAGE_RATE_LIMITED(bump::Log::DEBUG_LVL, bump::String(), messagesPerSecond, burst, __VA_ARGS__)
+
+#define BUMP_LOG_ALWAYS_EVERY_N(n, ...)		BUMP_LOG_MESSAGE_EVERY_N(bump::Log::ALWAYS_LVL, bump::String(), n, __VA_ARGS__)
+#define BUMP_LOG_ERROR_EVERY_N(n, ...)		BUMP_LOG_MESSAGE_EVERY_N(bump::Log::ERROR_LVL, bump::String(), n, __VA_ARGS__)
+#define BUMP_LOG_WARNING_EVERY_N(n, ...)	BUMP_LOG_MESSAGE_EVERY_N(bump::Log::WARNING_LVL, bump::String(), n, __VA_ARGS__)
+#define BUMP_LOG_INFO_EVERY_N(n, ...)		BUMP_LOG_MESSAGE_EVERY_N(bump::Log::INFO_LVL, bump::String(), n, __VA_ARGS__)
+#define BUMP_LOG_DEBUG_EVERY_N(n, ...)		BUMP_LOG_MESSAGE_EVERY_N(bump::Log::DEBUG_LVL, bump::String(), n, __VA_ARGS__)
+
+#define BUMP_LOG_ALWAYS_NO_REPEATS(...)		BUMP_LOG_MESSAGE_NO_REPEATS(bump::Log::ALWAYS_LVL, bump::String(), __VA_ARGS__)
+#define BUMP_LOG_ERROR_NO_REPEATS(...)		BUMP_LOG_MESSAGE_NO_REPEATS(bump::Log::ERROR_LVL, bump::String(), __VA_ARGS__)
+#define BUMP_LOG_WARNING_NO_REPEATS(...)	BUMP_LOG_MESSAGE_NO_REPEATS(bump::Log::WARNING_LVL, bump::String(), __VA_ARGS__)
+#define BUMP_LOG_INFO_NO_REPEATS(...)		BUMP_LOG_MESSAGE_NO_REPEATS(bump::Log::INFO_LVL, bump::String(), __VA_ARGS__)
+#define BUMP_LOG_DEBUG_NO_REPEATS(...)		BUMP_LOG_MESSAGE_NO_REPEATS(bump::Log::DEBUG_LVL, bump::String(), __VA_ARGS__)
+
+/**
+ * Structured log macros writing a message along with key/value fields.
+ *
+ * The fields are created with BUMP_LOG_FIELD, which interns the field name at the call
+ * site, and are only evaluated once the log level is known to be enabled. Nothing is
+ * allocated on the way to the sinks: the fields refer to their names and values, and
+ * sinks using JSON_SINK_FORMAT get them encoded straight into the sink buffer as members
+ * of a JSON object next to the time, level, prefix and message.
+ *
+ * @code
+ *   bump::Log::SinkOptions json_options;
+ *   json_options.format = bump::Log::JSON_SINK_FORMAT;
+ *   bump::Log::instance()->addLogSink(file, json_options);
+ *   BUMP_LOG_INFO_FIELDS("Request finished", BUMP_LOG_FIELD("path", path), BUMP_LOG_FIELD("status", 200));
+ *
+ *   {"time":1792396800000000,"level":"INFO","message":"Request finished","path":"/index","status":200}
+ * @endcode
+ */
+#define BUMP_LOG_FIELDS_MESSAGE(level, prefix, message, ...)									\
+	do																							\
+	{																							\
+		if (BUMP_LOG_IS_COMPILED(level))														\
+		{																						\
+			bump::Log* bump_log_instance = bump::Log::instance();								\
+			if (bump_log_instance->isLogLevelEnabled(level))									\
+			{																					\
+				const bump::LogField bump_log_fields[] = { __VA_ARGS__ };						\
+				bump_log_instance->writeFields(level, prefix, message, bump_log_fields,			\
+					sizeof(bump_log_fields) / sizeof(bump_log_fields[0]));						\
+			}																					\
+		}																						\
+	} while (0)
+
+#define BUMP_LOG_ALWAYS_FIELDS(message, ...)		BUMP_LOG_FIELDS_MESSAGE(bump::Log::ALWAYS_LVL, bump::String(), message, __VA_ARGS__)
+#define BUMP_LOG_ERROR_FIELDS(message, ...)			BUMP_LOG_FIELDS_MESSAGE(bump::Log::ERROR_LVL, bump::String(), message, __VA_ARGS__)
+#define BUMP_LOG_WARNING_FIELDS(message, ...)		BUMP_LOG_FIELDS_MESSAGE(bump::Log::WARNING_LVL, bump::String(), message, __VA_ARGS__)
+#define BUMP_LOG_INFO_FIELDS(message, ...)			BUMP_LOG_FIELDS_MESSAGE(bump::Log::INFO_LVL, bump::String(), message, __VA_ARGS__)
+#define BUMP_LOG_DEBUG_FIELDS(message, ...)			BUMP_LOG_FIELDS_MESSAGE(bump::Log::DEBUG_LVL, bump::String(), message, __VA_ARGS__)
+
+/** Structured log macros that append a prefix to the output message. */
+#define BUMP_LOG_ALWAYS_FIELDS_P(prefix, message, ...)		BUMP_LOG_FIELDS_MESSAGE(bump::Log::ALWAYS_LVL, prefix, message, __VA_ARGS__)
+#define BUMP_LOG_ERROR_FIELDS_P(prefix, message, ...)		BUMP_LOG_FIELDS_MESSAGE(bump::Log::ERROR_LVL, prefix, message, __VA_ARGS__)
+#define BUMP_LOG_WARNING_FIELDS_P(prefix, message, ...)		BUMP_LOG_FIELDS_MESSAGE(bump::Log::WARNING_LVL, prefix, message, __VA_ARGS__)
+#define BUMP_LOG_INFO_FIELDS_P(prefix, message, ...)		BUMP_LOG_FIELDS_MESSAGE(bump::Log::INFO_LVL, prefix, message, __VA_ARGS__)
+#define BUMP_LOG_DEBUG_FIELDS_P(prefix, message, ...)		BUMP_LOG_FIELDS_MESSAGE(bump::Log::DEBUG_LVL, prefix, message, __VA_ARGS__)
+
 #endif	// End of BUMP_LOG_H
@@ -0,0 +1,193 @@
+//
+//	LogArgument.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_LOG_ARGUMENT_H
+#define BUMP_LOG_ARGUMENT_H
+
+// C++ headers
+#include <cstring>
+#include <string>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * The LogArgument class refers to a single argument of a deferred log message.
+ *
+ * The BUMP_LOG_* macros wrap each of their arguments in a LogArgument once the log level
+ * is known to be enabled, then the log appends them straight into a per-thread buffer
+ * in place of the matching %1 - %99 markers. Numbers are stored by value and strings by
+ * pointer, so no bump::String is ever created for an argument.
+ *
+ * Every argument is formatted exactly like the matching bump::String constructor would,
+ * so BUMP_LOG_DEBUG("%1 of %2", index, count) writes the same text as
+ * bumpDEBUG(bump::String("%1 of %2").arg(index, count)). Other pointers are written as
+ * hex addresses.
+ */
+class BUMP_EXPORT LogArgument
+{
+public:
+
+	/** The kinds of values a log argument can hold. */
+	enum Type
+	{
+		SIGNED_TYPE,		/**< A signed integer. */
+		UNSIGNED_TYPE,		/**< An unsigned integer. */
+		FLOAT_TYPE,			/**< A float, written with the float precision. */
+		DOUBLE_TYPE,		/**< A double, written with the double precision. */
+		BOOL_TYPE,			/**< A bool, written as true or false. */
+		STRING_TYPE,		/**< A character string. */
+		POINTER_TYPE		/**< Any other pointer, written as a hex address. */
+	};
+
+	/** Constructors for each of the supported argument types. */
+	inline LogArgument(char value) : _type(SIGNED_TYPE) { _value.signedValue = value; }
+	inline LogArgument(signed char value) : _type(SIGNED_TYPE) { _value.signedValue = value; }
+	inline LogArgument(unsigned char value) : _type(UNSIGNED_TYPE) { _value.unsignedValue = value; }
+	inline LogArgument(short value) : _type(SIGNED_TYPE) { _value.signedValue = value; }
+	inline LogArgument(unsigned short value) : _type(UNSIGNED_TYPE) { _value.unsignedValue = value; }
+	inline LogArgument(int value) : _type(SIGNED_TYPE) { _value.signedValue = value; }
+	inline LogArgument(unsigned int value) : _type(UNSIGNED_TYPE) { _value.unsignedValue = value; }
+	inline LogArgument(long value) : _type(SIGNED_TYPE) { _value.signedValue = value; }
+	inline LogArgument(unsigned long value) : _type(UNSIGNED_TYPE) { _value.unsignedValue = value; }
+	inline LogArgument(long long value) : _type(SIGNED_TYPE) { _value.signedValue = value; }
+	inline LogArgument(unsigned long long value) : _type(UNSIGNED_TYPE) { _value.unsignedValue = value; }
+	inline LogArgument(float value) : _type(FLOAT_TYPE) { _value.doubleValue = value; }
+	inline LogArgument(double value) : _type(DOUBLE_TYPE) { _value.doubleValue = value; }
+	inline LogArgument(bool value) : _type(BOOL_TYPE) { _value.boolValue = value; }
+	inline LogArgument(const char* value) : _type(STRING_TYPE) { setString(value, value ? std::strlen(value) : 0); }
+	inline LogArgument(const std::string& value) : _type(STRING_TYPE) { setString(value.data(), value.size()); }
+	inline LogArgument(const void* value) : _type(POINTER_TYPE) { _value.pointerValue = value; }
+
+	/**
+	 * Returns the kind of value the argument holds.
+	 *
+	 * @return The kind of value the argument holds.
+	 */
+	inline Type type() const { return _type; }
+
+	/**
+	 * Appends the formatted argument to the end of the given buffer.
+	 *
+	 * @param buffer The buffer to append to.
+	 */
+	void appendTo(String& buffer) const;
+
+	/**
+	 * Appends the type and raw value of the argument to the end of the given buffer.
+	 *
+	 * This is how the binary log stores arguments without formatting them. Numbers are
+	 * written as 8 bytes in the native byte order and strings with a 4 byte length.
+	 *
+	 * @param buffer The buffer to append to.
+	 */
+	void encodeTo(String& buffer) const;
+
+	/**
+	 * Writes the type and raw value of the argument into a fixed size buffer.
+	 *
+	 * The layout is the same as the encodeTo() that appends to a string, except that a
+	 * string too long for the buffer is cut short to fill it.
+	 *
+	 * @param data The buffer to write to.
+	 * @param capacity The size of the buffer.
+	 * @return The number of bytes written, 0 if not even the type and length fit.
+	 */
+	size_t encodeTo(char* data, size_t capacity) const;
+
+	/**
+	 * Writes the formatted argument into a fixed size buffer without allocating.
+	 *
+	 * Unlike appendTo(), this never calls into the C library, so it is safe to call from a
+	 * signal handler. Floating point values are written with at most six decimals.
+	 *
+	 * @param data The buffer to write to.
+	 * @param capacity The size of the buffer.
+	 * @return The number of characters written, cut short when the buffer is too small.
+	 */
+	size_t formatTo(char* data, size_t capacity) const;
+
+	/**
+	 * Appends the argument to the end of the given buffer as a JSON value.
+	 *
+	 * Numbers and bools are written bare, with NaN and the infinities written as null since
+	 * JSON has no way to spell them. Strings and pointers are written as escaped JSON strings,
+	 * and null strings as null.
+	 *
+	 * @param buffer The buffer to append to.
+	 */
+	void appendJsonTo(String& buffer) const;
+
+	/**
+	 * Appends the characters to the end of the given buffer as a quoted and escaped JSON string.
+	 *
+	 * Quotes, backslashes and control characters are escaped and every other byte is copied
+	 * as is, so UTF-8 text stays UTF-8.
+	 *
+	 * @param buffer The buffer to append to.
+	 * @param data The characters.
+	 * @param length The number of characters.
+	 */
+	static void appendJsonString(String& buffer, const char* data, size_t length);
+
+	/**
+	 * Decodes an argument appended by encodeTo().
+	 *
+	 * Decoded strings point into the given data, so it must outlive the argument.
+	 *
+	 * @param data The start of the encoded argument.
+	 * @param end The end of the available data.
+	 * @param argument Set to the decoded argument.
+	 * @return The position following the argument, or NULL if the data is invalid or truncated.
+	 */
+	static const char* decode(const char* data, const char* end, LogArgument& argument);
+
+protected:
+
+	/** @internal A pointer and length referring to a character string. */
+	struct StringValue
+	{
+		const char*		data;		/**< @internal The characters, NULL for a null C string. */
+		size_t			length;		/**< @internal The number of characters. */
+	};
+
+	/** @internal The storage for every kind of value. */
+	union Value
+	{
+		long long				signedValue;	/**< @internal The value of a SIGNED_TYPE. */
+		unsigned long long		unsignedValue;	/**< @internal The value of an UNSIGNED_TYPE. */
+		double					doubleValue;	/**< @internal The value of a FLOAT_TYPE or DOUBLE_TYPE. */
+		bool					boolValue;		/**< @internal The value of a BOOL_TYPE. */
+		StringValue				stringValue;	/**< @internal The value of a STRING_TYPE. */
+		const void*				pointerValue;	/**< @internal The value of a POINTER_TYPE. */
+	};
+
+	/**
+	 * @internal
+	 * Stores the given character string.
+	 *
+	 * @param data The characters.
+	 * @param length The number of characters.
+	 */
+	inline void setString(const char* data, size_t length)
+	{
+		_value.stringValue.data = data;
+		_value.stringValue.length = length;
+	}
+
+	// Instance member variables
+	Type		_type;		/**< @internal The kind of value the argument holds. */
+	Value		_value;		/**< @internal The value. */
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_LOG_ARGUMENT_H
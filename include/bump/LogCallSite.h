@@ -0,0 +1,76 @@
+//
+//	LogCallSite.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_LOG_CALL_SITE_H
+#define BUMP_LOG_CALL_SITE_H
+
+// Boost headers
+#include <boost/atomic.hpp>
+
+namespace bump {
+
+/**
+ * The LogCallSite class identifies a single BUMP_LOG_* macro in the source code.
+ *
+ * Every macro expansion declares a static call site holding its file and line. The
+ * first time the macro logs while binary logging is enabled, the site is registered
+ * with the log, which records its format and log level and writes them to the binary
+ * log once. Every record after that only refers to the site by its id.
+ *
+ * The constructor is constexpr, so call sites are initialized at compile time and
+ * cost nothing until binary logging is used.
+ */
+class LogCallSite
+{
+public:
+
+	/**
+	 * Constructor.
+	 *
+	 * @param file The source file of the call site.
+	 * @param line The source line of the call site.
+	 */
+	constexpr LogCallSite(const char* file, unsigned int line) :
+		file(file),
+		line(line),
+		format(nullptr),
+		level(0),
+		id(0)
+	{
+		;
+	}
+
+	// Member variables
+	const char*						file;		/**< The source file of the call site. */
+	unsigned int					line;		/**< The source line of the call site. */
+	const char*						format;		/**< The message format, set when the site is registered. */
+	int								level;		/**< The log level of the messages, set when the site is registered. */
+	boost::atomic<unsigned int>		id;			/**< The id of the site in the binary log, 0 until registered. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since each call site is unique.
+	 */
+	LogCallSite(const LogCallSite& callSite);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since each call site is unique.
+	 */
+	void operator=(const LogCallSite& callSite);
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_LOG_CALL_SITE_H
@@ -0,0 +1,154 @@
+//
+//	LogField.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_LOG_FIELD_H
+#define BUMP_LOG_FIELD_H
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/LogArgument.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * The LogFieldName class holds the name of a structured log field along with its JSON key.
+ *
+ * Field names are meant to be interned once per call site by the BUMP_LOG_FIELD macro, so
+ * the quoting and escaping of the key is paid the first time the call site runs and the
+ * JSON sinks only ever copy the finished key into their output.
+ */
+class BUMP_EXPORT LogFieldName
+{
+public:
+
+	/**
+	 * Constructor taking a name that must outlive the field name, normally a string literal.
+	 *
+	 * @param name The name of the field.
+	 */
+	explicit LogFieldName(const char* name);
+
+	/**
+	 * Destructor.
+	 */
+	~LogFieldName();
+
+	/**
+	 * Returns the name of the field.
+	 *
+	 * @return The name of the field.
+	 */
+	inline const char* name() const { return _name; }
+
+	/**
+	 * Returns the quoted and escaped name followed by a colon, ready to be copied into a JSON object.
+	 *
+	 * @return The JSON key of the field.
+	 */
+	inline const String& jsonKey() const { return _jsonKey; }
+
+protected:
+
+	// Instance member variables
+	const char*		_name;			/**< @internal The name of the field. */
+	String			_jsonKey;		/**< @internal The quoted and escaped name followed by a colon. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since field names are only referred to by the fields.
+	 */
+	LogFieldName(const LogFieldName& fieldName);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since field names are only referred to by the fields.
+	 */
+	void operator=(const LogFieldName& fieldName);
+};
+
+/**
+ * The LogField class refers to a single key/value field of a structured log message.
+ *
+ * Like a LogArgument, the value is stored by value for numbers and by pointer for strings,
+ * and the name is a reference to an interned LogFieldName, so building the fields of a
+ * message never allocates. The values can be any number, bool, C string, std::string or
+ * bump::String.
+ */
+class BUMP_EXPORT LogField
+{
+public:
+
+	/**
+	 * Constructor.
+	 *
+	 * @param name The interned name of the field.
+	 * @param value The value of the field.
+	 */
+	inline LogField(const LogFieldName& name, const LogArgument& value) : _name(&name), _value(value) {}
+
+	/**
+	 * Returns the interned name of the field.
+	 *
+	 * @return The name of the field.
+	 */
+	inline const LogFieldName& name() const { return *_name; }
+
+	/**
+	 * Returns the value of the field.
+	 *
+	 * @return The value of the field.
+	 */
+	inline const LogArgument& value() const { return _value; }
+
+	/**
+	 * Appends the field as a "name":value member of a JSON object to the end of the given buffer.
+	 *
+	 * @param buffer The buffer to append to.
+	 */
+	void appendJsonTo(String& buffer) const;
+
+	/**
+	 * Appends the field as name=value to the end of the given buffer, with strings quoted and escaped.
+	 *
+	 * @param buffer The buffer to append to.
+	 */
+	void appendTextTo(String& buffer) const;
+
+protected:
+
+	// Instance member variables
+	const LogFieldName*		_name;		/**< @internal The interned name of the field. */
+	LogArgument				_value;		/**< @internal The value of the field. */
+};
+
+}	// End of bump namespace
+
+/**
+ * Creates a structured log field whose name is interned at the call site.
+ *
+ * The name must be a string literal. It is turned into a LogFieldName the first time the
+ * call site runs, and every later call only refers to it:
+ *
+ * @code
+ *   BUMP_LOG_INFO_FIELDS("Request finished", BUMP_LOG_FIELD("path", path), BUMP_LOG_FIELD("status", 200));
+ * @endcode
+ */
+#define BUMP_LOG_FIELD(name, value)																\
+	bump::LogField([]() -> const bump::LogFieldName& {											\
+		static const bump::LogFieldName bump_log_field_name(name);								\
+		return bump_log_field_name;																\
+	}(), value)
+
+#endif	// End of BUMP_LOG_FIELD_H
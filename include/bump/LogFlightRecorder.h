@@ -0,0 +1,185 @@
+//
+//	LogFlightRecorder.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_LOG_FLIGHT_RECORDER_H
+#define BUMP_LOG_FLIGHT_RECORDER_H
+
+// C++ headers
+#include <cstdint>
+
+// Boost headers
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/Log.h>
+#include <bump/LogArgument.h>
+#include <bump/String.h>
+
+namespace bump {
+
+// Forward declarations
+struct LogFlightRing;
+
+/**
+ * The LogFlightRecorder class keeps the last few log records of every thread in memory.
+ *
+ * Each thread records into a ring of its own, so recording never waits on another thread.
+ * A record is the level, the time, the format and the raw arguments, copied into a fixed
+ * size slot without formatting anything. Strings are copied as far as they fit in the slot.
+ *
+ * Nothing is written anywhere until dump() is called. Dumping formats the records of every
+ * thread, oldest first, and writes them to the file using only async-signal-safe code, so
+ * it can run in the handlers installed with installSignalHandlers() when the process crashes.
+ *
+ * The Log creates one of these with Log::enableFlightRecorder().
+ */
+class BUMP_EXPORT LogFlightRecorder
+{
+public:
+
+	/**
+	 * Constructor.
+	 *
+	 * @param filepath The file the records are dumped to.
+	 * @param recordCount The number of records kept for each thread.
+	 */
+	explicit LogFlightRecorder(const String& filepath, unsigned int recordCount = 256);
+
+	/**
+	 * Destructor freeing the rings of the threads that have exited.
+	 *
+	 * The rings of threads still running are freed when they exit.
+	 */
+	~LogFlightRecorder();
+
+	/**
+	 * Copies the record into the calling thread's ring, overwriting its oldest record once full.
+	 *
+	 * @param logLevel The log level of the message.
+	 * @param prefix The string to tack onto the front of the message.
+	 * @param format The message with %1 - %99 markers for the arguments, which must outlive the recorder.
+	 * @param arguments The arguments replacing the markers.
+	 * @param argumentCount The number of arguments.
+	 */
+	void record(Log::LogLevel logLevel, const String& prefix, const char* format, const LogArgument* arguments,
+		unsigned int argumentCount);
+
+	/**
+	 * Formats the records of every thread and writes them to the file, replacing its contents.
+	 *
+	 * Async-signal-safe. Records being written at the time of the dump are skipped.
+	 *
+	 * @return True if the file was written, false otherwise.
+	 */
+	bool dump() const;
+
+	/**
+	 * Returns the file the records are dumped to.
+	 *
+	 * @return The file the records are dumped to.
+	 */
+	const String& filepath() const;
+
+	/**
+	 * Returns the number of records kept for each thread.
+	 *
+	 * @return The number of records kept for each thread.
+	 */
+	unsigned int recordCount() const;
+
+	/**
+	 * Dumps the given recorder when the process receives a fatal signal.
+	 *
+	 * Handles SIGSEGV and SIGABRT, plus SIGBUS, SIGFPE and SIGILL where they exist. After
+	 * dumping, the handler puts back the previous handler and raises the signal again so
+	 * the process still crashes the way it would have. The handler runs on an alternate
+	 * signal stack, given to the calling thread and to every thread recording, so a thread
+	 * overflowing its stack still gets a dump. Implemented in the platform specific source
+	 * files.
+	 *
+	 * @param recorder The recorder to dump, NULL to put back the previous handlers.
+	 */
+	static void installSignalHandlers(LogFlightRecorder* recorder);
+
+protected:
+
+	/**
+	 * @internal
+	 * Returns the calling thread's ring, taking over the ring of an exited thread or adding a new one.
+	 *
+	 * @return The calling thread's ring.
+	 */
+	LogFlightRing* threadRing();
+
+	/**
+	 * @internal
+	 * Gives the calling thread an alternate stack for the signal handlers, unless it already has
+	 * one, freed when the thread exits. Implemented in the platform specific source files.
+	 */
+	static void installSignalStack();
+
+	/**
+	 * @internal
+	 * Opens the dump file for writing, replacing its contents. Async-signal-safe and
+	 * implemented in the platform specific source files.
+	 *
+	 * @param filepath The file to open.
+	 * @return The file descriptor or handle, -1 if the file could not be opened.
+	 */
+	static intptr_t openDumpFile(const char* filepath);
+
+	/**
+	 * @internal
+	 * Writes to the dump file. Async-signal-safe and implemented in the platform specific source files.
+	 *
+	 * @param file The file descriptor or handle.
+	 * @param data The characters to write.
+	 * @param size The number of characters.
+	 * @return True if everything was written, false otherwise.
+	 */
+	static bool writeDumpFile(intptr_t file, const char* data, size_t size);
+
+	/**
+	 * @internal
+	 * Closes the dump file. Async-signal-safe and implemented in the platform specific source files.
+	 *
+	 * @param file The file descriptor or handle.
+	 */
+	static void closeDumpFile(intptr_t file);
+
+	// Instance member variables
+	String								_filepath;		/**< @internal The file the records are dumped to. */
+	unsigned int						_recordCount;	/**< @internal The number of records kept for each thread. */
+	unsigned long long					_id;			/**< @internal Tells the rings of this recorder apart from those of earlier ones. */
+	boost::atomic<LogFlightRing*>		_rings;			/**< @internal The list of every ring, only ever pushed onto. */
+	boost::mutex						_ringMutex;		/**< @internal Serializes handing out rings. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since the rings cannot be shared.
+	 */
+	LogFlightRecorder(const LogFlightRecorder& recorder);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since the rings cannot be shared.
+	 */
+	void operator=(const LogFlightRecorder& recorder);
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_LOG_FLIGHT_RECORDER_H
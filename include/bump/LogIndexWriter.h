@@ -0,0 +1,163 @@
+//
+//	LogIndexWriter.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_LOG_INDEX_WRITER_H
+#define BUMP_LOG_INDEX_WRITER_H
+
+// C++ headers
+#include <fstream>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/LogSink.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * The LogIndexWriter class writes the sparse time index kept next to a text log file.
+ *
+ * The index lives in the log filepath followed by ".idx" and maps times to byte offsets
+ * in the log, so a LogReader can jump close to the start of a time range instead of
+ * scanning the whole file. An entry is added at the first line starting at least the index
+ * interval of bytes after the previous entry, which keeps the index tiny: a 200 GB log
+ * indexed every 64 KB has an index of about 50 MB.
+ *
+ * The time of an entry is the timestamp of the line it points at, see
+ * LogReader::parseTimestamp(). Lines without a timestamp, such as the rest of a multi-line
+ * message, are passed over for the next line with one. A log written without timestamps
+ * gets the current time instead, and the times are kept from going backwards so the index
+ * stays sorted.
+ * An index can be rebuilt from an existing log in a single sequential pass with rebuild().
+ *
+ * The index starts with the "BUMPIDX1" magic and the 8 byte index interval, followed by
+ * entries of an 8 byte time in microseconds since the Unix epoch and the 8 byte offset of
+ * the line, all in the byte order of the machine that wrote it.
+ */
+class BUMP_EXPORT LogIndexWriter
+{
+public:
+
+	/** The magic bytes every index starts with. */
+	static const char MAGIC[8];
+
+	/** The size of the magic and index interval at the start of the index. */
+	static const unsigned int HEADER_SIZE = 16;
+
+	/** The size of each entry. */
+	static const unsigned int ENTRY_SIZE = 16;
+
+	/**
+	 * Constructor opening the index of the given log.
+	 *
+	 * When appending, the index is continued from the current size of the log, otherwise
+	 * it is truncated along with the log.
+	 *
+	 * @param logFilepath The log file the index belongs to.
+	 * @param interval The number of bytes of the log between the entries.
+	 * @param append Whether the log is appended to, otherwise it is written from the start.
+	 * @throw bump::FileSystemError When the index cannot be opened.
+	 */
+	LogIndexWriter(const String& logFilepath, unsigned long long interval, bool append);
+
+	/**
+	 * Destructor.
+	 */
+	~LogIndexWriter();
+
+	/**
+	 * Adds the entries for buffers that were just written to the end of the log.
+	 *
+	 * Only the bytes around the next entry are looked at, everything else is skipped by size.
+	 *
+	 * @param buffers The buffers written to the log.
+	 * @param bufferCount The number of buffers.
+	 */
+	void add(const LogSink::Buffer* buffers, unsigned int bufferCount);
+
+	/**
+	 * Returns the number of entries written by this writer.
+	 *
+	 * @return The number of entries written by this writer.
+	 */
+	unsigned long long entryCount() const;
+
+	/**
+	 * Returns the path of the index belonging to the given log.
+	 *
+	 * @param logFilepath The log file.
+	 * @return The log filepath followed by ".idx".
+	 */
+	static String indexFilepath(const String& logFilepath);
+
+	/**
+	 * Replaces the index of an existing log by reading the log once from start to end.
+	 *
+	 * Only lines with a timestamp get an entry, so a log written without timestamps ends
+	 * up with an empty index.
+	 *
+	 * @param logFilepath The log file to index.
+	 * @param interval The number of bytes of the log between the entries.
+	 * @return The number of entries written.
+	 * @throw bump::FileSystemError When the log or the index cannot be opened.
+	 */
+	static unsigned long long rebuild(const String& logFilepath, unsigned long long interval);
+
+protected:
+
+	/**
+	 * @internal
+	 * Adds the entries for a single buffer.
+	 *
+	 * @param data The bytes written to the log.
+	 * @param size The number of bytes.
+	 */
+	void addBuffer(const char* data, size_t size);
+
+	/**
+	 * @internal
+	 * Writes an entry to the index, moving its time up to the previous one if necessary.
+	 *
+	 * @param time The time of the line in microseconds since the Unix epoch.
+	 * @param offset The offset of the line in the log.
+	 */
+	void writeEntry(long long time, unsigned long long offset);
+
+	// Instance member variables
+	std::ofstream			_file;				/**< @internal The index. */
+	unsigned long long		_interval;			/**< @internal The number of bytes between the entries. */
+	unsigned long long		_logSize;			/**< @internal The size of the log after everything added so far. */
+	unsigned long long		_nextEntryOffset;	/**< @internal The offset from which the next line gets an entry. */
+	unsigned long long		_entryCount;		/**< @internal The number of entries written. */
+	long long				_lastTime;			/**< @internal The time of the last entry. */
+	bool					_isAtLineStart;		/**< @internal Whether the log ends with a complete line. */
+	bool					_isTimestamped;		/**< @internal Whether a line with a timestamp has been seen. */
+	bool					_isRebuilding;		/**< @internal Whether lines without a timestamp are always skipped rather than given the current time. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since the writer can't be copied.
+	 */
+	LogIndexWriter(const LogIndexWriter& writer);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since the writer can't be copied.
+	 */
+	void operator=(const LogIndexWriter& writer);
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_LOG_INDEX_WRITER_H
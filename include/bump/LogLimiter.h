@@ -0,0 +1,223 @@
+//
+//	LogLimiter.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_LOG_LIMITER_H
+#define BUMP_LOG_LIMITER_H
+
+// Boost headers
+#include <boost/atomic.hpp>
+
+// Bump headers
+#include <bump/Export.h>
+
+namespace bump {
+
+/**
+ * The LogRateLimiter class limits a single call site to a sustained rate of messages.
+ *
+ * It behaves like a token bucket holding up to the burst size of tokens, refilled at the
+ * given rate. The bucket is kept as the single time at which it will be full again, so
+ * taking a token is one compare-and-swap on that time and a refused message only costs
+ * reading the clock. The messages refused since the last one logged are counted so the
+ * log can report them.
+ *
+ * The BUMP_LOG_*_RATE_LIMITED macros declare one of these next to their call site, and
+ * the constexpr constructor initializes it at compile time.
+ */
+class BUMP_EXPORT LogRateLimiter
+{
+public:
+
+	/**
+	 * Constructor.
+	 *
+	 * @param messagesPerSecond The sustained number of messages logged per second, must be positive.
+	 * @param burst The number of messages that can be logged back to back after a quiet period.
+	 */
+	constexpr LogRateLimiter(double messagesPerSecond, unsigned int burst) :
+		_interval(static_cast<long long>(1000000000.0 / messagesPerSecond)),
+		_tolerance(static_cast<long long>(1000000000.0 / messagesPerSecond) * static_cast<long long>(burst > 0 ? burst : 1)),
+		_fullTime(0),
+		_suppressedCount(0)
+	{
+		;
+	}
+
+	/**
+	 * Takes a token from the bucket if there is one.
+	 *
+	 * @param suppressedCount Set to the number of messages refused since the last token was
+	 *                        taken when this call takes one, left untouched otherwise.
+	 * @return True if the message should be logged, false otherwise.
+	 */
+	bool tryAcquire(unsigned long long& suppressedCount);
+
+protected:
+
+	// Instance member variables
+	long long							_interval;			/**< @internal The nanoseconds it takes to refill a token. */
+	long long							_tolerance;			/**< @internal The nanoseconds it takes to refill the whole bucket. */
+	boost::atomic<long long>			_fullTime;			/**< @internal The steady clock nanoseconds at which the bucket is full again. */
+	boost::atomic<unsigned long long>	_suppressedCount;	/**< @internal The messages refused since the last token was taken. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since each limiter belongs to a single call site.
+	 */
+	LogRateLimiter(const LogRateLimiter& limiter);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since each limiter belongs to a single call site.
+	 */
+	void operator=(const LogRateLimiter& limiter);
+};
+
+/**
+ * The LogSampler class lets through one in every N messages of a single call site.
+ *
+ * The first message is always logged. Sampling costs a single relaxed fetch-add on a counter
+ * shared by every thread logging from the call site.
+ */
+class BUMP_EXPORT LogSampler
+{
+public:
+
+	/**
+	 * Constructor.
+	 *
+	 * @param sampleInterval The number of messages N out of which one is logged, 0 behaves like 1.
+	 */
+	constexpr LogSampler(unsigned int sampleInterval) :
+		_sampleInterval(sampleInterval > 0 ? sampleInterval : 1),
+		_messageCount(0)
+	{
+		;
+	}
+
+	/**
+	 * Counts the message and returns whether it is the one in N that is logged.
+	 *
+	 * @return True if the message should be logged, false otherwise.
+	 */
+	inline bool sample()
+	{
+		return _messageCount.fetch_add(1, boost::memory_order_relaxed) % _sampleInterval == 0;
+	}
+
+protected:
+
+	// Instance member variables
+	unsigned long long					_sampleInterval;	/**< @internal The number of messages out of which one is logged. */
+	boost::atomic<unsigned long long>	_messageCount;		/**< @internal The messages seen so far. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since each sampler belongs to a single call site.
+	 */
+	LogSampler(const LogSampler& sampler);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since each sampler belongs to a single call site.
+	 */
+	void operator=(const LogSampler& sampler);
+};
+
+/**
+ * The LogRepeatSuppressor class collapses identical consecutive messages of a single call site.
+ *
+ * Only a hash of the last message is kept. A message matching it is counted instead of
+ * logged, and the count is reported as "Last message repeated K times" right before the
+ * next different message. While the same message keeps repeating, the count is also
+ * reported once per report interval so a message stuck in a loop never goes quiet for good.
+ *
+ * Every check is an atomic exchange of the hash plus, for repeats, a relaxed read of the clock.
+ * Threads logging different messages from the same call site at once can each see the other's
+ * message as the last one, which only costs an extra line and never loses a count.
+ */
+class BUMP_EXPORT LogRepeatSuppressor
+{
+public:
+
+	/**
+	 * Constructor.
+	 *
+	 * @param reportIntervalSeconds The seconds between reports of a message that keeps repeating.
+	 */
+	constexpr LogRepeatSuppressor(unsigned int reportIntervalSeconds = 30) :
+		_reportInterval(static_cast<long long>(reportIntervalSeconds) * 1000000000LL),
+		_lastHash(0),
+		_reportTime(0),
+		_repeatCount(0)
+	{
+		;
+	}
+
+	/**
+	 * Checks the message against the last one logged from the call site.
+	 *
+	 * @param hash The hash of the message.
+	 * @param repeatCount Set to the number of repeats that should be reported before anything
+	 *                    else is logged, 0 when there is nothing to report.
+	 * @return True if the message should be logged, false if it is a repeat.
+	 */
+	bool filter(unsigned long long hash, unsigned long long& repeatCount);
+
+	/**
+	 * Returns the FNV-1a hash of the given bytes, continuing the given hash.
+	 *
+	 * @param data The bytes to hash.
+	 * @param size The number of bytes.
+	 * @param hash The hash to continue, the FNV offset basis by default.
+	 * @return The hash of the bytes.
+	 */
+	static unsigned long long hash(const char* data, size_t size, unsigned long long hash = 14695981039346656037ULL);
+
+protected:
+
+	// Instance member variables
+	long long							_reportInterval;	/**< @internal The nanoseconds between reports of a repeating message. */
+	boost::atomic<unsigned long long>	_lastHash;			/**< @internal The hash of the last message seen. */
+	boost::atomic<long long>			_reportTime;		/**< @internal The steady clock nanoseconds the last message or report was logged. */
+	boost::atomic<unsigned long long>	_repeatCount;		/**< @internal The repeats not reported yet. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since each suppressor belongs to a single call site.
+	 */
+	LogRepeatSuppressor(const LogRepeatSuppressor& suppressor);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since each suppressor belongs to a single call site.
+	 */
+	void operator=(const LogRepeatSuppressor& suppressor);
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_LOG_LIMITER_H
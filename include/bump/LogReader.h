@@ -0,0 +1,156 @@
+//
+//	LogReader.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_LOG_READER_H
+#define BUMP_LOG_READER_H
+
+// C++ headers
+#include <fstream>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * The LogReader class streams the lines of a text log logged within a time range.
+ *
+ * With the sidecar index written by a sink with an index interval, or rebuilt with
+ * LogIndexWriter::rebuild(), the reader binary searches the index for the last entry
+ * before the range and only reads the log from there, so pulling a few minutes out of a
+ * 200 GB log reads a few index entries and the lines of those minutes. Without an index
+ * the log is read from the start.
+ *
+ * Lines are matched by their own timestamps, see parseTimestamp(). Lines without one,
+ * such as the rest of a multi-line message, belong to the last timestamped line before
+ * them. A log written without any timestamps is cut at the index entries around the
+ * range instead, so it may include up to an index interval of lines on either side.
+ *
+ * @code
+ *   bump::LogReader reader("/var/log/app.log");
+ *   reader.seekTimeRange(start, end);
+ *   bump::String line;
+ *   while (reader.readLine(line))
+ *   {
+ *       std::cout << line << std::endl;
+ *   }
+ * @endcode
+ */
+class BUMP_EXPORT LogReader
+{
+public:
+
+	/**
+	 * Constructor opening the log and its index if there is one.
+	 *
+	 * The reader starts out covering the whole log.
+	 *
+	 * @param filepath The log to read.
+	 * @throw bump::FileSystemError When the log cannot be opened.
+	 */
+	explicit LogReader(const String& filepath);
+
+	/**
+	 * Destructor.
+	 */
+	~LogReader();
+
+	/**
+	 * Returns whether the log has a valid index.
+	 *
+	 * @return Whether the log has a valid index.
+	 */
+	bool hasIndex() const;
+
+	/**
+	 * Moves the reader to the lines logged from the start time up to and including the end time.
+	 *
+	 * @param startTime The start of the range in microseconds since the Unix epoch.
+	 * @param endTime The end of the range in microseconds since the Unix epoch.
+	 */
+	void seekTimeRange(long long startTime, long long endTime);
+
+	/**
+	 * Reads the next line of the range.
+	 *
+	 * @param line Set to the next line without its newline.
+	 * @return True if a line was read, false at the end of the range.
+	 */
+	bool readLine(String& line);
+
+	/**
+	 * Parses the timestamp at the start of a line.
+	 *
+	 * Understands the lines of JSON sinks and of the log's timestamp formats that include the
+	 * date, with any precision: "2013-01-14 22:51:33.123:", "2013-01-14 10:51:33 PM:" and
+	 * "2013-01-14T22:51:33+01:00". Timestamps without a UTC offset are taken as local time.
+	 *
+	 * @param data The start of the line.
+	 * @param length The number of characters available.
+	 * @param microseconds Set to the time in microseconds since the Unix epoch.
+	 * @return True if the line starts with a timestamp, false otherwise.
+	 */
+	static bool parseTimestamp(const char* data, size_t length, long long& microseconds);
+
+protected:
+
+	/**
+	 * @internal
+	 * Reads an entry of the index.
+	 *
+	 * @param index The index of the entry.
+	 * @param time Set to the time of the entry.
+	 * @param offset Set to the offset of the entry.
+	 * @return True if the entry was read, false otherwise.
+	 */
+	bool readEntry(unsigned long long index, long long& time, unsigned long long& offset);
+
+	/**
+	 * @internal
+	 * Returns the index of the first entry with a time after the given one.
+	 *
+	 * @param time The time to search for.
+	 * @return The index of the first entry after the time, the entry count if there is none.
+	 */
+	unsigned long long findEntryAfter(long long time);
+
+	// Instance member variables
+	std::ifstream			_file;				/**< @internal The log. */
+	std::ifstream			_indexFile;			/**< @internal The index, closed when there is none. */
+	unsigned long long		_entryCount;		/**< @internal The number of entries in the index. */
+	unsigned long long		_offset;			/**< @internal The offset of the next line. */
+	unsigned long long		_endOffset;			/**< @internal The offset the range ends at for lines without timestamps. */
+	long long				_startTime;			/**< @internal The start of the range. */
+	long long				_endTime;			/**< @internal The end of the range. */
+	long long				_lineTime;			/**< @internal The time of the last timestamped line. */
+	bool					_hasLineTime;		/**< @internal Whether a timestamped line has been read since seeking. */
+	bool					_isFinished;		/**< @internal Whether the end of the range has been reached. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since the reader can't be copied.
+	 */
+	LogReader(const LogReader& reader);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since the reader can't be copied.
+	 */
+	void operator=(const LogReader& reader);
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_LOG_READER_H
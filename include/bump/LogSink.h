@@ -0,0 +1,112 @@
+//
+//	LogSink.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_LOG_SINK_H
+#define BUMP_LOG_SINK_H
+
+// C++ headers
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+
+// Bump headers
+#include <bump/Export.h>
+
+namespace bump {
+
+/**
+ * The LogSink class is the destination the log writes its formatted output to.
+ *
+ * Subclasses receive the output as a list of buffers so a whole batch of messages can be
+ * handed over in a single call, which lets sinks like the FileDescriptorLogSink write it
+ * with a single system call. The log never calls a sink from two threads at once unless
+ * the sink says it is thread-safe, so sinks don't need any locking of their own.
+ *
+ * Every sink also provides a std::ostream through stream(). It collects everything written
+ * to it in a small buffer and passes that to write() when full or flushed, which is how
+ * the log writes to a sink wherever it used to write to a std::ostream. Subclasses must
+ * flush stream() in their destructors since write() can no longer be called from here.
+ */
+class BUMP_EXPORT LogSink
+{
+public:
+
+	/** A range of characters to write. */
+	struct Buffer
+	{
+		const char*		data;	/**< The characters. */
+		size_t			size;	/**< The number of characters. */
+	};
+
+	/**
+	 * Constructor.
+	 */
+	LogSink();
+
+	/**
+	 * Destructor.
+	 */
+	virtual ~LogSink();
+
+	/**
+	 * Writes the given buffers in order.
+	 *
+	 * @param buffers The buffers to write.
+	 * @param bufferCount The number of buffers.
+	 */
+	virtual void write(const Buffer* buffers, unsigned int bufferCount) = 0;
+
+	/**
+	 * Pushes anything the sink holds on to towards its destination. Does nothing by default.
+	 */
+	virtual void flush();
+
+	/**
+	 * Returns whether write() can be called from several threads at once. False by default.
+	 *
+	 * The log skips locking around writes to the sinks added with Log::addLogSink() that are.
+	 *
+	 * @return Whether write() can be called from several threads at once.
+	 */
+	virtual bool isThreadSafe() const;
+
+	/**
+	 * Returns a stream writing to the sink.
+	 *
+	 * @return A stream writing to the sink.
+	 */
+	std::ostream& stream();
+
+protected:
+
+	// Instance member variables
+	std::streambuf*		_streamBuffer;		/**< @internal The buffer behind the stream, writing to the sink. */
+	std::ostream*		_stream;			/**< @internal The stream writing to the sink. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since the sink can't be copied.
+	 */
+	LogSink(const LogSink& sink);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since the sink can't be copied.
+	 */
+	void operator=(const LogSink& sink);
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_LOG_SINK_H
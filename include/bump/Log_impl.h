@@ -0,0 +1,71 @@
+//
+//	Log_impl.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_LOG_IMPL_H
+#define BUMP_LOG_IMPL_H
+
+namespace bump {
+
+//====================================================================================
+//                                Inline Level Checks
+//====================================================================================
+
+inline bool Log::isLogEnabled()
+{
+	return _isEnabled.load(boost::memory_order_relaxed);
+}
+
+inline bool Log::isLogLevelEnabled(LogLevel logLevel)
+{
+	// The enabled log level is -1 when the log is disabled, so no level passes
+	return static_cast<int>(logLevel) <= _enabledLogLevel.load(boost::memory_order_relaxed);
+}
+
+inline Log::LogLevel Log::logLevel()
+{
+	return _logLevel.load(boost::memory_order_relaxed);
+}
+
+//====================================================================================
+//                                Deferred Formatting
+//====================================================================================
+
+template <size_t FormatSize, typename Argument, typename... Arguments>
+inline void Log::writeFormattedMessage(LogCallSite& callSite, LogLevel logLevel, const String& prefix,
+	const char (&format)[FormatSize], const Argument& argument, const Arguments&... arguments)
+{
+	const LogArgument log_arguments[] = { LogArgument(argument), LogArgument(arguments)... };
+	writeArguments(callSite, logLevel, _logLevel.load(boost::memory_order_relaxed), prefix, format, log_arguments,
+		1 + sizeof...(Arguments));
+}
+
+template <size_t FormatSize>
+inline void Log::writeFormattedMessage(LogCallSite& callSite, LogLevel logLevel, const String& prefix,
+	const char (&format)[FormatSize])
+{
+	writeArguments(callSite, logLevel, _logLevel.load(boost::memory_order_relaxed), prefix, format, NULL, 0);
+}
+
+template <size_t FormatSize, typename Argument, typename... Arguments>
+inline void Log::writeUnrepeatedMessage(LogRepeatSuppressor& suppressor, LogCallSite& callSite, LogLevel logLevel,
+	const String& prefix, const char (&format)[FormatSize], const Argument& argument, const Arguments&... arguments)
+{
+	const LogArgument log_arguments[] = { LogArgument(argument), LogArgument(arguments)... };
+	writeUnrepeatedArguments(suppressor, callSite, logLevel, prefix, format, log_arguments, 1 + sizeof...(Arguments));
+}
+
+template <size_t FormatSize>
+inline void Log::writeUnrepeatedMessage(LogRepeatSuppressor& suppressor, LogCallSite& callSite, LogLevel logLevel,
+	const String& prefix, const char (&format)[FormatSize])
+{
+	writeUnrepeatedArguments(suppressor, callSite, logLevel, prefix, format, NULL, 0);
+}
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_LOG_IMPL_H
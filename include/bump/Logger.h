@@ -0,0 +1,224 @@
+//
+//	Logger.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_LOGGER_H
+#define BUMP_LOGGER_H
+
+// Boost headers
+#include <boost/atomic.hpp>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/Log.h>
+#include <bump/LogArgument.h>
+#include <bump/LogCallSite.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * The Logger class is a named handle onto the log for a single module.
+ *
+ * Loggers are named with dots separating the levels of a hierarchy, such as "bump.fs" or
+ * "app.ingest", and are created by Log::logger() the first time their name is asked for.
+ * A logger without a log level of its own inherits the level of its closest ancestor that
+ * has one, and the log level of the Log itself at the top. The levels can be set in code or
+ * through the BUMP_LOG_LEVEL environment variable:
+ *
+ * @code
+ *   $ BUMP_LOG_LEVEL=WARNING_LVL,bump=INFO_LVL,bump.fs=DEBUG_LVL ./app
+ * @endcode
+ *
+ * Every logger keeps its own enabled level in an atomic, updated whenever any level changes,
+ * so checking a level is a single relaxed load whichever module turned on DEBUG_LVL. The
+ * messages are written with the logger name as their prefix, so sinks can still pick them
+ * out with a prefix filter:
+ *
+ * @code
+ *   static bump::Logger& logger = bump::Log::instance()->logger("bump.fs");
+ *   BUMP_LOGGER_DEBUG(logger, "Copying %1 to %2", source, destination);
+ * @endcode
+ *
+ * Loggers are never destroyed, so the references handed out can be kept in statics. Once the
+ * Log is destroyed during static destruction they quietly stop writing.
+ */
+class BUMP_EXPORT Logger
+{
+public:
+
+	/**
+	 * Returns the name of the logger.
+	 *
+	 * @return The name of the logger.
+	 */
+	const String& name() const;
+
+	/**
+	 * Returns the prefix the messages of the logger are written with, the name in brackets.
+	 *
+	 * @return The prefix of the messages.
+	 */
+	const String& prefix() const;
+
+	/**
+	 * Returns whether messages of the log level are written by this logger.
+	 *
+	 * A single relaxed atomic load, like Log::isLogLevelEnabled().
+	 *
+	 * @param logLevel The log level to determine if enabled.
+	 * @return Whether the given logLevel is enabled.
+	 */
+	inline bool isLogLevelEnabled(Log::LogLevel logLevel) const;
+
+	/**
+	 * Returns the log level of the logger, its own or the inherited one.
+	 *
+	 * @return The log level of the logger.
+	 */
+	Log::LogLevel logLevel() const;
+
+	/**
+	 * Sets the log level of the logger and of the descendants without a level of their own.
+	 *
+	 * Same as Log::setLoggerLevel() with the name of this logger.
+	 *
+	 * @param logLevel The log level to set the logger to.
+	 */
+	void setLogLevel(Log::LogLevel logLevel);
+
+	/**
+	 * Goes back to inheriting the log level of the closest ancestor with a level of its own.
+	 */
+	void clearLogLevel();
+
+	/**
+	 * Writes the message with the logger name as the prefix if the log level is enabled.
+	 *
+	 * @param logLevel The log level of the message.
+	 * @param message The message to write.
+	 * @param newline Whether to end the line after the message, otherwise the stream is only flushed.
+	 */
+	void writeMessage(Log::LogLevel logLevel, const String& message, bool newline = true);
+
+	/**
+	 * Formats the message like Log::writeFormattedMessage() and writes it with the logger name
+	 * as the prefix. This is what the BUMP_LOGGER_* macros call once the level is enabled.
+	 *
+	 * @param callSite The call site of the message.
+	 * @param logLevel The log level of the message.
+	 * @param format The message with %1 - %99 markers for the arguments, a string literal.
+	 * @param arguments The arguments replacing the markers.
+	 */
+	template <size_t FormatSize, typename... Arguments>
+	inline void writeFormattedMessage(LogCallSite& callSite, Log::LogLevel logLevel, const char (&format)[FormatSize],
+		const Arguments&... arguments);
+
+	/** Deleted so formats in buffers that can change or go away don't compile. */
+	template <size_t FormatSize, typename... Arguments>
+	void writeFormattedMessage(LogCallSite& callSite, Log::LogLevel logLevel, char (&format)[FormatSize],
+		const Arguments&... arguments) = delete;
+
+protected:
+
+	// The log creates the loggers and keeps their levels up to date
+	friend class Log;
+
+	/**
+	 * @internal
+	 * Constructor for a logger taking the log level of the log until the levels are updated.
+	 *
+	 * @param log The log to write to.
+	 * @param name The name of the logger.
+	 */
+	Logger(Log* log, const String& name);
+
+	/**
+	 * @internal
+	 * Destructor.
+	 */
+	~Logger();
+
+	/**
+	 * @internal
+	 * Stores the levels worked out by the log. The log mutex must be locked.
+	 *
+	 * @param logLevel The log level of the logger, its own or the inherited one.
+	 * @param enabledLogLevel The most verbose level written to the log stream, a sink or the flight recorder, -1 when disabled.
+	 */
+	void updateLogLevelsLocked(Log::LogLevel logLevel, int enabledLogLevel);
+
+	// Instance member variables
+	Log*						_log;					/**< @internal The log to write to. */
+	String						_name;					/**< @internal The name of the logger. */
+	String						_prefix;				/**< @internal The name in brackets followed by a space. */
+	boost::atomic<Log::LogLevel>	_logLevel;			/**< @internal The log level, its own or the inherited one. */
+	boost::atomic<int>			_enabledLogLevel;		/**< @internal The most verbose level to write, -1 when the log is disabled. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since loggers are only handed out by reference.
+	 */
+	Logger(const Logger& logger);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since loggers are only handed out by reference.
+	 */
+	void operator=(const Logger& logger);
+};
+
+inline bool Logger::isLogLevelEnabled(Log::LogLevel logLevel) const
+{
+	return static_cast<int>(logLevel) <= _enabledLogLevel.load(boost::memory_order_relaxed);
+}
+
+template <size_t FormatSize, typename... Arguments>
+inline void Logger::writeFormattedMessage(LogCallSite& callSite, Log::LogLevel logLevel, const char (&format)[FormatSize],
+	const Arguments&... arguments)
+{
+	// The extra empty argument keeps the array valid without any arguments
+	const LogArgument log_arguments[] = { LogArgument(arguments)..., LogArgument(0) };
+	_log->writeArguments(callSite, logLevel, _logLevel.load(boost::memory_order_relaxed), _prefix, format,
+		log_arguments, sizeof...(Arguments));
+}
+
+}	// End of bump namespace
+
+/**
+ * Deferred-argument log macros writing through a Logger.
+ *
+ * These work like the BUMP_LOG_* macros, with the level checked against the logger instead
+ * of the log, and are stripped by BUMP_LOG_MIN_LEVEL the same way.
+ */
+#define BUMP_LOGGER_MESSAGE(logger, level, ...)													\
+	do																							\
+	{																							\
+		if (BUMP_LOG_IS_COMPILED(level))														\
+		{																						\
+			bump::Logger& bump_logger = (logger);												\
+			if (bump_logger.isLogLevelEnabled(level))											\
+			{																					\
+				static bump::LogCallSite bump_log_call_site(__FILE__, __LINE__);				\
+				bump_logger.writeFormattedMessage(bump_log_call_site, level, __VA_ARGS__);		\
+			}																					\
+		}																						\
+	} while (0)
+
+#define BUMP_LOGGER_ALWAYS(logger, ...)		BUMP_LOGGER_MESSAGE(logger, bump::Log::ALWAYS_LVL, __VA_ARGS__)
+#define BUMP_LOGGER_ERROR(logger, ...)		BUMP_LOGGER_MESSAGE(logger, bump::Log::ERROR_LVL, __VA_ARGS__)
+#define BUMP_LOGGER_WARNING(logger, ...)	BUMP_LOGGER_MESSAGE(logger, bump::Log::WARNING_LVL, __VA_ARGS__)
+#define BUMP_LOGGER_INFO(logger, ...)		BUMP_LOGGER_MESSAGE(logger, bump::Log::INFO_LVL, __VA_ARGS__)
+#define BUMP_LOGGER_DEBUG(logger, ...)		BUMP_LOGGER_MESSAGE(logger, bump::Log::DEBUG_LVL, __VA_ARGS__)
+
+#endif	// End of BUMP_LOGGER_H
@@ -0,0 +1,196 @@
+//
+//	MappedFileLogSink.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_MAPPED_FILE_LOG_SINK_H
+#define BUMP_MAPPED_FILE_LOG_SINK_H
+
+// C++ headers
+#include <cstdint>
+
+// Boost headers
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/LogSink.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * The MappedFileLogSink class appends the log output to a memory-mapped file.
+ *
+ * The file is mapped in fixed size segments. Each write reserves its range of the file with
+ * a single atomic fetch-add on the file cursor and copies the output straight into the mapped
+ * pages, so any number of threads can write at once without a lock or a system call. When a
+ * reservation runs past the last mapped segment, the file is extended by a segment and the
+ * next one is mapped, and a segment is unmapped by whichever write completes it.
+ *
+ * The output lives in the page cache as soon as it is copied, so it survives the process
+ * crashing. It does not survive the machine crashing until the kernel has written the pages
+ * back. The file is truncated to the output on destruction. After a crash the file instead
+ * ends with the zero bytes of the unused part of its last segment, which the next sink
+ * opening it skips before appending.
+ */
+class BUMP_EXPORT MappedFileLogSink : public LogSink
+{
+public:
+
+	/**
+	 * Constructor opening the given file for appending, creating it if necessary.
+	 *
+	 * @param filepath The file to write the log output to.
+	 * @param segmentSize The number of bytes mapped at a time, rounded up to a multiple of 1 MB.
+	 * @throw bump::FileSystemError When the file cannot be opened or mapped.
+	 */
+	explicit MappedFileLogSink(const String& filepath, size_t segmentSize = 64 * 1024 * 1024);
+
+	/**
+	 * Destructor unmapping the file and truncating it to the output.
+	 */
+	~MappedFileLogSink();
+
+	/**
+	 * Reserves room for the buffers at the end of the file and copies them into it.
+	 *
+	 * Safe to call from any number of threads at once.
+	 *
+	 * @param buffers The buffers to write.
+	 * @param bufferCount The number of buffers.
+	 */
+	void write(const Buffer* buffers, unsigned int bufferCount);
+
+	/**
+	 * Returns true since concurrent writes each reserve their own range of the file.
+	 *
+	 * @return True.
+	 */
+	bool isThreadSafe() const;
+
+	/**
+	 * Returns the file the log output is written to.
+	 *
+	 * @return The file the log output is written to.
+	 */
+	const String& filepath() const;
+
+	/**
+	 * Returns the number of bytes mapped at a time.
+	 *
+	 * @return The number of bytes mapped at a time.
+	 */
+	size_t segmentSize() const;
+
+	/**
+	 * Returns the size of the output in the file.
+	 *
+	 * @return The size of the output in the file.
+	 */
+	unsigned long long size() const;
+
+	/**
+	 * Returns the number of writes lost because the file could not be extended or mapped.
+	 *
+	 * @return The number of writes lost because the file could not be extended or mapped.
+	 */
+	unsigned long long droppedWriteCount() const;
+
+protected:
+
+	/** @internal A segment of the file along with how much of it has been written. */
+	struct Segment
+	{
+		boost::atomic<char*>		data;			/**< @internal The mapped segment, NULL when not mapped. */
+		boost::atomic<size_t>		writtenSize;	/**< @internal The number of bytes copied into the segment. */
+	};
+
+	/**
+	 * @internal
+	 * Returns the given segment, extending the file and mapping it if necessary.
+	 *
+	 * @param index The index of the segment.
+	 * @return The mapped segment, NULL if it could not be mapped.
+	 */
+	char* segmentData(size_t index);
+
+	/**
+	 * @internal
+	 * Counts bytes copied into a segment and unmaps it once it is full.
+	 *
+	 * @param index The index of the segment.
+	 * @param size The number of bytes copied into it.
+	 */
+	void completeSegment(size_t index, size_t size);
+
+	/**
+	 * @internal
+	 * Returns the end of the output in the file, skipping the zero bytes left by a crash.
+	 *
+	 * @param fileSize The size of the file.
+	 * @return The end of the output in the file.
+	 */
+	unsigned long long findOutputEnd(unsigned long long fileSize);
+
+	/**
+	 * @internal
+	 * Opens the file, creating it if necessary. Implemented in the platform specific source files.
+	 *
+	 * @param fileSize Set to the size of the file.
+	 * @throw bump::FileSystemError When the file cannot be opened.
+	 */
+	void openFile(unsigned long long& fileSize);
+
+	/**
+	 * @internal
+	 * Sets the size of the file. Implemented in the platform specific source files.
+	 *
+	 * @param size The new size of the file.
+	 * @return True if the file was resized, false otherwise.
+	 */
+	bool resizeFile(unsigned long long size);
+
+	/**
+	 * @internal
+	 * Maps part of the file. Implemented in the platform specific source files.
+	 *
+	 * @param offset The offset of the part in the file, a multiple of the segment size.
+	 * @param size The size of the part.
+	 * @return The mapped part, NULL if it could not be mapped.
+	 */
+	char* mapFile(unsigned long long offset, size_t size);
+
+	/**
+	 * @internal
+	 * Unmaps part of the file mapped with mapFile(). Implemented in the platform specific source files.
+	 *
+	 * @param data The mapped part.
+	 * @param size The size of the part.
+	 */
+	void unmapFile(char* data, size_t size);
+
+	/**
+	 * @internal
+	 * Closes the file. Implemented in the platform specific source files.
+	 */
+	void closeFile();
+
+	// Instance member variables
+	String								_filepath;				/**< @internal The file the log output is written to. */
+	size_t								_segmentSize;			/**< @internal The number of bytes mapped at a time. */
+	intptr_t							_fileHandle;			/**< @internal The file descriptor or handle of the open file. */
+	unsigned long long					_fileSize;				/**< @internal The size of the file. */
+	Segment*							_segments;				/**< @internal Every segment the file can grow to. */
+	boost::atomic<unsigned long long>	_cursor;				/**< @internal The end of the reserved output. */
+	boost::atomic<unsigned long long>	_droppedWriteCount;		/**< @internal The number of writes lost. */
+	boost::mutex						_mappingMutex;			/**< @internal Serializes extending the file and mapping segments. */
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_MAPPED_FILE_LOG_SINK_H
@@ -9,14 +9,25 @@
 #ifndef BUMP_NOTIFICATION_CENTER_H
 #define BUMP_NOTIFICATION_CENTER_H
 
+// C++ headers
+#include <deque>
+#include <string>
+#include <vector>
+
 // Boost headers
 #include <boost/any.hpp>
+#include <boost/atomic.hpp>
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/unordered_map.hpp>
 
 // Bump headers
 #include <bump/Export.h>
+#include <bump/GracePeriod.h>
 #include <bump/NotificationError.h>
 #include <bump/String.h>
 
@@ -242,11 +253,39 @@ protected:
  * @endcode
  *
  * And that's all there is to it! For more information, please see the bumpNotificationCenter example.
+ *
+ * The observers are kept in buckets by notification name, so posting a notification hashes
+ * its name once and only visits the observers registered for it, however many observers of
+ * other notifications there are. Observers of the same notification are notified in the
+ * order they were added.
+ *
+ * Posting never takes a lock. The observers live in an immutable snapshot read through an
+ * atomic pointer, and adding or removing an observer publishes a modified copy of it. The
+ * replaced snapshot and the removed observers are only deleted once every post that started
+ * before the change has finished, tracked by a GracePeriod, so observers can add and remove
+ * observers, themselves included, from their callbacks. Posts starting later never hold up
+ * the deletion. Outside of a callback, removeObserver() also waits for the posts in progress
+ * on other threads, so the removed observers are never notified once it returns.
+ *
+ * Slow observers can be kept off the posting thread with postNotificationAsync() and
+ * postNotificationWithObjectAsync(), which hand the post to a bounded pool of worker threads
+ * and return a future of the number of observers notified. Posts asking for FIFO_DELIVERY
+ * are delivered one at a time in the order they were made, per notification name, and
+ * stopAsyncPosting() delivers whatever is still queued before shutting the pool down. The
+ * destructor runs during static destruction, when the observers may already be gone, so it
+ * discards the posts still queued instead, leaving their futures with a boost::broken_promise.
  */
 class BUMP_EXPORT NotificationCenter
 {
 public:
 
+	/** The order the asynchronous posts of a notification are delivered in. */
+	enum DeliveryOrder
+	{
+		UNORDERED_DELIVERY,		/**< Delivered by whichever worker is free, possibly alongside other posts of the notification. */
+		FIFO_DELIVERY			/**< Delivered one at a time in the order posted, among the posts of the notification asking for it. */
+	};
+
 	/**
 	 * Creates a thread-safe singleton instance of the NotificationCenter object.
 	 *
@@ -290,10 +329,66 @@ public:
 	/**
 	 * Removes the observer from the notification center.
 	 *
+	 * Unless called from an observer callback, waits for the posts in progress on other threads
+	 * to finish so the observer instance can be destroyed right after.
+	 *
 	 * @param observer The observer instance to remove from the notification center.
 	 */
 	void removeObserver(void* observer);
 
+	/**
+	 * Queues the notification to be posted by the worker pool, starting the pool if necessary.
+	 *
+	 * Waits for room when the queue is full, except on the worker threads themselves so observers
+	 * can post asynchronously from their callbacks without blocking the pool.
+	 *
+	 * @param notificationName The notification to post to registered observers.
+	 * @param order The order the posts of the notification are delivered in.
+	 * @return A future holding the number of observers that received the notification, or the
+	 *         exception an observer threw.
+	 */
+	boost::unique_future<unsigned int> postNotificationAsync(const String& notificationName, DeliveryOrder order = UNORDERED_DELIVERY);
+
+	/**
+	 * Queues the notification with the given object to be posted by the worker pool, starting the
+	 * pool if necessary.
+	 *
+	 * The object is copied into the queue. Waits for room when the queue is full, except on the
+	 * worker threads themselves.
+	 *
+	 * @param notificationName The notification to post to registered observers.
+	 * @param object The object to send to the registered observers.
+	 * @param order The order the posts of the notification are delivered in.
+	 * @return A future holding the number of observers that received the notification, or the
+	 *         exception an observer threw.
+	 */
+	boost::unique_future<unsigned int> postNotificationWithObjectAsync(const String& notificationName, const boost::any& object,
+		DeliveryOrder order = UNORDERED_DELIVERY);
+
+	/**
+	 * Sets the size of the worker pool, stopping it first if it is running. 4 workers and 1024 posts by default.
+	 *
+	 * @param workerCount The number of worker threads delivering the asynchronous posts.
+	 * @param queueCapacity The most asynchronous posts waiting or being delivered at once.
+	 */
+	void setAsyncPostingLimits(unsigned int workerCount, unsigned int queueCapacity);
+
+	/**
+	 * Blocks until every asynchronous post queued so far has been delivered.
+	 *
+	 * Must not be called from an observer callback run by the worker pool.
+	 */
+	void waitForAsyncPosts();
+
+	/**
+	 * Delivers every asynchronous post still queued and stops the worker pool.
+	 *
+	 * The pool starts again with the next asynchronous post. The destructor discards the posts
+	 * still queued instead, so call it before exiting while the observers are still around to
+	 * have them delivered. Must not be called from an observer callback run by the worker pool.
+	 */
+	void stopAsyncPosting();
+
 protected:
 
 	/**
@@ -302,10 +397,156 @@ protected:
 	 */
 	~NotificationCenter();
 
+	/** @internal The observers of a notification in the order they were added, never changed once published. */
+	typedef boost::shared_ptr<const std::vector<Observer*> > ObserverList;
+
+	/** @internal The observers of each notification name. */
+	typedef boost::unordered_map<String, ObserverList, boost::hash<std::string> > ObserverMap;
+
+	/** @internal An immutable copy of every registered observer, replaced as a whole by each change. */
+	struct ObserverSnapshot
+	{
+		ObserverMap		keyObservers;		/**< @internal The key observers by notification name. */
+		ObserverMap		objectObservers;	/**< @internal The object observers by notification name. */
+	};
+
+	/** @internal A replaced snapshot and the observers removed along with it, deleted once its grace period ends. */
+	struct Retirement
+	{
+		unsigned long long				stamp;			/**< @internal The grace period stamp taken when it was replaced. */
+		ObserverSnapshot*				snapshot;		/**< @internal The replaced snapshot. */
+		std::vector<Observer*>			observers;		/**< @internal The removed observers. */
+	};
+
+	/** @internal A notification waiting to be posted by the worker pool. */
+	struct AsyncPost
+	{
+		String							notificationName;	/**< @internal The notification to post. */
+		boost::any						object;				/**< @internal The object to send, if any. */
+		bool							hasObject;			/**< @internal Whether the notification is posted with the object. */
+		bool							isOrdered;			/**< @internal Whether the post is delivered in order with the other ordered ones. */
+		boost::promise<unsigned int>	promise;			/**< @internal Set to the number of observers notified. */
+	};
+
+	/** @internal The ordered posts of each notification waiting behind the one queued or being delivered. */
+	typedef boost::unordered_map<String, std::deque<AsyncPost*>, boost::hash<std::string> > OrderedPostMap;
+
+	/**
+	 * @internal
+	 * Holds on to the current snapshot for as long as it's in scope.
+	 */
+	class SnapshotReader
+	{
+	public:
+
+		/**
+		 * @internal
+		 * Constructor entering the grace period and loading the current snapshot.
+		 *
+		 * @param notificationCenter The notification center to read the snapshot of.
+		 */
+		explicit SnapshotReader(NotificationCenter* notificationCenter);
+
+		/**
+		 * @internal
+		 * Destructor leaving the grace period and reclaiming the retired snapshots whose grace period ended.
+		 */
+		~SnapshotReader();
+
+		/**
+		 * @internal
+		 * Returns the snapshot.
+		 *
+		 * @return The snapshot.
+		 */
+		inline const ObserverSnapshot& snapshot() const { return *_snapshot; }
+
+	protected:
+
+		// Instance member variables
+		NotificationCenter*			_notificationCenter;	/**< @internal The notification center being read. */
+		unsigned int				_token;					/**< @internal The token returned by GracePeriod::enter(). */
+		const ObserverSnapshot*		_snapshot;				/**< @internal The snapshot being read. */
+	};
+
+	/**
+	 * @internal
+	 * Returns the observers of the given notification in the map.
+	 *
+	 * Returned as a plain pointer into the snapshot, which the reader keeps alive, so posting
+	 * never touches the reference count of the list.
+	 *
+	 * @param observers The observers by notification name.
+	 * @param notificationName The notification name.
+	 * @return The observers of the notification, NULL if there are none.
+	 */
+	static const std::vector<Observer*>* findObservers(const ObserverMap& observers, const String& notificationName);
+
+	/**
+	 * @internal
+	 * Removes every observer of the given observer instance from a copy of the map.
+	 *
+	 * @param observers The map to remove the observers from.
+	 * @param observer The observer instance to remove.
+	 * @param removedObservers The removed observers are added to the end of it.
+	 */
+	static void removeObserverFrom(ObserverMap& observers, void* observer, std::vector<Observer*>& removedObservers);
+
+	/**
+	 * @internal
+	 * Publishes the given snapshot and retires the previous one along with the removed observers. The mutex must be locked.
+	 *
+	 * @param snapshot The new snapshot.
+	 * @param removedObservers The observers no longer in the new snapshot, deleted along with the previous one.
+	 * @return The grace period stamp of the retirement.
+	 */
+	unsigned long long publishSnapshotLocked(ObserverSnapshot* snapshot, const std::vector<Observer*>& removedObservers);
+
+	/**
+	 * @internal
+	 * Deletes the retired snapshots and observers whose grace period has ended. The mutex must be locked.
+	 */
+	void reclaimRetiredLocked();
+
+	/**
+	 * @internal
+	 * Queues an asynchronous post, starting the worker pool if necessary.
+	 *
+	 * @param post The post to queue, deleted once delivered.
+	 * @return The future of the post.
+	 */
+	boost::unique_future<unsigned int> queueAsyncPost(AsyncPost* post);
+
+	/**
+	 * @internal
+	 * Deletes every asynchronous post not being delivered yet, breaking the promises of their futures.
+	 */
+	void discardAsyncPosts();
+
+	/**
+	 * @internal
+	 * Runs a worker thread of the pool, delivering the queued posts until the pool is stopped.
+	 */
+	void runAsyncWorker();
+
 	// Instance member variables
-	std::vector<Observer*>	_keyObservers;		/**< @internal The list of key observers registered with the NotificationCenter. */
-	std::vector<Observer*>	_objectObservers;	/**< @internal The list of object observers registered with the NotificationCenter. */
-	boost::shared_mutex		_mutex;				/**< @internal A boost mutex used to make the notification center access thread-safe. */
+	boost::atomic<ObserverSnapshot*>	_snapshot;				/**< @internal The current snapshot of the registered observers. */
+	GracePeriod							_gracePeriod;			/**< @internal Tracks the posts in progress reading the snapshots. */
+	std::deque<Retirement>				_retirements;			/**< @internal The replaced snapshots and removed observers posts in progress may still be using, oldest first. */
+	boost::atomic<bool>					_hasRetired;			/**< @internal Whether anything is waiting to be reclaimed. */
+	boost::mutex						_mutex;					/**< @internal A boost mutex serializing adding and removing observers. */
+
+	// Asynchronous posting member variables
+	std::deque<AsyncPost*>				_asyncQueue;			/**< @internal The posts waiting for a worker. */
+	OrderedPostMap						_orderedAsyncPosts;		/**< @internal The ordered posts waiting behind the one of their notification. */
+	unsigned int						_asyncPostCount;		/**< @internal The number of posts queued or being delivered. */
+	unsigned int						_asyncWorkerCount;		/**< @internal The number of worker threads. */
+	unsigned int						_asyncQueueCapacity;	/**< @internal The most posts queued or being delivered at once. */
+	bool								_isStoppingAsyncWorkers;	/**< @internal Whether the workers exit once the queue is empty. */
+	boost::thread_group*				_asyncWorkers;			/**< @internal The worker threads, NULL when the pool isn't running. */
+	boost::mutex						_asyncMutex;			/**< @internal Protects the asynchronous posting member variables. */
+	boost::condition_variable			_asyncWorkCondition;	/**< @internal Wakes the workers when there are posts to deliver. */
+	boost::condition_variable			_asyncIdleCondition;	/**< @internal Wakes the threads waiting for room or for the posts to be delivered. */
 
 private:
 
@@ -365,6 +606,27 @@ BUMP_EXPORT unsigned int POST_NOTIFICATION(const bump::String& notificationName)
  */
 BUMP_EXPORT unsigned int POST_NOTIFICATION_WITH_OBJECT(const bump::String& notificationName, const boost::any& object);
 
+/**
+ * Convenience function for accessing the NotificationCenter singleton's postNotificationAsync() method.
+ *
+ * @param notificationName The notification to post to registered observers.
+ * @param order The order the posts of the notification are delivered in.
+ * @return A future holding the number of observers that received the notification.
+ */
+BUMP_EXPORT boost::unique_future<unsigned int> POST_NOTIFICATION_ASYNC(const bump::String& notificationName,
+	bump::NotificationCenter::DeliveryOrder order = bump::NotificationCenter::UNORDERED_DELIVERY);
+
+/**
+ * Convenience function for accessing the NotificationCenter singleton's postNotificationWithObjectAsync() method.
+ *
+ * @param notificationName The notification to post to registered observers.
+ * @param object The object to send to the registered observers.
+ * @param order The order the posts of the notification are delivered in.
+ * @return A future holding the number of observers that received the notification.
+ */
+BUMP_EXPORT boost::unique_future<unsigned int> POST_NOTIFICATION_WITH_OBJECT_ASYNC(const bump::String& notificationName, const boost::any& object,
+	bump::NotificationCenter::DeliveryOrder order = bump::NotificationCenter::UNORDERED_DELIVERY);
+
 // Pull in the KeyObserver and ObjectObserver template implementations
 #include <bump/NotificationCenter_impl.h>
 
@@ -0,0 +1,99 @@
+//
+//	RingBufferLogSink.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_RING_BUFFER_LOG_SINK_H
+#define BUMP_RING_BUFFER_LOG_SINK_H
+
+// C++ headers
+#include <vector>
+
+// Boost headers
+#include <boost/thread/mutex.hpp>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/LogSink.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * The RingBufferLogSink class keeps the most recent log output in memory.
+ *
+ * The output is written into a fixed size ring, overwriting the oldest output once the
+ * ring is full, so the sink never allocates after construction. This makes it cheap
+ * enough to take every message at DEBUG_LVL and dump the recent history when something
+ * goes wrong, or to look at the output in tests.
+ */
+class BUMP_EXPORT RingBufferLogSink : public LogSink
+{
+public:
+
+	/**
+	 * Constructor.
+	 *
+	 * @param capacity The number of bytes of output kept.
+	 */
+	explicit RingBufferLogSink(size_t capacity = 1024 * 1024);
+
+	/**
+	 * Destructor.
+	 */
+	~RingBufferLogSink();
+
+	/**
+	 * Copies the given buffers into the ring, overwriting the oldest output if necessary.
+	 *
+	 * @param buffers The buffers to write.
+	 * @param bufferCount The number of buffers.
+	 */
+	void write(const Buffer* buffers, unsigned int bufferCount);
+
+	/**
+	 * Returns the output kept in the ring, oldest first.
+	 *
+	 * Once older output has been overwritten, the first line is left out since it may have
+	 * lost its beginning.
+	 *
+	 * @return The output kept in the ring.
+	 */
+	String contents() const;
+
+	/**
+	 * Throws away the output kept in the ring.
+	 */
+	void clear();
+
+	/**
+	 * Returns the number of bytes of output kept.
+	 *
+	 * @return The number of bytes of output kept.
+	 */
+	size_t capacity() const;
+
+	/**
+	 * Returns the number of bytes written to the sink since it was created.
+	 *
+	 * @return The number of bytes written to the sink since it was created.
+	 */
+	unsigned long long totalByteCount() const;
+
+protected:
+
+	// Instance member variables
+	std::vector<char>		_ring;				/**< @internal The ring holding the output. */
+	size_t					_end;				/**< @internal Where the next output is written in the ring. */
+	size_t					_size;				/**< @internal The number of bytes of output in the ring. */
+	unsigned long long		_totalByteCount;	/**< @internal The number of bytes written since creation. */
+	bool					_isOverwritten;		/**< @internal Whether older output has been overwritten since the last clear. */
+	mutable boost::mutex	_mutex;				/**< @internal Guards the ring against concurrent reads. */
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_RING_BUFFER_LOG_SINK_H
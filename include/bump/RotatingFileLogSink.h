@@ -0,0 +1,239 @@
+//
+//	RotatingFileLogSink.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_ROTATING_FILE_LOG_SINK_H
+#define BUMP_ROTATING_FILE_LOG_SINK_H
+
+// C++ headers
+#include <deque>
+
+// Boost headers
+#include <boost/atomic.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/FileDescriptorLogSink.h>
+#include <bump/LogSink.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * The RotatingFileLogSink class writes the log output to a file that is rotated once it
+ * grows too large or once a wall-clock interval has passed.
+ *
+ * The active file always lives at the given filepath. Rotating renames it to the filepath
+ * followed by an increasing index ("app.log.1", "app.log.2", ...), so the highest index is
+ * the most recent file, and continues writing to a fresh file. Only the newest rotated files
+ * are kept, as many as the retention count allows.
+ *
+ * The expensive parts of rotating never run on the logging threads. A background thread
+ * with a lowered priority preallocates the next file ahead of time and compresses the
+ * rotated files with gzip ("app.log.1.gz"), so a rotation only costs two renames and an
+ * open(). Compression requires Bump to be built with zlib, see isCompressionSupported().
+ *
+ * With an index interval, each file gets a time index ("app.log.idx") that is rotated
+ * along with it, see LogIndexWriter. Compressed files can't be read from the middle, so
+ * their indices are removed once they are compressed.
+ */
+class BUMP_EXPORT RotatingFileLogSink : public LogSink
+{
+public:
+
+	/** When the file is rotated and what happens to the rotated files. */
+	struct RotationPolicy
+	{
+		/** Constructor rotating at 100 MB and keeping the 10 newest compressed files. */
+		RotationPolicy() :
+			maxFileSize(100 * 1024 * 1024),
+			intervalSeconds(0),
+			retentionCount(10),
+			preallocationSize(0),
+			isCompressionEnabled(true),
+			indexInterval(0)
+		{
+			;
+		}
+
+		unsigned long long	maxFileSize;			/**< The size in bytes that rotates the file, 0 for no limit. */
+		unsigned int		intervalSeconds;		/**< The wall-clock interval rotating the file at each multiple of it since the epoch, 0 for none. */
+		unsigned int		retentionCount;			/**< The number of rotated files kept, 0 to keep them all. */
+		unsigned long long	preallocationSize;		/**< The disk space reserved for the next file ahead of time, 0 for none. */
+		bool				isCompressionEnabled;	/**< Whether the rotated files are compressed with gzip. */
+		unsigned long long	indexInterval;			/**< The bytes between the entries of the time index kept next to each file, 0 for none. */
+	};
+
+	/**
+	 * Constructor opening the given file for appending, creating it if necessary.
+	 *
+	 * Rotated files left over from earlier runs count towards the retention and their
+	 * indices are continued.
+	 *
+	 * @param filepath The file to write the log output to.
+	 * @param policy When the file is rotated and what happens to the rotated files.
+	 * @throw bump::FileSystemError When the file cannot be opened.
+	 */
+	explicit RotatingFileLogSink(const String& filepath, const RotationPolicy& policy = RotationPolicy());
+
+	/**
+	 * Destructor waits for the background thread to finish compressing the rotated files.
+	 */
+	~RotatingFileLogSink();
+
+	/**
+	 * Writes the given buffers to the active file, rotating it first if necessary.
+	 *
+	 * @param buffers The buffers to write.
+	 * @param bufferCount The number of buffers.
+	 */
+	void write(const Buffer* buffers, unsigned int bufferCount);
+
+	/**
+	 * Rotates the active file right away unless it is empty.
+	 *
+	 * @throw bump::FileSystemError When the new file cannot be opened.
+	 */
+	void rotate();
+
+	/**
+	 * Blocks until the background thread has compressed and pruned all the rotated files.
+	 */
+	void waitForBackgroundWork();
+
+	/**
+	 * Returns the file the log output is written to.
+	 *
+	 * @return The file the log output is written to.
+	 */
+	const String& filepath() const;
+
+	/**
+	 * Returns the rotation policy.
+	 *
+	 * @return The rotation policy.
+	 */
+	const RotationPolicy& rotationPolicy() const;
+
+	/**
+	 * Returns the number of times the file has been rotated by this sink.
+	 *
+	 * @return The number of times the file has been rotated by this sink.
+	 */
+	unsigned int rotationCount() const;
+
+	/**
+	 * Returns whether Bump was built with zlib and can compress the rotated files.
+	 *
+	 * @return Whether Bump was built with zlib and can compress the rotated files.
+	 */
+	static bool isCompressionSupported();
+
+protected:
+
+	/** @internal The state of the preallocated next file. */
+	enum NextFileState
+	{
+		NO_NEXT_FILE,
+		PREPARING_NEXT_FILE,
+		NEXT_FILE_READY
+	};
+
+	/**
+	 * @internal
+	 * Rotates the active file, the mutex must be locked.
+	 */
+	void rotateLocked();
+
+	/**
+	 * @internal
+	 * Returns the start of the rotation interval containing the given time.
+	 *
+	 * @param seconds The seconds since the Unix epoch.
+	 * @return The start of the rotation interval containing the given time, 0 without an interval.
+	 */
+	long long intervalStart(long long seconds) const;
+
+	/**
+	 * @internal
+	 * Returns the path of the rotated file with the given index.
+	 *
+	 * @param index The index of the rotated file.
+	 * @return The path of the rotated file with the given index.
+	 */
+	String rotatedFilepath(unsigned int index) const;
+
+	/**
+	 * @internal
+	 * Finds the rotated files left over from earlier runs.
+	 */
+	void findRotatedFiles();
+
+	/**
+	 * @internal
+	 * Creates the next file and reserves the preallocation size for it on disk.
+	 *
+	 * Implemented in the platform specific source files.
+	 *
+	 * @param filepath The file to create.
+	 * @param size The disk space to reserve.
+	 * @return True if the file was created, false otherwise.
+	 */
+	static bool preallocateFile(const String& filepath, unsigned long long size);
+
+	/**
+	 * @internal
+	 * Lowers the scheduling priority of the calling thread as far as possible.
+	 *
+	 * Implemented in the platform specific source files.
+	 */
+	static void lowerCurrentThreadPriority();
+
+	/**
+	 * @internal
+	 * Compresses the given file with gzip and removes it.
+	 *
+	 * @param filepath The file to compress.
+	 * @return True if the file was compressed, false otherwise.
+	 */
+	static bool compressFile(const String& filepath);
+
+	/**
+	 * @internal
+	 * Runs the background thread compressing and pruning the rotated files.
+	 */
+	void runBackgroundThread();
+
+	// Instance member variables
+	String								_filepath;				/**< @internal The file the log output is written to. */
+	String								_nextFilepath;			/**< @internal The preallocated file the next rotation switches to. */
+	RotationPolicy						_policy;				/**< @internal When the file is rotated. */
+	FileDescriptorLogSink*				_fileSink;				/**< @internal The sink writing to the active file. */
+	unsigned long long					_fileSize;				/**< @internal The size of the active file. */
+	long long							_intervalStart;			/**< @internal The start of the rotation interval of the active file. */
+	unsigned int						_nextIndex;				/**< @internal The index given to the next rotated file. */
+	boost::atomic<unsigned int>			_rotationCount;			/**< @internal The number of rotations. */
+	boost::atomic<NextFileState>		_nextFileState;			/**< @internal The state of the preallocated next file. */
+	boost::mutex						_mutex;					/**< @internal Serializes writing and rotating. */
+
+	// Background thread member variables
+	std::deque<unsigned int>			_rotatedIndices;		/**< @internal The indices of the kept rotated files, oldest first. */
+	std::deque<unsigned int>			_compressionQueue;		/**< @internal The indices of the rotated files waiting to be compressed. */
+	bool								_isNextFileRequested;	/**< @internal Whether the next file should be preallocated. */
+	bool								_isBackgroundThreadBusy;	/**< @internal Whether the background thread is working on a request. */
+	bool								_isBackgroundThreadStopping;	/**< @internal Whether the background thread should exit. */
+	boost::mutex						_backgroundMutex;		/**< @internal Protects the background thread requests. */
+	boost::condition_variable			_backgroundCondition;	/**< @internal Wakes the background thread and its waiters. */
+	boost::thread*						_backgroundThread;		/**< @internal The thread compressing and pruning the rotated files. */
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_ROTATING_FILE_LOG_SINK_H
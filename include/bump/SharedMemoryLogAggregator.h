@@ -0,0 +1,114 @@
+//
+//	SharedMemoryLogAggregator.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_SHARED_MEMORY_LOG_AGGREGATOR_H
+#define BUMP_SHARED_MEMORY_LOG_AGGREGATOR_H
+
+// Boost headers
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/LogSink.h>
+#include <bump/SharedMemoryLogRing.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * The SharedMemoryLogAggregator class drains the log output of a group of processes into a single sink.
+ *
+ * The aggregator creates the shared memory ring the SharedMemoryLogSinks of the group
+ * publish into, and a thread writing the records to the given sink in the order they were
+ * reserved. The thread polls the ring, backing off up to a millisecond while it's empty,
+ * so publishing never has to wake anyone up. The sink is flushed whenever the ring runs
+ * empty. Only one process may aggregate a ring, and it should be started before the
+ * processes publishing into it.
+ *
+ * @code
+ *   // In the designated process
+ *   bump::RotatingFileLogSink file("/var/log/app.log");
+ *   bump::SharedMemoryLogAggregator aggregator("app-log", file);
+ *
+ *   // In every process of the group, including the designated one
+ *   bump::SharedMemoryLogSink sink("app-log");
+ *   bump::Log::instance()->addLogSink(sink);
+ * @endcode
+ */
+class BUMP_EXPORT SharedMemoryLogAggregator
+{
+public:
+
+	/**
+	 * Constructor creating the ring and starting the thread draining it.
+	 *
+	 * @param name The name of the ring, without any leading slash.
+	 * @param sink The sink the records are written to, which must outlive the aggregator.
+	 * @param capacity The number of bytes of records the ring holds.
+	 * @throw bump::FileSystemError When the ring cannot be created.
+	 */
+	SharedMemoryLogAggregator(const String& name, LogSink& sink, size_t capacity = 16 * 1024 * 1024);
+
+	/**
+	 * Destructor draining what is left in the ring, stopping the thread and removing the ring.
+	 */
+	~SharedMemoryLogAggregator();
+
+	/**
+	 * Blocks until every record reserved before the call has been written to the sink and the sink flushed.
+	 */
+	void flush();
+
+	/**
+	 * Returns the ring being drained.
+	 *
+	 * @return The ring being drained.
+	 */
+	const SharedMemoryLogRing& ring() const;
+
+protected:
+
+	/**
+	 * @internal
+	 * Runs the thread draining the ring into the sink.
+	 */
+	void runDrainThread();
+
+	// Instance member variables
+	SharedMemoryLogRing				_ring;				/**< @internal The ring being drained. */
+	LogSink&						_sink;				/**< @internal The sink the records are written to. */
+	unsigned long long				_flushedSize;		/**< @internal The number of bytes of the ring written to the sink and flushed. */
+	bool							_isStopping;		/**< @internal Whether the drain thread should exit once the ring is empty. */
+	boost::mutex					_mutex;				/**< @internal Protects the flushed size and the stopping flag. */
+	boost::condition_variable		_condition;			/**< @internal Wakes the drain thread and the flush waiters. */
+	boost::thread*					_drainThread;		/**< @internal The thread draining the ring. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since the aggregator can't be copied.
+	 */
+	SharedMemoryLogAggregator(const SharedMemoryLogAggregator& aggregator);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since the aggregator can't be copied.
+	 */
+	void operator=(const SharedMemoryLogAggregator& aggregator);
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_SHARED_MEMORY_LOG_AGGREGATOR_H
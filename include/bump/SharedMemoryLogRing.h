@@ -0,0 +1,325 @@
+//
+//	SharedMemoryLogRing.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_SHARED_MEMORY_LOG_RING_H
+#define BUMP_SHARED_MEMORY_LOG_RING_H
+
+// C++ headers
+#include <cstdint>
+
+// Boost headers
+#include <boost/atomic/ipc_atomic.hpp>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/LogSink.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * The SharedMemoryLogRing class is a ring of log records in a named shared memory segment.
+ *
+ * Any number of threads in any number of processes can publish records into the ring
+ * while the single process that created it takes them off in order. Publishing reserves
+ * room for the record with a compare-and-swap on a cursor in the segment and copies the
+ * record straight into it, so it never takes a lock, makes a system call or waits on the
+ * consumer. When the ring is full the record is dropped and counted instead.
+ *
+ * Each record starts with a 16 byte header holding the length of the record along with the
+ * id of the publishing process and, once the record has been copied, the position it was
+ * published at. The consumer only takes a record off the ring once its header says it is
+ * complete, so records are never torn or interleaved with each other. A publisher that dies
+ * partway through a record would stall the ring, so once a record has stayed incomplete
+ * for a few seconds the consumer checks whether its publisher is still running and only
+ * skips the record, counting it as lost, once it is gone. A slow publisher is waited on for
+ * as long as it takes, since handing its room to another record would let it overwrite it.
+ *
+ * Until a publisher has stored the length, the record itself can't say who it belongs to.
+ * So before reserving the room a publisher claims one of the publisher slots in the segment
+ * and announces its process and the position it is about to reserve there, and it frees
+ * the slot once the length is stored. When every slot is taken the record is dropped too.
+ *
+ * The cursors are boost::ipc_atomic values, which work across processes because they are
+ * lock-free. The segment is a POSIX shared memory object on Unix and a named file mapping
+ * in the session namespace on Windows, and it goes away along with the ring that created it.
+ */
+class BUMP_EXPORT SharedMemoryLogRing
+{
+public:
+
+	/** The magic bytes every segment starts with. */
+	static const char MAGIC[8];
+
+	/** The number of publishers that can be reserving a record at the same time. */
+	static const unsigned int PUBLISHER_SLOT_COUNT = 64;
+
+	/** The size of the cursors, counters and publisher slots at the start of the segment. */
+	static const size_t HEADER_SIZE = 256 + PUBLISHER_SLOT_COUNT * 16;
+
+	/** The size of the header in front of every record. */
+	static const size_t RECORD_HEADER_SIZE = 16;
+
+	/**
+	 * Constructor creating the segment with the given name, replacing any left behind by a crash.
+	 *
+	 * @param name The name of the segment, without any leading slash.
+	 * @param capacity The number of bytes of records the ring holds, rounded up to a multiple of 64 KB.
+	 * @throw bump::FileSystemError When the segment cannot be created or mapped.
+	 */
+	SharedMemoryLogRing(const String& name, size_t capacity);
+
+	/**
+	 * Constructor opening the segment created by another ring with the given name.
+	 *
+	 * @param name The name of the segment, without any leading slash.
+	 * @throw bump::FileSystemError When the segment does not exist or is not a log ring.
+	 */
+	explicit SharedMemoryLogRing(const String& name);
+
+	/**
+	 * Destructor unmapping the segment, and removing it if this ring created it.
+	 */
+	~SharedMemoryLogRing();
+
+	/**
+	 * Publishes the given buffers as a single record.
+	 *
+	 * Safe to call from any number of threads in any number of processes at once.
+	 *
+	 * @param buffers The buffers making up the record.
+	 * @param bufferCount The number of buffers.
+	 * @return True if the record was published, false if it was dropped because the ring or every publisher slot is full, or it's over 4 GB.
+	 */
+	bool publish(const LogSink::Buffer* buffers, unsigned int bufferCount);
+
+	/**
+	 * Writes the complete records at the front of the ring to the given sink and frees their room.
+	 *
+	 * Must only be called by the ring that created the segment, and from a single thread at a time.
+	 *
+	 * @param sink The sink to write the records to.
+	 * @return The number of records taken off the ring, including the skipped ones.
+	 */
+	size_t consume(LogSink& sink);
+
+	/**
+	 * Returns the name of the segment.
+	 *
+	 * @return The name of the segment.
+	 */
+	const String& name() const;
+
+	/**
+	 * Returns the number of bytes of records the ring holds.
+	 *
+	 * @return The number of bytes of records the ring holds.
+	 */
+	size_t capacity() const;
+
+	/**
+	 * Returns whether this ring created the segment and is the one consuming it.
+	 *
+	 * @return Whether this ring created the segment.
+	 */
+	bool isOwner() const;
+
+	/**
+	 * Returns the total number of bytes reserved by all publishers so far.
+	 *
+	 * @return The total number of bytes reserved by all publishers so far.
+	 */
+	unsigned long long reservedSize() const;
+
+	/**
+	 * Returns the total number of bytes taken off the ring so far.
+	 *
+	 * @return The total number of bytes taken off the ring so far.
+	 */
+	unsigned long long consumedSize() const;
+
+	/**
+	 * Returns the number of records dropped by all publishers because the ring was full.
+	 *
+	 * @return The number of records dropped because the ring was full.
+	 */
+	unsigned long long droppedRecordCount() const;
+
+	/**
+	 * Returns the number of records skipped because their publisher never completed them.
+	 *
+	 * @return The number of records skipped because their publisher never completed them.
+	 */
+	unsigned long long lostRecordCount() const;
+
+protected:
+
+	/** @internal A publisher between reserving a record and storing its length. */
+	struct PublisherSlot
+	{
+		boost::ipc_atomic<uint64_t>		processId;			/**< @internal The process of the publisher, zero when the slot is free. */
+		boost::ipc_atomic<uint64_t>		position;			/**< @internal The position the publisher is reserving a record at. */
+	};
+
+	/** @internal The start of the segment, with the cursors written by different processes on their own cache lines. */
+	struct Header
+	{
+		char							magic[8];			/**< @internal The magic bytes, written last. */
+		unsigned long long				capacity;			/**< @internal The number of bytes of records. */
+		char							padding0[48];		/**< @internal Padding up to the next cache line. */
+		boost::ipc_atomic<uint64_t>		reserveCursor;		/**< @internal The end of the reserved records. */
+		char							padding1[56];		/**< @internal Padding up to the next cache line. */
+		boost::ipc_atomic<uint64_t>		readCursor;			/**< @internal The end of the records taken off the ring. */
+		char							padding2[56];		/**< @internal Padding up to the next cache line. */
+		boost::ipc_atomic<uint64_t>		droppedCount;		/**< @internal The number of records dropped by publishers. */
+		boost::ipc_atomic<uint64_t>		lostCount;			/**< @internal The number of records skipped by the consumer. */
+		char							padding3[48];		/**< @internal Padding up to the publisher slots. */
+		PublisherSlot					publishers[PUBLISHER_SLOT_COUNT];	/**< @internal The publishers reserving records. */
+	};
+
+	/**
+	 * @internal
+	 * Claims a publisher slot and reserves room for a record, announcing the position in the slot first.
+	 *
+	 * @param length The length of the record.
+	 * @param position Set to the position of the reserved record.
+	 * @param slot Set to the claimed publisher slot, to be passed on to writeRecord().
+	 * @return True if the room was reserved, false if the record was dropped.
+	 */
+	bool reserveRecord(unsigned long long length, uint64_t& position, PublisherSlot*& slot);
+
+	/**
+	 * @internal
+	 * Stores the length of a reserved record, frees its publisher slot and copies the buffers into it.
+	 *
+	 * @param position The position of the reserved record.
+	 * @param slot The publisher slot claimed by reserveRecord().
+	 * @param length The length of the record.
+	 * @param buffers The buffers making up the record.
+	 * @param bufferCount The number of buffers.
+	 */
+	void writeRecord(uint64_t position, PublisherSlot* slot, unsigned long long length,
+		const LogSink::Buffer* buffers, unsigned int bufferCount);
+
+	/**
+	 * @internal
+	 * Returns whether the publisher of the record at the given position, which never wrote its length, may still write it.
+	 *
+	 * The slots of the announcing processes that are gone are freed along the way.
+	 *
+	 * @param position The position of the record without a length.
+	 * @return False only once every process that announced the position is gone.
+	 */
+	bool isPublisherRunning(unsigned long long position);
+
+	/**
+	 * @internal
+	 * Frees the publisher slots still claimed by the given process, which is gone.
+	 *
+	 * @param processId The id of the process.
+	 */
+	void freePublisherSlots(uint32_t processId);
+
+	/**
+	 * @internal
+	 * Zeroes a range of the ring so the headers of the next lap start out incomplete.
+	 *
+	 * @param start The position the range starts at.
+	 * @param end The position the range ends at.
+	 */
+	void clearRange(unsigned long long start, unsigned long long end);
+
+	/**
+	 * @internal
+	 * Returns the position of the first record after the one at the given position, which never wrote its length.
+	 *
+	 * A record without a length was never copied either, so its room is still zeroed and the next
+	 * record is the first one after it with a length.
+	 *
+	 * @param position The position of the record without a length.
+	 * @param reserved The end of the reserved records.
+	 * @return The position of the next record with a length, or the given position if there is none yet.
+	 */
+	unsigned long long findNextRecord(unsigned long long position, unsigned long long reserved) const;
+
+	/**
+	 * @internal
+	 * Returns the id of the calling process. Implemented in the platform specific source files.
+	 *
+	 * @return The id of the calling process.
+	 */
+	static uint32_t currentProcessId();
+
+	/**
+	 * @internal
+	 * Returns whether the given process is still running. Implemented in the platform specific source files.
+	 *
+	 * @param processId The id of the process.
+	 * @return True if the process is still running or can't be checked, false if it is gone.
+	 */
+	static bool isProcessRunning(uint32_t processId);
+
+	/**
+	 * @internal
+	 * Creates the segment, replacing any existing one. Implemented in the platform specific source files.
+	 *
+	 * @param size The size of the segment.
+	 * @throw bump::FileSystemError When the segment cannot be created or mapped.
+	 */
+	void createSegment(size_t size);
+
+	/**
+	 * @internal
+	 * Opens and maps the existing segment. Implemented in the platform specific source files.
+	 *
+	 * @param size Set to the size of the segment.
+	 * @throw bump::FileSystemError When the segment cannot be opened or mapped.
+	 */
+	void openSegment(size_t& size);
+
+	/**
+	 * @internal
+	 * Unmaps and closes the segment, removing it if owned. Implemented in the platform specific source files.
+	 */
+	void closeSegment();
+
+	// Instance member variables
+	String					_name;				/**< @internal The name of the segment. */
+	size_t					_capacity;			/**< @internal The number of bytes of records. */
+	bool					_isOwner;			/**< @internal Whether this ring created the segment. */
+	intptr_t				_segmentHandle;		/**< @internal The file descriptor or handle of the segment. */
+	char*					_segment;			/**< @internal The mapped segment. */
+	size_t					_segmentSize;		/**< @internal The size of the mapped segment. */
+	Header*					_header;			/**< @internal The header at the start of the segment. */
+	char*					_records;			/**< @internal The records following the header. */
+	uint32_t				_processId;			/**< @internal The id of this process, written into the records it publishes. */
+	unsigned long long		_stallPosition;		/**< @internal The position of the incomplete record the consumer is waiting on. */
+	long long				_stallStart;		/**< @internal When the consumer started waiting on it in microseconds. */
+
+private:
+
+	/**
+	 * @internal
+	 * Copy constructor.
+	 *
+	 * No-op since the ring can't be copied.
+	 */
+	SharedMemoryLogRing(const SharedMemoryLogRing& ring);
+
+	/**
+	 * @internal
+	 * Overloaded assignment operator.
+	 *
+	 * No-op since the ring can't be copied.
+	 */
+	void operator=(const SharedMemoryLogRing& ring);
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_SHARED_MEMORY_LOG_RING_H
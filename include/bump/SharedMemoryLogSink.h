@@ -0,0 +1,92 @@
+//
+//	SharedMemoryLogSink.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_SHARED_MEMORY_LOG_SINK_H
+#define BUMP_SHARED_MEMORY_LOG_SINK_H
+
+// Boost headers
+#include <boost/atomic.hpp>
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/LogSink.h>
+#include <bump/SharedMemoryLogRing.h>
+#include <bump/String.h>
+
+namespace bump {
+
+/**
+ * The SharedMemoryLogSink class publishes the log output into a shared memory ring drained by another process.
+ *
+ * Every process of a group logs through one of these sinks into the ring created by the
+ * SharedMemoryLogAggregator of a single designated process, which writes everything to
+ * its own sinks. Only the aggregator opens the log files, so the group needs one file
+ * descriptor instead of one per process, and since every write lands in the ring as a
+ * single record the lines of different processes are never torn or interleaved.
+ *
+ * Writing never blocks. A write that doesn't fit in the room left in the ring is dropped
+ * and counted in droppedWriteCount(), as is every write larger than the whole ring.
+ */
+class BUMP_EXPORT SharedMemoryLogSink : public LogSink
+{
+public:
+
+	/**
+	 * Constructor opening the ring created by the aggregator with the given name.
+	 *
+	 * @param name The name of the ring.
+	 * @throw bump::FileSystemError When the ring does not exist.
+	 */
+	explicit SharedMemoryLogSink(const String& name);
+
+	/**
+	 * Destructor.
+	 */
+	~SharedMemoryLogSink();
+
+	/**
+	 * Publishes the buffers into the ring as a single record.
+	 *
+	 * Safe to call from any number of threads at once.
+	 *
+	 * @param buffers The buffers to write.
+	 * @param bufferCount The number of buffers.
+	 */
+	void write(const Buffer* buffers, unsigned int bufferCount);
+
+	/**
+	 * Returns true since concurrent writes each reserve their own record in the ring.
+	 *
+	 * @return True.
+	 */
+	bool isThreadSafe() const;
+
+	/**
+	 * Returns the ring the log output is published into.
+	 *
+	 * @return The ring the log output is published into.
+	 */
+	const SharedMemoryLogRing& ring() const;
+
+	/**
+	 * Returns the number of writes of this sink dropped because the ring was full.
+	 *
+	 * @return The number of writes dropped because the ring was full.
+	 */
+	unsigned long long droppedWriteCount() const;
+
+protected:
+
+	// Instance member variables
+	SharedMemoryLogRing					_ring;					/**< @internal The ring the log output is published into. */
+	boost::atomic<unsigned long long>	_droppedWriteCount;		/**< @internal The number of writes dropped. */
+};
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_SHARED_MEMORY_LOG_SINK_H
@@ -180,6 +180,26 @@ public:
 	 */
 	static String join(const StringList& strings, const String& separator);
 
+	/**
+	 * Creates a UTF-8 encoded string from the given UTF-16 code units.
+	 *
+	 * @throw bump::TypeCastError When the UTF-16 data contains an unpaired surrogate.
+	 *
+	 * @param utf16String The UTF-16 code units to convert.
+	 * @return A new UTF-8 encoded string.
+	 */
+	static String fromUtf16(const std::u16string& utf16String);
+
+	/**
+	 * Creates a UTF-8 encoded string from the given UTF-32 code points.
+	 *
+	 * @throw bump::TypeCastError When a code point is a surrogate or larger than U+10FFFF.
+	 *
+	 * @param utf32String The UTF-32 code points to convert.
+	 * @return A new UTF-8 encoded string.
+	 */
+	static String fromUtf32(const std::u32string& utf32String);
+
 	/**
 	 * Appends the given string onto the end of this string.
 	 *
@@ -429,6 +449,16 @@ public:
 	 */
 	void clear();
 
+	/**
+	 * Computes the number of Unicode code points in this string when interpreted as UTF-8.
+	 *
+	 * NOTE: The string is not validated first, every byte that is not a UTF-8 continuation
+	 * byte is counted. Use isValidUtf8() beforehand if the contents are untrusted.
+	 *
+	 * @return The number of code points in this string.
+	 */
+	int codePointCount() const;
+
 	/**
 	 * Compares the content of the this string with the given string.
 	 *
@@ -582,6 +612,17 @@ public:
 	 */
 	bool isNumber() const;
 
+	/**
+	 * Determines whether the string contains well-formed UTF-8.
+	 *
+	 * Overlong encodings, surrogate code points, code points larger than U+10FFFF and
+	 * truncated sequences are all rejected. Large strings are validated 32 bytes at a
+	 * time using vectorized lookup tables when available.
+	 *
+	 * @return True if the string is valid UTF-8, false otherwise.
+	 */
+	bool isValidUtf8() const;
+
 	/**
 	 * Finds the position of the last occurrence of indexString in this string by searching
 	 * backwards from the startPosition. If startPosition is -1 (default), the search starts
@@ -928,6 +969,24 @@ public:
 	 */
 	unsigned short toUShort() const;
 
+	/**
+	 * Converts this UTF-8 string to UTF-16 code units.
+	 *
+	 * @throw bump::TypeCastError When this string is not valid UTF-8.
+	 *
+	 * @return The UTF-16 representation of the string.
+	 */
+	std::u16string toUtf16() const;
+
+	/**
+	 * Converts this UTF-8 string to UTF-32 code points.
+	 *
+	 * @throw bump::TypeCastError When this string is not valid UTF-8.
+	 *
+	 * @return The UTF-32 representation of the string.
+	 */
+	std::u32string toUtf32() const;
+
 	/**
 	 * Generates a string that has all whitespace removed from the start and end.
 	 *
@@ -1056,8 +1115,23 @@ public:
 	 * @return The modified version of this string.
 	 */
 	String& operator << (bool appendBool);
+
+protected:
+
+	/**
+	 * @internal
+	 * Throws an out of range error for the inline accessors.
+	 *
+	 * Kept out of line so the inline accessors stay small enough to inline everywhere.
+	 *
+	 * @throw bump::OutOfRangeError Always.
+	 */
+	static void throwOutOfRangeError();
 };
 
 }	// End of bump namespace
 
+// Pull in the inline accessor implementations
+#include <bump/String_impl.h>
+
 #endif	// End of BUMP_STRING_H
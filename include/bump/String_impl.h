@@ -0,0 +1,51 @@
+//
+//	String_impl.h
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_STRING_IMPL_H
+#define BUMP_STRING_IMPL_H
+
+namespace bump {
+
+//====================================================================================
+//                                 Inline Accessors
+//====================================================================================
+
+inline const char& String::at(int position) const
+{
+	// Casting to the unsigned size type also rejects negative positions
+	if (static_cast<size_type>(position) >= std::string::size())
+	{
+		throwOutOfRangeError();
+	}
+
+	return std::string::operator[](position);
+}
+
+inline const char* String::c_str() const
+{
+	return std::string::c_str();
+}
+
+inline const char* String::data() const
+{
+	return std::string::data();
+}
+
+inline bool String::isEmpty() const
+{
+	return std::string::empty();
+}
+
+inline int String::length() const
+{
+	return (int)std::string::length();
+}
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_STRING_IMPL_H
@@ -0,0 +1,70 @@
+//
+//	Version.h
+//	Bump
+//
+//	Created by Christian Noon on 11/7/12.
+//	Copyright (c) 2012 Christian Noon. All rights reserved.
+//
+
+#ifndef BUMP_VERSION_H
+#define BUMP_VERSION_H
+
+// Bump headers
+#include <bump/Export.h>
+#include <bump/String.h>
+
+#define BUMP_MAJOR_VERSION	  1
+#define BUMP_MINOR_VERSION	  2
+#define BUMP_PATCH_VERSION	  2
+#define BUMP_SO_VERSION		  17
+
+namespace bump {
+
+/**
+ * Returns the library version number.
+ *
+ * The number convention is as follows:
+ *    - Bump-1.0.2 will return "1.0.2".
+ *
+ * @return The version of the bump library as a string.
+ */
+BUMP_EXPORT String version();
+
+/**
+ * Returns the library's major version number.
+ *
+ * @return The major version of the bump library as a string.
+ */
+BUMP_EXPORT String majorVersion();
+
+/**
+ * Returns the library's minor version number.
+ *
+ * @return The minor version of the bump library as a string.
+ */
+BUMP_EXPORT String minorVersion();
+
+/**
+ * Returns the library's patch version number.
+ *
+ * @return The patch version of the bump library as a string.
+ */
+BUMP_EXPORT String patchVersion();
+
+/**
+ * Returns the library's so version number.
+ *
+ * @return The so version of the bump library as a string.
+ */
+BUMP_EXPORT String soVersion();
+
+/**
+ * Returns the library name in human-friendly form.
+ *
+ * @return The library name in human-friendly form.
+ */
+BUMP_EXPORT String libraryName();
+
+}	// End of bump namespace
+
+#endif	// End of BUMP_VERSION_H
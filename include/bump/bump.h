@@ -10,19 +10,40 @@
 #define BUMP_BUMP_H
 
 #include <bump/AutoTimer.h>
+#include <bump/BinaryLogReader.h>
+#include <bump/Cpu.h>
 #include <bump/Environment.h>
 #include <bump/Exception.h>
 #include <bump/Export.h>
+#include <bump/FileDescriptorLogSink.h>
 #include <bump/FileInfo.h>
 #include <bump/FileSystem.h>
 #include <bump/FileSystemError.h>
+#include <bump/GracePeriod.h>
 #include <bump/InvalidArgumentError.h>
+#include <bump/LockFreeQueue.h>
+#include <bump/LockFreeQueue_impl.h>
 #include <bump/Log.h>
+#include <bump/LogArgument.h>
+#include <bump/LogCallSite.h>
+#include <bump/LogField.h>
+#include <bump/LogFlightRecorder.h>
+#include <bump/Logger.h>
+#include <bump/LogIndexWriter.h>
+#include <bump/LogLimiter.h>
+#include <bump/LogReader.h>
+#include <bump/LogSink.h>
+#include <bump/MappedFileLogSink.h>
 #include <bump/NotificationCenter.h>
 #include <bump/NotificationCenter_impl.h>
 #include <bump/NotificationError.h>
 #include <bump/NotImplementedError.h>
 #include <bump/OutOfRangeError.h>
+#include <bump/RingBufferLogSink.h>
+#include <bump/RotatingFileLogSink.h>
+#include <bump/SharedMemoryLogAggregator.h>
+#include <bump/SharedMemoryLogRing.h>
+#include <bump/SharedMemoryLogSink.h>
 #include <bump/String.h>
 #include <bump/StringSearchError.h>
 #include <bump/Timeline.h>
@@ -0,0 +1,200 @@
+//
+//	BinaryLogReader.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <cstring>
+
+// Bump headers
+#include <bump/BinaryLogReader.h>
+#include <bump/FileSystemError.h>
+
+namespace bump {
+
+namespace // local
+{
+	// Reads the raw bytes of a value, returning NULL if there aren't enough
+	template <typename T>
+	const char* readRaw(const char* data, const char* end, T& value)
+	{
+		if (!data || static_cast<size_t>(end - data) < sizeof(T))
+		{
+			return NULL;
+		}
+
+		std::memcpy(&value, data, sizeof(T));
+		return data + sizeof(T);
+	}
+
+	// Reads a 4 byte length followed by that many characters
+	const char* readString(const char* data, const char* end, String& value)
+	{
+		unsigned int length = 0;
+		data = readRaw(data, end, length);
+		if (!data || static_cast<size_t>(end - data) < length)
+		{
+			return NULL;
+		}
+
+		value.assign(data, length);
+		return data + length;
+	}
+
+}	// End of local namespace
+
+const char BinaryLogReader::MAGIC[8] = { 'B', 'U', 'M', 'P', 'L', 'O', 'G', '1' };
+
+BinaryLogReader::BinaryLogReader(const String& filepath) :
+	_file(filepath.c_str(), std::ios::in | std::ios::binary),
+	_ticksPerMicrosecond(1.0),
+	_baseTicks(0),
+	_baseTime(0)
+{
+	if (!_file)
+	{
+		String msg = String("The following binary log could not be opened: %1").arg(filepath);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	// Check the magic and read the initial calibration
+	char header[sizeof(MAGIC) + sizeof(double) + sizeof(unsigned long long) + sizeof(long long)];
+	if (!_file.read(header, sizeof(header)) || std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		String msg = String("The following file is not a binary log: %1").arg(filepath);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	const char* position = header + sizeof(MAGIC);
+	const char* end = header + sizeof(header);
+	position = readRaw(position, end, _ticksPerMicrosecond);
+	position = readRaw(position, end, _baseTicks);
+	readRaw(position, end, _baseTime);
+}
+
+BinaryLogReader::~BinaryLogReader()
+{
+	;
+}
+
+bool BinaryLogReader::readMessage(BinaryLogMessage& message)
+{
+	unsigned char type = 0;
+	while (readEntry(type))
+	{
+		if (type == CALL_SITE_ENTRY)
+		{
+			readCallSite();
+		}
+		else if (type == CALIBRATION_ENTRY)
+		{
+			const char* position = _payload.data();
+			const char* end = position + _payload.size();
+			unsigned long long ticks = 0;
+			long long time = 0;
+			position = readRaw(position, end, ticks);
+			if (readRaw(position, end, time))
+			{
+				_baseTicks = ticks;
+				_baseTime = time;
+			}
+		}
+		else if (type == RECORD_ENTRY && readRecord(message))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool BinaryLogReader::readEntry(unsigned char& type)
+{
+	char header[1 + sizeof(unsigned int)];
+	if (!_file.read(header, sizeof(header)))
+	{
+		return false;
+	}
+
+	unsigned int size = 0;
+	std::memcpy(&size, header + 1, sizeof(size));
+	type = static_cast<unsigned char>(header[0]);
+
+	_payload.resize(size);
+	return size == 0 || _file.read(&_payload[0], size);
+}
+
+void BinaryLogReader::readCallSite()
+{
+	const char* position = _payload.data();
+	const char* end = position + _payload.size();
+
+	unsigned int id = 0;
+	unsigned char level = 0;
+	CallSite call_site;
+	position = readRaw(position, end, id);
+	position = readRaw(position, end, level);
+	position = readRaw(position, end, call_site.line);
+	position = readString(position, end, call_site.file);
+	position = readString(position, end, call_site.format);
+	if (!position || id == 0)
+	{
+		return;
+	}
+
+	call_site.level = static_cast<Log::LogLevel>(level);
+	if (_callSites.size() < id)
+	{
+		_callSites.resize(id);
+	}
+	_callSites[id - 1] = call_site;
+}
+
+bool BinaryLogReader::readRecord(BinaryLogMessage& message)
+{
+	const char* position = _payload.data();
+	const char* end = position + _payload.size();
+
+	unsigned int id = 0;
+	unsigned long long ticks = 0;
+	unsigned char argument_count = 0;
+	position = readRaw(position, end, id);
+	position = readRaw(position, end, ticks);
+	position = readString(position, end, message.text);
+	position = readRaw(position, end, argument_count);
+	if (!position || id == 0 || id > _callSites.size())
+	{
+		return false;
+	}
+
+	// The decoded string arguments point into the payload
+	_arguments.clear();
+	for (unsigned int i = 0; i < argument_count; ++i)
+	{
+		LogArgument argument(0);
+		position = LogArgument::decode(position, end, argument);
+		if (!position)
+		{
+			return false;
+		}
+		_arguments.push_back(argument);
+	}
+
+	// The text already holds the prefix, so the message is formatted after it
+	const CallSite& call_site = _callSites[id - 1];
+	Log::formatMessage(message.text, call_site.format.c_str(), _arguments.empty() ? NULL : &_arguments[0],
+		argument_count);
+
+	// Convert the counter value relative to the latest calibration
+	double elapsed_ticks = static_cast<double>(static_cast<long long>(ticks - _baseTicks));
+	message.time = _baseTime + static_cast<long long>(elapsed_ticks / _ticksPerMicrosecond);
+	message.level = call_site.level;
+	message.file = call_site.file;
+	message.line = call_site.line;
+	return true;
+}
+
+}	// End of bump namespace
@@ -0,0 +1,236 @@
+//
+//	Cpu.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <iostream>
+
+// Bump headers
+#include <bump/Cpu.h>
+#include <bump/Environment.h>
+
+// CPUID headers
+#if defined(BUMP_CPU_X86) && defined(_MSC_VER)
+	#include <intrin.h>
+#elif defined(BUMP_CPU_X86)
+	#include <cpuid.h>
+#endif
+
+namespace bump {
+
+namespace Cpu {
+
+namespace // local
+{
+#ifdef BUMP_CPU_X86
+
+	// Fills registers with EAX, EBX, ECX and EDX of the given CPUID leaf and subleaf
+	void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int registers[4])
+	{
+#ifdef _MSC_VER
+		__cpuidex(reinterpret_cast<int*>(registers), leaf, subleaf);
+#else
+		__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+	}
+
+	// Returns the XCR0 register which tells which register states the OS saves on a context switch
+	unsigned long long xgetbv()
+	{
+#ifdef _MSC_VER
+		return _xgetbv(0);
+#else
+		unsigned int eax, edx;
+		__asm__ __volatile__("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+		return ((unsigned long long)edx << 32) | eax;
+#endif
+	}
+
+	// Detects the features of the host processor with CPUID
+	unsigned int detectFeatures()
+	{
+		unsigned int registers[4] = { 0 };
+		cpuid(0, 0, registers);
+		unsigned int max_leaf = registers[0];
+		if (max_leaf < 1)
+		{
+			return 0;
+		}
+
+		unsigned int features = 0;
+		cpuid(1, 0, registers);
+		bool has_ssse3 = (registers[2] & (1 << 9)) != 0;
+		bool has_sse41 = (registers[2] & (1 << 19)) != 0;
+		bool has_sse42 = (registers[2] & (1 << 20)) != 0;
+		bool has_osxsave = (registers[2] & (1 << 27)) != 0;
+		bool has_avx = (registers[2] & (1 << 28)) != 0;
+		if (has_ssse3 && has_sse41 && has_sse42)
+		{
+			features |= SSE42_FEATURE;
+		}
+
+		// The vector registers can only be used if the OS saves them on a context switch
+		unsigned long long xcr0 = has_osxsave ? xgetbv() : 0;
+		bool os_saves_ymm = (xcr0 & 0x06) == 0x06;
+		bool os_saves_zmm = (xcr0 & 0xE6) == 0xE6;
+
+		if (max_leaf >= 7)
+		{
+			cpuid(7, 0, registers);
+			unsigned int ebx = registers[1];
+			if (has_avx && os_saves_ymm && (ebx & (1 << 5)))
+			{
+				features |= AVX2_FEATURE;
+			}
+
+			// AVX-512 F, BW and VL
+			unsigned int avx512_bits = (1u << 16) | (1u << 30) | (1u << 31);
+			if ((features & AVX2_FEATURE) && os_saves_zmm && (ebx & avx512_bits) == avx512_bits)
+			{
+				features |= AVX512_FEATURE;
+			}
+
+			if ((features & SSE42_FEATURE) && (ebx & (1 << 29)))
+			{
+				features |= SHA_FEATURE;
+			}
+
+			if (ebx & (1 << 8))
+			{
+				features |= BMI2_FEATURE;
+			}
+		}
+
+		return features;
+	}
+
+#else
+
+	// Detects the features of the host processor, of which there are none on this architecture
+	unsigned int detectFeatures()
+	{
+		return 0;
+	}
+
+#endif
+
+	// Returns the features that are not above the given kernel level
+	unsigned int featuresForKernelLevel(KernelLevel level)
+	{
+		switch (level)
+		{
+			case SCALAR_KERNEL:
+				return 0;
+			case SSE42_KERNEL:
+				return SSE42_FEATURE | SHA_FEATURE | BMI2_FEATURE;
+			case AVX2_KERNEL:
+				return SSE42_FEATURE | SHA_FEATURE | BMI2_FEATURE | AVX2_FEATURE;
+			default:
+				return SSE42_FEATURE | SHA_FEATURE | BMI2_FEATURE | AVX2_FEATURE | AVX512_FEATURE;
+		}
+	}
+
+	// Detects the features and applies the "BUMP_CPU_KERNEL_LEVEL" environment variable
+	unsigned int detectAllowedFeatures()
+	{
+		unsigned int detected_features = detectFeatures();
+
+		String kernel_level = bump::Environment::environmentVariable(BUMP_CPU_KERNEL_LEVEL);
+		if (kernel_level == "SCALAR_KERNEL")
+		{
+			std::cout << "[bump] Setting BUMP_CPU_KERNEL_LEVEL to SCALAR" << std::endl;
+			return detected_features & featuresForKernelLevel(SCALAR_KERNEL);
+		}
+		else if (kernel_level == "SSE42_KERNEL")
+		{
+			std::cout << "[bump] Setting BUMP_CPU_KERNEL_LEVEL to SSE42" << std::endl;
+			return detected_features & featuresForKernelLevel(SSE42_KERNEL);
+		}
+		else if (kernel_level == "AVX2_KERNEL")
+		{
+			std::cout << "[bump] Setting BUMP_CPU_KERNEL_LEVEL to AVX2" << std::endl;
+			return detected_features & featuresForKernelLevel(AVX2_KERNEL);
+		}
+		else if (kernel_level == "AVX512_KERNEL")
+		{
+			std::cout << "[bump] Setting BUMP_CPU_KERNEL_LEVEL to AVX512" << std::endl;
+			return detected_features & featuresForKernelLevel(AVX512_KERNEL);
+		}
+		else if (!kernel_level.empty())
+		{
+			std::cout << "[bump] WARNING: Your BUMP_CPU_KERNEL_LEVEL environment variable: [" << kernel_level
+				<< "] does not match any of the possible options: [ SCALAR_KERNEL | SSE42_KERNEL | AVX2_KERNEL "
+				<< "| AVX512_KERNEL ]" << std::endl;
+		}
+
+		return detected_features;
+	}
+
+}	// End of local namespace
+
+String featureString()
+{
+	unsigned int allowed_features = features();
+	String feature_string;
+	if (allowed_features & SSE42_FEATURE)
+	{
+		feature_string += "SSE4.2 ";
+	}
+	if (allowed_features & AVX2_FEATURE)
+	{
+		feature_string += "AVX2 ";
+	}
+	if (allowed_features & AVX512_FEATURE)
+	{
+		feature_string += "AVX-512 ";
+	}
+	if (allowed_features & SHA_FEATURE)
+	{
+		feature_string += "SHA ";
+	}
+	if (allowed_features & BMI2_FEATURE)
+	{
+		feature_string += "BMI2 ";
+	}
+
+	return feature_string.trimmed();
+}
+
+unsigned int features()
+{
+	// Thread-safe one time initialization
+	static const unsigned int allowed_features = detectAllowedFeatures();
+	return allowed_features;
+}
+
+bool hasFeature(Feature feature)
+{
+	return (features() & feature) != 0;
+}
+
+KernelLevel kernelLevel()
+{
+	unsigned int allowed_features = features();
+	if (allowed_features & AVX512_FEATURE)
+	{
+		return AVX512_KERNEL;
+	}
+	else if (allowed_features & AVX2_FEATURE)
+	{
+		return AVX2_KERNEL;
+	}
+	else if (allowed_features & SSE42_FEATURE)
+	{
+		return SSE42_KERNEL;
+	}
+
+	return SCALAR_KERNEL;
+}
+
+}	// End of Cpu namespace
+
+}	// End of bump namespace
@@ -0,0 +1,55 @@
+//
+//	FileDescriptorLogSink.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/FileDescriptorLogSink.h>
+
+namespace bump {
+
+FileDescriptorLogSink::FileDescriptorLogSink(int fileDescriptor, bool closeOnDestruction) :
+	_fileDescriptor(fileDescriptor),
+	_closeOnDestruction(closeOnDestruction),
+	_writeCallCount(0),
+	_indexWriter(NULL)
+{
+	;
+}
+
+FileDescriptorLogSink::~FileDescriptorLogSink()
+{
+	// Write out what is left in the stream while write() can still be called
+	stream().flush();
+	close();
+	delete _indexWriter;
+}
+
+void FileDescriptorLogSink::write(const Buffer* buffers, unsigned int bufferCount)
+{
+	writeBuffers(buffers, bufferCount);
+	if (_indexWriter)
+	{
+		_indexWriter->add(buffers, bufferCount);
+	}
+}
+
+int FileDescriptorLogSink::fileDescriptor() const
+{
+	return _fileDescriptor;
+}
+
+unsigned long long FileDescriptorLogSink::writeCallCount() const
+{
+	return _writeCallCount;
+}
+
+const LogIndexWriter* FileDescriptorLogSink::indexWriter() const
+{
+	return _indexWriter;
+}
+
+}	// End of bump namespace
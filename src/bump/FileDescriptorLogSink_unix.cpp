@@ -0,0 +1,114 @@
+//
+//	FileDescriptorLogSink_unix.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/FileDescriptorLogSink.h>
+#include <bump/FileSystemError.h>
+
+// Unix headers
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace bump {
+
+namespace // local
+{
+	// The number of buffers handed to each writev() call, well below any IOV_MAX
+	const unsigned int MAX_WRITE_VECTORS = 256;
+
+}	// End of local namespace
+
+FileDescriptorLogSink::FileDescriptorLogSink(const String& filepath, bool append, unsigned long long indexInterval) :
+	_fileDescriptor(-1),
+	_closeOnDestruction(true),
+	_writeCallCount(0),
+	_indexWriter(NULL)
+{
+	int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC);
+	_fileDescriptor = ::open(filepath.c_str(), flags, 0644);
+	if (_fileDescriptor < 0)
+	{
+		String msg = String("The following log file could not be opened: %1").arg(filepath);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	if (indexInterval > 0)
+	{
+		try
+		{
+			_indexWriter = new LogIndexWriter(filepath, indexInterval, append);
+		}
+		catch (const FileSystemError& /*e*/)
+		{
+			close();
+			throw;
+		}
+	}
+}
+
+void FileDescriptorLogSink::writeBuffers(const Buffer* buffers, unsigned int bufferCount)
+{
+	struct iovec vectors[MAX_WRITE_VECTORS];
+	unsigned int index = 0;
+	size_t offset = 0;
+	while (index < bufferCount)
+	{
+		// Gather the unwritten rest of the buffers
+		int vector_count = 0;
+		for (unsigned int i = index; i < bufferCount && vector_count < static_cast<int>(MAX_WRITE_VECTORS); ++i)
+		{
+			size_t skipped = i == index ? offset : 0;
+			if (buffers[i].size > skipped)
+			{
+				vectors[vector_count].iov_base = const_cast<char*>(buffers[i].data + skipped);
+				vectors[vector_count].iov_len = buffers[i].size - skipped;
+				++vector_count;
+			}
+		}
+
+		if (vector_count == 0)
+		{
+			break;
+		}
+
+		ssize_t written = ::writev(_fileDescriptor, vectors, vector_count);
+		++_writeCallCount;
+		if (written < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			return;
+		}
+
+		// Skip past everything the kernel accepted, which may end partway through a buffer
+		size_t remaining = static_cast<size_t>(written);
+		while (index < bufferCount && remaining >= buffers[index].size - offset)
+		{
+			remaining -= buffers[index].size - offset;
+			offset = 0;
+			++index;
+		}
+		offset += remaining;
+	}
+}
+
+void FileDescriptorLogSink::close()
+{
+	if (_closeOnDestruction && _fileDescriptor >= 0)
+	{
+		::close(_fileDescriptor);
+		_fileDescriptor = -1;
+	}
+}
+
+}	// End of bump namespace
@@ -0,0 +1,80 @@
+//
+//	FileDescriptorLogSink_win.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/FileDescriptorLogSink.h>
+#include <bump/FileSystemError.h>
+
+// Windows headers
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+
+namespace bump {
+
+FileDescriptorLogSink::FileDescriptorLogSink(const String& filepath, bool append, unsigned long long indexInterval) :
+	_fileDescriptor(-1),
+	_closeOnDestruction(true),
+	_writeCallCount(0),
+	_indexWriter(NULL)
+{
+	int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : _O_TRUNC);
+	_fileDescriptor = ::_open(filepath.c_str(), flags, _S_IREAD | _S_IWRITE);
+	if (_fileDescriptor < 0)
+	{
+		String msg = String("The following log file could not be opened: %1").arg(filepath);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	if (indexInterval > 0)
+	{
+		try
+		{
+			_indexWriter = new LogIndexWriter(filepath, indexInterval, append);
+		}
+		catch (const FileSystemError& /*e*/)
+		{
+			close();
+			throw;
+		}
+	}
+}
+
+void FileDescriptorLogSink::writeBuffers(const Buffer* buffers, unsigned int bufferCount)
+{
+	// There is no writev() on Windows, so each buffer gets its own calls
+	for (unsigned int i = 0; i < bufferCount; ++i)
+	{
+		const char* data = buffers[i].data;
+		size_t remaining = buffers[i].size;
+		while (remaining > 0)
+		{
+			unsigned int chunk_size = remaining > 0x40000000 ? 0x40000000 : static_cast<unsigned int>(remaining);
+			int written = ::_write(_fileDescriptor, data, chunk_size);
+			++_writeCallCount;
+			if (written <= 0)
+			{
+				return;
+			}
+
+			data += written;
+			remaining -= static_cast<size_t>(written);
+		}
+	}
+}
+
+void FileDescriptorLogSink::close()
+{
+	if (_closeOnDestruction && _fileDescriptor >= 0)
+	{
+		::_close(_fileDescriptor);
+		_fileDescriptor = -1;
+	}
+}
+
+}	// End of bump namespace
@@ -0,0 +1,131 @@
+//
+//	GracePeriod.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/GracePeriod.h>
+
+namespace bump {
+
+namespace // local
+{
+	// The slot index given to the next thread that enters a grace period
+	boost::atomic<unsigned int> gNextSlotIndex(0);
+
+}	// End of local namespace
+
+GracePeriod::GracePeriod() :
+	_generation(0),
+	_waiterCount(0)
+{
+	for (unsigned int i = 0; i < SLOT_COUNT; ++i)
+	{
+		_slots[i].counts[0] = 0;
+		_slots[i].counts[1] = 0;
+	}
+}
+
+GracePeriod::~GracePeriod()
+{
+	;
+}
+
+unsigned int GracePeriod::enter()
+{
+	static thread_local unsigned int slot_index = gNextSlotIndex.fetch_add(1, boost::memory_order_relaxed) % SLOT_COUNT;
+
+	// Counting the reader before it reads the state means a writer that sees no readers
+	// afterwards knows the reader can only see the new state
+	unsigned int phase = static_cast<unsigned int>(_generation.load() & 1);
+	_slots[slot_index].counts[phase].fetch_add(1);
+	return slot_index * 2 + phase;
+}
+
+void GracePeriod::leave(unsigned int token)
+{
+	// Only the readers of the previous phase hold up the generation, so they alone wake the waiters
+	unsigned int phase = token & 1;
+	if (_slots[token / 2].counts[phase].fetch_sub(1) == 1 && _waiterCount.load() != 0 &&
+		phase != static_cast<unsigned int>(_generation.load() & 1))
+	{
+		boost::mutex::scoped_lock lock(_mutex);
+		_condition.notify_all();
+	}
+}
+
+unsigned long long GracePeriod::retire()
+{
+	return _generation.load();
+}
+
+bool GracePeriod::hasElapsed(unsigned long long stamp)
+{
+	if (_generation.load() >= stamp + 2)
+	{
+		return true;
+	}
+
+	// Another thread moving the generation on is as good as doing it here
+	boost::unique_lock<boost::mutex> lock(_mutex, boost::try_to_lock);
+	if (lock.owns_lock())
+	{
+		advanceLocked();
+	}
+
+	return _generation.load() >= stamp + 2;
+}
+
+void GracePeriod::waitFor(unsigned long long stamp)
+{
+	++_waiterCount;
+	{
+		boost::mutex::scoped_lock lock(_mutex);
+		advanceLocked();
+		while (_generation.load() < stamp + 2)
+		{
+			_condition.wait(lock);
+			advanceLocked();
+		}
+	}
+	--_waiterCount;
+}
+
+void GracePeriod::wait()
+{
+	waitFor(retire());
+}
+
+void GracePeriod::advanceLocked()
+{
+	// Two steps are all it takes for any grace period started so far to end
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		unsigned long long generation = _generation.load();
+		if (hasReaders(static_cast<unsigned int>((generation + 1) & 1)))
+		{
+			return;
+		}
+
+		_generation.store(generation + 1);
+		_condition.notify_all();
+	}
+}
+
+bool GracePeriod::hasReaders(unsigned int phase) const
+{
+	for (unsigned int i = 0; i < SLOT_COUNT; ++i)
+	{
+		if (_slots[i].counts[phase].load() != 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+}	// End of bump namespace
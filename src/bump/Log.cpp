@@ -7,28 +7,555 @@
 //
 
 // C++ headers
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <ctime>
 #include <fstream>
 
 // Boost headers
+#include <boost/bind/bind.hpp>
+#include <boost/chrono/system_clocks.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 // Bump headers
+#include <bump/BinaryLogReader.h>
 #include <bump/Environment.h>
+#include <bump/FileDescriptorLogSink.h>
+#include <bump/LockFreeQueue.h>
 #include <bump/Log.h>
+#include <bump/LogFlightRecorder.h>
+#include <bump/Logger.h>
+
+// Timestamp counter headers
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define BUMP_HAS_TIMESTAMP_COUNTER
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+	#define BUMP_HAS_TIMESTAMP_COUNTER
+#endif
 
 namespace bump {
 
-// Global singleton mutex
-static boost::mutex gLogSingletonMutex;
+/**
+ * The messages a thread has buffered while buffered logging is enabled.
+ *
+ * Buffers are only deleted along with the log. When a thread exits, its buffer is released
+ * for the next new thread to take over, and anything left in it goes out with the next batch.
+ */
+struct LogThreadBuffer
+{
+	boost::mutex				mutex;		/**< Locked by the owning thread while appending and by batches while swapping. */
+	String						data;		/**< The formatted messages waiting to be written. */
+	String						pending;	/**< The messages swapped out for the batch being written. */
+	boost::atomic<bool>			isInUse;	/**< Whether a thread currently owns the buffer. */
+	LogThreadBuffer*			next;		/**< The next buffer in the list. */
+};
+
+/**
+ * Write latencies counted with relaxed atomics and added up into a Log::LatencyHistogram when read.
+ */
+struct LogLatencyCounters
+{
+	boost::atomic<unsigned long long>	bucketCounts[Log::LatencyHistogram::BUCKET_COUNT];	/**< The number of writes in each bucket. */
+	boost::atomic<unsigned long long>	totalNanoseconds;		/**< The time taken by all the writes. */
+	boost::atomic<unsigned long long>	maxNanoseconds;			/**< The time taken by the slowest write. */
+
+	/** Constructor for counters without any writes. */
+	LogLatencyCounters() : totalNanoseconds(0), maxNanoseconds(0)
+	{
+		for (unsigned int i = 0; i < Log::LatencyHistogram::BUCKET_COUNT; ++i)
+		{
+			bucketCounts[i].store(0, boost::memory_order_relaxed);
+		}
+	}
+
+	/** Counts a write that took the given time. */
+	void add(unsigned long long nanoseconds)
+	{
+		// Bucket i holds the writes under 2^i microseconds
+		unsigned long long microseconds = nanoseconds / 1000;
+		unsigned int bucket = 0;
+		while (microseconds > 0 && bucket < Log::LatencyHistogram::BUCKET_COUNT - 1)
+		{
+			microseconds >>= 1;
+			++bucket;
+		}
+
+		bucketCounts[bucket].fetch_add(1, boost::memory_order_relaxed);
+		totalNanoseconds.fetch_add(nanoseconds, boost::memory_order_relaxed);
+		unsigned long long max_nanoseconds = maxNanoseconds.load(boost::memory_order_relaxed);
+		while (nanoseconds > max_nanoseconds &&
+			!maxNanoseconds.compare_exchange_weak(max_nanoseconds, nanoseconds, boost::memory_order_relaxed))
+		{
+			// max_nanoseconds was reloaded, try again
+		}
+	}
+
+	/** Adds the counted writes to the histogram. */
+	void addTo(Log::LatencyHistogram& histogram) const
+	{
+		for (unsigned int i = 0; i < Log::LatencyHistogram::BUCKET_COUNT; ++i)
+		{
+			unsigned long long count = bucketCounts[i].load(boost::memory_order_relaxed);
+			histogram.bucketCounts[i] += count;
+			histogram.count += count;
+		}
+
+		histogram.totalNanoseconds += totalNanoseconds.load(boost::memory_order_relaxed);
+		histogram.maxNanoseconds = std::max(histogram.maxNanoseconds, maxNanoseconds.load(boost::memory_order_relaxed));
+	}
+};
+
+/**
+ * What a thread has logged, counted by that thread alone and added up by Log::statistics().
+ *
+ * Like the thread buffers, they are only deleted along with the log. When a thread exits,
+ * its statistics are released for the next new thread to take over and keep counting.
+ */
+struct LogThreadStatistics
+{
+	boost::atomic<unsigned long long>	recordCounts[5];		/**< The number of messages logged at each level. */
+	boost::atomic<unsigned long long>	filteredCount;			/**< The number of messages nothing took. */
+	boost::atomic<unsigned long long>	writtenByteCount;		/**< The number of bytes written to the log stream or the binary log. */
+	boost::atomic<unsigned long long>	blockedCount;			/**< The number of waits for a lock or a full queue. */
+	boost::atomic<unsigned long long>	blockedNanoseconds;		/**< The time spent waiting. */
+	LogLatencyCounters					streamLatency;			/**< How long the writes to the log stream took. */
+	boost::atomic<bool>					isInUse;				/**< Whether a thread currently owns the statistics. */
+	LogThreadStatistics*				next;					/**< The next statistics in the list. */
+
+	/** Constructor for statistics without anything counted. */
+	LogThreadStatistics() : filteredCount(0), writtenByteCount(0), blockedCount(0), blockedNanoseconds(0),
+		streamLatency(), isInUse(false), next(NULL)
+	{
+		for (unsigned int i = 0; i < 5; ++i)
+		{
+			recordCounts[i].store(0, boost::memory_order_relaxed);
+		}
+	}
+};
+
+/**
+ * A formatted message queued for a threaded sink.
+ *
+ * The records live in the queue cells and their text is swapped in and out of them, so once the
+ * queue has warmed up the buffers only circulate and queueing a message never allocates.
+ */
+struct LogSinkRecord
+{
+	String		text;		/**< The formatted message. */
+};
+
+/**
+ * A sink added to the log along with its options and, for threaded sinks, its queue and worker thread.
+ */
+struct LogSinkEntry
+{
+	LogSink*							sink;					/**< The sink. */
+	Log::SinkOptions					options;				/**< Which messages the sink receives. */
+	boost::mutex						mutex;					/**< Locked while writing to the sink. */
+	LockFreeQueue<LogSinkRecord>*		queue;					/**< The messages waiting for the worker thread, NULL when not threaded. */
+	boost::thread*						thread;					/**< The worker thread, NULL when not threaded. */
+	boost::mutex						threadMutex;			/**< A boost mutex used with the thread and flush conditions. */
+	boost::condition_variable			threadCondition;		/**< Signaled when messages are queued for a waiting worker thread. */
+	boost::condition_variable			flushCondition;			/**< Signaled when the worker thread has written a batch, waking flushes and blocked writers. */
+	boost::atomic<bool>					isThreadWaiting;		/**< Whether the worker thread is waiting for messages. */
+	boost::atomic<bool>					isThreadStopping;		/**< Whether the worker thread should exit once the queue is empty. */
+	boost::atomic<unsigned long long>	enqueuedCount;			/**< The number of messages pushed onto the queue. */
+	boost::atomic<unsigned long long>	completedCount;			/**< The number of queued messages written or dropped. */
+	boost::atomic<unsigned long long>	writtenByteCount;		/**< The number of bytes written to the sink. */
+	LogLatencyCounters					writeLatency;			/**< How long the writes to the sink took. */
+
+	/** Returns whether the sink takes messages with the given level and prefix. */
+	bool accepts(Log::LogLevel logLevel, const String& prefix) const
+	{
+		return logLevel <= options.logLevel && (options.prefixFilter.empty() || prefix.startsWith(options.prefixFilter));
+	}
+};
+
+namespace // local
+{
+	// The level checks inline in Log_impl.h that are still exported
+	struct InlineLevelChecks
+	{
+		bool (Log::*isLogEnabled)();
+		bool (Log::*isLogLevelEnabled)(Log::LogLevel);
+		Log::LogLevel (Log::*logLevel)();
+	};
+
+	BUMP_KEEP_INLINE_SYMBOLS const InlineLevelChecks gInlineLevelChecks = { &Log::isLogEnabled, &Log::isLogLevelEnabled, &Log::logLevel };
+
+	// Set once the log is destroyed, after which exiting threads must leave their buffers alone
+	boost::atomic<bool> gAreThreadBuffersDestroyed(false);
+
+	// Releases the calling thread's log buffer when the thread exits
+	struct ThreadBufferOwner
+	{
+		LogThreadBuffer* buffer;
+
+		~ThreadBufferOwner()
+		{
+			if (buffer && !gAreThreadBuffersDestroyed)
+			{
+				buffer->isInUse = false;
+			}
+		}
+	};
+
+	// Returns the owner of the calling thread's log buffer
+	ThreadBufferOwner& threadBufferOwner()
+	{
+		static thread_local ThreadBufferOwner owner = { NULL };
+		return owner;
+	}
+
+	// Set once the log is destroyed, after which exiting threads must leave their statistics alone
+	boost::atomic<bool> gAreThreadStatisticsDestroyed(false);
+
+	// Releases the calling thread's statistics when the thread exits
+	struct ThreadStatisticsOwner
+	{
+		LogThreadStatistics* statistics;
+
+		~ThreadStatisticsOwner()
+		{
+			if (statistics && !gAreThreadStatisticsDestroyed)
+			{
+				statistics->isInUse = false;
+			}
+		}
+	};
+
+	// Returns the owner of the calling thread's statistics
+	ThreadStatisticsOwner& threadStatisticsOwner()
+	{
+		static thread_local ThreadStatisticsOwner owner = { NULL };
+		return owner;
+	}
+
+	// Adds to a counter only its owning thread writes, which needs no read-modify-write
+	void addToCounter(boost::atomic<unsigned long long>& counter, unsigned long long value)
+	{
+		counter.store(counter.load(boost::memory_order_relaxed) + value, boost::memory_order_relaxed);
+	}
+
+	// Returns the steady clock in nanoseconds, used to time writes and waits
+	unsigned long long steadyNanoseconds()
+	{
+		boost::chrono::steady_clock::duration since_epoch = boost::chrono::steady_clock::now().time_since_epoch();
+		return boost::chrono::duration_cast<boost::chrono::nanoseconds>(since_epoch).count();
+	}
+
+	// The call sites of the messages logged through the convenience functions, one per log level
+	LogCallSite gMessageCallSites[] =
+	{
+		LogCallSite("", 0),
+		LogCallSite("", 0),
+		LogCallSite("", 0),
+		LogCallSite("", 0),
+		LogCallSite("", 0)
+	};
+
+	// The binary log buffer size at which the records are written
+	const size_t BINARY_BUFFER_THRESHOLD = 65536;
+
+	// Returns the CPU timestamp counter, or the steady clock in nanoseconds without one
+	unsigned long long readTimestampCounter()
+	{
+#ifdef BUMP_HAS_TIMESTAMP_COUNTER
+		return __rdtsc();
+#else
+		return steadyNanoseconds();
+#endif
+	}
+
+	// Measures how fast the timestamp counter runs against the system clock
+	double measureTicksPerMicrosecond()
+	{
+		unsigned long long start_ticks = readTimestampCounter();
+		long long start_time = Log::currentTimestamp();
+		boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+		unsigned long long end_ticks = readTimestampCounter();
+		long long end_time = Log::currentTimestamp();
+
+		if (end_time <= start_time || end_ticks <= start_ticks)
+		{
+			return 1.0;
+		}
+
+		return static_cast<double>(end_ticks - start_ticks) / static_cast<double>(end_time - start_time);
+	}
+
+	// Appends the raw bytes of the value
+	template <typename T>
+	void appendRaw(std::string& output, const T& value)
+	{
+		output.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	// Appends a 4 byte length followed by the characters
+	void appendRawString(std::string& output, const char* characters, size_t length)
+	{
+		appendRaw(output, static_cast<unsigned int>(length));
+		output.append(characters, length);
+	}
+
+	// Starts a binary log entry, returning where it starts so endEntry() can fill in its size
+	size_t beginEntry(std::string& output, BinaryLogReader::EntryType type)
+	{
+		size_t start = output.size();
+		output.push_back(static_cast<char>(type));
+		appendRaw(output, static_cast<unsigned int>(0));
+		return start;
+	}
+
+	// Fills in the payload size of the entry started at the given position
+	void endEntry(std::string& output, size_t start)
+	{
+		unsigned int size = static_cast<unsigned int>(output.size() - start - 1 - sizeof(unsigned int));
+		std::memcpy(&output[start + 1], &size, sizeof(size));
+	}
+
+	// Appends the definition of a registered call site
+	void appendCallSiteEntry(std::string& output, const LogCallSite& callSite)
+	{
+		size_t start = beginEntry(output, BinaryLogReader::CALL_SITE_ENTRY);
+		appendRaw(output, callSite.id.load(boost::memory_order_relaxed));
+		output.push_back(static_cast<char>(callSite.level));
+		appendRaw(output, callSite.line);
+		appendRawString(output, callSite.file, std::strlen(callSite.file));
+		appendRawString(output, callSite.format, std::strlen(callSite.format));
+		endEntry(output, start);
+	}
+
+	// Appends the current counter value and the time it was read at
+	void appendCalibration(std::string& output)
+	{
+		appendRaw(output, readTimestampCounter());
+		appendRaw(output, Log::currentTimestamp());
+	}
+
+	// Returns the calling thread's buffer for encoding binary log records
+	String& threadBinaryBuffer()
+	{
+		static thread_local String buffer;
+		return buffer;
+	}
+
+	// Returns the calling thread's buffer for formatting deferred-argument messages
+	String& threadFormatBuffer()
+	{
+		static thread_local String buffer;
+		return buffer;
+	}
+
+	// Returns the calling thread's buffer for formatting messages for the synchronous sinks
+	String& threadSinkBuffer()
+	{
+		static thread_local String buffer;
+		return buffer;
+	}
+
+	// Returns the calling thread's buffer for encoding messages for the synchronous JSON sinks
+	String& threadJsonSinkBuffer()
+	{
+		static thread_local String buffer;
+		return buffer;
+	}
+
+	// The number of Log::SinkFormat values
+	const int SINK_FORMAT_COUNT = 2;
+
+	// The level names written to the JSON sinks, indexed by Log::LogLevel
+	const char* const JSON_LEVEL_NAMES[] = { "ALWAYS", "ERROR", "WARNING", "INFO", "DEBUG" };
+
+	// The most messages a sink worker thread writes in a single batch
+	const unsigned int MAX_SINK_BATCH_SIZE = 256;
+
+	// Copies a formatted message into a queue cell, reusing the capacity the cell already has
+	struct FillSinkRecord
+	{
+		const LogSink::Buffer& buffer;
+
+		void operator()(LogSinkRecord& record) const
+		{
+			static_cast<std::string&>(record.text).assign(buffer.data, buffer.size);
+		}
+	};
+
+	// Moves a queued message out of its cell. The string buffers trade places, so both sides keep their capacity.
+	struct SwapSinkRecord
+	{
+		String& text;
+
+		void operator()(LogSinkRecord& record) const
+		{
+			text.swap(record.text);
+		}
+	};
+
+	// Drops a queued message, leaving its buffer in the cell for the next one
+	struct DiscardSinkRecord
+	{
+		void operator()(LogSinkRecord& /*record*/) const
+		{
+			;
+		}
+	};
+
+	// The timestamp last formatted on a thread. The date and time only change once a second,
+	// so in between only the fraction of a second is patched into the text.
+	struct TimestampCache
+	{
+		long long second;				// The seconds since the epoch the text was formatted for
+		int settings;					// The format, precision and time zone the text was formatted with
+		size_t fractionOffset;			// Where the fraction of a second starts in the text
+		unsigned int fractionDigits;	// The number of fraction digits, 0 for whole seconds
+		size_t length;					// The number of characters in the text
+		char text[48];					// The formatted timestamp
+	};
+
+	// Returns the calling thread's timestamp cache
+	TimestampCache& threadTimestampCache()
+	{
+		static thread_local TimestampCache cache = { LLONG_MIN, -1, 0, 0, 0, { 0 } };
+		return cache;
+	}
+
+	// Writes the value as exactly digitCount zero padded digits and returns the end
+	char* writeDigits(char* output, unsigned int value, unsigned int digitCount)
+	{
+		for (unsigned int i = digitCount; i > 0; --i)
+		{
+			output[i - 1] = static_cast<char>('0' + value % 10);
+			value /= 10;
+		}
+
+		return output + digitCount;
+	}
+
+	// Breaks the seconds since the epoch down into the UTC or local calendar time
+	void breakDownTime(std::time_t seconds, bool utc, std::tm& time)
+	{
+#ifdef _WIN32
+		bool success = (utc ? gmtime_s(&time, &seconds) : localtime_s(&time, &seconds)) == 0;
+#else
+		bool success = (utc ? gmtime_r(&seconds, &time) : localtime_r(&seconds, &time)) != NULL;
+#endif
+		if (!success)
+		{
+			std::memset(&time, 0, sizeof(time));
+			time.tm_mday = 1;
+		}
+	}
+
+	// Returns the offset of the given local time from UTC in minutes
+	int utcOffsetInMinutes(std::time_t seconds, const std::tm& localTime)
+	{
+		std::tm utc_time;
+		breakDownTime(seconds, true, utc_time);
+
+		// The two can only be a day apart, which may also cross a year boundary
+		int day_difference = localTime.tm_yday - utc_time.tm_yday;
+		if (localTime.tm_year != utc_time.tm_year)
+		{
+			day_difference = localTime.tm_year < utc_time.tm_year ? -1 : 1;
+		}
+
+		return day_difference * 1440 + (localTime.tm_hour - utc_time.tm_hour) * 60 + localTime.tm_min - utc_time.tm_min;
+	}
+
+	// Copies a message into a queued log record, reusing the record's string capacity
+	struct FillLogRecord
+	{
+		Log::LogLevel level;
+		long long time;
+		const String& prefix;
+		const String& message;
+		bool newline;
+
+		void operator()(LogRecord& record) const
+		{
+			record.level = level;
+			record.time = time;
+			record.prefix.assign(prefix);
+			record.message.assign(message);
+			record.newline = newline;
+		}
+	};
+
+	// Swaps a queued log record out of its cell so the cell is released before any writing.
+	// The string buffers trade places, so both sides keep their capacity.
+	struct SwapLogRecord
+	{
+		LogRecord& record;
+
+		void operator()(LogRecord& queuedRecord) const
+		{
+			record.level = queuedRecord.level;
+			record.time = queuedRecord.time;
+			record.prefix.swap(queuedRecord.prefix);
+			record.message.swap(queuedRecord.message);
+			record.newline = queuedRecord.newline;
+		}
+	};
+
+
+	// Parses the name of a log level, such as DEBUG_LVL
+	bool parseLogLevel(const String& text, Log::LogLevel& logLevel)
+	{
+		static const char* const names[] = { "ALWAYS_LVL", "ERROR_LVL", "WARNING_LVL", "INFO_LVL", "DEBUG_LVL" };
+		for (int i = 0; i < 5; ++i)
+		{
+			if (text == names[i])
+			{
+				logLevel = static_cast<Log::LogLevel>(i);
+				return true;
+			}
+		}
+
+		return false;
+	}
+}	// End of local namespace
 
 Log::Log() :
 	_isEnabled(true),
 	_logLevel(WARNING_LVL),
+	_enabledLogLevel(WARNING_LVL),
 	_isDateTimeFormatEnabled(false),
 	_timestampFormat(DATE_TIME_WITH_AM_PM_TIMESTAMP),
+	_timestampPrecision(SECONDS_PRECISION),
+	_isUtcTimestampingEnabled(false),
 	_logStream(&std::cout),
+	_logSink(NULL),
+	_logFile(NULL),
 	_mutex(),
-	_convenienceFunctionMutex()
+	_convenienceFunctionMutex(),
+	_isAsynchronous(false),
+	_queue(NULL),
+	_overflowPolicy(BLOCK_OVERFLOW),
+	_writerThread(NULL),
+	_isWriterThreadWaiting(false),
+	_isWriterThreadStopping(false),
+	_enqueuedMessageCount(0),
+	_completedMessageCount(0),
+	_droppedMessageCount(0),
+	_isBuffered(false),
+	_threadBuffers(NULL),
+	_flusherThread(NULL),
+	_isFlusherThreadStopping(false),
+	_isBinary(false),
+	_binarySink(NULL),
+	_ticksPerMicrosecond(1.0),
+	_sinkEntries(NULL),
+	_sinkLogLevel(-1),
+	_flightRecorder(NULL),
+	_flightRecorderLogLevel(-1),
+	_isFlightRecorderHandlingSignals(false),
+	_threadStatistics(NULL)
 {
 	// Attempt to disable the entire log system based on the "BUMP_LOG_ENABLED" environment variable
 	String logEnabled = bump::Environment::environmentVariable(BUMP_LOG_ENABLED);
@@ -36,47 +563,28 @@ Log::Log() :
 	if (logEnabled == "no" || logEnabled == "false" || logEnabled == "nope" || logEnabled == "disable")
 	{
 		_isEnabled = false;
+		_enabledLogLevel = -1;
 		std::cout << "[bump] Setting LOG_ENABLED to NO" << std::endl;
 		return;
 	}
 
-	// Attempt to set the log level based on the "BUMP_LOG_LEVEL" environment variable
+	// Attempt to set the log level and the logger levels based on the "BUMP_LOG_LEVEL" environment variable
 	String logLevel = bump::Environment::environmentVariable(BUMP_LOG_LEVEL);
-	if (logLevel == "ALWAYS_LVL")
-	{
-		_logLevel = ALWAYS_LVL;
-		std::cout << "[bump] Setting BUMP_LOG_LEVEL to ALWAYS" << std::endl;
-	}
-	else if (logLevel == "ERROR_LVL")
-	{
-		_logLevel = ERROR_LVL;
-		std::cout << "[bump] Setting BUMP_LOG_LEVEL to ERROR" << std::endl;
-	}
-	else if (logLevel == "WARNING_LVL")
+	if (logLevel.empty())
 	{
-		_logLevel = WARNING_LVL;
-		std::cout << "[bump] Setting BUMP_LOG_LEVEL to WARNING" << std::endl;
-	}
-	else if (logLevel == "INFO_LVL")
-	{
-		_logLevel = INFO_LVL;
-		std::cout << "[bump] Setting BUMP_LOG_LEVEL to INFO" << std::endl;
+		// DO NOTHING
 	}
-	else if (logLevel == "DEBUG_LVL")
+	else if (setLogLevels(logLevel))
 	{
-		_logLevel = DEBUG_LVL;
-		std::cout << "[bump] Setting BUMP_LOG_LEVEL to DEBUG" << std::endl;
+		std::cout << "[bump] Setting BUMP_LOG_LEVEL to " << logLevel << std::endl;
 	}
-	else if (!logLevel.empty())
+	else
 	{
 		std::cout << "[bump] WARNING: Your BUMP_LOG_LEVEL environment variable: [" << logLevel
 			<< "] does not match any of the possible options: [ ALWAYS_LVL | ERROR_LVL | WARNING_LVL "
-			<< "| INFO_LVL | DEBUG_LVL ]" << std::endl;
-	}
-	else
-	{
-		// DO NOTHING
+			<< "| INFO_LVL | DEBUG_LVL ] followed by any name=LEVEL logger levels" << std::endl;
 	}
+	_enabledLogLevel = _logLevel.load();
 
 	// Attempt to set the log file based on the "BUMP_LOG_FILE" environment variable
 	String logFile = bump::Environment::environmentVariable(BUMP_LOG_FILE);
@@ -104,12 +612,65 @@ Log::Log() :
 
 Log::~Log()
 {
-	;
+	// Put back the signal handlers before the recorder they dump goes away
+	{
+		boost::mutex::scoped_lock lock(_mutex);
+		disableFlightRecorderLocked();
+	}
+
+	// Write out anything still queued or buffered before the stream goes away
+	disableBinaryLogging();
+	disableAsynchronousLogging();
+	disableBufferedLogging();
+
+	{
+		boost::mutex::scoped_lock lock(_sinkMutex);
+		std::vector<LogSinkEntry*>* entries = _sinkEntries.load();
+		if (entries)
+		{
+			std::vector<LogSinkEntry*> removed_entries = *entries;
+			_sinkLogLevel = -1;
+			replaceSinkEntriesLocked(NULL);
+			for (size_t i = 0; i < removed_entries.size(); ++i)
+			{
+				destroySinkEntry(removed_entries[i]);
+			}
+		}
+	}
+
+	gAreThreadBuffersDestroyed = true;
+	while (_threadBuffers)
+	{
+		LogThreadBuffer* next = _threadBuffers->next;
+		delete _threadBuffers;
+		_threadBuffers = next;
+	}
+
+	gAreThreadStatisticsDestroyed = true;
+	LogThreadStatistics* statistics = _threadStatistics.exchange(NULL);
+	while (statistics)
+	{
+		LogThreadStatistics* next = statistics->next;
+		delete statistics;
+		statistics = next;
+	}
+
+	// Anything still logging during static destruction ends up on stdout
+	boost::mutex::scoped_lock lock(_mutex);
+	replaceLogStreamLocked(&std::cout, NULL, NULL);
+
+	// The loggers are leaked on purpose since other statics may still hold references to them,
+	// they just stop writing so nothing reaches the log once it's gone
+	for (std::map<String, Logger*>::iterator it = _loggers.begin(); it != _loggers.end(); ++it)
+	{
+		it->second->updateLogLevelsLocked(it->second->logLevel(), -1);
+	}
 }
 
 Log* Log::instance()
 {
-	boost::mutex::scoped_lock lock(gLogSingletonMutex);
+	// Function local statics are initialized exactly once, even with concurrent callers,
+	// and every later call only checks the initialization guard
 	static Log log;
 	return &log;
 }
@@ -118,37 +679,70 @@ void Log::setIsLogEnabled(bool enabled)
 {
 	boost::mutex::scoped_lock lock(_mutex);
 	_isEnabled = enabled;
+	updateEnabledLogLevel();
 }
 
-bool Log::isLogEnabled()
+void Log::setLogLevel(LogLevel logLevel)
 {
 	boost::mutex::scoped_lock lock(_mutex);
-	return _isEnabled;
+	_logLevel = logLevel;
+	updateEnabledLogLevel();
 }
 
-bool Log::isLogLevelEnabled(LogLevel logLevel)
+Logger& Log::logger(const String& name)
 {
 	boost::mutex::scoped_lock lock(_mutex);
-
-	// Returning false if disabled
-	if (!_isEnabled)
+	Logger*& logger = _loggers[name];
+	if (!logger)
 	{
-		return false;
+		logger = new Logger(this, name);
+		updateEnabledLogLevel();
 	}
 
-	return logLevel <= _logLevel;
+	return *logger;
 }
 
-void Log::setLogLevel(LogLevel logLevel)
+void Log::setLoggerLevel(const String& name, LogLevel logLevel)
 {
 	boost::mutex::scoped_lock lock(_mutex);
-	_logLevel = logLevel;
+	_loggerLevels[name] = logLevel;
+	updateEnabledLogLevel();
 }
 
-Log::LogLevel Log::logLevel()
+void Log::clearLoggerLevel(const String& name)
 {
 	boost::mutex::scoped_lock lock(_mutex);
-	return _logLevel;
+	_loggerLevels.erase(name);
+	updateEnabledLogLevel();
+}
+
+bool Log::setLogLevels(const String& levels)
+{
+	boost::mutex::scoped_lock lock(_mutex);
+	bool is_valid = true;
+	StringList entries = levels.split(",");
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		// A level on its own is the log level, anything else is name=LEVEL
+		String entry = entries[i].trimmed();
+		int separator = entry.indexOf("=");
+		LogLevel log_level = WARNING_LVL;
+		if (separator < 0 && parseLogLevel(entry, log_level))
+		{
+			_logLevel = log_level;
+		}
+		else if (separator > 0 && parseLogLevel(entry.section(separator + 1).trimmed(), log_level))
+		{
+			_loggerLevels[entry.left(separator).trimmed()] = log_level;
+		}
+		else if (!entry.empty())
+		{
+			is_valid = false;
+		}
+	}
+
+	updateEnabledLogLevel();
+	return is_valid;
 }
 
 void Log::setIsTimestampingEnabled(bool enabled)
@@ -159,7 +753,6 @@ void Log::setIsTimestampingEnabled(bool enabled)
 
 bool Log::isTimestampingEnabled()
 {
-	boost::mutex::scoped_lock lock(_mutex);
 	return _isDateTimeFormatEnabled;
 }
 
@@ -171,10 +764,44 @@ void Log::setTimestampFormat(const TimestampFormat& format)
 
 Log::TimestampFormat Log::timestampFormat()
 {
-	boost::mutex::scoped_lock lock(_mutex);
 	return _timestampFormat;
 }
 
+void Log::setTimestampPrecision(TimestampPrecision precision)
+{
+	boost::mutex::scoped_lock lock(_mutex);
+	_timestampPrecision = precision;
+}
+
+Log::TimestampPrecision Log::timestampPrecision()
+{
+	return _timestampPrecision;
+}
+
+void Log::setIsUtcTimestampingEnabled(bool enabled)
+{
+	boost::mutex::scoped_lock lock(_mutex);
+	_isUtcTimestampingEnabled = enabled;
+}
+
+bool Log::isUtcTimestampingEnabled()
+{
+	return _isUtcTimestampingEnabled;
+}
+
+String Log::formatTimestamp(long long microseconds)
+{
+	size_t length = 0;
+	const char* timestamp = cachedTimestamp(microseconds, length);
+	return std::string(timestamp, length);
+}
+
+long long Log::currentTimestamp()
+{
+	boost::chrono::system_clock::duration since_epoch = boost::chrono::system_clock::now().time_since_epoch();
+	return boost::chrono::duration_cast<boost::chrono::microseconds>(since_epoch).count();
+}
+
 bool Log::setLogFile(const String& filepath)
 {
 	boost::mutex::scoped_lock lock(_mutex);
@@ -189,85 +816,1566 @@ bool Log::setLogFile(const String& filepath)
 	}
 
 	// We successfully opened the file for writing, so switch log streams
-	_logStream = logFile;
+	replaceLogStreamLocked(logFile, NULL, logFile);
 	return true;
 }
 
 void Log::setLogStream(std::ostream& stream)
 {
 	boost::mutex::scoped_lock lock(_mutex);
-	_logStream = &stream;
+	replaceLogStreamLocked(&stream, NULL, NULL);
 }
 
-std::ostream& Log::logStream(const String& prefix)
+void Log::setLogSink(LogSink& sink)
 {
 	boost::mutex::scoped_lock lock(_mutex);
+	replaceLogStreamLocked(&sink.stream(), &sink, NULL);
+}
 
-	// The generic stream to "buffer" output to for the output handler. This allows us to
-	// avoid pointer dereferences until necessary.
-	std::ostream& ostream = *_logStream;
+void Log::addLogSink(LogSink& sink, const SinkOptions& options)
+{
+	// Write out anything the sink still has queued with its previous options
+	removeLogSink(sink);
 
-	// Append the date time if necessary
-	if (_isDateTimeFormatEnabled)
+	LogSinkEntry* entry = new LogSinkEntry();
+	entry->sink = &sink;
+	entry->options = options;
+	entry->queue = NULL;
+	entry->thread = NULL;
+	entry->isThreadWaiting = false;
+	entry->isThreadStopping = false;
+	entry->enqueuedCount = 0;
+	entry->completedCount = 0;
+	entry->writtenByteCount = 0;
+	if (options.isThreaded)
 	{
-		ostream << convertTimeToString() << " ";
+		entry->queue = new LockFreeQueue<LogSinkRecord>(options.queueCapacity);
+		entry->thread = new boost::thread(boost::bind(&Log::runSinkThread, this, entry));
 	}
 
-	// Append the prefix if necessary
-	if (!prefix.empty())
+	// Writers only ever see complete lists, so the new one is built next to the old one
+	boost::mutex::scoped_lock lock(_sinkMutex);
+	std::vector<LogSinkEntry*>* entries = new std::vector<LogSinkEntry*>();
+	if (_sinkEntries.load())
+	{
+		*entries = *_sinkEntries.load();
+	}
+	entries->push_back(entry);
+
+	_sinkLogLevel = std::max(_sinkLogLevel.load(), static_cast<int>(options.logLevel));
+	replaceSinkEntriesLocked(entries);
+}
+
+bool Log::removeLogSink(LogSink& sink)
+{
+	boost::mutex::scoped_lock lock(_sinkMutex);
+	std::vector<LogSinkEntry*>* entries = _sinkEntries.load();
+	if (!entries)
+	{
+		return false;
+	}
+
+	LogSinkEntry* removed_entry = NULL;
+	std::vector<LogSinkEntry*>* remaining_entries = new std::vector<LogSinkEntry*>();
+	int sink_log_level = -1;
+	for (size_t i = 0; i < entries->size(); ++i)
+	{
+		if ((*entries)[i]->sink == &sink)
+		{
+			removed_entry = (*entries)[i];
+		}
+		else
+		{
+			remaining_entries->push_back((*entries)[i]);
+			sink_log_level = std::max(sink_log_level, static_cast<int>((*entries)[i]->options.logLevel));
+		}
+	}
+
+	if (!removed_entry)
+	{
+		delete remaining_entries;
+		return false;
+	}
+
+	if (remaining_entries->empty())
+	{
+		delete remaining_entries;
+		remaining_entries = NULL;
+	}
+
+	_sinkLogLevel = sink_log_level;
+	replaceSinkEntriesLocked(remaining_entries);
+	destroySinkEntry(removed_entry);
+	return true;
+}
+
+std::ostream& Log::logStream(const String& prefix)
+{
+	boost::mutex::scoped_lock lock(_mutex);
+
+	// The generic stream to "buffer" output to for the output handler. This allows us to
+	// avoid pointer dereferences until necessary.
+	std::ostream& ostream = *_logStream;
+
+	// Append the date time if necessary
+	if (_isDateTimeFormatEnabled.load(boost::memory_order_relaxed))
+	{
+		writeTimestamp(ostream, currentTimestamp());
+	}
+
+	// Append the prefix if necessary
+	if (!prefix.empty())
 	{
 		ostream << prefix;
 	}
 
-	return *_logStream;
+	return *_logStream;
+}
+
+void Log::replaceLogStreamLocked(std::ostream* stream, LogSink* sink, std::ofstream* file)
+{
+	// Everything written so far goes to the old stream, which may be closed below
+	writeThreadBuffersLocked();
+	_logStream->flush();
+
+	// The file opened by the previous call to setLogFile() is no longer needed
+	delete _logFile;
+
+	_logStream = stream;
+	_logSink = sink;
+	_logFile = file;
+}
+
+const char* Log::cachedTimestamp(long long microseconds, size_t& length)
+{
+	TimestampFormat format = _timestampFormat.load(boost::memory_order_relaxed);
+	TimestampPrecision precision = _timestampPrecision.load(boost::memory_order_relaxed);
+	bool utc = _isUtcTimestampingEnabled.load(boost::memory_order_relaxed);
+	int settings = static_cast<int>(format) | static_cast<int>(precision) << 4 | (utc ? 1 << 8 : 0);
+
+	// Split off the fraction of a second, rounding down for times before the epoch
+	long long second = microseconds / 1000000;
+	long long fraction = microseconds % 1000000;
+	if (fraction < 0)
+	{
+		fraction += 1000000;
+		--second;
+	}
+
+	// Only format the date and time when they differ from the cached ones
+	TimestampCache& cache = threadTimestampCache();
+	if (second != cache.second || settings != cache.settings)
+	{
+		std::tm time;
+		breakDownTime(static_cast<std::time_t>(second), utc, time);
+
+		bool has_date = format != TIME_TIMESTAMP && format != TIME_WITHOUT_AM_PM_TIMESTAMP;
+		bool has_am_pm = format == DATE_TIME_WITH_AM_PM_TIMESTAMP || format == TIME_TIMESTAMP;
+
+		char* output = cache.text;
+		if (has_date)
+		{
+			output = writeDigits(output, static_cast<unsigned int>(time.tm_year + 1900), 4);
+			*output++ = '-';
+			output = writeDigits(output, static_cast<unsigned int>(time.tm_mon + 1), 2);
+			*output++ = '-';
+			output = writeDigits(output, static_cast<unsigned int>(time.tm_mday), 2);
+			*output++ = format == ISO_8601_TIMESTAMP ? 'T' : ' ';
+		}
+
+		// The 12-hour clock runs from 12 AM through 11 AM, then 12 PM through 11 PM
+		unsigned int hours = static_cast<unsigned int>(time.tm_hour);
+		if (has_am_pm)
+		{
+			hours = hours % 12 == 0 ? 12 : hours % 12;
+		}
+
+		output = writeDigits(output, hours, 2);
+		*output++ = ':';
+		output = writeDigits(output, static_cast<unsigned int>(time.tm_min), 2);
+		*output++ = ':';
+		output = writeDigits(output, static_cast<unsigned int>(time.tm_sec), 2);
+
+		// Leave room for the fraction of a second, which is patched in below
+		cache.fractionDigits = precision == MICROSECONDS_PRECISION ? 6 : precision == MILLISECONDS_PRECISION ? 3 : 0;
+		if (cache.fractionDigits > 0)
+		{
+			*output++ = '.';
+			cache.fractionOffset = output - cache.text;
+			output += cache.fractionDigits;
+		}
+
+		if (has_am_pm)
+		{
+			std::memcpy(output, time.tm_hour < 12 ? " AM" : " PM", 3);
+			output += 3;
+		}
+
+		// ISO 8601 ends with the time zone, the others with the separator they always had
+		if (format == ISO_8601_TIMESTAMP)
+		{
+			if (utc)
+			{
+				*output++ = 'Z';
+			}
+			else
+			{
+				int offset = utcOffsetInMinutes(static_cast<std::time_t>(second), time);
+				*output++ = offset < 0 ? '-' : '+';
+				offset = offset < 0 ? -offset : offset;
+				output = writeDigits(output, static_cast<unsigned int>(offset / 60), 2);
+				*output++ = ':';
+				output = writeDigits(output, static_cast<unsigned int>(offset % 60), 2);
+			}
+		}
+		else
+		{
+			*output++ = ':';
+		}
+
+		cache.second = second;
+		cache.settings = settings;
+		cache.length = output - cache.text;
+	}
+
+	// Patch in the fraction of a second
+	if (cache.fractionDigits == 6)
+	{
+		writeDigits(cache.text + cache.fractionOffset, static_cast<unsigned int>(fraction), 6);
+	}
+	else if (cache.fractionDigits == 3)
+	{
+		writeDigits(cache.text + cache.fractionOffset, static_cast<unsigned int>(fraction / 1000), 3);
+	}
+
+	length = cache.length;
+	return cache.text;
+}
+
+void Log::writeTimestamp(std::ostream& stream, long long microseconds)
+{
+	size_t length = 0;
+	const char* timestamp = cachedTimestamp(microseconds, length);
+	stream.write(timestamp, static_cast<std::streamsize>(length));
+	stream.put(' ');
+
+	addToCounter(threadStatistics()->writtenByteCount, length + 1);
+}
+
+void Log::enableAsynchronousLogging(unsigned int queueCapacity, OverflowPolicy overflowPolicy)
+{
+	// Write out anything queued with the previous settings
+	disableAsynchronousLogging();
+
+	boost::mutex::scoped_lock lock(_asynchronousMutex);
+	_queue = new LockFreeQueue<LogRecord>(queueCapacity);
+	_overflowPolicy = overflowPolicy;
+	_isWriterThreadStopping = false;
+	_writerThread = new boost::thread(boost::bind(&Log::runWriterThread, this));
+	_isAsynchronous = true;
+}
+
+void Log::disableAsynchronousLogging()
+{
+	boost::mutex::scoped_lock lock(_asynchronousMutex);
+	if (!_queue)
+	{
+		return;
+	}
+
+	// Send new messages down the synchronous path and wait for the threads already pushing
+	_isAsynchronous = false;
+	_producerGracePeriod.wait();
+
+	// The writer thread exits once it has written everything left in the queue
+	_isWriterThreadStopping = true;
+	{
+		boost::mutex::scoped_lock writer_lock(_writerMutex);
+		_writerCondition.notify_one();
+	}
+	_writerThread->join();
+
+	delete _writerThread;
+	_writerThread = NULL;
+	delete _queue;
+	_queue = NULL;
+}
+
+bool Log::isAsynchronousLoggingEnabled()
+{
+	return _isAsynchronous;
+}
+
+unsigned long long Log::droppedMessageCount()
+{
+	return _droppedMessageCount;
+}
+
+Log::Statistics Log::statistics()
+{
+	Statistics statistics;
+
+	// The list is only ever pushed onto, so it can be walked without locking
+	for (LogThreadStatistics* thread = _threadStatistics.load(); thread; thread = thread->next)
+	{
+		for (unsigned int i = 0; i < 5; ++i)
+		{
+			statistics.recordCounts[i] += thread->recordCounts[i].load(boost::memory_order_relaxed);
+		}
+
+		statistics.filteredRecordCount += thread->filteredCount.load(boost::memory_order_relaxed);
+		statistics.writtenByteCount += thread->writtenByteCount.load(boost::memory_order_relaxed);
+		statistics.blockedCount += thread->blockedCount.load(boost::memory_order_relaxed);
+		statistics.blockedNanoseconds += thread->blockedNanoseconds.load(boost::memory_order_relaxed);
+		thread->streamLatency.addTo(statistics.streamWriteLatency);
+	}
+
+	statistics.droppedRecordCount = _droppedMessageCount;
+
+	// A message is counted as enqueued just after it was pushed, so it may already be completed
+	unsigned long long completed_count = _completedMessageCount;
+	unsigned long long enqueued_count = _enqueuedMessageCount;
+	if (_isAsynchronous && enqueued_count > completed_count)
+	{
+		statistics.queuedRecordCount = enqueued_count - completed_count;
+	}
+
+	boost::mutex::scoped_lock lock(_sinkMutex);
+	std::vector<LogSinkEntry*>* entries = _sinkEntries.load();
+	for (size_t i = 0; entries && i < entries->size(); ++i)
+	{
+		LogSinkEntry* entry = (*entries)[i];
+		SinkStatistics sink_statistics;
+		sink_statistics.sink = entry->sink;
+		sink_statistics.writtenByteCount = entry->writtenByteCount;
+		completed_count = entry->completedCount;
+		enqueued_count = entry->enqueuedCount;
+		if (enqueued_count > completed_count)
+		{
+			sink_statistics.queuedRecordCount = enqueued_count - completed_count;
+		}
+		entry->writeLatency.addTo(sink_statistics.writeLatency);
+		statistics.sinks.push_back(sink_statistics);
+	}
+
+	return statistics;
+}
+
+void Log::enableBufferedLogging(const FlushPolicy& policy)
+{
+	// Write out anything buffered with the previous policy
+	disableBufferedLogging();
+
+	boost::mutex::scoped_lock lock(_bufferedMutex);
+	_flushPolicy = policy;
+	_isFlusherThreadStopping = false;
+	if (policy.intervalMilliseconds > 0)
+	{
+		_flusherThread = new boost::thread(boost::bind(&Log::runFlusherThread, this));
+	}
+	_isBuffered = true;
+}
+
+void Log::disableBufferedLogging()
+{
+	boost::mutex::scoped_lock lock(_bufferedMutex);
+	if (!_isBuffered)
+	{
+		return;
+	}
+
+	// Send new messages down the synchronous path and wait for the threads already appending
+	_isBuffered = false;
+	_bufferedWriterGracePeriod.wait();
+
+	if (_flusherThread)
+	{
+		{
+			boost::mutex::scoped_lock flusher_lock(_flusherMutex);
+			_isFlusherThreadStopping = true;
+			_flusherCondition.notify_one();
+		}
+		_flusherThread->join();
+		delete _flusherThread;
+		_flusherThread = NULL;
+	}
+
+	boost::mutex::scoped_lock stream_lock(_mutex);
+	writeThreadBuffersLocked();
+	_logStream->flush();
+}
+
+bool Log::isBufferedLoggingEnabled()
+{
+	return _isBuffered;
+}
+
+void Log::enableBinaryLogging(const String& filepath)
+{
+	// Finish the previous binary log
+	disableBinaryLogging();
+
+	boost::mutex::scoped_lock lock(_binaryMutex);
+	FileDescriptorLogSink* sink = new FileDescriptorLogSink(filepath, false);
+	double ticks_per_microsecond = measureTicksPerMicrosecond();
+
+	// Start the file with the header and every call site registered so far
+	boost::mutex::scoped_lock buffer_lock(_binaryBufferMutex);
+	std::string& buffer = _binaryBuffer;
+	buffer.clear();
+	buffer.append(BinaryLogReader::MAGIC, sizeof(BinaryLogReader::MAGIC));
+	appendRaw(buffer, ticks_per_microsecond);
+	appendCalibration(buffer);
+	for (size_t i = 0; i < _callSites.size(); ++i)
+	{
+		appendCallSiteEntry(buffer, *_callSites[i]);
+	}
+
+	LogSink::Buffer sink_buffer = { buffer.data(), buffer.size() };
+	sink->write(&sink_buffer, 1);
+	buffer.clear();
+
+	_binarySink = sink;
+	_ticksPerMicrosecond = ticks_per_microsecond;
+	_isBinary = true;
+}
+
+void Log::disableBinaryLogging()
+{
+	boost::mutex::scoped_lock lock(_binaryMutex);
+	if (!_binarySink)
+	{
+		return;
+	}
+
+	// Send new messages back to the text paths and wait for the threads already writing records
+	_isBinary = false;
+	_binaryWriterGracePeriod.wait();
+
+	boost::mutex::scoped_lock buffer_lock(_binaryBufferMutex);
+	writeBinaryBufferLocked();
+	delete _binarySink;
+	_binarySink = NULL;
+}
+
+bool Log::isBinaryLoggingEnabled()
+{
+	return _isBinary;
+}
+
+void Log::enableFlightRecorder(const String& filepath, unsigned int recordCount, LogLevel logLevel, bool isHandlingSignals)
+{
+	boost::mutex::scoped_lock lock(_mutex);
+	disableFlightRecorderLocked();
+
+	LogFlightRecorder* recorder = new LogFlightRecorder(filepath, recordCount);
+	_isFlightRecorderHandlingSignals = isHandlingSignals;
+	if (isHandlingSignals)
+	{
+		LogFlightRecorder::installSignalHandlers(recorder);
+	}
+
+	_flightRecorder = recorder;
+	_flightRecorderLogLevel = logLevel;
+	updateEnabledLogLevel();
+}
+
+void Log::disableFlightRecorder()
+{
+	boost::mutex::scoped_lock lock(_mutex);
+	disableFlightRecorderLocked();
+}
+
+bool Log::isFlightRecorderEnabled()
+{
+	return _flightRecorder.load() != NULL;
+}
+
+bool Log::dumpFlightRecorder()
+{
+	GracePeriod::Reader reader(_flightRecorderGracePeriod);
+	LogFlightRecorder* recorder = _flightRecorder.load();
+	return recorder && recorder->dump();
+}
+
+void Log::flush()
+{
+	boost::mutex::scoped_lock lock(_asynchronousMutex);
+
+	// Wait for the writer thread to catch up with everything queued so far
+	if (_queue)
+	{
+		unsigned long long target_count = _enqueuedMessageCount;
+		boost::mutex::scoped_lock writer_lock(_writerMutex);
+		while (_completedMessageCount < target_count)
+		{
+			_writerCondition.notify_one();
+			_flushCondition.timed_wait(writer_lock, boost::posix_time::milliseconds(10));
+		}
+	}
+
+	{
+		boost::mutex::scoped_lock buffer_lock(_binaryBufferMutex);
+		writeBinaryBufferLocked();
+	}
+
+	{
+		boost::mutex::scoped_lock stream_lock(_mutex);
+		writeThreadBuffersLocked();
+		_logStream->flush();
+	}
+
+	// Wait for the worker threads of the sinks to catch up as well
+	boost::mutex::scoped_lock sink_lock(_sinkMutex);
+	std::vector<LogSinkEntry*>* entries = _sinkEntries.load();
+	for (size_t i = 0; entries && i < entries->size(); ++i)
+	{
+		LogSinkEntry* entry = (*entries)[i];
+		if (entry->queue)
+		{
+			unsigned long long target_count = entry->enqueuedCount;
+			boost::mutex::scoped_lock thread_lock(entry->threadMutex);
+			while (entry->completedCount < target_count)
+			{
+				entry->threadCondition.notify_one();
+				entry->flushCondition.timed_wait(thread_lock, boost::posix_time::milliseconds(10));
+			}
+		}
+
+		boost::mutex::scoped_lock entry_lock(entry->mutex);
+		entry->sink->flush();
+	}
+}
+
+void Log::writeMessage(LogLevel logLevel, const String& prefix, const String& message, bool newline)
+{
+	writeMessage(logLevel, _logLevel.load(boost::memory_order_relaxed), prefix, message, newline);
+}
+
+void Log::writeMessage(LogLevel logLevel, LogLevel streamLogLevel, const String& prefix, const String& message,
+	bool newline)
+{
+	// The message is recorded as the only argument of a "%1" format
+	LogArgument argument(static_cast<const std::string&>(message));
+	recordFlight(logLevel, prefix, "%1", &argument, 1);
+	addToCounter(threadStatistics()->recordCounts[logLevel], 1);
+
+	writeUnrecordedMessage(logLevel, streamLogLevel, prefix, message, newline);
+}
+
+void Log::writeUnrecordedMessage(LogLevel logLevel, LogLevel streamLogLevel, const String& prefix,
+	const String& message, bool newline)
+{
+	// Hand the message to the sinks taking it, then check whether the log stream wants it too
+	bool is_sunk = false;
+	if (static_cast<int>(logLevel) <= _sinkLogLevel.load(boost::memory_order_relaxed))
+	{
+		is_sunk = writeToSinks(logLevel, prefix, message, newline, NULL, 0);
+	}
+
+	// The level may only have been let through for the sinks or the flight recorder
+	if (logLevel > streamLogLevel)
+	{
+		if (!is_sunk)
+		{
+			addToCounter(threadStatistics()->filteredCount, 1);
+		}
+		return;
+	}
+
+	writeToStream(logLevel, prefix, message, newline);
+}
+
+void Log::writeToStream(LogLevel logLevel, const String& prefix, const String& message, bool newline)
+{
+	// Write the message as the only argument of its level's call site if binary logging is enabled
+	if (_isBinary.load(boost::memory_order_relaxed))
+	{
+		GracePeriod::Reader reader(_binaryWriterGracePeriod);
+		if (_isBinary)
+		{
+			LogArgument argument(static_cast<const std::string&>(message));
+			writeBinaryRecord(gMessageCallSites[logLevel], logLevel, prefix, "%1", &argument, 1);
+			return;
+		}
+	}
+
+	// Queue the message if the writer thread is running. The producer grace period tells
+	// disableAsynchronousLogging() when no thread can still be pushing onto the queue.
+	if (_isAsynchronous.load(boost::memory_order_relaxed))
+	{
+		GracePeriod::Reader reader(_producerGracePeriod);
+		if (_isAsynchronous)
+		{
+			enqueueMessage(logLevel, prefix, message, newline);
+			return;
+		}
+	}
+
+	// Or append it to this thread's buffer, counted the same way for disableBufferedLogging()
+	if (_isBuffered.load(boost::memory_order_relaxed))
+	{
+		GracePeriod::Reader reader(_bufferedWriterGracePeriod);
+		if (_isBuffered)
+		{
+			appendToThreadBuffer(logLevel, prefix, message, newline);
+			return;
+		}
+	}
+
+	// Otherwise write it on this thread
+	boost::mutex::scoped_lock lock(_convenienceFunctionMutex, boost::defer_lock);
+	lockCounted(lock);
+	unsigned long long start = steadyNanoseconds();
+	std::ostream& stream = logStream(prefix);
+	stream << message;
+	if (newline)
+	{
+		stream << std::endl;
+	}
+	else
+	{
+		stream << std::flush;
+	}
+
+	LogThreadStatistics* statistics = threadStatistics();
+	statistics->streamLatency.add(steadyNanoseconds() - start);
+	addToCounter(statistics->writtenByteCount, prefix.size() + message.size() + (newline ? 1 : 0));
+}
+
+void Log::formatMessage(String& buffer, const char* format, const LogArgument* arguments, unsigned int argumentCount)
+{
+	// String::append() hides the std::string overload taking a range
+	std::string& output = buffer;
+
+	const char* segment_start = format;
+	const char* position = format;
+	while (*position != '\0')
+	{
+		// Look for a %1 - %99 marker
+		if (position[0] == '%' && position[1] >= '1' && position[1] <= '9')
+		{
+			unsigned int index = position[1] - '0';
+			const char* marker_end = position + 2;
+			if (*marker_end >= '0' && *marker_end <= '9')
+			{
+				index = index * 10 + (*marker_end - '0');
+				++marker_end;
+			}
+
+			// Replace the marker if it has a matching argument
+			if (index <= argumentCount)
+			{
+				output.append(segment_start, position);
+				arguments[index - 1].appendTo(buffer);
+				segment_start = marker_end;
+				position = marker_end;
+				continue;
+			}
+		}
+
+		++position;
+	}
+
+	output.append(segment_start, position);
+}
+
+void Log::writeArguments(LogCallSite& callSite, LogLevel logLevel, LogLevel streamLogLevel, const String& prefix,
+	const char* format, const LogArgument* arguments, unsigned int argumentCount)
+{
+	// Messages only let through for the flight recorder are never formatted
+	recordFlight(logLevel, prefix, format, arguments, argumentCount);
+	LogThreadStatistics* statistics = threadStatistics();
+	addToCounter(statistics->recordCounts[logLevel], 1);
+	if (logLevel > streamLogLevel && static_cast<int>(logLevel) > _sinkLogLevel.load(boost::memory_order_relaxed))
+	{
+		addToCounter(statistics->filteredCount, 1);
+		return;
+	}
+
+	// Skip formatting altogether if binary logging is enabled and no sink takes the message
+	if (_isBinary.load(boost::memory_order_relaxed))
+	{
+		unsigned int token = _binaryWriterGracePeriod.enter();
+		if (_isBinary)
+		{
+			bool is_written = logLevel <= streamLogLevel;
+			if (is_written)
+			{
+				writeBinaryRecord(callSite, logLevel, prefix, format, arguments, argumentCount);
+			}
+			_binaryWriterGracePeriod.leave(token);
+
+			if (static_cast<int>(logLevel) <= _sinkLogLevel.load(boost::memory_order_relaxed))
+			{
+				String& buffer = threadFormatBuffer();
+				buffer.clear();
+				formatMessage(buffer, format, arguments, argumentCount);
+				is_written = writeToSinks(logLevel, prefix, buffer, true, NULL, 0) || is_written;
+			}
+
+			if (!is_written)
+			{
+				addToCounter(statistics->filteredCount, 1);
+			}
+			return;
+		}
+		_binaryWriterGracePeriod.leave(token);
+	}
+
+	// The buffer keeps its capacity between messages so formatting stops allocating
+	String& buffer = threadFormatBuffer();
+	buffer.clear();
+	formatMessage(buffer, format, arguments, argumentCount);
+	writeUnrecordedMessage(logLevel, streamLogLevel, prefix, buffer, true);
+}
+
+void Log::recordFlight(LogLevel logLevel, const String& prefix, const char* format, const LogArgument* arguments,
+	unsigned int argumentCount)
+{
+	// The recorder grace period tells disableFlightRecorderLocked() when the recorder is no longer in use
+	if (static_cast<int>(logLevel) <= _flightRecorderLogLevel.load(boost::memory_order_relaxed))
+	{
+		GracePeriod::Reader reader(_flightRecorderGracePeriod);
+		LogFlightRecorder* recorder = _flightRecorder.load();
+		if (recorder)
+		{
+			recorder->record(logLevel, prefix, format, arguments, argumentCount);
+		}
+	}
+}
+
+void Log::disableFlightRecorderLocked()
+{
+	LogFlightRecorder* recorder = _flightRecorder.exchange(NULL);
+	if (!recorder)
+	{
+		return;
+	}
+
+	_flightRecorderLogLevel = -1;
+	updateEnabledLogLevel();
+	if (_isFlightRecorderHandlingSignals)
+	{
+		LogFlightRecorder::installSignalHandlers(NULL);
+	}
+
+	// Threads still recording may be using the recorder
+	_flightRecorderGracePeriod.wait();
+	delete recorder;
+}
+
+void Log::writeUnrepeatedArguments(LogRepeatSuppressor& suppressor, LogCallSite& callSite, LogLevel logLevel,
+	const String& prefix, const char* format, const LogArgument* arguments, unsigned int argumentCount)
+{
+	// Repeats can only be spotted on the formatted text, so it is formatted even for the binary log
+	String& buffer = threadFormatBuffer();
+	buffer.clear();
+	formatMessage(buffer, format, arguments, argumentCount);
+
+	unsigned long long hash = LogRepeatSuppressor::hash(prefix.c_str(), prefix.size());
+	hash = LogRepeatSuppressor::hash(buffer.c_str(), buffer.size(), hash);
+	unsigned long long repeat_count = 0;
+	bool is_logged = suppressor.filter(hash, repeat_count);
+
+	if (repeat_count > 0)
+	{
+		String notice = String("Last message repeated %1 times").arg(repeat_count);
+		writeMessage(logLevel, prefix, notice, true);
+	}
+
+	if (!is_logged)
+	{
+		LogThreadStatistics* statistics = threadStatistics();
+		addToCounter(statistics->recordCounts[logLevel], 1);
+		addToCounter(statistics->filteredCount, 1);
+		return;
+	}
+
+	// The binary log wants the raw arguments along with the call site
+	if (_isBinary.load(boost::memory_order_relaxed))
+	{
+		writeArguments(callSite, logLevel, _logLevel.load(boost::memory_order_relaxed), prefix, format, arguments,
+			argumentCount);
+	}
+	else
+	{
+		writeMessage(logLevel, prefix, buffer, true);
+	}
+}
+
+void Log::writeSuppressedMessageCount(LogLevel logLevel, const String& prefix, unsigned long long suppressedCount)
+{
+	if (suppressedCount > 0)
+	{
+		String notice = String("%1 messages suppressed by the rate limit").arg(suppressedCount);
+		writeMessage(logLevel, prefix, notice, true);
+	}
+}
+
+void Log::writeFields(LogLevel logLevel, const String& prefix, const char* message, const LogField* fields,
+	unsigned int fieldCount)
+{
+	LogThreadStatistics* statistics = threadStatistics();
+	addToCounter(statistics->recordCounts[logLevel], 1);
+
+	// The buffer keeps its capacity between messages, first holding the bare message for the sinks
+	String& buffer = threadFormatBuffer();
+	std::string& text = buffer;
+	text.assign(message);
+
+	bool is_sunk = false;
+	if (static_cast<int>(logLevel) <= _sinkLogLevel.load(boost::memory_order_relaxed))
+	{
+		is_sunk = writeToSinks(logLevel, prefix, buffer, true, fields, fieldCount);
+	}
+
+	// Then the fields are appended as text for the log stream and the flight recorder
+	bool is_streamed = logLevel <= _logLevel.load(boost::memory_order_relaxed);
+	bool is_recorded = static_cast<int>(logLevel) <= _flightRecorderLogLevel.load(boost::memory_order_relaxed);
+	if (is_streamed || is_recorded)
+	{
+		for (unsigned int i = 0; i < fieldCount; ++i)
+		{
+			text.push_back(' ');
+			fields[i].appendTextTo(buffer);
+		}
+
+		LogArgument argument(text);
+		recordFlight(logLevel, prefix, "%1", &argument, 1);
+	}
+
+	if (is_streamed)
+	{
+		writeToStream(logLevel, prefix, buffer, true);
+	}
+	else if (!is_sunk)
+	{
+		addToCounter(statistics->filteredCount, 1);
+	}
+}
+
+void Log::appendLine(String& output, const String& prefix, const String& message, bool newline)
+{
+	// String::append() hides the std::string overload taking a pointer and length
+	std::string& data = output;
+	if (_isDateTimeFormatEnabled.load(boost::memory_order_relaxed))
+	{
+		size_t length = 0;
+		const char* timestamp = cachedTimestamp(currentTimestamp(), length);
+		data.append(timestamp, length);
+		data.push_back(' ');
+	}
+
+	data.append(prefix);
+	data.append(message);
+	if (newline)
+	{
+		data.push_back('\n');
+	}
+}
+
+void Log::appendJsonLine(String& output, LogLevel logLevel, const String& prefix, const String& message,
+	const LogField* fields, unsigned int fieldCount)
+{
+	// String::append() hides the std::string overloads taking ranges and lengths
+	std::string& data = output;
+
+	char characters[32];
+	std::to_chars_result result = std::to_chars(characters, characters + sizeof(characters), currentTimestamp());
+	data.append("{\"time\":");
+	data.append(characters, result.ptr);
+	data.append(",\"level\":\"");
+	data.append(JSON_LEVEL_NAMES[logLevel]);
+	data.push_back('"');
+
+	if (!prefix.empty())
+	{
+		data.append(",\"prefix\":");
+		LogArgument::appendJsonString(output, prefix.data(), prefix.size());
+	}
+
+	data.append(",\"message\":");
+	LogArgument::appendJsonString(output, message.data(), message.size());
+
+	for (unsigned int i = 0; i < fieldCount; ++i)
+	{
+		data.push_back(',');
+		fields[i].appendJsonTo(output);
+	}
+
+	data.append("}\n");
+}
+
+bool Log::writeToSinks(LogLevel logLevel, const String& prefix, const String& message, bool newline,
+	const LogField* fields, unsigned int fieldCount)
+{
+	// The writer grace period tells replaceSinkEntriesLocked() when the old list is no longer in use
+	GracePeriod::Reader reader(_sinkWriterGracePeriod);
+	std::vector<LogSinkEntry*>* entries = _sinkEntries.load();
+	if (!entries)
+	{
+		return false;
+	}
+
+	// Find out who takes the message so it is formatted exactly once per sink format
+	unsigned int accepted_counts[SINK_FORMAT_COUNT] = { 0, 0 };
+	for (size_t i = 0; i < entries->size(); ++i)
+	{
+		if ((*entries)[i]->accepts(logLevel, prefix))
+		{
+			++accepted_counts[(*entries)[i]->options.format];
+		}
+	}
+
+	if (accepted_counts[TEXT_SINK_FORMAT] == 0 && accepted_counts[JSON_SINK_FORMAT] == 0)
+	{
+		return false;
+	}
+
+	// Formatted into this thread's buffers, the threaded sinks copy the text into their queue cells
+	LogSink::Buffer buffers[SINK_FORMAT_COUNT] = { { NULL, 0 }, { NULL, 0 } };
+	for (int format = 0; format < SINK_FORMAT_COUNT; ++format)
+	{
+		if (accepted_counts[format] == 0)
+		{
+			continue;
+		}
+
+		String* text = format == TEXT_SINK_FORMAT ? &threadSinkBuffer() : &threadJsonSinkBuffer();
+		text->clear();
+
+		if (format == JSON_SINK_FORMAT)
+		{
+			appendJsonLine(*text, logLevel, prefix, message, fields, fieldCount);
+		}
+		else if (fieldCount == 0)
+		{
+			appendLine(*text, prefix, message, newline);
+		}
+		else
+		{
+			appendLine(*text, prefix, message, false);
+			for (unsigned int i = 0; i < fieldCount; ++i)
+			{
+				static_cast<std::string&>(*text).push_back(' ');
+				fields[i].appendTextTo(*text);
+			}
+			if (newline)
+			{
+				static_cast<std::string&>(*text).push_back('\n');
+			}
+		}
+
+		buffers[format].data = text->data();
+		buffers[format].size = text->size();
+	}
+
+	for (size_t i = 0; i < entries->size(); ++i)
+	{
+		LogSinkEntry* entry = (*entries)[i];
+		if (!entry->accepts(logLevel, prefix))
+		{
+			continue;
+		}
+
+		const LogSink::Buffer& buffer = buffers[entry->options.format];
+
+		if (!entry->queue)
+		{
+			boost::mutex::scoped_lock lock(entry->mutex, boost::defer_lock);
+			if (!entry->sink->isThreadSafe())
+			{
+				lockCounted(lock);
+			}
+
+			unsigned long long start = steadyNanoseconds();
+			entry->sink->write(&buffer, 1);
+			entry->writeLatency.add(steadyNanoseconds() - start);
+			entry->writtenByteCount.fetch_add(buffer.size, boost::memory_order_relaxed);
+			continue;
+		}
+
+		FillSinkRecord push = { buffer };
+		bool is_pushed = true;
+		unsigned long long blocked_start = 0;
+		while (!entry->queue->tryPush(push))
+		{
+			if (entry->options.overflowPolicy == DROP_NEWEST_OVERFLOW)
+			{
+				is_pushed = false;
+				break;
+			}
+			else if (entry->options.overflowPolicy == DROP_OLDEST_OVERFLOW)
+			{
+				if (entry->queue->tryPop(DiscardSinkRecord()))
+				{
+					++_droppedMessageCount;
+					++entry->completedCount;
+				}
+			}
+			else // overflowPolicy == BLOCK_OVERFLOW
+			{
+				// Park until the worker thread makes room, which it signals under the thread mutex after every batch
+				blocked_start = blocked_start == 0 ? steadyNanoseconds() : blocked_start;
+				boost::mutex::scoped_lock lock(entry->threadMutex);
+				entry->threadCondition.notify_one();
+				if (entry->queue->size() >= entry->queue->capacity())
+				{
+					entry->flushCondition.wait(lock);
+				}
+			}
+		}
+
+		if (blocked_start != 0)
+		{
+			LogThreadStatistics* statistics = threadStatistics();
+			addToCounter(statistics->blockedCount, 1);
+			addToCounter(statistics->blockedNanoseconds, steadyNanoseconds() - blocked_start);
+		}
+
+		if (!is_pushed)
+		{
+			++_droppedMessageCount;
+			continue;
+		}
+
+		// Pairs with the fence in runSinkThread() so the push is visible before the flag is read
+		++entry->enqueuedCount;
+		boost::atomic_thread_fence(boost::memory_order_seq_cst);
+		if (entry->isThreadWaiting.load(boost::memory_order_relaxed))
+		{
+			boost::mutex::scoped_lock lock(entry->threadMutex);
+			entry->threadCondition.notify_one();
+		}
+	}
+
+	return true;
+}
+
+void Log::runSinkThread(LogSinkEntry* entry)
+{
+	// Reused for every batch, the texts swap their buffers with the queue cells
+	std::vector<String> texts(MAX_SINK_BATCH_SIZE);
+	std::vector<LogSink::Buffer> buffers;
+	buffers.reserve(MAX_SINK_BATCH_SIZE);
+
+	while (true)
+	{
+		// Gather a batch so the sink can write it in one go
+		size_t byte_count = 0;
+		while (buffers.size() < MAX_SINK_BATCH_SIZE)
+		{
+			String& text = texts[buffers.size()];
+			SwapSinkRecord pop = { text };
+			if (!entry->queue->tryPop(pop))
+			{
+				break;
+			}
+
+			LogSink::Buffer buffer = { text.data(), text.size() };
+			buffers.push_back(buffer);
+			byte_count += buffer.size;
+		}
+
+		if (!buffers.empty())
+		{
+			{
+				boost::mutex::scoped_lock lock(entry->mutex);
+				unsigned long long start = steadyNanoseconds();
+				entry->sink->write(&buffers[0], static_cast<unsigned int>(buffers.size()));
+				entry->sink->flush();
+				entry->writeLatency.add(steadyNanoseconds() - start);
+				entry->writtenByteCount.fetch_add(byte_count, boost::memory_order_relaxed);
+			}
+
+			entry->completedCount += buffers.size();
+			buffers.clear();
+
+			// Let any flush() calls know how far the worker thread has gotten
+			boost::mutex::scoped_lock lock(entry->threadMutex);
+			entry->flushCondition.notify_all();
+			continue;
+		}
+
+		// Only exit once stopping and everything has been written
+		if (entry->isThreadStopping)
+		{
+			break;
+		}
+
+		// Wait for more messages, the same way the asynchronous writer thread does
+		boost::mutex::scoped_lock lock(entry->threadMutex);
+		entry->isThreadWaiting = true;
+		boost::atomic_thread_fence(boost::memory_order_seq_cst);
+		if (entry->queue->isEmpty() && !entry->isThreadStopping)
+		{
+			entry->threadCondition.timed_wait(lock, boost::posix_time::milliseconds(100));
+		}
+		entry->isThreadWaiting = false;
+	}
+}
+
+void Log::replaceSinkEntriesLocked(std::vector<LogSinkEntry*>* entries)
+{
+	std::vector<LogSinkEntry*>* old_entries = _sinkEntries.exchange(entries);
+	{
+		boost::mutex::scoped_lock lock(_mutex);
+		updateEnabledLogLevel();
+	}
+
+	// Threads still writing to the sinks may be walking the old list
+	_sinkWriterGracePeriod.wait();
+	delete old_entries;
+}
+
+void Log::destroySinkEntry(LogSinkEntry* entry)
+{
+	// The worker thread exits once it has written everything left in the queue
+	if (entry->thread)
+	{
+		entry->isThreadStopping = true;
+		{
+			boost::mutex::scoped_lock lock(entry->threadMutex);
+			entry->threadCondition.notify_one();
+		}
+		entry->thread->join();
+		delete entry->thread;
+		delete entry->queue;
+	}
+
+	entry->sink->flush();
+	delete entry;
+}
+
+void Log::writeBinaryRecord(LogCallSite& callSite, LogLevel logLevel, const String& prefix, const char* format,
+	const LogArgument* arguments, unsigned int argumentCount)
+{
+	unsigned int id = callSite.id.load(boost::memory_order_acquire);
+	if (id == 0)
+	{
+		id = registerCallSite(callSite, logLevel, format);
+	}
+
+	// Encode the record on this thread so the lock is only held for the copy
+	String& record = threadBinaryBuffer();
+	std::string& output = record;
+	output.clear();
+	size_t start = beginEntry(output, BinaryLogReader::RECORD_ENTRY);
+	appendRaw(output, id);
+	appendRaw(output, readTimestampCounter());
+	appendRawString(output, prefix.data(), prefix.size());
+	output.push_back(static_cast<char>(argumentCount));
+	for (unsigned int i = 0; i < argumentCount; ++i)
+	{
+		arguments[i].encodeTo(record);
+	}
+	endEntry(output, start);
+
+	boost::mutex::scoped_lock lock(_binaryBufferMutex, boost::defer_lock);
+	lockCounted(lock);
+	std::string& buffer = _binaryBuffer;
+	buffer.append(output);
+	if (buffer.size() >= BINARY_BUFFER_THRESHOLD || logLevel <= ERROR_LVL)
+	{
+		writeBinaryBufferLocked();
+	}
+}
+
+unsigned int Log::registerCallSite(LogCallSite& callSite, LogLevel logLevel, const char* format)
+{
+	boost::mutex::scoped_lock lock(_binaryBufferMutex);
+
+	// Another thread may have registered it in the meantime
+	unsigned int id = callSite.id.load(boost::memory_order_relaxed);
+	if (id != 0)
+	{
+		return id;
+	}
+
+	// The definition goes ahead of the first record in the buffer
+	callSite.format = format;
+	callSite.level = logLevel;
+	_callSites.push_back(&callSite);
+	id = static_cast<unsigned int>(_callSites.size());
+	callSite.id.store(id, boost::memory_order_release);
+	appendCallSiteEntry(_binaryBuffer, callSite);
+	return id;
+}
+
+void Log::writeBinaryBufferLocked()
+{
+	if (!_binarySink || _binaryBuffer.empty())
+	{
+		return;
+	}
+
+	// Re-anchor the counter so the decoded times don't drift
+	std::string& buffer = _binaryBuffer;
+	size_t start = beginEntry(buffer, BinaryLogReader::CALIBRATION_ENTRY);
+	appendCalibration(buffer);
+	endEntry(buffer, start);
+
+	LogSink::Buffer sink_buffer = { buffer.data(), buffer.size() };
+	unsigned long long write_start = steadyNanoseconds();
+	_binarySink->write(&sink_buffer, 1);
+
+	LogThreadStatistics* statistics = threadStatistics();
+	statistics->streamLatency.add(steadyNanoseconds() - write_start);
+	addToCounter(statistics->writtenByteCount, buffer.size());
+	buffer.clear();
+}
+
+void Log::enqueueMessage(LogLevel logLevel, const String& prefix, const String& message, bool newline)
+{
+	long long time = _isDateTimeFormatEnabled.load(boost::memory_order_relaxed) ? currentTimestamp() : -1;
+
+	FillLogRecord fill = { logLevel, time, prefix, message, newline };
+	unsigned long long blocked_start = 0;
+	while (!_queue->tryPush(fill))
+	{
+		if (_overflowPolicy == DROP_NEWEST_OVERFLOW)
+		{
+			++_droppedMessageCount;
+			return;
+		}
+		else if (_overflowPolicy == DROP_OLDEST_OVERFLOW)
+		{
+			if (_queue->tryDiscard())
+			{
+				++_droppedMessageCount;
+				++_completedMessageCount;
+			}
+		}
+		else // _overflowPolicy == BLOCK_OVERFLOW
+		{
+			blocked_start = blocked_start == 0 ? steadyNanoseconds() : blocked_start;
+			wakeWriterThread();
+
+			// Park until the writer thread makes room. It notifies under the writer mutex after
+			// every batch, so a batch written after the check below still wakes this thread.
+			boost::mutex::scoped_lock lock(_writerMutex);
+			if (_queue->size() >= _queue->capacity())
+			{
+				_flushCondition.wait(lock);
+			}
+		}
+	}
+
+	if (blocked_start != 0)
+	{
+		LogThreadStatistics* statistics = threadStatistics();
+		addToCounter(statistics->blockedCount, 1);
+		addToCounter(statistics->blockedNanoseconds, steadyNanoseconds() - blocked_start);
+	}
+
+	++_enqueuedMessageCount;
+	wakeWriterThread();
+}
+
+void Log::runWriterThread()
+{
+	// Reused for every message so the swapped string buffers keep circulating
+	LogRecord record;
+
+	while (true)
+	{
+		// Keep writing as long as there are messages
+		if (writeQueuedMessages(record) > 0)
+		{
+			continue;
+		}
+
+		// Only exit once stopping and everything has been written
+		if (_isWriterThreadStopping)
+		{
+			break;
+		}
+
+		// Wait for more messages. The flag is set before checking the queue again so a producer
+		// either sees the flag and signals, or pushed early enough for the check to see it.
+		boost::mutex::scoped_lock lock(_writerMutex);
+		_isWriterThreadWaiting = true;
+		boost::atomic_thread_fence(boost::memory_order_seq_cst);
+		if (_queue->isEmpty() && !_isWriterThreadStopping)
+		{
+			_writerCondition.timed_wait(lock, boost::posix_time::milliseconds(100));
+		}
+		_isWriterThreadWaiting = false;
+	}
+}
+
+unsigned int Log::writeQueuedMessages(LogRecord& record)
+{
+	unsigned int written_count = 0;
+	{
+		boost::mutex::scoped_lock lock(_mutex);
+
+		// Write at most one queue's worth so waiting flushes get notified regularly
+		SwapLogRecord swap = { record };
+		unsigned int capacity = _queue->capacity();
+		unsigned long long start = steadyNanoseconds();
+		while (written_count < capacity && _queue->tryPop(swap))
+		{
+			writeRecord(*_logStream, record);
+			++written_count;
+		}
+
+		if (written_count > 0)
+		{
+			_logStream->flush();
+			threadStatistics()->streamLatency.add(steadyNanoseconds() - start);
+		}
+	}
+
+	// Let any flush() calls know how far the writer thread has gotten
+	if (written_count > 0)
+	{
+		_completedMessageCount += written_count;
+		boost::mutex::scoped_lock writer_lock(_writerMutex);
+		_flushCondition.notify_all();
+	}
+
+	return written_count;
+}
+
+void Log::writeRecord(std::ostream& stream, const LogRecord& record)
+{
+	if (record.time >= 0)
+	{
+		writeTimestamp(stream, record.time);
+	}
+
+	stream << record.prefix << record.message;
+	if (record.newline)
+	{
+		stream << '\n';
+	}
+
+	size_t byte_count = record.prefix.size() + record.message.size() + (record.newline ? 1 : 0);
+	addToCounter(threadStatistics()->writtenByteCount, byte_count);
+}
+
+void Log::wakeWriterThread()
+{
+	// Pairs with the fence in runWriterThread() so the push is visible before the flag is read
+	boost::atomic_thread_fence(boost::memory_order_seq_cst);
+	if (_isWriterThreadWaiting.load(boost::memory_order_relaxed))
+	{
+		boost::mutex::scoped_lock lock(_writerMutex);
+		_writerCondition.notify_one();
+	}
+}
+
+void Log::appendToThreadBuffer(LogLevel logLevel, const String& prefix, const String& message, bool newline)
+{
+	LogThreadBuffer* buffer = threadBuffer();
+	bool should_write = false;
+	{
+		boost::mutex::scoped_lock lock(buffer->mutex, boost::defer_lock);
+		lockCounted(lock);
+		appendLine(buffer->data, prefix, message, newline);
+		should_write = buffer->data.size() >= _flushPolicy.byteThreshold || logLevel <= _flushPolicy.immediateLevel;
+	}
+
+	if (should_write)
+	{
+		writeThreadBuffers();
+	}
+}
+
+LogThreadBuffer* Log::threadBuffer()
+{
+	ThreadBufferOwner& owner = threadBufferOwner();
+	if (owner.buffer)
+	{
+		return owner.buffer;
+	}
+
+	// Take over the buffer of a thread that has exited, or add a new one
+	boost::mutex::scoped_lock lock(_mutex);
+	for (LogThreadBuffer* buffer = _threadBuffers; buffer; buffer = buffer->next)
+	{
+		bool is_in_use = false;
+		if (buffer->isInUse.compare_exchange_strong(is_in_use, true))
+		{
+			owner.buffer = buffer;
+			return buffer;
+		}
+	}
+
+	LogThreadBuffer* buffer = new LogThreadBuffer();
+	buffer->isInUse = true;
+	buffer->next = _threadBuffers;
+	_threadBuffers = buffer;
+	owner.buffer = buffer;
+	return buffer;
+}
+
+void Log::writeThreadBuffers()
+{
+	boost::mutex::scoped_lock lock(_mutex, boost::defer_lock);
+	lockCounted(lock);
+	writeThreadBuffersLocked();
 }
 
-String Log::convertTimeToString()
+void Log::writeThreadBuffersLocked()
 {
-	// Get the time using boost
-	boost::posix_time::ptime now = boost::posix_time::second_clock::local_time();
+	// Swap every buffer's messages out so the threads can keep appending while they're written
+	_sinkBuffers.clear();
+	for (LogThreadBuffer* buffer = _threadBuffers; buffer; buffer = buffer->next)
+	{
+		{
+			boost::mutex::scoped_lock lock(buffer->mutex);
+			buffer->pending.swap(buffer->data);
+		}
 
-	// Build strings for each time value from the boost ptime value
-	String year = static_cast<long>(now.date().year());
-	String month = static_cast<long>(now.date().month());
-	String day = static_cast<long>(now.date().day());
-	String hours = static_cast<long>(now.time_of_day().hours());
-	String minutes = static_cast<long>(now.time_of_day().minutes());
-	String seconds = static_cast<long>(now.time_of_day().seconds());
+		if (!buffer->pending.empty())
+		{
+			LogSink::Buffer sink_buffer = { buffer->pending.data(), buffer->pending.size() };
+			_sinkBuffers.push_back(sink_buffer);
+		}
+	}
+
+	if (_sinkBuffers.empty())
+	{
+		return;
+	}
+
+	// Sinks take the whole batch at once, after anything already written to their stream
+	unsigned long long start = steadyNanoseconds();
+	size_t byte_count = 0;
+	for (size_t i = 0; i < _sinkBuffers.size(); ++i)
+	{
+		byte_count += _sinkBuffers[i].size;
+	}
+
+	if (_logSink)
+	{
+		_logStream->flush();
+		_logSink->write(&_sinkBuffers[0], static_cast<unsigned int>(_sinkBuffers.size()));
+		_logSink->flush();
+	}
+	else
+	{
+		for (size_t i = 0; i < _sinkBuffers.size(); ++i)
+		{
+			_logStream->write(_sinkBuffers[i].data, static_cast<std::streamsize>(_sinkBuffers[i].size));
+		}
+		_logStream->flush();
+	}
+
+	LogThreadStatistics* statistics = threadStatistics();
+	statistics->streamLatency.add(steadyNanoseconds() - start);
+	addToCounter(statistics->writtenByteCount, byte_count);
+
+	// Clearing keeps the capacity for the next swap
+	for (LogThreadBuffer* buffer = _threadBuffers; buffer; buffer = buffer->next)
+	{
+		buffer->pending.clear();
+	}
+}
+
+void Log::runFlusherThread()
+{
+	boost::mutex::scoped_lock lock(_flusherMutex);
+	while (!_isFlusherThreadStopping)
+	{
+		_flusherCondition.timed_wait(lock, boost::posix_time::milliseconds(_flushPolicy.intervalMilliseconds));
+		if (_isFlusherThreadStopping)
+		{
+			break;
+		}
 
-	// Figure out if we're AM or PM
-	String am_pm = hours.toInt() < 13 ? "AM" : "PM";
+		lock.unlock();
+		writeThreadBuffers();
+		lock.lock();
+	}
+}
 
-	// Correct the hours if larger than 12
-	if (hours.toInt() > 12)
+LogThreadStatistics* Log::threadStatistics()
+{
+	// Whatever is still logged while the log is being destroyed is counted where nobody looks
+	if (gAreThreadStatisticsDestroyed.load(boost::memory_order_relaxed))
 	{
-		hours = hours.toInt() - 12;
+		static LogThreadStatistics discarded_statistics;
+		return &discarded_statistics;
 	}
 
-	// Pad the month, day, hours, minutes and seconds
-	month.padWithString("0", 2);
-	day.padWithString("0", 2);
-	hours.padWithString("0", 2);
-	minutes.padWithString("0", 2);
-	seconds.padWithString("0", 2);
+	ThreadStatisticsOwner& owner = threadStatisticsOwner();
+	if (owner.statistics)
+	{
+		return owner.statistics;
+	}
 
-	// Now create a string representation of the timestamp based on the timestamp format
-	if (_timestampFormat == DATE_TIME_TIMESTAMP)
+	// Take over the statistics of a thread that has exited, or add new ones. This has a mutex
+	// of its own since the statistics are also counted with the log stream mutex locked.
+	boost::mutex::scoped_lock lock(_statisticsMutex);
+	for (LogThreadStatistics* statistics = _threadStatistics.load(); statistics; statistics = statistics->next)
 	{
-		return String("%1-%2-%3 %4:%5:%6:").arg(year, month, day, hours, minutes, seconds);
+		bool is_in_use = false;
+		if (statistics->isInUse.compare_exchange_strong(is_in_use, true))
+		{
+			owner.statistics = statistics;
+			return statistics;
+		}
 	}
-	else if (_timestampFormat == DATE_TIME_WITH_AM_PM_TIMESTAMP)
+
+	LogThreadStatistics* statistics = new LogThreadStatistics();
+	statistics->isInUse = true;
+	statistics->next = _threadStatistics.load();
+	_threadStatistics = statistics;
+	owner.statistics = statistics;
+	return statistics;
+}
+
+void Log::lockCounted(boost::mutex::scoped_lock& lock)
+{
+	// Only reading the clock when actually waiting keeps the uncontended case free
+	if (lock.try_lock())
 	{
-		return String("%1-%2-%3 %4:%5:%6 %7:").arg(year, month, day, hours, minutes, seconds, am_pm);
+		return;
 	}
-	else if (_timestampFormat == DATE_TIME_TIMESTAMP)
+
+	unsigned long long start = steadyNanoseconds();
+	lock.lock();
+	LogThreadStatistics* statistics = threadStatistics();
+	addToCounter(statistics->blockedCount, 1);
+	addToCounter(statistics->blockedNanoseconds, steadyNanoseconds() - start);
+}
+
+void Log::updateEnabledLogLevel()
+{
+	int other_log_level = std::max(_sinkLogLevel.load(), _flightRecorderLogLevel.load());
+	int enabled_log_level = std::max(static_cast<int>(_logLevel.load()), other_log_level);
+	_enabledLogLevel = _isEnabled ? enabled_log_level : -1;
+
+	// Each logger takes the log stream level it inherits in place of the log level
+	for (std::map<String, Logger*>::iterator it = _loggers.begin(); it != _loggers.end(); ++it)
 	{
-		return String("%1:%2:%3:").arg(hours, minutes, seconds);
+		LogLevel logger_level = loggerLevelLocked(it->first);
+		enabled_log_level = std::max(static_cast<int>(logger_level), other_log_level);
+		it->second->updateLogLevelsLocked(logger_level, _isEnabled ? enabled_log_level : -1);
 	}
-	else // _timestampFormat == TIME_WITH_AM_PM_TIMESTAMP
+}
+
+Log::LogLevel Log::loggerLevelLocked(const String& name)
+{
+	// Walk up the dot separated hierarchy to the closest name with a level
+	String ancestor = name;
+	while (!ancestor.empty())
 	{
-		return String("%1:%2:%3 %4:").arg(hours, minutes, seconds, am_pm);
+		std::map<String, LogLevel>::const_iterator it = _loggerLevels.find(ancestor);
+		if (it != _loggerLevels.end())
+		{
+			return it->second;
+		}
+
+		int separator = ancestor.lastIndexOf(".");
+		ancestor = separator > 0 ? ancestor.left(separator) : String();
 	}
+
+	return _logLevel;
 }
 
 boost::mutex& Log::convenienceFunctionMutex()
@@ -275,202 +2383,226 @@ boost::mutex& Log::convenienceFunctionMutex()
 	return _convenienceFunctionMutex;
 }
 
+double Log::LatencyHistogram::percentileMicroseconds(double percentile) const
+{
+	if (count == 0)
+	{
+		return 0.0;
+	}
+
+	// Find the bucket the percentile falls into and return its upper limit
+	unsigned long long target_count = static_cast<unsigned long long>(std::ceil(percentile * count));
+	target_count = std::max(target_count, 1ULL);
+	unsigned long long cumulative_count = 0;
+	for (unsigned int i = 0; i < BUCKET_COUNT - 1; ++i)
+	{
+		cumulative_count += bucketCounts[i];
+		if (cumulative_count >= target_count)
+		{
+			return std::min(static_cast<double>(1ULL << i), maxNanoseconds / 1000.0);
+		}
+	}
+
+	// The last bucket has no upper limit, but nothing took longer than the slowest write
+	return maxNanoseconds / 1000.0;
+}
+
 }	// End of bump namespace
 
 void bumpALWAYS(const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::ALWAYS_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::ALWAYS_LVL))
 	{
-		bump::Log::instance()->logStream() << message << std::endl;
+		log->writeMessage(bump::Log::ALWAYS_LVL, bump::String(), message, true);
 	}
 }
 
 void bumpERROR(const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::ERROR_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::ERROR_LVL))
 	{
-		bump::Log::instance()->logStream() << message << std::endl;
+		log->writeMessage(bump::Log::ERROR_LVL, bump::String(), message, true);
 	}
 }
 
 void bumpWARNING(const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::WARNING_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::WARNING_LVL))
 	{
-		bump::Log::instance()->logStream() << message << std::endl;
+		log->writeMessage(bump::Log::WARNING_LVL, bump::String(), message, true);
 	}
 }
 
 void bumpINFO(const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::INFO_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::INFO_LVL))
 	{
-		bump::Log::instance()->logStream() << message << std::endl;
+		log->writeMessage(bump::Log::INFO_LVL, bump::String(), message, true);
 	}
 }
 
 void bumpDEBUG(const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::DEBUG_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::DEBUG_LVL))
 	{
-		bump::Log::instance()->logStream() << message << std::endl;
+		log->writeMessage(bump::Log::DEBUG_LVL, bump::String(), message, true);
 	}
 }
 
 void bumpNEWLINE()
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::ALWAYS_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::ALWAYS_LVL))
 	{
-		bump::Log::instance()->logStream() << std::endl;
+		log->writeMessage(bump::Log::ALWAYS_LVL, bump::String(), bump::String(), true);
 	}
 }
 
 void bumpALWAYS_F(const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::ALWAYS_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::ALWAYS_LVL))
 	{
-		std::flush(bump::Log::instance()->logStream() << message);
+		log->writeMessage(bump::Log::ALWAYS_LVL, bump::String(), message, false);
 	}
 }
 
 void bumpERROR_F(const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::ERROR_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::ERROR_LVL))
 	{
-		std::flush(bump::Log::instance()->logStream() << message);
+		log->writeMessage(bump::Log::ERROR_LVL, bump::String(), message, false);
 	}
 }
 
 void bumpWARNING_F(const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::WARNING_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::WARNING_LVL))
 	{
-		std::flush(bump::Log::instance()->logStream() << message);
+		log->writeMessage(bump::Log::WARNING_LVL, bump::String(), message, false);
 	}
 }
 
 void bumpINFO_F(const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::INFO_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::INFO_LVL))
 	{
-		std::flush(bump::Log::instance()->logStream() << message);
+		log->writeMessage(bump::Log::INFO_LVL, bump::String(), message, false);
 	}
 }
 
 void bumpDEBUG_F(const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::DEBUG_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::DEBUG_LVL))
 	{
-		std::flush(bump::Log::instance()->logStream() << message);
+		log->writeMessage(bump::Log::DEBUG_LVL, bump::String(), message, false);
 	}
 }
 
 void bumpALWAYS_P(const bump::String& prefix, const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::ALWAYS_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::ALWAYS_LVL))
 	{
-		bump::Log::instance()->logStream(prefix) << message << std::endl;
+		log->writeMessage(bump::Log::ALWAYS_LVL, prefix, message, true);
 	}
 }
 
 void bumpERROR_P(const bump::String& prefix, const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::ERROR_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::ERROR_LVL))
 	{
-		bump::Log::instance()->logStream(prefix) << message << std::endl;
+		log->writeMessage(bump::Log::ERROR_LVL, prefix, message, true);
 	}
 }
 
 void bumpWARNING_P(const bump::String& prefix, const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::WARNING_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::WARNING_LVL))
 	{
-		bump::Log::instance()->logStream(prefix) << message << std::endl;
+		log->writeMessage(bump::Log::WARNING_LVL, prefix, message, true);
 	}
 }
 
 void bumpINFO_P(const bump::String& prefix, const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::INFO_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::INFO_LVL))
 	{
-		bump::Log::instance()->logStream(prefix) << message << std::endl;
+		log->writeMessage(bump::Log::INFO_LVL, prefix, message, true);
 	}
 }
 
 void bumpDEBUG_P(const bump::String& prefix, const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::DEBUG_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::DEBUG_LVL))
 	{
-		bump::Log::instance()->logStream(prefix) << message << std::endl;
+		log->writeMessage(bump::Log::DEBUG_LVL, prefix, message, true);
 	}
 }
 
 void bumpNEWLINE_P(const bump::String& prefix)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::ALWAYS_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::ALWAYS_LVL))
 	{
-		bump::Log::instance()->logStream(prefix) << std::endl;
+		log->writeMessage(bump::Log::ALWAYS_LVL, prefix, bump::String(), true);
 	}
 }
 
 void bumpALWAYS_PF(const bump::String& prefix, const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::ALWAYS_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::ALWAYS_LVL))
 	{
-		std::flush(bump::Log::instance()->logStream(prefix) << message);
+		log->writeMessage(bump::Log::ALWAYS_LVL, prefix, message, false);
 	}
 }
 
 void bumpERROR_PF(const bump::String& prefix, const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::ERROR_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::ERROR_LVL))
 	{
-		std::flush(bump::Log::instance()->logStream(prefix) << message);
+		log->writeMessage(bump::Log::ERROR_LVL, prefix, message, false);
 	}
 }
 
 void bumpWARNING_PF(const bump::String& prefix, const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::WARNING_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::WARNING_LVL))
 	{
-		std::flush(bump::Log::instance()->logStream(prefix) << message);
+		log->writeMessage(bump::Log::WARNING_LVL, prefix, message, false);
 	}
 }
 
 void bumpINFO_PF(const bump::String& prefix, const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::INFO_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::INFO_LVL))
 	{
-		std::flush(bump::Log::instance()->logStream(prefix) << message);
+		log->writeMessage(bump::Log::INFO_LVL, prefix, message, false);
 	}
 }
 
 void bumpDEBUG_PF(const bump::String& prefix, const bump::String& message)
 {
-	boost::mutex::scoped_lock lock(bump::Log::instance()->convenienceFunctionMutex());
-	if (bump::Log::instance()->isLogLevelEnabled(bump::Log::DEBUG_LVL))
+	bump::Log* log = bump::Log::instance();
+	if (log->isLogLevelEnabled(bump::Log::DEBUG_LVL))
 	{
-		std::flush(bump::Log::instance()->logStream(prefix) << message);
+		log->writeMessage(bump::Log::DEBUG_LVL, prefix, message, false);
 	}
 }
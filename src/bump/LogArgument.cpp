@@ -0,0 +1,490 @@
+//
+//	LogArgument.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+// Bump headers
+#include <bump/LogArgument.h>
+
+namespace bump {
+
+namespace // local
+{
+	// The length written in place of a null string
+	const unsigned int NULL_STRING_LENGTH = 0xFFFFFFFF;
+
+	// Appends the raw bytes of the value
+	template <typename T>
+	void appendRaw(std::string& output, const T& value)
+	{
+		output.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	// Reads the raw bytes of a value, returning NULL if there aren't enough
+	template <typename T>
+	const char* readRaw(const char* data, const char* end, T& value)
+	{
+		if (!data || static_cast<size_t>(end - data) < sizeof(T))
+		{
+			return NULL;
+		}
+
+		std::memcpy(&value, data, sizeof(T));
+		return data + sizeof(T);
+	}
+
+	// Copies as many of the characters as fit, returning how many were copied
+	size_t copyCharacters(char* data, size_t capacity, const char* characters, size_t length)
+	{
+		size_t copied = length < capacity ? length : capacity;
+		for (size_t i = 0; i < copied; ++i)
+		{
+			data[i] = characters[i];
+		}
+
+		return copied;
+	}
+
+	// Writes the number in the given base without the C library, returning the number of characters
+	size_t formatUnsigned(char* data, size_t capacity, unsigned long long value, unsigned int base, size_t minimumDigits = 1)
+	{
+		char digits[64];
+		size_t digit_count = 0;
+		while (value > 0 || digit_count < minimumDigits)
+		{
+			digits[digit_count++] = "0123456789abcdef"[value % base];
+			value /= base;
+		}
+
+		size_t length = 0;
+		while (digit_count > 0 && length < capacity)
+		{
+			data[length++] = digits[--digit_count];
+		}
+
+		return length;
+	}
+
+	// Writes the double with at most six decimals, or in scientific notation when it is too large
+	size_t formatDouble(char* data, size_t capacity, double value)
+	{
+		size_t length = 0;
+		if (value != value)
+		{
+			return copyCharacters(data, capacity, "nan", 3);
+		}
+
+		if (value < 0.0)
+		{
+			length += copyCharacters(data, capacity, "-", 1);
+			value = -value;
+		}
+
+		if (value > std::numeric_limits<double>::max())
+		{
+			return length + copyCharacters(data + length, capacity - length, "inf", 3);
+		}
+
+		int exponent = 0;
+		while (value >= 1e18)
+		{
+			value /= 10.0;
+			++exponent;
+		}
+
+		// Round to six decimals first so 0.9999999 carries into the integer part
+		unsigned long long micros = static_cast<unsigned long long>(value * 1000000.0 + 0.5);
+		unsigned long long integer = micros / 1000000;
+		unsigned long long fraction = micros % 1000000;
+		length += formatUnsigned(data + length, capacity - length, integer, 10);
+
+		if (fraction > 0)
+		{
+			size_t digit_count = 6;
+			while (fraction % 10 == 0)
+			{
+				fraction /= 10;
+				--digit_count;
+			}
+			length += copyCharacters(data + length, capacity - length, ".", 1);
+			length += formatUnsigned(data + length, capacity - length, fraction, 10, digit_count);
+		}
+
+		if (exponent > 0)
+		{
+			length += copyCharacters(data + length, capacity - length, "e+", 2);
+			length += formatUnsigned(data + length, capacity - length, exponent, 10);
+		}
+
+		return length;
+	}
+
+}	// End of local namespace
+
+void LogArgument::appendTo(String& buffer) const
+{
+	// Large enough for any integer, float, double or pointer
+	char characters[64];
+
+	// String::append() hides the std::string overloads taking ranges and lengths
+	std::string& output = buffer;
+
+	switch (_type)
+	{
+		case SIGNED_TYPE:
+		{
+			std::to_chars_result result = std::to_chars(characters, characters + sizeof(characters), _value.signedValue);
+			output.append(characters, result.ptr);
+			break;
+		}
+		case UNSIGNED_TYPE:
+		{
+			std::to_chars_result result = std::to_chars(characters, characters + sizeof(characters), _value.unsignedValue);
+			output.append(characters, result.ptr);
+			break;
+		}
+		case FLOAT_TYPE:
+		{
+			// Same as the default bump::String float precision
+			int length = std::snprintf(characters, sizeof(characters), "%.*g", std::numeric_limits<float>::digits10 + 1, _value.doubleValue);
+			output.append(characters, length);
+			break;
+		}
+		case DOUBLE_TYPE:
+		{
+			// Same as the default bump::String double precision
+			int length = std::snprintf(characters, sizeof(characters), "%.*g", std::numeric_limits<double>::digits10 + 1, _value.doubleValue);
+			output.append(characters, length);
+			break;
+		}
+		case BOOL_TYPE:
+		{
+			output.append(_value.boolValue ? "true" : "false");
+			break;
+		}
+		case STRING_TYPE:
+		{
+			if (_value.stringValue.data)
+			{
+				output.append(_value.stringValue.data, _value.stringValue.length);
+			}
+			else
+			{
+				output.append("(null)");
+			}
+			break;
+		}
+		case POINTER_TYPE:
+		{
+			int length = std::snprintf(characters, sizeof(characters), "%p", _value.pointerValue);
+			output.append(characters, length);
+			break;
+		}
+	}
+}
+
+void LogArgument::encodeTo(String& buffer) const
+{
+	// String::append() hides the std::string overload taking a length
+	std::string& output = buffer;
+	output.push_back(static_cast<char>(_type));
+
+	switch (_type)
+	{
+		case SIGNED_TYPE:
+			appendRaw(output, _value.signedValue);
+			break;
+		case UNSIGNED_TYPE:
+			appendRaw(output, _value.unsignedValue);
+			break;
+		case FLOAT_TYPE:
+		case DOUBLE_TYPE:
+			appendRaw(output, _value.doubleValue);
+			break;
+		case BOOL_TYPE:
+			output.push_back(_value.boolValue ? 1 : 0);
+			break;
+		case STRING_TYPE:
+		{
+			if (_value.stringValue.data)
+			{
+				appendRaw(output, static_cast<unsigned int>(_value.stringValue.length));
+				output.append(_value.stringValue.data, _value.stringValue.length);
+			}
+			else
+			{
+				appendRaw(output, NULL_STRING_LENGTH);
+			}
+			break;
+		}
+		case POINTER_TYPE:
+			appendRaw(output, static_cast<unsigned long long>(reinterpret_cast<size_t>(_value.pointerValue)));
+			break;
+	}
+}
+
+size_t LogArgument::encodeTo(char* data, size_t capacity) const
+{
+	// Every type fits in the type byte plus 8 bytes, and strings need at least their length
+	const size_t header_size = 1 + (_type == STRING_TYPE ? sizeof(unsigned int) : 0);
+	if (capacity < header_size)
+	{
+		return 0;
+	}
+
+	data[0] = static_cast<char>(_type);
+	switch (_type)
+	{
+		case SIGNED_TYPE:
+		case UNSIGNED_TYPE:
+		case FLOAT_TYPE:
+		case DOUBLE_TYPE:
+		case POINTER_TYPE:
+		{
+			if (capacity < 1 + sizeof(unsigned long long))
+			{
+				return 0;
+			}
+
+			unsigned long long value = 0;
+			if (_type == POINTER_TYPE)
+			{
+				value = static_cast<unsigned long long>(reinterpret_cast<size_t>(_value.pointerValue));
+			}
+			else
+			{
+				std::memcpy(&value, &_value, sizeof(value));
+			}
+			std::memcpy(data + 1, &value, sizeof(value));
+			return 1 + sizeof(value);
+		}
+		case BOOL_TYPE:
+		{
+			if (capacity < 2)
+			{
+				return 0;
+			}
+
+			data[1] = _value.boolValue ? 1 : 0;
+			return 2;
+		}
+		case STRING_TYPE:
+		{
+			unsigned int length = NULL_STRING_LENGTH;
+			if (_value.stringValue.data)
+			{
+				length = static_cast<unsigned int>(std::min(_value.stringValue.length, capacity - header_size));
+				std::memcpy(data + header_size, _value.stringValue.data, length);
+			}
+			std::memcpy(data + 1, &length, sizeof(length));
+			return header_size + (length == NULL_STRING_LENGTH ? 0 : length);
+		}
+	}
+
+	return 0;
+}
+
+size_t LogArgument::formatTo(char* data, size_t capacity) const
+{
+	switch (_type)
+	{
+		case SIGNED_TYPE:
+		{
+			// Negating as unsigned also works for the most negative value
+			if (_value.signedValue < 0)
+			{
+				size_t length = copyCharacters(data, capacity, "-", 1);
+				unsigned long long magnitude = 0ULL - static_cast<unsigned long long>(_value.signedValue);
+				return length + formatUnsigned(data + length, capacity - length, magnitude, 10);
+			}
+			return formatUnsigned(data, capacity, static_cast<unsigned long long>(_value.signedValue), 10);
+		}
+		case UNSIGNED_TYPE:
+			return formatUnsigned(data, capacity, _value.unsignedValue, 10);
+		case FLOAT_TYPE:
+		case DOUBLE_TYPE:
+			return formatDouble(data, capacity, _value.doubleValue);
+		case BOOL_TYPE:
+			return _value.boolValue ? copyCharacters(data, capacity, "true", 4) : copyCharacters(data, capacity, "false", 5);
+		case STRING_TYPE:
+		{
+			if (_value.stringValue.data)
+			{
+				return copyCharacters(data, capacity, _value.stringValue.data, _value.stringValue.length);
+			}
+			return copyCharacters(data, capacity, "(null)", 6);
+		}
+		case POINTER_TYPE:
+		{
+			size_t length = copyCharacters(data, capacity, "0x", 2);
+			unsigned long long address = static_cast<unsigned long long>(reinterpret_cast<size_t>(_value.pointerValue));
+			return length + formatUnsigned(data + length, capacity - length, address, 16);
+		}
+	}
+
+	return 0;
+}
+
+void LogArgument::appendJsonTo(String& buffer) const
+{
+	// String::append() hides the std::string overloads taking ranges and lengths
+	std::string& output = buffer;
+
+	switch (_type)
+	{
+		case FLOAT_TYPE:
+		case DOUBLE_TYPE:
+		{
+			if (!std::isfinite(_value.doubleValue))
+			{
+				output.append("null");
+				return;
+			}
+			appendTo(buffer);
+			break;
+		}
+		case STRING_TYPE:
+		{
+			if (_value.stringValue.data)
+			{
+				appendJsonString(buffer, _value.stringValue.data, _value.stringValue.length);
+			}
+			else
+			{
+				output.append("null");
+			}
+			break;
+		}
+		case POINTER_TYPE:
+		{
+			char characters[32];
+			size_t length = formatTo(characters, sizeof(characters));
+			appendJsonString(buffer, characters, length);
+			break;
+		}
+		default:
+		{
+			appendTo(buffer);
+			break;
+		}
+	}
+}
+
+void LogArgument::appendJsonString(String& buffer, const char* data, size_t length)
+{
+	static const char HEX_DIGITS[] = "0123456789abcdef";
+
+	// String::append() hides the std::string overloads taking ranges and lengths
+	std::string& output = buffer;
+	output.push_back('"');
+
+	// Copy the runs of characters that need no escaping in one go
+	const char* end = data + length;
+	const char* run_start = data;
+	for (const char* position = data; position != end; ++position)
+	{
+		unsigned char character = static_cast<unsigned char>(*position);
+		if (character >= 0x20 && character != '"' && character != '\\')
+		{
+			continue;
+		}
+
+		output.append(run_start, position);
+		run_start = position + 1;
+		switch (character)
+		{
+			case '"':	output.append("\\\"");	break;
+			case '\\':	output.append("\\\\");	break;
+			case '\n':	output.append("\\n");	break;
+			case '\r':	output.append("\\r");	break;
+			case '\t':	output.append("\\t");	break;
+			default:
+			{
+				char escape[] = { '\\', 'u', '0', '0', HEX_DIGITS[character >> 4], HEX_DIGITS[character & 0xF] };
+				output.append(escape, sizeof(escape));
+				break;
+			}
+		}
+	}
+
+	output.append(run_start, end);
+	output.push_back('"');
+}
+
+const char* LogArgument::decode(const char* data, const char* end, LogArgument& argument)
+{
+	unsigned char type = 0;
+	data = readRaw(data, end, type);
+	if (!data)
+	{
+		return NULL;
+	}
+
+	switch (type)
+	{
+		case SIGNED_TYPE:
+			argument._type = SIGNED_TYPE;
+			return readRaw(data, end, argument._value.signedValue);
+		case UNSIGNED_TYPE:
+			argument._type = UNSIGNED_TYPE;
+			return readRaw(data, end, argument._value.unsignedValue);
+		case FLOAT_TYPE:
+		case DOUBLE_TYPE:
+			argument._type = static_cast<Type>(type);
+			return readRaw(data, end, argument._value.doubleValue);
+		case BOOL_TYPE:
+		{
+			unsigned char value = 0;
+			data = readRaw(data, end, value);
+			argument._type = BOOL_TYPE;
+			argument._value.boolValue = value != 0;
+			return data;
+		}
+		case STRING_TYPE:
+		{
+			unsigned int length = 0;
+			data = readRaw(data, end, length);
+			if (!data)
+			{
+				return NULL;
+			}
+
+			argument._type = STRING_TYPE;
+			if (length == NULL_STRING_LENGTH)
+			{
+				argument.setString(NULL, 0);
+				return data;
+			}
+			else if (static_cast<size_t>(end - data) < length)
+			{
+				return NULL;
+			}
+
+			argument.setString(data, length);
+			return data + length;
+		}
+		case POINTER_TYPE:
+		{
+			unsigned long long value = 0;
+			data = readRaw(data, end, value);
+			argument._type = POINTER_TYPE;
+			argument._value.pointerValue = reinterpret_cast<const void*>(static_cast<size_t>(value));
+			return data;
+		}
+		default:
+			return NULL;
+	}
+}
+
+}	// End of bump namespace
@@ -0,0 +1,54 @@
+//
+//	LogField.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <cstring>
+
+// Bump headers
+#include <bump/LogField.h>
+
+namespace bump {
+
+LogFieldName::LogFieldName(const char* name) :
+	_name(name),
+	_jsonKey()
+{
+	LogArgument::appendJsonString(_jsonKey, name, std::strlen(name));
+	static_cast<std::string&>(_jsonKey).push_back(':');
+}
+
+LogFieldName::~LogFieldName()
+{
+	;
+}
+
+void LogField::appendJsonTo(String& buffer) const
+{
+	// String::append() hides the std::string overloads
+	std::string& output = buffer;
+	output.append(_name->jsonKey());
+	_value.appendJsonTo(buffer);
+}
+
+void LogField::appendTextTo(String& buffer) const
+{
+	// String::append() hides the std::string overloads
+	std::string& output = buffer;
+	output.append(_name->name());
+	output.push_back('=');
+	if (_value.type() == LogArgument::STRING_TYPE)
+	{
+		_value.appendJsonTo(buffer);
+	}
+	else
+	{
+		_value.appendTo(buffer);
+	}
+}
+
+}	// End of bump namespace
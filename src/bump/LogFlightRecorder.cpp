@@ -0,0 +1,486 @@
+//
+//	LogFlightRecorder.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <cstring>
+#include <sstream>
+
+// Boost headers
+#include <boost/thread/thread.hpp>
+
+// Bump headers
+#include <bump/LogFlightRecorder.h>
+
+namespace bump {
+
+namespace // local
+{
+	// The bytes of a record left for the prefix and the arguments, keeping each record at 256 bytes
+	const size_t RECORD_DATA_SIZE = 256 - 24;
+
+	// The states a ring goes through, orphaned once its recorder is destroyed while a thread still owns it
+	enum RingState
+	{
+		RING_FREE,
+		RING_IN_USE,
+		RING_ORPHANED
+	};
+
+	// Tells the rings of each recorder apart, since a thread can outlive several of them
+	boost::atomic<unsigned long long> gNextRecorderId(1);
+
+}	// End of local namespace
+
+/**
+ * A single record in a flight recorder ring.
+ *
+ * The sequence is odd while the owning thread writes the record, so a dump can tell a
+ * record it read halfway through an update apart from a complete one.
+ */
+struct LogFlightRecord
+{
+	boost::atomic<unsigned int>		sequence;				/**< Odd while the record is being written. */
+	unsigned char					level;					/**< The log level of the message. */
+	unsigned char					argumentCount;			/**< The number of arguments that fit in the data. */
+	unsigned short					size;					/**< The number of bytes of data used. */
+	long long						time;					/**< The microseconds since the Unix epoch the message was logged. */
+	const char*						format;					/**< The message with %1 - %99 markers for the arguments. */
+	char							data[RECORD_DATA_SIZE];	/**< The encoded prefix followed by the encoded arguments. */
+};
+
+/**
+ * The records of a single thread.
+ *
+ * Rings are only ever pushed onto the recorder's list, so a dump can walk it without a lock.
+ * When a thread exits, its ring is released for the next new thread to take over.
+ */
+struct LogFlightRing
+{
+	boost::atomic<int>					state;				/**< The RingState of the ring. */
+	unsigned long long					recorderId;			/**< The id of the recorder the ring belongs to. */
+	char								threadName[32];		/**< The id of the owning thread, formatted ahead of time. */
+	boost::atomic<unsigned long long>	writtenCount;		/**< The number of records written by the owning thread. */
+	LogFlightRecord*					records;			/**< The records, indexed by the written count modulo the record count. */
+	LogFlightRing*						next;				/**< The next ring in the list. */
+};
+
+namespace // local
+{
+	// Frees a ring along with its records
+	void deleteRing(LogFlightRing* ring)
+	{
+		delete [] ring->records;
+		delete ring;
+	}
+
+	// Gives up a ring, freeing it when its recorder is already gone
+	void releaseRing(LogFlightRing* ring)
+	{
+		int state = RING_IN_USE;
+		if (!ring->state.compare_exchange_strong(state, RING_FREE))
+		{
+			deleteRing(ring);
+		}
+	}
+
+	// Releases the calling thread's ring when the thread exits
+	struct ThreadRingOwner
+	{
+		LogFlightRing* ring;
+
+		~ThreadRingOwner()
+		{
+			if (ring)
+			{
+				releaseRing(ring);
+			}
+		}
+	};
+
+	// Returns the owner of the calling thread's ring
+	ThreadRingOwner& threadRingOwner()
+	{
+		static thread_local ThreadRingOwner owner = { NULL };
+		return owner;
+	}
+
+	// Collects the dump in a fixed buffer and writes it out whenever it fills up
+	class DumpWriter
+	{
+	public:
+
+		DumpWriter(intptr_t file, bool (*write)(intptr_t, const char*, size_t)) :
+			_file(file),
+			_write(write),
+			_size(0),
+			_isWritten(true)
+		{
+			;
+		}
+
+		// Makes sure the given number of characters fit in the buffer
+		void reserve(size_t size)
+		{
+			if (sizeof(_buffer) - _size < size)
+			{
+				flush();
+			}
+		}
+
+		void append(const char* characters, size_t length)
+		{
+			reserve(length);
+			size_t copied = length < sizeof(_buffer) - _size ? length : sizeof(_buffer) - _size;
+			std::memcpy(_buffer + _size, characters, copied);
+			_size += copied;
+		}
+
+		void append(const char* characters)
+		{
+			append(characters, std::strlen(characters));
+		}
+
+		void append(const LogArgument& argument)
+		{
+			reserve(RECORD_DATA_SIZE);
+			_size += argument.formatTo(_buffer + _size, sizeof(_buffer) - _size);
+		}
+
+		// Appends the number padded with zeros to the given number of digits
+		void appendNumber(unsigned long long value, unsigned int digits)
+		{
+			char characters[20];
+			unsigned int length = 0;
+			while (value > 0 || length < digits)
+			{
+				characters[sizeof(characters) - 1 - length] = static_cast<char>('0' + value % 10);
+				value /= 10;
+				++length;
+			}
+			append(characters + sizeof(characters) - length, length);
+		}
+
+		bool flush()
+		{
+			if (_size > 0)
+			{
+				_isWritten = _write(_file, _buffer, _size) && _isWritten;
+				_size = 0;
+			}
+
+			return _isWritten;
+		}
+
+	private:
+
+		intptr_t		_file;
+		bool			(*_write)(intptr_t, const char*, size_t);
+		char			_buffer[4096];
+		size_t			_size;
+		bool			_isWritten;
+	};
+
+	// Writes the time as a UTC date and time down to the microsecond without the C library
+	void appendTimestamp(DumpWriter& writer, long long microseconds)
+	{
+		long long seconds = microseconds / 1000000;
+		long long fraction = microseconds % 1000000;
+		if (fraction < 0)
+		{
+			fraction += 1000000;
+			--seconds;
+		}
+
+		long long days = seconds / 86400;
+		long long second_of_day = seconds % 86400;
+		if (second_of_day < 0)
+		{
+			second_of_day += 86400;
+			--days;
+		}
+
+		// Converts days since the epoch to a civil date in the proleptic Gregorian calendar
+		long long shifted_days = days + 719468;
+		long long era = (shifted_days >= 0 ? shifted_days : shifted_days - 146096) / 146097;
+		long long day_of_era = shifted_days - era * 146097;
+		long long year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+		long long day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+		long long shifted_month = (5 * day_of_year + 2) / 153;
+		long long day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+		long long month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+		long long year = year_of_era + era * 400 + (month <= 2 ? 1 : 0);
+
+		writer.appendNumber(static_cast<unsigned long long>(year), 4);
+		writer.append("-", 1);
+		writer.appendNumber(static_cast<unsigned long long>(month), 2);
+		writer.append("-", 1);
+		writer.appendNumber(static_cast<unsigned long long>(day), 2);
+		writer.append(" ", 1);
+		writer.appendNumber(static_cast<unsigned long long>(second_of_day / 3600), 2);
+		writer.append(":", 1);
+		writer.appendNumber(static_cast<unsigned long long>(second_of_day / 60 % 60), 2);
+		writer.append(":", 1);
+		writer.appendNumber(static_cast<unsigned long long>(second_of_day % 60), 2);
+		writer.append(".", 1);
+		writer.appendNumber(static_cast<unsigned long long>(fraction), 6);
+	}
+
+	// Decodes the argument with the given index, the prefix being index 0
+	bool findArgument(const char* data, const char* end, unsigned int index, LogArgument& argument)
+	{
+		for (unsigned int i = 0; i <= index; ++i)
+		{
+			data = LogArgument::decode(data, end, argument);
+			if (!data)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Writes a record the way the log would have written the message, preceded by its time and level
+	void appendRecord(DumpWriter& writer, int level, long long time, const char* format, const char* data,
+		size_t size, unsigned int argumentCount)
+	{
+		static const char* const LEVEL_NAMES[] = { "ALWAYS", "ERROR", "WARNING", "INFO", "DEBUG" };
+
+		appendTimestamp(writer, time);
+		writer.append(" ", 1);
+		writer.append(level >= 0 && level <= 4 ? LEVEL_NAMES[level] : "UNKNOWN");
+		writer.append(" ", 1);
+
+		const char* end = data + size;
+		LogArgument argument(0);
+		if (findArgument(data, end, 0, argument))
+		{
+			writer.append(argument);
+		}
+
+		// Replace the %1 - %99 markers the same way Log::formatMessage() does
+		const char* segment_start = format;
+		const char* position = format;
+		while (*position != '\0')
+		{
+			if (position[0] == '%' && position[1] >= '1' && position[1] <= '9')
+			{
+				unsigned int index = position[1] - '0';
+				const char* marker_end = position + 2;
+				if (*marker_end >= '0' && *marker_end <= '9')
+				{
+					index = index * 10 + (*marker_end - '0');
+					++marker_end;
+				}
+
+				if (index <= argumentCount && findArgument(data, end, index, argument))
+				{
+					writer.append(segment_start, position - segment_start);
+					writer.append(argument);
+					segment_start = marker_end;
+					position = marker_end;
+					continue;
+				}
+			}
+
+			++position;
+		}
+
+		writer.append(segment_start, position - segment_start);
+		writer.append("\n", 1);
+	}
+
+}	// End of local namespace
+
+LogFlightRecorder::LogFlightRecorder(const String& filepath, unsigned int recordCount) :
+	_filepath(filepath),
+	_recordCount(recordCount > 0 ? recordCount : 1),
+	_id(gNextRecorderId++),
+	_rings(NULL)
+{
+	;
+}
+
+LogFlightRecorder::~LogFlightRecorder()
+{
+	// Rings still owned by a thread are left for the thread to free when it exits
+	LogFlightRing* ring = _rings.load();
+	while (ring)
+	{
+		LogFlightRing* next = ring->next;
+		int state = RING_IN_USE;
+		if (!ring->state.compare_exchange_strong(state, RING_ORPHANED))
+		{
+			deleteRing(ring);
+		}
+		ring = next;
+	}
+}
+
+void LogFlightRecorder::record(Log::LogLevel logLevel, const String& prefix, const char* format,
+	const LogArgument* arguments, unsigned int argumentCount)
+{
+	LogFlightRing* ring = threadRing();
+	unsigned long long index = ring->writtenCount.load(boost::memory_order_relaxed);
+	LogFlightRecord& record = ring->records[index % _recordCount];
+
+	// Mark the record as being written before touching it
+	unsigned int sequence = record.sequence.load(boost::memory_order_relaxed);
+	record.sequence.store(sequence + 1, boost::memory_order_relaxed);
+	boost::atomic_thread_fence(boost::memory_order_release);
+
+	record.level = static_cast<unsigned char>(logLevel);
+	record.time = Log::currentTimestamp();
+	record.format = format;
+
+	size_t size = LogArgument(static_cast<const std::string&>(prefix)).encodeTo(record.data, RECORD_DATA_SIZE);
+	unsigned int count = 0;
+	for (; count < argumentCount; ++count)
+	{
+		size_t argument_size = arguments[count].encodeTo(record.data + size, RECORD_DATA_SIZE - size);
+		if (argument_size == 0)
+		{
+			break;
+		}
+		size += argument_size;
+	}
+	record.argumentCount = static_cast<unsigned char>(count);
+	record.size = static_cast<unsigned short>(size);
+
+	record.sequence.store(sequence + 2, boost::memory_order_release);
+	ring->writtenCount.store(index + 1, boost::memory_order_release);
+}
+
+bool LogFlightRecorder::dump() const
+{
+	intptr_t file = openDumpFile(_filepath.c_str());
+	if (file == -1)
+	{
+		return false;
+	}
+
+	DumpWriter writer(file, &LogFlightRecorder::writeDumpFile);
+	writer.append("Flight recorder dump, times in UTC\n");
+
+	for (LogFlightRing* ring = _rings.load(boost::memory_order_acquire); ring; ring = ring->next)
+	{
+		unsigned long long written_count = ring->writtenCount.load(boost::memory_order_acquire);
+		if (written_count == 0)
+		{
+			continue;
+		}
+
+		writer.append("Thread ");
+		writer.append(ring->threadName);
+		writer.append("\n", 1);
+
+		// Oldest first. A copy is only trusted if the sequence didn't change while it was taken.
+		unsigned long long first = written_count > _recordCount ? written_count - _recordCount : 0;
+		for (unsigned long long i = first; i < written_count; ++i)
+		{
+			const LogFlightRecord& record = ring->records[i % _recordCount];
+			unsigned int sequence = record.sequence.load(boost::memory_order_acquire);
+			if (sequence & 1)
+			{
+				continue;
+			}
+
+			char data[RECORD_DATA_SIZE];
+			int level = record.level;
+			long long time = record.time;
+			const char* format = record.format;
+			size_t size = record.size < RECORD_DATA_SIZE ? record.size : RECORD_DATA_SIZE;
+			unsigned int argument_count = record.argumentCount;
+			std::memcpy(data, record.data, size);
+
+			boost::atomic_thread_fence(boost::memory_order_acquire);
+			if (record.sequence.load(boost::memory_order_relaxed) != sequence || !format)
+			{
+				continue;
+			}
+
+			appendRecord(writer, level, time, format, data, size, argument_count);
+		}
+	}
+
+	bool is_written = writer.flush();
+	closeDumpFile(file);
+	return is_written;
+}
+
+const String& LogFlightRecorder::filepath() const
+{
+	return _filepath;
+}
+
+unsigned int LogFlightRecorder::recordCount() const
+{
+	return _recordCount;
+}
+
+LogFlightRing* LogFlightRecorder::threadRing()
+{
+	ThreadRingOwner& owner = threadRingOwner();
+	if (owner.ring && owner.ring->recorderId == _id)
+	{
+		return owner.ring;
+	}
+
+	// The thread still holds a ring of an earlier recorder
+	if (owner.ring)
+	{
+		releaseRing(owner.ring);
+		owner.ring = NULL;
+	}
+
+	// A thread overflowing its stack can only be dumped from another one
+	installSignalStack();
+
+	// Take over the ring of a thread that has exited, or add a new one
+	boost::mutex::scoped_lock lock(_ringMutex);
+	LogFlightRing* ring = NULL;
+	for (LogFlightRing* candidate = _rings.load(); candidate; candidate = candidate->next)
+	{
+		int state = RING_FREE;
+		if (candidate->state.compare_exchange_strong(state, RING_IN_USE))
+		{
+			ring = candidate;
+			ring->writtenCount = 0;
+			break;
+		}
+	}
+
+	std::ostringstream thread_name;
+	thread_name << boost::this_thread::get_id();
+	std::string name = thread_name.str().substr(0, sizeof(ring->threadName) - 1);
+
+	if (!ring)
+	{
+		ring = new LogFlightRing();
+		ring->state = RING_IN_USE;
+		ring->recorderId = _id;
+		ring->writtenCount = 0;
+		ring->records = new LogFlightRecord[_recordCount];
+		for (unsigned int i = 0; i < _recordCount; ++i)
+		{
+			ring->records[i].sequence = 0;
+		}
+		std::memcpy(ring->threadName, name.c_str(), name.size() + 1);
+		ring->next = _rings.load();
+		_rings.store(ring, boost::memory_order_release);
+	}
+	else
+	{
+		std::memcpy(ring->threadName, name.c_str(), name.size() + 1);
+	}
+
+	owner.ring = ring;
+	return ring;
+}
+
+}	// End of bump namespace
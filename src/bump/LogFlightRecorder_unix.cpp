@@ -0,0 +1,165 @@
+//
+//	LogFlightRecorder_unix.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <algorithm>
+
+// Bump headers
+#include <bump/LogFlightRecorder.h>
+
+// Unix headers
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+
+namespace bump {
+
+namespace // local
+{
+	// The fatal signals that dump the recorder
+	const int HANDLED_SIGNALS[] = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL };
+	const unsigned int HANDLED_SIGNAL_COUNT = sizeof(HANDLED_SIGNALS) / sizeof(HANDLED_SIGNALS[0]);
+
+	// The recorder dumped by the handlers and the handlers they replaced
+	boost::atomic<LogFlightRecorder*> gSignalRecorder(NULL);
+	struct sigaction gPreviousActions[HANDLED_SIGNAL_COUNT];
+	bool gAreSignalHandlersInstalled = false;
+
+	// The size of the alternate signal stacks, enough for a dump whatever SIGSTKSZ is
+	const size_t SIGNAL_STACK_SIZE = 64 * 1024;
+
+	// Turns off and frees the calling thread's alternate signal stack when the thread exits
+	struct ThreadSignalStack
+	{
+		char* stack;
+
+		~ThreadSignalStack()
+		{
+			if (stack)
+			{
+				stack_t disabled_stack;
+				disabled_stack.ss_sp = NULL;
+				disabled_stack.ss_size = 0;
+				disabled_stack.ss_flags = SS_DISABLE;
+				::sigaltstack(&disabled_stack, NULL);
+				delete [] stack;
+			}
+		}
+	};
+
+	// Dumps the recorder once, then lets the previous handler deal with the signal
+	void handleFatalSignal(int signalNumber)
+	{
+		LogFlightRecorder* recorder = gSignalRecorder.exchange(NULL);
+		if (recorder)
+		{
+			recorder->dump();
+		}
+
+		// The signal stays blocked until the handler returns, then the previous handler gets it
+		for (unsigned int i = 0; i < HANDLED_SIGNAL_COUNT; ++i)
+		{
+			if (HANDLED_SIGNALS[i] == signalNumber)
+			{
+				::sigaction(signalNumber, &gPreviousActions[i], NULL);
+			}
+		}
+		::raise(signalNumber);
+	}
+
+}	// End of local namespace
+
+void LogFlightRecorder::installSignalHandlers(LogFlightRecorder* recorder)
+{
+	gSignalRecorder = recorder;
+
+	if (recorder)
+	{
+		installSignalStack();
+	}
+
+	if (recorder && !gAreSignalHandlersInstalled)
+	{
+		struct sigaction action;
+		action.sa_handler = &handleFatalSignal;
+		sigemptyset(&action.sa_mask);
+		action.sa_flags = SA_ONSTACK;
+		for (unsigned int i = 0; i < HANDLED_SIGNAL_COUNT; ++i)
+		{
+			::sigaction(HANDLED_SIGNALS[i], &action, &gPreviousActions[i]);
+		}
+		gAreSignalHandlersInstalled = true;
+	}
+	else if (!recorder && gAreSignalHandlersInstalled)
+	{
+		for (unsigned int i = 0; i < HANDLED_SIGNAL_COUNT; ++i)
+		{
+			::sigaction(HANDLED_SIGNALS[i], &gPreviousActions[i], NULL);
+		}
+		gAreSignalHandlersInstalled = false;
+	}
+}
+
+void LogFlightRecorder::installSignalStack()
+{
+	// Leave a stack installed by the application alone
+	static thread_local ThreadSignalStack signal_stack = { NULL };
+	stack_t current_stack;
+	if (signal_stack.stack || ::sigaltstack(NULL, &current_stack) != 0 || !(current_stack.ss_flags & SS_DISABLE))
+	{
+		return;
+	}
+
+	size_t size = std::max(SIGNAL_STACK_SIZE, static_cast<size_t>(SIGSTKSZ));
+	stack_t stack;
+	stack.ss_sp = new char[size];
+	stack.ss_size = size;
+	stack.ss_flags = 0;
+	if (::sigaltstack(&stack, NULL) == 0)
+	{
+		signal_stack.stack = static_cast<char*>(stack.ss_sp);
+	}
+	else
+	{
+		delete [] static_cast<char*>(stack.ss_sp);
+	}
+}
+
+intptr_t LogFlightRecorder::openDumpFile(const char* filepath)
+{
+	return ::open(filepath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+}
+
+bool LogFlightRecorder::writeDumpFile(intptr_t file, const char* data, size_t size)
+{
+	while (size > 0)
+	{
+		ssize_t written = ::write(static_cast<int>(file), data, size);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return false;
+		}
+
+		data += written;
+		size -= static_cast<size_t>(written);
+	}
+
+	return true;
+}
+
+void LogFlightRecorder::closeDumpFile(intptr_t file)
+{
+	::close(static_cast<int>(file));
+}
+
+}	// End of bump namespace
@@ -0,0 +1,123 @@
+//
+//	LogFlightRecorder_win.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <csignal>
+
+// Bump headers
+#include <bump/LogFlightRecorder.h>
+
+// Windows headers
+#include <windows.h>
+
+namespace bump {
+
+namespace // local
+{
+	// The fatal signals that dump the recorder
+	const int HANDLED_SIGNALS[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL };
+	const unsigned int HANDLED_SIGNAL_COUNT = sizeof(HANDLED_SIGNALS) / sizeof(HANDLED_SIGNALS[0]);
+
+	// The recorder dumped by the handlers and the handlers they replaced
+	typedef void (*SignalHandler)(int);
+	boost::atomic<LogFlightRecorder*> gSignalRecorder(NULL);
+	SignalHandler gPreviousHandlers[HANDLED_SIGNAL_COUNT];
+	bool gAreSignalHandlersInstalled = false;
+
+	// The stack kept back for handling a stack overflow, enough for a dump
+	const ULONG SIGNAL_STACK_SIZE = 64 * 1024;
+
+	// Dumps the recorder once, then hands the signal to the previous handler
+	void handleFatalSignal(int signalNumber)
+	{
+		LogFlightRecorder* recorder = gSignalRecorder.exchange(NULL);
+		if (recorder)
+		{
+			recorder->dump();
+		}
+
+		for (unsigned int i = 0; i < HANDLED_SIGNAL_COUNT; ++i)
+		{
+			if (HANDLED_SIGNALS[i] == signalNumber)
+			{
+				std::signal(signalNumber, gPreviousHandlers[i]);
+			}
+		}
+		std::raise(signalNumber);
+	}
+
+}	// End of local namespace
+
+void LogFlightRecorder::installSignalHandlers(LogFlightRecorder* recorder)
+{
+	gSignalRecorder = recorder;
+
+	if (recorder)
+	{
+		installSignalStack();
+	}
+
+	if (recorder && !gAreSignalHandlersInstalled)
+	{
+		for (unsigned int i = 0; i < HANDLED_SIGNAL_COUNT; ++i)
+		{
+			gPreviousHandlers[i] = std::signal(HANDLED_SIGNALS[i], &handleFatalSignal);
+		}
+		gAreSignalHandlersInstalled = true;
+	}
+	else if (!recorder && gAreSignalHandlersInstalled)
+	{
+		for (unsigned int i = 0; i < HANDLED_SIGNAL_COUNT; ++i)
+		{
+			std::signal(HANDLED_SIGNALS[i], gPreviousHandlers[i]);
+		}
+		gAreSignalHandlersInstalled = false;
+	}
+}
+
+void LogFlightRecorder::installSignalStack()
+{
+	// Windows has no alternate signal stacks, but keeps the guaranteed room at the end of the stack
+	static thread_local bool is_installed = false;
+	if (!is_installed)
+	{
+		ULONG size = SIGNAL_STACK_SIZE;
+		::SetThreadStackGuarantee(&size);
+		is_installed = true;
+	}
+}
+
+intptr_t LogFlightRecorder::openDumpFile(const char* filepath)
+{
+	HANDLE file = ::CreateFileA(filepath, GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	return file == INVALID_HANDLE_VALUE ? -1 : reinterpret_cast<intptr_t>(file);
+}
+
+bool LogFlightRecorder::writeDumpFile(intptr_t file, const char* data, size_t size)
+{
+	while (size > 0)
+	{
+		DWORD written = 0;
+		if (!::WriteFile(reinterpret_cast<HANDLE>(file), data, static_cast<DWORD>(size), &written, NULL))
+		{
+			return false;
+		}
+
+		data += written;
+		size -= written;
+	}
+
+	return true;
+}
+
+void LogFlightRecorder::closeDumpFile(intptr_t file)
+{
+	::CloseHandle(reinterpret_cast<HANDLE>(file));
+}
+
+}	// End of bump namespace
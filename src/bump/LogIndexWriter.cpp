@@ -0,0 +1,180 @@
+//
+//	LogIndexWriter.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <vector>
+
+// Bump headers
+#include <bump/FileInfo.h>
+#include <bump/FileSystemError.h>
+#include <bump/Log.h>
+#include <bump/LogIndexWriter.h>
+#include <bump/LogReader.h>
+
+namespace bump {
+
+namespace // local
+{
+	// The chunk size used to read the log when rebuilding its index
+	const size_t REBUILD_CHUNK_SIZE = 1024 * 1024;
+
+}	// End of local namespace
+
+const char LogIndexWriter::MAGIC[8] = { 'B', 'U', 'M', 'P', 'I', 'D', 'X', '1' };
+
+LogIndexWriter::LogIndexWriter(const String& logFilepath, unsigned long long interval, bool append) :
+	_file(),
+	_interval(interval > 0 ? interval : 1),
+	_logSize(0),
+	_nextEntryOffset(0),
+	_entryCount(0),
+	_lastTime(LLONG_MIN),
+	_isAtLineStart(true),
+	_isTimestamped(false),
+	_isRebuilding(false)
+{
+	// Continue after the end of an existing log, which may end partway through a line
+	FileInfo log_info(logFilepath);
+	if (append && log_info.isFile() && log_info.fileSize() > 0)
+	{
+		_logSize = log_info.fileSize();
+		std::ifstream log(logFilepath.c_str(), std::ios::binary);
+		char last_character = '\n';
+		if (log.seekg(-1, std::ios::end) && log.get(last_character))
+		{
+			_isAtLineStart = last_character == '\n';
+		}
+	}
+	_nextEntryOffset = _logSize;
+
+	// An index without a complete header is started over
+	String index_filepath = indexFilepath(logFilepath);
+	FileInfo index_info(index_filepath);
+	bool is_continued = append && index_info.isFile() && index_info.fileSize() >= HEADER_SIZE;
+	_file.open(index_filepath.c_str(), std::ios::out | std::ios::binary | (is_continued ? std::ios::app : std::ios::trunc));
+	if (!_file)
+	{
+		String msg = String("The following log index could not be opened: %1").arg(index_filepath);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	if (!is_continued)
+	{
+		_file.write(MAGIC, sizeof(MAGIC));
+		_file.write(reinterpret_cast<const char*>(&_interval), sizeof(_interval));
+		_file.flush();
+	}
+}
+
+LogIndexWriter::~LogIndexWriter()
+{
+	;
+}
+
+void LogIndexWriter::add(const LogSink::Buffer* buffers, unsigned int bufferCount)
+{
+	for (unsigned int i = 0; i < bufferCount; ++i)
+	{
+		addBuffer(buffers[i].data, buffers[i].size);
+	}
+}
+
+unsigned long long LogIndexWriter::entryCount() const
+{
+	return _entryCount;
+}
+
+String LogIndexWriter::indexFilepath(const String& logFilepath)
+{
+	return logFilepath + ".idx";
+}
+
+unsigned long long LogIndexWriter::rebuild(const String& logFilepath, unsigned long long interval)
+{
+	std::ifstream log(logFilepath.c_str(), std::ios::binary);
+	if (!log)
+	{
+		String msg = String("The following log file could not be opened: %1").arg(logFilepath);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	LogIndexWriter writer(logFilepath, interval, false);
+	writer._isRebuilding = true;
+
+	std::vector<char> chunk(REBUILD_CHUNK_SIZE);
+	while (log.read(&chunk[0], static_cast<std::streamsize>(chunk.size())) || log.gcount() > 0)
+	{
+		writer.addBuffer(&chunk[0], static_cast<size_t>(log.gcount()));
+	}
+
+	return writer._entryCount;
+}
+
+void LogIndexWriter::addBuffer(const char* data, size_t size)
+{
+	if (size == 0)
+	{
+		return;
+	}
+
+	unsigned long long end_offset = _logSize + size;
+	while (_nextEntryOffset < end_offset)
+	{
+		// Find the first line starting at or after the next entry offset
+		size_t position = _nextEntryOffset > _logSize ? static_cast<size_t>(_nextEntryOffset - _logSize) : 0;
+		bool is_line_start = position == 0 ? _isAtLineStart : data[position - 1] == '\n';
+		if (!is_line_start)
+		{
+			const char* newline = static_cast<const char*>(std::memchr(data + position, '\n', size - position));
+			if (!newline || newline + 1 == data + size)
+			{
+				break;
+			}
+			position = newline + 1 - data;
+		}
+
+		// A line cut short by the end of a rebuild chunk could parse as an earlier time, so it is skipped
+		const char* line = data + position;
+		const char* line_end = static_cast<const char*>(std::memchr(line, '\n', size - position));
+		long long time = 0;
+		bool is_parsed = (line_end || !_isRebuilding) &&
+			LogReader::parseTimestamp(line, (line_end ? line_end : data + size) - line, time);
+		_isTimestamped = _isTimestamped || is_parsed;
+
+		// Lines without a timestamp in a log with timestamps are skipped, in a log without any they get the current time
+		if (is_parsed || (!_isTimestamped && !_isRebuilding))
+		{
+			writeEntry(is_parsed ? time : Log::currentTimestamp(), _logSize + position);
+			_nextEntryOffset = _logSize + position + _interval;
+		}
+		else
+		{
+			_nextEntryOffset = _logSize + position + 1;
+		}
+	}
+
+	_isAtLineStart = data[size - 1] == '\n';
+	_logSize = end_offset;
+}
+
+void LogIndexWriter::writeEntry(long long time, unsigned long long offset)
+{
+	// Keep the index sorted even if the clock or the lines went backwards
+	time = std::max(time, _lastTime);
+	_lastTime = time;
+
+	_file.write(reinterpret_cast<const char*>(&time), sizeof(time));
+	_file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+	_file.flush();
+	++_entryCount;
+}
+
+}	// End of bump namespace
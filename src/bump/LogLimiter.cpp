@@ -0,0 +1,102 @@
+//
+//	LogLimiter.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <algorithm>
+
+// Boost headers
+#include <boost/chrono/system_clocks.hpp>
+
+// Bump headers
+#include <bump/LogLimiter.h>
+
+namespace bump {
+
+namespace // local
+{
+	// Returns the steady clock time in nanoseconds, which never goes backwards
+	long long steadyNanoseconds()
+	{
+		boost::chrono::steady_clock::duration elapsed = boost::chrono::steady_clock::now().time_since_epoch();
+		return boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed).count();
+	}
+
+}	// End of local namespace
+
+//====================================================================================
+//                                  LogRateLimiter
+//====================================================================================
+
+bool LogRateLimiter::tryAcquire(unsigned long long& suppressedCount)
+{
+	// Taking a token pushes the time the bucket is full again out by one interval. The
+	// bucket is empty once that time is more than the whole bucket's worth ahead of now.
+	long long now = steadyNanoseconds();
+	long long full_time = _fullTime.load(boost::memory_order_relaxed);
+	while (true)
+	{
+		long long next_full_time = std::max(full_time, now) + _interval;
+		if (next_full_time - now > _tolerance)
+		{
+			_suppressedCount.fetch_add(1, boost::memory_order_relaxed);
+			return false;
+		}
+
+		if (_fullTime.compare_exchange_weak(full_time, next_full_time, boost::memory_order_relaxed))
+		{
+			break;
+		}
+	}
+
+	suppressedCount = _suppressedCount.exchange(0, boost::memory_order_relaxed);
+	return true;
+}
+
+//====================================================================================
+//                                LogRepeatSuppressor
+//====================================================================================
+
+bool LogRepeatSuppressor::filter(unsigned long long hash, unsigned long long& repeatCount)
+{
+	repeatCount = 0;
+	long long now = steadyNanoseconds();
+
+	// A different message reports the repeats of the one before it
+	unsigned long long last_hash = _lastHash.exchange(hash, boost::memory_order_relaxed);
+	if (last_hash != hash)
+	{
+		repeatCount = _repeatCount.exchange(0, boost::memory_order_relaxed);
+		_reportTime.store(now, boost::memory_order_relaxed);
+		return true;
+	}
+
+	// A repeat is only counted, unless the repeats haven't been reported for a whole interval
+	long long report_time = _reportTime.load(boost::memory_order_relaxed);
+	if (now - report_time >= _reportInterval &&
+		_reportTime.compare_exchange_strong(report_time, now, boost::memory_order_relaxed))
+	{
+		repeatCount = _repeatCount.exchange(0, boost::memory_order_relaxed) + 1;
+		return false;
+	}
+
+	_repeatCount.fetch_add(1, boost::memory_order_relaxed);
+	return false;
+}
+
+unsigned long long LogRepeatSuppressor::hash(const char* data, size_t size, unsigned long long hash)
+{
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= static_cast<unsigned char>(data[i]);
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+}	// End of bump namespace
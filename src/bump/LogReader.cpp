@@ -0,0 +1,335 @@
+//
+//	LogReader.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+// Bump headers
+#include <bump/FileSystemError.h>
+#include <bump/LogIndexWriter.h>
+#include <bump/LogReader.h>
+
+namespace bump {
+
+namespace // local
+{
+	// Reads a fixed number of decimal digits
+	bool readDigits(const char* data, int count, int& value)
+	{
+		value = 0;
+		for (int i = 0; i < count; ++i)
+		{
+			if (data[i] < '0' || data[i] > '9')
+			{
+				return false;
+			}
+			value = value * 10 + (data[i] - '0');
+		}
+
+		return true;
+	}
+
+	// Returns the days since the Unix epoch of a date in the proleptic Gregorian calendar
+	long long daysFromCivil(int year, int month, int day)
+	{
+		year -= month <= 2 ? 1 : 0;
+		long long era = (year >= 0 ? year : year - 399) / 400;
+		long long year_of_era = year - era * 400;
+		long long day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+		long long day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+		return era * 146097 + day_of_era - 719468;
+	}
+
+	// Returns the seconds since the Unix epoch of a local time, only asking the C library once an hour
+	long long localSeconds(int year, int month, int day, int hour, int minute, int second)
+	{
+		struct HourCache
+		{
+			long long	key;
+			long long	seconds;
+		};
+		static thread_local HourCache cache = { -1, 0 };
+
+		long long key = ((static_cast<long long>(year) * 100 + month) * 100 + day) * 100 + hour;
+		if (key != cache.key)
+		{
+			std::tm time = std::tm();
+			time.tm_year = year - 1900;
+			time.tm_mon = month - 1;
+			time.tm_mday = day;
+			time.tm_hour = hour;
+			time.tm_isdst = -1;
+			cache.seconds = static_cast<long long>(std::mktime(&time));
+			cache.key = key;
+		}
+
+		return cache.seconds + minute * 60 + second;
+	}
+
+}	// End of local namespace
+
+LogReader::LogReader(const String& filepath) :
+	_file(),
+	_indexFile(),
+	_entryCount(0),
+	_offset(0),
+	_endOffset(ULLONG_MAX),
+	_startTime(LLONG_MIN),
+	_endTime(LLONG_MAX),
+	_lineTime(0),
+	_hasLineTime(false),
+	_isFinished(false)
+{
+	_file.open(filepath.c_str(), std::ios::binary);
+	if (!_file)
+	{
+		String msg = String("The following log file could not be opened: %1").arg(filepath);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	// A missing or foreign index is the same as none at all
+	String index_filepath = LogIndexWriter::indexFilepath(filepath);
+	_indexFile.open(index_filepath.c_str(), std::ios::binary);
+	char header[LogIndexWriter::HEADER_SIZE];
+	if (_indexFile.read(header, sizeof(header)) && std::memcmp(header, LogIndexWriter::MAGIC, sizeof(LogIndexWriter::MAGIC)) == 0)
+	{
+		_indexFile.seekg(0, std::ios::end);
+		unsigned long long size = static_cast<unsigned long long>(_indexFile.tellg());
+		_entryCount = (size - LogIndexWriter::HEADER_SIZE) / LogIndexWriter::ENTRY_SIZE;
+	}
+	else
+	{
+		_indexFile.close();
+	}
+
+	seekTimeRange(LLONG_MIN, LLONG_MAX);
+}
+
+LogReader::~LogReader()
+{
+	;
+}
+
+bool LogReader::hasIndex() const
+{
+	return _indexFile.is_open();
+}
+
+void LogReader::seekTimeRange(long long startTime, long long endTime)
+{
+	_startTime = startTime;
+	_endTime = endTime;
+	_hasLineTime = false;
+	_isFinished = false;
+
+	// Lines before an entry were logged no later than it, so start at the last entry before
+	// the range and stop at the first one after it
+	unsigned long long start_offset = 0;
+	_endOffset = ULLONG_MAX;
+	if (hasIndex())
+	{
+		long long time = 0;
+		unsigned long long first_index = startTime > LLONG_MIN ? findEntryAfter(startTime - 1) : 0;
+		if (first_index > 0 && !readEntry(first_index - 1, time, start_offset))
+		{
+			start_offset = 0;
+		}
+
+		unsigned long long end_index = findEntryAfter(endTime);
+		if (end_index < _entryCount && !readEntry(end_index, time, _endOffset))
+		{
+			_endOffset = ULLONG_MAX;
+		}
+	}
+
+	_file.clear();
+	_file.seekg(static_cast<std::streamoff>(start_offset));
+	_offset = start_offset;
+
+	// An entry left behind by a failed write may point into a line, which is skipped
+	char previous_character = '\n';
+	if (start_offset > 0 && _file.seekg(static_cast<std::streamoff>(start_offset - 1)) && _file.get(previous_character) &&
+		previous_character != '\n')
+	{
+		std::string rest;
+		std::getline(_file, rest);
+		_offset += rest.size() + 1;
+	}
+}
+
+bool LogReader::readLine(String& line)
+{
+	std::string& text = line;
+	while (!_isFinished)
+	{
+		if (_offset >= _endOffset || !std::getline(_file, text))
+		{
+			_isFinished = true;
+			break;
+		}
+		_offset += text.size() + 1;
+
+		// Lines without a timestamp belong to the last line with one
+		long long time = 0;
+		if (parseTimestamp(text.data(), text.size(), time))
+		{
+			_lineTime = time;
+			_hasLineTime = true;
+		}
+
+		if (!_hasLineTime)
+		{
+			return true;
+		}
+		else if (_lineTime < _startTime)
+		{
+			continue;
+		}
+		else if (_lineTime > _endTime)
+		{
+			_isFinished = true;
+			break;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+bool LogReader::parseTimestamp(const char* data, size_t length, long long& microseconds)
+{
+	const char* end = data + length;
+
+	// JSON sinks start every line with the time in microseconds
+	static const char JSON_TIME[] = "{\"time\":";
+	const size_t json_time_length = sizeof(JSON_TIME) - 1;
+	if (length > json_time_length && std::memcmp(data, JSON_TIME, json_time_length) == 0)
+	{
+		std::from_chars_result result = std::from_chars(data + json_time_length, end, microseconds);
+		return result.ec == std::errc();
+	}
+
+	// Then "YYYY-MM-DD HH:MM:SS" with a 'T' instead of the space for ISO 8601
+	int year = 0;
+	int month = 0;
+	int day = 0;
+	int hour = 0;
+	int minute = 0;
+	int second = 0;
+	if (length < 19 || !readDigits(data, 4, year) || data[4] != '-' || !readDigits(data + 5, 2, month) ||
+		data[7] != '-' || !readDigits(data + 8, 2, day) || (data[10] != ' ' && data[10] != 'T') ||
+		!readDigits(data + 11, 2, hour) || data[13] != ':' || !readDigits(data + 14, 2, minute) ||
+		data[16] != ':' || !readDigits(data + 17, 2, second))
+	{
+		return false;
+	}
+
+	// The fraction of a second has as many digits as the precision asked for
+	const char* position = data + 19;
+	long long fraction = 0;
+	if (position < end && *position == '.')
+	{
+		int digit_count = 0;
+		for (++position; position < end && *position >= '0' && *position <= '9'; ++position)
+		{
+			if (digit_count < 6)
+			{
+				fraction = fraction * 10 + (*position - '0');
+				++digit_count;
+			}
+		}
+
+		for (; digit_count < 6; ++digit_count)
+		{
+			fraction *= 10;
+		}
+	}
+
+	// The 12-hour clock runs from 12 AM through 11 AM, then 12 PM through 11 PM
+	if (end - position >= 3 && position[0] == ' ' && (position[1] == 'A' || position[1] == 'P') && position[2] == 'M')
+	{
+		if (hour < 1 || hour > 12)
+		{
+			return false;
+		}
+		hour = hour % 12 + (position[1] == 'P' ? 12 : 0);
+		position += 3;
+	}
+
+	if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60)
+	{
+		return false;
+	}
+
+	// ISO 8601 ends with the UTC offset, everything else is local time
+	long long seconds = 0;
+	long long utc_seconds = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+	int offset_hours = 0;
+	int offset_minutes = 0;
+	if (position < end && *position == 'Z')
+	{
+		seconds = utc_seconds;
+	}
+	else if (end - position >= 6 && (*position == '+' || *position == '-') && readDigits(position + 1, 2, offset_hours) &&
+		position[3] == ':' && readDigits(position + 4, 2, offset_minutes))
+	{
+		long long offset = (offset_hours * 60 + offset_minutes) * 60;
+		seconds = *position == '+' ? utc_seconds - offset : utc_seconds + offset;
+	}
+	else
+	{
+		seconds = localSeconds(year, month, day, hour, minute, second);
+	}
+
+	microseconds = seconds * 1000000 + fraction;
+	return true;
+}
+
+bool LogReader::readEntry(unsigned long long index, long long& time, unsigned long long& offset)
+{
+	char entry[LogIndexWriter::ENTRY_SIZE];
+	_indexFile.clear();
+	if (!_indexFile.seekg(static_cast<std::streamoff>(LogIndexWriter::HEADER_SIZE + index * LogIndexWriter::ENTRY_SIZE)) ||
+		!_indexFile.read(entry, sizeof(entry)))
+	{
+		return false;
+	}
+
+	std::memcpy(&time, entry, sizeof(time));
+	std::memcpy(&offset, entry + sizeof(time), sizeof(offset));
+	return true;
+}
+
+unsigned long long LogReader::findEntryAfter(long long time)
+{
+	unsigned long long low = 0;
+	unsigned long long high = _entryCount;
+	while (low < high)
+	{
+		unsigned long long middle = low + (high - low) / 2;
+		long long entry_time = 0;
+		unsigned long long entry_offset = 0;
+		if (!readEntry(middle, entry_time, entry_offset) || entry_time > time)
+		{
+			high = middle;
+		}
+		else
+		{
+			low = middle + 1;
+		}
+	}
+
+	return low;
+}
+
+}	// End of bump namespace
@@ -0,0 +1,92 @@
+//
+//	LogSink.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/LogSink.h>
+
+namespace bump {
+
+namespace // local
+{
+	// Collects the characters written to a sink's stream and passes them on in chunks
+	class LogSinkStreamBuffer : public std::streambuf
+	{
+	public:
+
+		explicit LogSinkStreamBuffer(LogSink& sink) : _sink(sink)
+		{
+			setp(_buffer, _buffer + sizeof(_buffer));
+		}
+
+	protected:
+
+		int overflow(int character)
+		{
+			writeBuffer();
+			if (!traits_type::eq_int_type(character, traits_type::eof()))
+			{
+				*pptr() = traits_type::to_char_type(character);
+				pbump(1);
+			}
+
+			return traits_type::not_eof(character);
+		}
+
+		int sync()
+		{
+			writeBuffer();
+			_sink.flush();
+			return 0;
+		}
+
+		void writeBuffer()
+		{
+			LogSink::Buffer buffer = { pbase(), static_cast<size_t>(pptr() - pbase()) };
+			if (buffer.size > 0)
+			{
+				_sink.write(&buffer, 1);
+				setp(_buffer, _buffer + sizeof(_buffer));
+			}
+		}
+
+		LogSink& _sink;
+		char _buffer[8192];
+	};
+
+}	// End of local namespace
+
+LogSink::LogSink() :
+	_streamBuffer(NULL),
+	_stream(NULL)
+{
+	_streamBuffer = new LogSinkStreamBuffer(*this);
+	_stream = new std::ostream(_streamBuffer);
+}
+
+LogSink::~LogSink()
+{
+	delete _stream;
+	delete _streamBuffer;
+}
+
+void LogSink::flush()
+{
+	// DO NOTHING
+}
+
+bool LogSink::isThreadSafe() const
+{
+	return false;
+}
+
+std::ostream& LogSink::stream()
+{
+	return *_stream;
+}
+
+}	// End of bump namespace
@@ -0,0 +1,68 @@
+//
+//	Logger.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/Logger.h>
+
+namespace bump {
+
+Logger::Logger(Log* log, const String& name) :
+	_log(log),
+	_name(name),
+	_prefix(String("[%1] ").arg(name)),
+	_logLevel(log->logLevel()),
+	_enabledLogLevel(-1)
+{
+	;
+}
+
+Logger::~Logger()
+{
+	;
+}
+
+const String& Logger::name() const
+{
+	return _name;
+}
+
+const String& Logger::prefix() const
+{
+	return _prefix;
+}
+
+Log::LogLevel Logger::logLevel() const
+{
+	return _logLevel.load(boost::memory_order_relaxed);
+}
+
+void Logger::setLogLevel(Log::LogLevel logLevel)
+{
+	_log->setLoggerLevel(_name, logLevel);
+}
+
+void Logger::clearLogLevel()
+{
+	_log->clearLoggerLevel(_name);
+}
+
+void Logger::writeMessage(Log::LogLevel logLevel, const String& message, bool newline)
+{
+	if (isLogLevelEnabled(logLevel))
+	{
+		_log->writeMessage(logLevel, _logLevel.load(boost::memory_order_relaxed), _prefix, message, newline);
+	}
+}
+
+void Logger::updateLogLevelsLocked(Log::LogLevel logLevel, int enabledLogLevel)
+{
+	_logLevel = logLevel;
+	_enabledLogLevel = enabledLogLevel;
+}
+
+}	// End of bump namespace
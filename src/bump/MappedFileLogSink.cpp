@@ -0,0 +1,245 @@
+//
+//	MappedFileLogSink.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <algorithm>
+#include <cstring>
+
+// Bump headers
+#include <bump/FileSystemError.h>
+#include <bump/MappedFileLogSink.h>
+
+namespace bump {
+
+namespace // local
+{
+	// The segment size is a multiple of this, which is a multiple of every page size and
+	// of the 64 KB allocation granularity mapped views are aligned to on Windows
+	const size_t SEGMENT_ALIGNMENT = 1024 * 1024;
+
+	// The most segments a file can grow to, 1 TB with the default segment size
+	const size_t MAX_SEGMENT_COUNT = 16384;
+
+}	// End of local namespace
+
+MappedFileLogSink::MappedFileLogSink(const String& filepath, size_t segmentSize) :
+	_filepath(filepath),
+	_segmentSize(std::max(SEGMENT_ALIGNMENT, (segmentSize + SEGMENT_ALIGNMENT - 1) / SEGMENT_ALIGNMENT * SEGMENT_ALIGNMENT)),
+	_fileHandle(-1),
+	_fileSize(0),
+	_segments(NULL),
+	_cursor(0),
+	_droppedWriteCount(0)
+{
+	unsigned long long file_size = 0;
+	openFile(file_size);
+
+	_segments = new Segment[MAX_SEGMENT_COUNT];
+	for (size_t i = 0; i < MAX_SEGMENT_COUNT; ++i)
+	{
+		_segments[i].data = NULL;
+		_segments[i].writtenSize = 0;
+	}
+
+	// Appending continues right after the existing output, which already fills part of its segment
+	_fileSize = file_size;
+	unsigned long long output_end = findOutputEnd(file_size);
+	_cursor = output_end;
+	if (output_end / _segmentSize < MAX_SEGMENT_COUNT)
+	{
+		_segments[output_end / _segmentSize].writtenSize = static_cast<size_t>(output_end % _segmentSize);
+	}
+
+	// Map the first segment up front so the first write doesn't have to
+	if (!segmentData(static_cast<size_t>(output_end / _segmentSize)))
+	{
+		delete [] _segments;
+		closeFile();
+		String msg = String("The following log file could not be mapped: %1").arg(filepath);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+}
+
+MappedFileLogSink::~MappedFileLogSink()
+{
+	// Write out what is left in the stream while write() can still be called
+	stream().flush();
+
+	for (size_t i = 0; i < MAX_SEGMENT_COUNT; ++i)
+	{
+		char* data = _segments[i].data.exchange(NULL);
+		if (data)
+		{
+			unmapFile(data, _segmentSize);
+		}
+	}
+	delete [] _segments;
+
+	// Writes that were dropped reserved their ranges too, so they can leave a gap at the end
+	resizeFile(std::min(_cursor.load(), static_cast<unsigned long long>(MAX_SEGMENT_COUNT) * _segmentSize));
+	closeFile();
+}
+
+void MappedFileLogSink::write(const Buffer* buffers, unsigned int bufferCount)
+{
+	size_t size = 0;
+	for (unsigned int i = 0; i < bufferCount; ++i)
+	{
+		size += buffers[i].size;
+	}
+
+	if (size == 0)
+	{
+		return;
+	}
+
+	// The only thing writers share is the cursor, everything after this is their own range
+	unsigned long long position = _cursor.fetch_add(size);
+	if (position + size > static_cast<unsigned long long>(MAX_SEGMENT_COUNT) * _segmentSize)
+	{
+		++_droppedWriteCount;
+		return;
+	}
+
+	// Copy each buffer in pieces that don't cross the end of a segment
+	bool is_dropped = false;
+	for (unsigned int i = 0; i < bufferCount; ++i)
+	{
+		const char* data = buffers[i].data;
+		size_t remaining = buffers[i].size;
+		while (remaining > 0)
+		{
+			size_t index = static_cast<size_t>(position / _segmentSize);
+			size_t offset = static_cast<size_t>(position % _segmentSize);
+			size_t piece_size = std::min(remaining, _segmentSize - offset);
+
+			char* segment = segmentData(index);
+			if (segment)
+			{
+				std::memcpy(segment + offset, data, piece_size);
+			}
+			else
+			{
+				is_dropped = true;
+			}
+			completeSegment(index, piece_size);
+
+			data += piece_size;
+			remaining -= piece_size;
+			position += piece_size;
+		}
+	}
+
+	if (is_dropped)
+	{
+		++_droppedWriteCount;
+	}
+}
+
+bool MappedFileLogSink::isThreadSafe() const
+{
+	return true;
+}
+
+const String& MappedFileLogSink::filepath() const
+{
+	return _filepath;
+}
+
+size_t MappedFileLogSink::segmentSize() const
+{
+	return _segmentSize;
+}
+
+unsigned long long MappedFileLogSink::size() const
+{
+	return _cursor;
+}
+
+unsigned long long MappedFileLogSink::droppedWriteCount() const
+{
+	return _droppedWriteCount;
+}
+
+char* MappedFileLogSink::segmentData(size_t index)
+{
+	char* data = _segments[index].data.load(boost::memory_order_acquire);
+	if (data)
+	{
+		return data;
+	}
+
+	// Only the first writer to reach a new segment extends the file and maps it
+	boost::mutex::scoped_lock lock(_mappingMutex);
+	data = _segments[index].data.load(boost::memory_order_acquire);
+	if (data)
+	{
+		return data;
+	}
+
+	unsigned long long segment_end = static_cast<unsigned long long>(index + 1) * _segmentSize;
+	if (segment_end > _fileSize)
+	{
+		if (!resizeFile(segment_end))
+		{
+			return NULL;
+		}
+		_fileSize = segment_end;
+	}
+
+	data = mapFile(static_cast<unsigned long long>(index) * _segmentSize, _segmentSize);
+	_segments[index].data.store(data, boost::memory_order_release);
+	return data;
+}
+
+void MappedFileLogSink::completeSegment(size_t index, size_t size)
+{
+	// Every byte of a full segment has been reserved and copied, so nobody touches it again
+	size_t written_size = _segments[index].writtenSize.fetch_add(size) + size;
+	if (written_size == _segmentSize)
+	{
+		char* data = _segments[index].data.exchange(NULL);
+		if (data)
+		{
+			unmapFile(data, _segmentSize);
+		}
+	}
+}
+
+unsigned long long MappedFileLogSink::findOutputEnd(unsigned long long fileSize)
+{
+	// Only a crash leaves zero bytes behind, and only in the last segment that was written
+	unsigned long long output_end = fileSize;
+	while (output_end > 0)
+	{
+		unsigned long long segment_start = (output_end - 1) / _segmentSize * _segmentSize;
+		size_t mapped_size = static_cast<size_t>(std::min(static_cast<unsigned long long>(_segmentSize), fileSize - segment_start));
+		char* data = mapFile(segment_start, mapped_size);
+		if (!data)
+		{
+			break;
+		}
+
+		const char* position = data + (output_end - segment_start);
+		while (position > data && position[-1] == '\0')
+		{
+			--position;
+		}
+		output_end = segment_start + static_cast<unsigned long long>(position - data);
+		unmapFile(data, mapped_size);
+
+		if (output_end > segment_start)
+		{
+			break;
+		}
+	}
+
+	return output_end;
+}
+
+}	// End of bump namespace
@@ -0,0 +1,65 @@
+//
+//	MappedFileLogSink_unix.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/FileSystemError.h>
+#include <bump/MappedFileLogSink.h>
+
+// Unix headers
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bump {
+
+void MappedFileLogSink::openFile(unsigned long long& fileSize)
+{
+	int file_descriptor = ::open(_filepath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	struct stat file_status;
+	if (file_descriptor < 0 || ::fstat(file_descriptor, &file_status) != 0)
+	{
+		if (file_descriptor >= 0)
+		{
+			::close(file_descriptor);
+		}
+
+		String msg = String("The following log file could not be opened: %1").arg(_filepath);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	_fileHandle = file_descriptor;
+	fileSize = static_cast<unsigned long long>(file_status.st_size);
+}
+
+bool MappedFileLogSink::resizeFile(unsigned long long size)
+{
+	return ::ftruncate(static_cast<int>(_fileHandle), static_cast<off_t>(size)) == 0;
+}
+
+char* MappedFileLogSink::mapFile(unsigned long long offset, size_t size)
+{
+	void* data = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, static_cast<int>(_fileHandle), static_cast<off_t>(offset));
+	return data == MAP_FAILED ? NULL : static_cast<char*>(data);
+}
+
+void MappedFileLogSink::unmapFile(char* data, size_t size)
+{
+	::munmap(data, size);
+}
+
+void MappedFileLogSink::closeFile()
+{
+	if (_fileHandle >= 0)
+	{
+		::close(static_cast<int>(_fileHandle));
+		_fileHandle = -1;
+	}
+}
+
+}	// End of bump namespace
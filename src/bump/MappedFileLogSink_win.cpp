@@ -0,0 +1,77 @@
+//
+//	MappedFileLogSink_win.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/FileSystemError.h>
+#include <bump/MappedFileLogSink.h>
+
+// Windows headers
+#include <windows.h>
+
+namespace bump {
+
+void MappedFileLogSink::openFile(unsigned long long& fileSize)
+{
+	HANDLE file = ::CreateFileA(_filepath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	LARGE_INTEGER file_size;
+	if (file == INVALID_HANDLE_VALUE || !::GetFileSizeEx(file, &file_size))
+	{
+		if (file != INVALID_HANDLE_VALUE)
+		{
+			::CloseHandle(file);
+		}
+
+		String msg = String("The following log file could not be opened: %1").arg(_filepath);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	_fileHandle = reinterpret_cast<intptr_t>(file);
+	fileSize = static_cast<unsigned long long>(file_size.QuadPart);
+}
+
+bool MappedFileLogSink::resizeFile(unsigned long long size)
+{
+	HANDLE file = reinterpret_cast<HANDLE>(_fileHandle);
+	LARGE_INTEGER position;
+	position.QuadPart = static_cast<LONGLONG>(size);
+	return ::SetFilePointerEx(file, position, NULL, FILE_BEGIN) && ::SetEndOfFile(file);
+}
+
+char* MappedFileLogSink::mapFile(unsigned long long offset, size_t size)
+{
+	// The view keeps the mapping object alive, so its handle can be closed right away
+	unsigned long long mapping_size = offset + size;
+	HANDLE mapping = ::CreateFileMappingA(reinterpret_cast<HANDLE>(_fileHandle), NULL, PAGE_READWRITE,
+		static_cast<DWORD>(mapping_size >> 32), static_cast<DWORD>(mapping_size & 0xFFFFFFFF), NULL);
+	if (!mapping)
+	{
+		return NULL;
+	}
+
+	void* data = ::MapViewOfFile(mapping, FILE_MAP_WRITE, static_cast<DWORD>(offset >> 32),
+		static_cast<DWORD>(offset & 0xFFFFFFFF), size);
+	::CloseHandle(mapping);
+	return static_cast<char*>(data);
+}
+
+void MappedFileLogSink::unmapFile(char* data, size_t /*size*/)
+{
+	::UnmapViewOfFile(data);
+}
+
+void MappedFileLogSink::closeFile()
+{
+	if (_fileHandle != -1)
+	{
+		::CloseHandle(reinterpret_cast<HANDLE>(_fileHandle));
+		_fileHandle = -1;
+	}
+}
+
+}	// End of bump namespace
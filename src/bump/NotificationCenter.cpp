@@ -14,9 +14,6 @@
 
 namespace bump {
 
-// Global singleton mutex
-static boost::mutex gNotificationCenterSingletonMutex;
-
 //====================================================================================
 //                                     Observer
 //====================================================================================
@@ -62,56 +59,129 @@ bool Observer::containsObserver(void* observer)
 //                                 NotificationCenter
 //====================================================================================
 
-NotificationCenter::NotificationCenter()
+namespace // local
+{
+	// The number of posts in progress on the calling thread, non-zero inside observer callbacks
+	thread_local unsigned int gThreadPostDepth = 0;
+
+	// Whether the calling thread is a worker of the asynchronous posting pool
+	thread_local bool gIsAsyncWorker = false;
+
+	// The default size of the asynchronous posting pool
+	const unsigned int DEFAULT_ASYNC_WORKER_COUNT = 4;
+	const unsigned int DEFAULT_ASYNC_QUEUE_CAPACITY = 1024;
+
+}	// End of local namespace
+
+NotificationCenter::SnapshotReader::SnapshotReader(NotificationCenter* notificationCenter) :
+	_notificationCenter(notificationCenter),
+	_token(0),
+	_snapshot(NULL)
+{
+	// Entering the grace period before loading the snapshot means a change whose grace period
+	// ended knows nobody can still be reading the snapshot it replaced
+	++gThreadPostDepth;
+	_token = _notificationCenter->_gracePeriod.enter();
+	_snapshot = _notificationCenter->_snapshot.load(boost::memory_order_seq_cst);
+}
+
+NotificationCenter::SnapshotReader::~SnapshotReader()
+{
+	_notificationCenter->_gracePeriod.leave(_token);
+	--gThreadPostDepth;
+
+	// Delete whatever the changes made during earlier posts left behind, without ever blocking
+	if (_notificationCenter->_hasRetired.load())
+	{
+		boost::unique_lock<boost::mutex> lock(_notificationCenter->_mutex, boost::try_to_lock);
+		if (lock.owns_lock())
+		{
+			_notificationCenter->reclaimRetiredLocked();
+		}
+	}
+}
+
+NotificationCenter::NotificationCenter() :
+	_snapshot(new ObserverSnapshot()),
+	_hasRetired(false),
+	_asyncPostCount(0),
+	_asyncWorkerCount(DEFAULT_ASYNC_WORKER_COUNT),
+	_asyncQueueCapacity(DEFAULT_ASYNC_QUEUE_CAPACITY),
+	_isStoppingAsyncWorkers(false),
+	_asyncWorkers(NULL)
 {
 	;
 }
 
 NotificationCenter::~NotificationCenter()
 {
-	;
+	// The observers may already be destroyed along with other statics, so only the posts being
+	// delivered get to finish
+	discardAsyncPosts();
+	stopAsyncPosting();
+
+	// Nothing can be posting anymore, so everything retired goes regardless of its grace period
+	boost::mutex::scoped_lock lock(_mutex);
+	BOOST_FOREACH (const Retirement& retirement, _retirements)
+	{
+		delete retirement.snapshot;
+		BOOST_FOREACH (Observer* abs_observer, retirement.observers)
+		{
+			delete abs_observer;
+		}
+	}
+	_retirements.clear();
+	delete _snapshot.load();
 }
 
 NotificationCenter* NotificationCenter::instance()
 {
-	boost::mutex::scoped_lock lock(gNotificationCenterSingletonMutex);
+	// Function local statics are initialized exactly once, even with concurrent callers,
+	// and every later call only checks the initialization guard
 	static NotificationCenter notification_center;
 	return &notification_center;
 }
 
 void NotificationCenter::addObserver(Observer* observer)
 {
-	boost::unique_lock<boost::shared_mutex> lock(_mutex);
+	boost::mutex::scoped_lock lock(_mutex);
 
-	if (observer->observerType() == bump::Observer::KEY_OBSERVER)
-	{
-		_keyObservers.push_back(observer);
-	}
-	else
-	{
-		_objectObservers.push_back(observer);
-	}
+	// Copy the snapshot along with the one list the observer is added to
+	ObserverSnapshot* snapshot = new ObserverSnapshot(*_snapshot.load());
+	ObserverMap& observers = observer->observerType() == bump::Observer::KEY_OBSERVER ? snapshot->keyObservers : snapshot->objectObservers;
+	ObserverList& list = observers[observer->notificationName()];
+	std::vector<Observer*>* new_list = list ? new std::vector<Observer*>(*list) : new std::vector<Observer*>();
+	new_list->push_back(observer);
+	list.reset(new_list);
+
+	publishSnapshotLocked(snapshot, std::vector<Observer*>());
 }
 
 bool NotificationCenter::containsObserver(void* observer)
 {
-	boost::shared_lock<boost::shared_mutex> lock(_mutex);
+	SnapshotReader reader(this);
 
-	// Iterate through the observers
-	BOOST_FOREACH (Observer* abs_observer, _keyObservers)
+	// Iterate through the observers of every notification
+	BOOST_FOREACH (const ObserverMap::value_type& observers, reader.snapshot().keyObservers)
 	{
-		if (abs_observer->containsObserver(observer))
+		BOOST_FOREACH (Observer* abs_observer, *observers.second)
 		{
-			return true;
+			if (abs_observer->containsObserver(observer))
+			{
+				return true;
+			}
 		}
 	}
 
-	// Iterate through the object observers
-	BOOST_FOREACH (Observer* abs_observer, _objectObservers)
+	// Iterate through the object observers of every notification
+	BOOST_FOREACH (const ObserverMap::value_type& observers, reader.snapshot().objectObservers)
 	{
-		if (abs_observer->containsObserver(observer))
+		BOOST_FOREACH (Observer* abs_observer, *observers.second)
 		{
-			return true;
+			if (abs_observer->containsObserver(observer))
+			{
+				return true;
+			}
 		}
 	}
 
@@ -120,73 +190,355 @@ bool NotificationCenter::containsObserver(void* observer)
 
 unsigned int NotificationCenter::postNotification(const String& notificationName)
 {
-	boost::shared_lock<boost::shared_mutex> lock(_mutex);
+	SnapshotReader reader(this);
+
+	// Only the observers registered for the notification are visited
+	const std::vector<Observer*>* observers = findObservers(reader.snapshot().keyObservers, notificationName);
+	if (!observers)
+	{
+		return 0;
+	}
+
+	BOOST_FOREACH (Observer* abs_observer, *observers)
+	{
+		abs_observer->notify();
+	}
+
+	return static_cast<unsigned int>(observers->size());
+}
+
+unsigned int NotificationCenter::postNotificationWithObject(const String& notificationName, const boost::any& object)
+{
+	SnapshotReader reader(this);
+
+	// Only the observers registered for the notification are visited
+	const std::vector<Observer*>* observers = findObservers(reader.snapshot().objectObservers, notificationName);
+	if (!observers)
+	{
+		return 0;
+	}
 
-	unsigned int notification_count = 0;
-	BOOST_FOREACH (Observer* abs_observer, _keyObservers)
+	BOOST_FOREACH (Observer* abs_observer, *observers)
 	{
-		if (abs_observer->notificationName() == notificationName)
+		abs_observer->notify(object);
+	}
+
+	return static_cast<unsigned int>(observers->size());
+}
+
+void NotificationCenter::removeObserver(void* observer)
+{
+	unsigned long long stamp = 0;
+	{
+		boost::mutex::scoped_lock lock(_mutex);
+
+		// Remove all the observers and object observers that match observer from a copy of the snapshot
+		ObserverSnapshot* snapshot = new ObserverSnapshot(*_snapshot.load());
+		std::vector<Observer*> removed_observers;
+		removeObserverFrom(snapshot->keyObservers, observer, removed_observers);
+		removeObserverFrom(snapshot->objectObservers, observer, removed_observers);
+		if (removed_observers.empty())
 		{
-			abs_observer->notify();
-			++notification_count;
+			delete snapshot;
+			return;
 		}
+
+		stamp = publishSnapshotLocked(snapshot, removed_observers);
 	}
 
-	return notification_count;
+	// Posts on other threads may still be notifying the observer, unless this is one of them
+	if (gThreadPostDepth == 0)
+	{
+		_gracePeriod.waitFor(stamp);
+		boost::mutex::scoped_lock lock(_mutex);
+		reclaimRetiredLocked();
+	}
 }
 
-unsigned int NotificationCenter::postNotificationWithObject(const String& notificationName, const boost::any& object)
+boost::unique_future<unsigned int> NotificationCenter::postNotificationAsync(const String& notificationName, DeliveryOrder order)
 {
-	boost::shared_lock<boost::shared_mutex> lock(_mutex);
+	AsyncPost* post = new AsyncPost();
+	post->notificationName = notificationName;
+	post->hasObject = false;
+	post->isOrdered = order == FIFO_DELIVERY;
+	return queueAsyncPost(post);
+}
 
-	unsigned int notification_count = 0;
-	BOOST_FOREACH (Observer* abs_observer, _objectObservers)
+boost::unique_future<unsigned int> NotificationCenter::postNotificationWithObjectAsync(const String& notificationName,
+	const boost::any& object, DeliveryOrder order)
+{
+	AsyncPost* post = new AsyncPost();
+	post->notificationName = notificationName;
+	post->object = object;
+	post->hasObject = true;
+	post->isOrdered = order == FIFO_DELIVERY;
+	return queueAsyncPost(post);
+}
+
+void NotificationCenter::setAsyncPostingLimits(unsigned int workerCount, unsigned int queueCapacity)
+{
+	stopAsyncPosting();
+
+	boost::mutex::scoped_lock lock(_asyncMutex);
+	_asyncWorkerCount = workerCount > 0 ? workerCount : 1;
+	_asyncQueueCapacity = queueCapacity > 0 ? queueCapacity : 1;
+}
+
+void NotificationCenter::waitForAsyncPosts()
+{
+	boost::mutex::scoped_lock lock(_asyncMutex);
+	while (_asyncPostCount > 0)
+	{
+		_asyncIdleCondition.wait(lock);
+	}
+}
+
+void NotificationCenter::stopAsyncPosting()
+{
+	boost::thread_group* workers = NULL;
 	{
-		if (abs_observer->notificationName() == notificationName)
+		boost::mutex::scoped_lock lock(_asyncMutex);
+
+		// Another thread is already stopping the pool, so wait for it to finish
+		if (_isStoppingAsyncWorkers)
+		{
+			while (_asyncWorkers)
+			{
+				_asyncIdleCondition.wait(lock);
+			}
+			return;
+		}
+		else if (!_asyncWorkers)
 		{
-			abs_observer->notify(object);
-			++notification_count;
+			return;
 		}
+
+		_isStoppingAsyncWorkers = true;
+		workers = _asyncWorkers;
+		_asyncWorkCondition.notify_all();
 	}
 
-	return notification_count;
+	// The workers only exit once they have delivered everything in the queue
+	workers->join_all();
+	delete workers;
+
+	boost::mutex::scoped_lock lock(_asyncMutex);
+	_asyncWorkers = NULL;
+	_isStoppingAsyncWorkers = false;
+	_asyncIdleCondition.notify_all();
 }
 
-void NotificationCenter::removeObserver(void* observer)
+const std::vector<Observer*>* NotificationCenter::findObservers(const ObserverMap& observers, const String& notificationName)
 {
-	boost::unique_lock<boost::shared_mutex> lock(_mutex);
+	ObserverMap::const_iterator iter = observers.find(notificationName);
+	return iter == observers.end() ? NULL : iter->second.get();
+}
 
-	// Remove all the observers that match observer
-	std::vector<Observer*> key_observers_to_keep;
-	BOOST_FOREACH (Observer* abs_observer, _keyObservers)
+void NotificationCenter::removeObserverFrom(ObserverMap& observers, void* observer, std::vector<Observer*>& removedObservers)
+{
+	ObserverMap::iterator iter = observers.begin();
+	while (iter != observers.end())
 	{
-		if (abs_observer->containsObserver(observer))
+		std::vector<Observer*> observers_to_keep;
+		BOOST_FOREACH (Observer* abs_observer, *iter->second)
 		{
-			delete abs_observer;
-			abs_observer = NULL;
+			if (abs_observer->containsObserver(observer))
+			{
+				removedObservers.push_back(abs_observer);
+			}
+			else
+			{
+				observers_to_keep.push_back(abs_observer);
+			}
+		}
+
+		// Notifications without any observers left are dropped from the map
+		if (observers_to_keep.empty())
+		{
+			iter = observers.erase(iter);
 		}
 		else
 		{
-			key_observers_to_keep.push_back(abs_observer);
+			if (observers_to_keep.size() != iter->second->size())
+			{
+				iter->second.reset(new std::vector<Observer*>(observers_to_keep));
+			}
+			++iter;
 		}
 	}
-	_keyObservers = key_observers_to_keep;
+}
 
-	// Remove all the object observers that match observer
-	std::vector<Observer*> object_observers_to_keep;
-	BOOST_FOREACH (Observer* abs_observer, _objectObservers)
+unsigned long long NotificationCenter::publishSnapshotLocked(ObserverSnapshot* snapshot, const std::vector<Observer*>& removedObservers)
+{
+	Retirement retirement;
+	retirement.snapshot = _snapshot.exchange(snapshot, boost::memory_order_seq_cst);
+	retirement.stamp = _gracePeriod.retire();
+	retirement.observers = removedObservers;
+	_retirements.push_back(retirement);
+	_hasRetired.store(true);
+	reclaimRetiredLocked();
+	return retirement.stamp;
+}
+
+void NotificationCenter::reclaimRetiredLocked()
+{
+	// The stamps only ever grow, so the first retirement still in its grace period ends the reclaiming
+	while (!_retirements.empty() && _gracePeriod.hasElapsed(_retirements.front().stamp))
 	{
-		if (abs_observer->containsObserver(observer))
+		Retirement& retirement = _retirements.front();
+		delete retirement.snapshot;
+		BOOST_FOREACH (Observer* abs_observer, retirement.observers)
 		{
 			delete abs_observer;
-			abs_observer = NULL;
 		}
-		else
+		_retirements.pop_front();
+	}
+
+	_hasRetired.store(!_retirements.empty());
+}
+
+boost::unique_future<unsigned int> NotificationCenter::queueAsyncPost(AsyncPost* post)
+{
+	boost::unique_future<unsigned int> future = post->promise.get_future();
+
+	boost::mutex::scoped_lock lock(_asyncMutex);
+
+	// Workers posting from their callbacks never wait for room, which could otherwise stall the whole pool
+	while (!gIsAsyncWorker && (_isStoppingAsyncWorkers || _asyncPostCount >= _asyncQueueCapacity))
+	{
+		_asyncIdleCondition.wait(lock);
+	}
+
+	if (!_asyncWorkers)
+	{
+		_asyncWorkers = new boost::thread_group();
+		for (unsigned int i = 0; i < _asyncWorkerCount; ++i)
+		{
+			_asyncWorkers->create_thread(boost::bind(&NotificationCenter::runAsyncWorker, this));
+		}
+	}
+
+	++_asyncPostCount;
+
+	// An ordered post waits behind the one of its notification already queued or being delivered
+	if (post->isOrdered)
+	{
+		OrderedPostMap::iterator iter = _orderedAsyncPosts.find(post->notificationName);
+		if (iter != _orderedAsyncPosts.end())
+		{
+			iter->second.push_back(post);
+			return future;
+		}
+		_orderedAsyncPosts[post->notificationName];
+	}
+
+	_asyncQueue.push_back(post);
+	_asyncWorkCondition.notify_one();
+
+	return future;
+}
+
+void NotificationCenter::discardAsyncPosts()
+{
+	boost::mutex::scoped_lock lock(_asyncMutex);
+
+	// The ordered posts waiting behind one being delivered are dropped, the worker delivering
+	// it then finds nothing left to hand over
+	unsigned int discarded_count = 0;
+	for (OrderedPostMap::iterator iter = _orderedAsyncPosts.begin(); iter != _orderedAsyncPosts.end(); ++iter)
+	{
+		BOOST_FOREACH (AsyncPost* post, iter->second)
+		{
+			delete post;
+			++discarded_count;
+		}
+		iter->second.clear();
+	}
+
+	// A queued ordered post is the only one of its notification, none is being delivered
+	BOOST_FOREACH (AsyncPost* post, _asyncQueue)
+	{
+		if (post->isOrdered)
 		{
-			object_observers_to_keep.push_back(abs_observer);
+			_orderedAsyncPosts.erase(post->notificationName);
+		}
+		delete post;
+		++discarded_count;
+	}
+	_asyncQueue.clear();
+
+	_asyncPostCount -= discarded_count;
+	_asyncIdleCondition.notify_all();
+	_asyncWorkCondition.notify_all();
+}
+
+void NotificationCenter::runAsyncWorker()
+{
+	gIsAsyncWorker = true;
+
+	boost::mutex::scoped_lock lock(_asyncMutex);
+	while (true)
+	{
+		while (_asyncQueue.empty() && !_isStoppingAsyncWorkers)
+		{
+			_asyncWorkCondition.wait(lock);
+		}
+
+		// Stopping only takes effect once the queue has been drained, the ordered posts still
+		// waiting are queued by the workers delivering the post in front of them
+		if (_asyncQueue.empty())
+		{
+			if (_asyncPostCount == 0)
+			{
+				break;
+			}
+			_asyncWorkCondition.wait(lock);
+			continue;
+		}
+
+		AsyncPost* post = _asyncQueue.front();
+		_asyncQueue.pop_front();
+		lock.unlock();
+
+		// Any exception thrown by an observer is handed over to the future
+		try
+		{
+			unsigned int count = post->hasObject ?
+				postNotificationWithObject(post->notificationName, post->object) :
+				postNotification(post->notificationName);
+			post->promise.set_value(count);
+		}
+		catch (...)
+		{
+			post->promise.set_exception(boost::current_exception());
+		}
+
+		lock.lock();
+
+		// Hand the next ordered post of the notification over to the queue
+		if (post->isOrdered)
+		{
+			OrderedPostMap::iterator iter = _orderedAsyncPosts.find(post->notificationName);
+			if (iter->second.empty())
+			{
+				_orderedAsyncPosts.erase(iter);
+			}
+			else
+			{
+				_asyncQueue.push_back(iter->second.front());
+				iter->second.pop_front();
+				_asyncWorkCondition.notify_one();
+			}
+		}
+
+		delete post;
+		--_asyncPostCount;
+		_asyncIdleCondition.notify_all();
+		if (_asyncPostCount == 0 && _isStoppingAsyncWorkers)
+		{
+			_asyncWorkCondition.notify_all();
 		}
 	}
-	_objectObservers = object_observers_to_keep;
 }
 
 }	// End of bump namespace
@@ -210,3 +562,15 @@ unsigned int POST_NOTIFICATION_WITH_OBJECT(const bump::String& notificationName,
 {
 	return bump::NotificationCenter::instance()->postNotificationWithObject(notificationName, object);
 }
+
+boost::unique_future<unsigned int> POST_NOTIFICATION_ASYNC(const bump::String& notificationName,
+	bump::NotificationCenter::DeliveryOrder order)
+{
+	return bump::NotificationCenter::instance()->postNotificationAsync(notificationName, order);
+}
+
+boost::unique_future<unsigned int> POST_NOTIFICATION_WITH_OBJECT_ASYNC(const bump::String& notificationName, const boost::any& object,
+	bump::NotificationCenter::DeliveryOrder order)
+{
+	return bump::NotificationCenter::instance()->postNotificationWithObjectAsync(notificationName, object, order);
+}
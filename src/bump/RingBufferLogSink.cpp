@@ -0,0 +1,100 @@
+//
+//	RingBufferLogSink.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <algorithm>
+#include <cstring>
+
+// Bump headers
+#include <bump/RingBufferLogSink.h>
+
+namespace bump {
+
+RingBufferLogSink::RingBufferLogSink(size_t capacity) :
+	_ring(std::max(capacity, static_cast<size_t>(1))),
+	_end(0),
+	_size(0),
+	_totalByteCount(0),
+	_isOverwritten(false)
+{
+	;
+}
+
+RingBufferLogSink::~RingBufferLogSink()
+{
+	// Write out what is left in the stream while write() can still be called
+	stream().flush();
+}
+
+void RingBufferLogSink::write(const Buffer* buffers, unsigned int bufferCount)
+{
+	boost::mutex::scoped_lock lock(_mutex);
+	for (unsigned int i = 0; i < bufferCount; ++i)
+	{
+		// Only the tail of a buffer larger than the ring can survive anyway
+		const char* data = buffers[i].data;
+		size_t size = buffers[i].size;
+		_totalByteCount += size;
+		if (size > _ring.size())
+		{
+			data += size - _ring.size();
+			size = _ring.size();
+		}
+
+		// Copy in at most two pieces, wrapping around the end of the ring
+		size_t first_size = std::min(size, _ring.size() - _end);
+		std::memcpy(&_ring[_end], data, first_size);
+		std::memcpy(&_ring[0], data + first_size, size - first_size);
+		_end = (_end + size) % _ring.size();
+		_isOverwritten = _isOverwritten || _size + size > _ring.size();
+		_size = std::min(_size + size, _ring.size());
+	}
+}
+
+String RingBufferLogSink::contents() const
+{
+	boost::mutex::scoped_lock lock(_mutex);
+	size_t start = (_end + _ring.size() - _size) % _ring.size();
+	size_t first_size = std::min(_size, _ring.size() - start);
+
+	String contents;
+	std::string& output = contents;
+	output.reserve(_size);
+	output.append(&_ring[start], first_size);
+	output.append(&_ring[0], _size - first_size);
+
+	// Skip the line that may have lost its beginning to newer output
+	if (_isOverwritten)
+	{
+		size_t line_end = output.find('\n');
+		output.erase(0, line_end == std::string::npos ? output.size() : line_end + 1);
+	}
+
+	return contents;
+}
+
+void RingBufferLogSink::clear()
+{
+	boost::mutex::scoped_lock lock(_mutex);
+	_end = 0;
+	_size = 0;
+	_isOverwritten = false;
+}
+
+size_t RingBufferLogSink::capacity() const
+{
+	return _ring.size();
+}
+
+unsigned long long RingBufferLogSink::totalByteCount() const
+{
+	boost::mutex::scoped_lock lock(_mutex);
+	return _totalByteCount;
+}
+
+}	// End of bump namespace
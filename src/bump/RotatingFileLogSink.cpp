@@ -0,0 +1,466 @@
+//
+//	RotatingFileLogSink.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <set>
+#include <vector>
+
+// Boost headers
+#include <boost/bind/bind.hpp>
+
+// Bump headers
+#include <bump/FileInfo.h>
+#include <bump/FileSystem.h>
+#include <bump/FileSystemError.h>
+#include <bump/LogIndexWriter.h>
+#include <bump/RotatingFileLogSink.h>
+
+// zlib headers
+#ifdef Bump_HAS_ZLIB
+	#include <zlib.h>
+#endif
+
+namespace bump {
+
+namespace // local
+{
+	// The chunk size used to compress the rotated files
+	const size_t COMPRESSION_CHUNK_SIZE = 64 * 1024;
+
+	/**
+	 * Returns the index of a rotated file name such as "app.log.3" or "app.log.3.gz".
+	 *
+	 * @param filename The name of a file in the log directory.
+	 * @param prefix The name of the log file followed by a period.
+	 * @return The index of the rotated file, 0 if the name doesn't belong to one.
+	 */
+	unsigned int rotatedFileIndex(const String& filename, const String& prefix)
+	{
+		if (!filename.startsWith(prefix))
+		{
+			return 0;
+		}
+
+		String suffix = filename.substr(prefix.size());
+		if (suffix.endsWith(".gz"))
+		{
+			suffix.erase(suffix.size() - 3);
+		}
+
+		if (suffix.empty() || suffix.size() > 9)
+		{
+			return 0;
+		}
+
+		for (size_t i = 0; i < suffix.size(); ++i)
+		{
+			if (suffix[i] < '0' || suffix[i] > '9')
+			{
+				return 0;
+			}
+		}
+
+		return suffix.toUInt();
+	}
+
+}	// End of local namespace
+
+RotatingFileLogSink::RotatingFileLogSink(const String& filepath, const RotationPolicy& policy) :
+	_filepath(filepath),
+	_nextFilepath(filepath + ".next"),
+	_policy(policy),
+	_fileSink(NULL),
+	_fileSize(0),
+	_intervalStart(0),
+	_nextIndex(1),
+	_rotationCount(0),
+	_nextFileState(NO_NEXT_FILE),
+	_isNextFileRequested(false),
+	_isBackgroundThreadBusy(false),
+	_isBackgroundThreadStopping(false),
+	_backgroundThread(NULL)
+{
+	_fileSink = new FileDescriptorLogSink(_filepath, true, _policy.indexInterval);
+	_fileSize = FileInfo(_filepath).fileSize();
+	_intervalStart = intervalStart(static_cast<long long>(std::time(NULL)));
+	findRotatedFiles();
+
+	// A file left over from an earlier interval is rotated before anything new goes in
+	if (_fileSize > 0 && _intervalStart > intervalStart(static_cast<long long>(FileInfo(_filepath).modifiedDate())))
+	{
+		try
+		{
+			rotateLocked();
+		}
+		catch (const FileSystemError& /*e*/)
+		{
+			// Keep appending to the old file, the next interval tries again
+		}
+	}
+
+	if (_policy.preallocationSize > 0 && _nextFileState == NO_NEXT_FILE)
+	{
+		_nextFileState = PREPARING_NEXT_FILE;
+		_isNextFileRequested = true;
+	}
+
+	_backgroundThread = new boost::thread(boost::bind(&RotatingFileLogSink::runBackgroundThread, this));
+}
+
+RotatingFileLogSink::~RotatingFileLogSink()
+{
+	// Write out what is left in the stream while write() can still be called
+	stream().flush();
+
+	{
+		boost::mutex::scoped_lock lock(_backgroundMutex);
+		_isBackgroundThreadStopping = true;
+	}
+	_backgroundCondition.notify_all();
+	_backgroundThread->join();
+	delete _backgroundThread;
+
+	delete _fileSink;
+}
+
+void RotatingFileLogSink::write(const Buffer* buffers, unsigned int bufferCount)
+{
+	boost::mutex::scoped_lock lock(_mutex);
+
+	size_t size = 0;
+	for (unsigned int i = 0; i < bufferCount; ++i)
+	{
+		size += buffers[i].size;
+	}
+
+	try
+	{
+		// Start a new file for each interval, the time is only looked up when there is one
+		if (_policy.intervalSeconds > 0)
+		{
+			long long interval_start = intervalStart(static_cast<long long>(std::time(NULL)));
+			if (interval_start != _intervalStart)
+			{
+				rotateLocked();
+				_intervalStart = interval_start;
+			}
+		}
+
+		// Oversized batches still go into a single file so messages are never split
+		if (_policy.maxFileSize > 0 && _fileSize + size > _policy.maxFileSize)
+		{
+			rotateLocked();
+		}
+	}
+	catch (const FileSystemError& /*e*/)
+	{
+		// Keep writing to the current file rather than losing the messages
+	}
+
+	_fileSink->write(buffers, bufferCount);
+	_fileSize += size;
+}
+
+void RotatingFileLogSink::rotate()
+{
+	boost::mutex::scoped_lock lock(_mutex);
+	rotateLocked();
+}
+
+void RotatingFileLogSink::waitForBackgroundWork()
+{
+	boost::mutex::scoped_lock lock(_backgroundMutex);
+	while (_isBackgroundThreadBusy || _isNextFileRequested || !_compressionQueue.empty() ||
+		(_policy.retentionCount > 0 && _rotatedIndices.size() > _policy.retentionCount))
+	{
+		_backgroundCondition.wait(lock);
+	}
+}
+
+const String& RotatingFileLogSink::filepath() const
+{
+	return _filepath;
+}
+
+const RotatingFileLogSink::RotationPolicy& RotatingFileLogSink::rotationPolicy() const
+{
+	return _policy;
+}
+
+unsigned int RotatingFileLogSink::rotationCount() const
+{
+	return _rotationCount;
+}
+
+bool RotatingFileLogSink::isCompressionSupported()
+{
+#ifdef Bump_HAS_ZLIB
+	return true;
+#else
+	return false;
+#endif
+}
+
+void RotatingFileLogSink::rotateLocked()
+{
+	if (_fileSize == 0)
+	{
+		return;
+	}
+
+	// The open file descriptor keeps writing to the renamed file until it is replaced
+	unsigned int index = _nextIndex;
+	String rotated_filepath = rotatedFilepath(index);
+	if (!FileSystem::renameFile(_filepath, rotated_filepath))
+	{
+		String msg = String("The following log file could not be rotated: %1").arg(_filepath);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	// The index goes along with its file so the new file starts a new index
+	if (_policy.indexInterval > 0)
+	{
+		FileSystem::renameFile(LogIndexWriter::indexFilepath(_filepath), LogIndexWriter::indexFilepath(rotated_filepath));
+	}
+
+	// Switch to the preallocated file when the background thread has one ready
+	if (_nextFileState == NEXT_FILE_READY)
+	{
+		_nextFileState = NO_NEXT_FILE;
+		FileSystem::renameFile(_nextFilepath, _filepath);
+	}
+
+	FileDescriptorLogSink* file_sink = NULL;
+	try
+	{
+		file_sink = new FileDescriptorLogSink(_filepath, true, _policy.indexInterval);
+	}
+	catch (const FileSystemError& /*e*/)
+	{
+		FileSystem::renameFile(rotated_filepath, _filepath);
+		if (_policy.indexInterval > 0)
+		{
+			FileSystem::renameFile(LogIndexWriter::indexFilepath(rotated_filepath), LogIndexWriter::indexFilepath(_filepath));
+		}
+		throw;
+	}
+
+	delete _fileSink;
+	_fileSink = file_sink;
+	_fileSize = 0;
+	++_nextIndex;
+	++_rotationCount;
+
+	// Hand everything else to the background thread
+	{
+		boost::mutex::scoped_lock lock(_backgroundMutex);
+		_rotatedIndices.push_back(index);
+		if (_policy.isCompressionEnabled && isCompressionSupported())
+		{
+			_compressionQueue.push_back(index);
+		}
+
+		if (_policy.preallocationSize > 0 && _nextFileState == NO_NEXT_FILE)
+		{
+			_nextFileState = PREPARING_NEXT_FILE;
+			_isNextFileRequested = true;
+		}
+	}
+	_backgroundCondition.notify_all();
+}
+
+long long RotatingFileLogSink::intervalStart(long long seconds) const
+{
+	if (_policy.intervalSeconds == 0)
+	{
+		return 0;
+	}
+
+	return seconds - seconds % _policy.intervalSeconds;
+}
+
+String RotatingFileLogSink::rotatedFilepath(unsigned int index) const
+{
+	return String("%1.%2").arg(_filepath, index);
+}
+
+void RotatingFileLogSink::findRotatedFiles()
+{
+	FileInfo file_info(_filepath);
+	String directory = file_info.parentPath();
+	if (directory.empty())
+	{
+		directory = ".";
+	}
+
+	StringList items;
+	try
+	{
+		items = FileSystem::directoryList(directory);
+	}
+	catch (const FileSystemError& /*e*/)
+	{
+		return;
+	}
+
+	// Collect the indices of both the compressed and the uncompressed rotated files
+	String prefix = file_info.filename() + ".";
+	std::set<unsigned int> indices;
+	for (StringList::const_iterator iter = items.begin(); iter != items.end(); ++iter)
+	{
+		unsigned int index = rotatedFileIndex(FileInfo(*iter).filename(), prefix);
+		if (index > 0)
+		{
+			indices.insert(index);
+		}
+	}
+
+	// Uncompressed files were rotated with compression off or interrupted while compressing
+	bool is_compressing = _policy.isCompressionEnabled && isCompressionSupported();
+	for (std::set<unsigned int>::const_iterator iter = indices.begin(); iter != indices.end(); ++iter)
+	{
+		_rotatedIndices.push_back(*iter);
+		if (is_compressing && FileInfo(rotatedFilepath(*iter)).isFile())
+		{
+			_compressionQueue.push_back(*iter);
+		}
+	}
+
+	if (!indices.empty())
+	{
+		_nextIndex = *indices.rbegin() + 1;
+	}
+
+	// A preallocated file left over from an earlier run is as good as a new one
+	if (_policy.preallocationSize > 0 && FileInfo(_nextFilepath).isFile() && FileInfo(_nextFilepath).fileSize() == 0)
+	{
+		_nextFileState = NEXT_FILE_READY;
+	}
+}
+
+bool RotatingFileLogSink::compressFile(const String& filepath)
+{
+#ifdef Bump_HAS_ZLIB
+	std::FILE* input = std::fopen(filepath.c_str(), "rb");
+	if (!input)
+	{
+		return false;
+	}
+
+	String compressed_filepath = filepath + ".gz";
+	gzFile output = gzopen(compressed_filepath.c_str(), "wb6");
+	if (!output)
+	{
+		std::fclose(input);
+		return false;
+	}
+
+	std::vector<char> chunk(COMPRESSION_CHUNK_SIZE);
+	bool success = true;
+	size_t size = 0;
+	while ((size = std::fread(&chunk[0], 1, chunk.size(), input)) > 0)
+	{
+		if (gzwrite(output, &chunk[0], static_cast<unsigned int>(size)) != static_cast<int>(size))
+		{
+			success = false;
+			break;
+		}
+	}
+
+	success = !std::ferror(input) && success;
+	std::fclose(input);
+	success = gzclose(output) == Z_OK && success;
+
+	// Only the compressed file is kept once it is complete
+	if (success)
+	{
+		FileSystem::removeFile(filepath);
+	}
+	else
+	{
+		FileSystem::removeFile(compressed_filepath);
+	}
+
+	return success;
+#else
+	(void)filepath;
+	return false;
+#endif
+}
+
+void RotatingFileLogSink::runBackgroundThread()
+{
+	lowerCurrentThreadPriority();
+
+	boost::mutex::scoped_lock lock(_backgroundMutex);
+	while (true)
+	{
+		// Collect the requests, pruning before compressing so no time is spent on doomed files
+		bool is_next_file_requested = _isNextFileRequested;
+		_isNextFileRequested = false;
+
+		std::deque<unsigned int> pruned_indices;
+		while (_policy.retentionCount > 0 && _rotatedIndices.size() > _policy.retentionCount)
+		{
+			pruned_indices.push_back(_rotatedIndices.front());
+			_rotatedIndices.pop_front();
+		}
+
+		std::deque<unsigned int> compression_queue;
+		compression_queue.swap(_compressionQueue);
+
+		if (!is_next_file_requested && pruned_indices.empty() && compression_queue.empty())
+		{
+			_isBackgroundThreadBusy = false;
+			_backgroundCondition.notify_all();
+			if (_isBackgroundThreadStopping)
+			{
+				break;
+			}
+
+			_backgroundCondition.wait(lock);
+			continue;
+		}
+
+		_isBackgroundThreadBusy = true;
+		lock.unlock();
+
+		if (is_next_file_requested)
+		{
+			bool is_ready = preallocateFile(_nextFilepath, _policy.preallocationSize);
+			_nextFileState = is_ready ? NEXT_FILE_READY : NO_NEXT_FILE;
+		}
+
+		for (std::deque<unsigned int>::const_iterator iter = pruned_indices.begin(); iter != pruned_indices.end(); ++iter)
+		{
+			String rotated_filepath = rotatedFilepath(*iter);
+			FileSystem::removeFile(rotated_filepath);
+			FileSystem::removeFile(rotated_filepath + ".gz");
+			FileSystem::removeFile(LogIndexWriter::indexFilepath(rotated_filepath));
+		}
+
+		for (std::deque<unsigned int>::const_iterator iter = compression_queue.begin(); iter != compression_queue.end(); ++iter)
+		{
+			if (std::find(pruned_indices.begin(), pruned_indices.end(), *iter) == pruned_indices.end())
+			{
+				String rotated_filepath = rotatedFilepath(*iter);
+				if (compressFile(rotated_filepath))
+				{
+					FileSystem::removeFile(LogIndexWriter::indexFilepath(rotated_filepath));
+				}
+			}
+		}
+
+		lock.lock();
+	}
+}
+
+}	// End of bump namespace
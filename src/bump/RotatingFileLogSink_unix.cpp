@@ -0,0 +1,63 @@
+//
+//	RotatingFileLogSink_unix.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/RotatingFileLogSink.h>
+
+// Unix headers
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __linux__
+	#include <sys/syscall.h>
+#endif
+
+namespace bump {
+
+bool RotatingFileLogSink::preallocateFile(const String& filepath, unsigned long long size)
+{
+	int file_descriptor = ::open(filepath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (file_descriptor < 0)
+	{
+		return false;
+	}
+
+	// Reserve the blocks without changing the file size so appending starts at the beginning.
+	// Filesystems without support simply allocate as the file grows.
+#if defined(__linux__)
+	::fallocate(file_descriptor, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size));
+#elif defined(__APPLE__)
+	fstore_t store = { F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>(size), 0 };
+	::fcntl(file_descriptor, F_PREALLOCATE, &store);
+#else
+	(void)size;
+#endif
+
+	::close(file_descriptor);
+	return true;
+}
+
+void RotatingFileLogSink::lowerCurrentThreadPriority()
+{
+#if defined(__linux__)
+	// Linux gives each thread its own nice value
+	::setpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid)), 19);
+#else
+	struct sched_param parameters;
+	int policy = 0;
+	if (::pthread_getschedparam(::pthread_self(), &policy, &parameters) == 0)
+	{
+		parameters.sched_priority = ::sched_get_priority_min(policy);
+		::pthread_setschedparam(::pthread_self(), policy, &parameters);
+	}
+#endif
+}
+
+}	// End of bump namespace
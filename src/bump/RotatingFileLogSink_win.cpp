@@ -0,0 +1,41 @@
+//
+//	RotatingFileLogSink_win.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/RotatingFileLogSink.h>
+
+// Windows headers
+#include <windows.h>
+
+namespace bump {
+
+bool RotatingFileLogSink::preallocateFile(const String& filepath, unsigned long long size)
+{
+	HANDLE file = ::CreateFileA(filepath.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	// Reserve the clusters without changing the end of the file so appending starts at the beginning
+	FILE_ALLOCATION_INFO allocation_info;
+	allocation_info.AllocationSize.QuadPart = static_cast<LONGLONG>(size);
+	::SetFileInformationByHandle(file, FileAllocationInfo, &allocation_info, sizeof(allocation_info));
+
+	::CloseHandle(file);
+	return true;
+}
+
+void RotatingFileLogSink::lowerCurrentThreadPriority()
+{
+	// Background mode lowers the disk priority along with the CPU priority
+	::SetThreadPriority(::GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+}
+
+}	// End of bump namespace
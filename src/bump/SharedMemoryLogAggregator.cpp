@@ -0,0 +1,99 @@
+//
+//	SharedMemoryLogAggregator.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <algorithm>
+
+// Boost headers
+#include <boost/bind/bind.hpp>
+#include <boost/chrono.hpp>
+
+// Bump headers
+#include <bump/SharedMemoryLogAggregator.h>
+
+namespace bump {
+
+namespace // local
+{
+	// The drain thread sleeps this long once the ring runs empty, doubling up to the maximum
+	const long long MIN_IDLE_TIME = 50;
+	const long long MAX_IDLE_TIME = 1000;
+
+}	// End of local namespace
+
+SharedMemoryLogAggregator::SharedMemoryLogAggregator(const String& name, LogSink& sink, size_t capacity) :
+	_ring(name, capacity),
+	_sink(sink),
+	_flushedSize(0),
+	_isStopping(false),
+	_drainThread(NULL)
+{
+	_drainThread = new boost::thread(boost::bind(&SharedMemoryLogAggregator::runDrainThread, this));
+}
+
+SharedMemoryLogAggregator::~SharedMemoryLogAggregator()
+{
+	{
+		boost::mutex::scoped_lock lock(_mutex);
+		_isStopping = true;
+	}
+	_condition.notify_all();
+	_drainThread->join();
+	delete _drainThread;
+}
+
+void SharedMemoryLogAggregator::flush()
+{
+	unsigned long long reserved_size = _ring.reservedSize();
+	boost::mutex::scoped_lock lock(_mutex);
+	_condition.notify_all();
+	while (_flushedSize < reserved_size)
+	{
+		_condition.wait(lock);
+	}
+}
+
+const SharedMemoryLogRing& SharedMemoryLogAggregator::ring() const
+{
+	return _ring;
+}
+
+void SharedMemoryLogAggregator::runDrainThread()
+{
+	long long idle_time = MIN_IDLE_TIME;
+	unsigned long long flushed_size = 0;
+	while (true)
+	{
+		if (_ring.consume(_sink) > 0)
+		{
+			idle_time = MIN_IDLE_TIME;
+			continue;
+		}
+
+		// The ring is empty or waiting on a record that is still being copied
+		unsigned long long consumed_size = _ring.consumedSize();
+		if (consumed_size != flushed_size)
+		{
+			_sink.flush();
+			flushed_size = consumed_size;
+		}
+
+		boost::mutex::scoped_lock lock(_mutex);
+		_flushedSize = flushed_size;
+		_condition.notify_all();
+		if (_isStopping)
+		{
+			break;
+		}
+
+		_condition.wait_for(lock, boost::chrono::microseconds(idle_time));
+		idle_time = std::min(idle_time * 2, MAX_IDLE_TIME);
+	}
+}
+
+}	// End of bump namespace
@@ -0,0 +1,471 @@
+//
+//	SharedMemoryLogRing.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <new>
+
+// Boost headers
+#include <boost/atomic/atomic.hpp>
+#include <boost/atomic/fences.hpp>
+#include <boost/atomic/ipc_atomic_ref.hpp>
+#include <boost/chrono.hpp>
+
+// Bump headers
+#include <bump/FileSystemError.h>
+#include <bump/SharedMemoryLogRing.h>
+
+namespace bump {
+
+namespace // local
+{
+	// The capacity is a multiple of this, which keeps the records aligned to their headers
+	const size_t CAPACITY_ALIGNMENT = 64 * 1024;
+
+	// How long a record can stay incomplete before checking whether its publisher died
+	const long long STALL_TIMEOUT = 3 * 1000000;
+
+	// The length of a record takes up the low half of its second header word, the publishing process the high half
+	const unsigned long long MAX_RECORD_LENGTH = 0xFFFFFFFFull;
+
+	// The most buffers handed to the sink at once
+	const unsigned int MAX_CONSUMED_BUFFER_COUNT = 64;
+
+	// Returns the room a record of the given length takes up in the ring
+	unsigned long long recordSize(unsigned long long length)
+	{
+		return SharedMemoryLogRing::RECORD_HEADER_SIZE + (length + 15) / 16 * 16;
+	}
+
+	// Hands each thread its own publisher slot to try first, so the threads rarely contend for one
+	boost::atomic<unsigned int> nextPublisherSlot(0);
+
+	// Returns the publisher slot the calling thread tries first
+	unsigned int& threadPublisherSlot()
+	{
+		static thread_local unsigned int slot_index = nextPublisherSlot.fetch_add(1, boost::memory_order_relaxed);
+		return slot_index;
+	}
+
+	// Returns the current time of the steady clock in microseconds
+	long long steadyMicroseconds()
+	{
+		boost::chrono::steady_clock::duration elapsed = boost::chrono::steady_clock::now().time_since_epoch();
+		return boost::chrono::duration_cast<boost::chrono::microseconds>(elapsed).count();
+	}
+
+}	// End of local namespace
+
+const char SharedMemoryLogRing::MAGIC[8] = { 'B', 'U', 'M', 'P', 'S', 'H', 'M', '2' };
+
+SharedMemoryLogRing::SharedMemoryLogRing(const String& name, size_t capacity) :
+	_name(name),
+	_capacity(std::max(CAPACITY_ALIGNMENT, (capacity + CAPACITY_ALIGNMENT - 1) / CAPACITY_ALIGNMENT * CAPACITY_ALIGNMENT)),
+	_isOwner(true),
+	_segmentHandle(-1),
+	_segment(NULL),
+	_segmentSize(0),
+	_header(NULL),
+	_records(NULL),
+	_processId(currentProcessId()),
+	_stallPosition(ULLONG_MAX),
+	_stallStart(0)
+{
+	static_assert(sizeof(Header) == HEADER_SIZE, "The header must fill the start of the segment exactly");
+
+	_segmentSize = HEADER_SIZE + _capacity;
+	createSegment(_segmentSize);
+	_header = new (_segment) Header();
+	_header->capacity = _capacity;
+	_header->reserveCursor.store(0);
+	_header->readCursor.store(0);
+	_header->droppedCount.store(0);
+	_header->lostCount.store(0);
+	for (unsigned int i = 0; i < PUBLISHER_SLOT_COUNT; ++i)
+	{
+		_header->publishers[i].processId.store(0);
+		_header->publishers[i].position.store(0);
+	}
+	_records = _segment + HEADER_SIZE;
+
+	// Publishers opening the segment early see the magic only once everything else is in place
+	boost::atomic_thread_fence(boost::memory_order_release);
+	std::memcpy(_header->magic, MAGIC, sizeof(MAGIC));
+}
+
+SharedMemoryLogRing::SharedMemoryLogRing(const String& name) :
+	_name(name),
+	_capacity(0),
+	_isOwner(false),
+	_segmentHandle(-1),
+	_segment(NULL),
+	_segmentSize(0),
+	_header(NULL),
+	_records(NULL),
+	_processId(currentProcessId()),
+	_stallPosition(ULLONG_MAX),
+	_stallStart(0)
+{
+	openSegment(_segmentSize);
+	_header = reinterpret_cast<Header*>(_segment);
+	bool is_ring = _segmentSize >= HEADER_SIZE && std::memcmp(_header->magic, MAGIC, sizeof(MAGIC)) == 0;
+	boost::atomic_thread_fence(boost::memory_order_acquire);
+
+	// The mapping can be rounded up to whole pages, but never be smaller than the ring
+	if (!is_ring || _header->capacity == 0 || _header->capacity > _segmentSize - HEADER_SIZE ||
+		_header->capacity % CAPACITY_ALIGNMENT != 0)
+	{
+		closeSegment();
+		String msg = String("The following shared memory segment is not a log ring: %1").arg(name);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	_capacity = static_cast<size_t>(_header->capacity);
+	_records = _segment + HEADER_SIZE;
+}
+
+SharedMemoryLogRing::~SharedMemoryLogRing()
+{
+	closeSegment();
+}
+
+bool SharedMemoryLogRing::publish(const LogSink::Buffer* buffers, unsigned int bufferCount)
+{
+	unsigned long long length = 0;
+	for (unsigned int i = 0; i < bufferCount; ++i)
+	{
+		length += buffers[i].size;
+	}
+
+	if (length == 0)
+	{
+		return true;
+	}
+	else if (length > MAX_RECORD_LENGTH)
+	{
+		_header->droppedCount.fetch_add(1, boost::memory_order_relaxed);
+		return false;
+	}
+
+	uint64_t position = 0;
+	PublisherSlot* slot = NULL;
+	if (!reserveRecord(length, position, slot))
+	{
+		return false;
+	}
+
+	writeRecord(position, slot, length, buffers, bufferCount);
+	return true;
+}
+
+size_t SharedMemoryLogRing::consume(LogSink& sink)
+{
+	LogSink::Buffer buffers[MAX_CONSUMED_BUFFER_COUNT];
+	unsigned int buffer_count = 0;
+	size_t record_count = 0;
+
+	unsigned long long start = _header->readCursor.load(boost::memory_order_relaxed);
+	unsigned long long reserved = _header->reserveCursor.load(boost::memory_order_acquire);
+	unsigned long long position = start;
+	while (position < reserved && buffer_count + 2 <= MAX_CONSUMED_BUFFER_COUNT)
+	{
+		size_t offset = static_cast<size_t>(position % _capacity);
+		uint64_t* record_header = reinterpret_cast<uint64_t*>(_records + offset);
+		bool is_complete = boost::ipc_atomic_ref<uint64_t>(record_header[0]).load(boost::memory_order_acquire) == position + 1;
+		uint64_t length_and_process = boost::ipc_atomic_ref<uint64_t>(record_header[1]).load(boost::memory_order_relaxed);
+		unsigned long long length = length_and_process & MAX_RECORD_LENGTH;
+		if (is_complete)
+		{
+			// A record can wrap around the end of the ring, so it takes up to two buffers
+			size_t payload_offset = (offset + RECORD_HEADER_SIZE) % _capacity;
+			size_t first_size = static_cast<size_t>(std::min(length, static_cast<unsigned long long>(_capacity - payload_offset)));
+			buffers[buffer_count].data = _records + payload_offset;
+			buffers[buffer_count].size = first_size;
+			++buffer_count;
+			if (length > first_size)
+			{
+				buffers[buffer_count].data = _records;
+				buffers[buffer_count].size = static_cast<size_t>(length) - first_size;
+				++buffer_count;
+			}
+
+			position += recordSize(length);
+			++record_count;
+			continue;
+		}
+
+		// Hand over the complete records first, the incomplete one is waited on from the front of the ring
+		if (position != start)
+		{
+			break;
+		}
+
+		long long now = steadyMicroseconds();
+		if (_stallPosition != position)
+		{
+			_stallPosition = position;
+			_stallStart = now;
+			break;
+		}
+		else if (now - _stallStart < STALL_TIMEOUT)
+		{
+			break;
+		}
+
+		// A publisher that is still running gets all the time it needs, its room can't be reused under it
+		if (length > 0)
+		{
+			uint32_t process_id = static_cast<uint32_t>(length_and_process >> 32);
+			if (isProcessRunning(process_id))
+			{
+				break;
+			}
+
+			freePublisherSlots(process_id);
+			position += recordSize(length);
+		}
+		else
+		{
+			// Without a length only the publisher slots say whose record it is. Once all of its possible
+			// publishers are gone, skip up to the next record as soon as one has been published after it.
+			if (isPublisherRunning(position) ||
+				boost::ipc_atomic_ref<uint64_t>(record_header[1]).load(boost::memory_order_relaxed) != 0)
+			{
+				break;
+			}
+
+			unsigned long long next_position = findNextRecord(position, reserved);
+			if (next_position == position)
+			{
+				break;
+			}
+
+			position = next_position;
+		}
+
+		_stallPosition = ULLONG_MAX;
+		_header->lostCount.fetch_add(1, boost::memory_order_relaxed);
+		++record_count;
+		start = position;
+	}
+
+	if (buffer_count > 0)
+	{
+		sink.write(buffers, buffer_count);
+	}
+
+	// Publishers can only reuse the room once it has been zeroed
+	unsigned long long read = _header->readCursor.load(boost::memory_order_relaxed);
+	if (position > read)
+	{
+		clearRange(read, position);
+		_header->readCursor.store(position, boost::memory_order_release);
+	}
+
+	return record_count;
+}
+
+const String& SharedMemoryLogRing::name() const
+{
+	return _name;
+}
+
+size_t SharedMemoryLogRing::capacity() const
+{
+	return _capacity;
+}
+
+bool SharedMemoryLogRing::isOwner() const
+{
+	return _isOwner;
+}
+
+unsigned long long SharedMemoryLogRing::reservedSize() const
+{
+	return _header->reserveCursor.load();
+}
+
+unsigned long long SharedMemoryLogRing::consumedSize() const
+{
+	return _header->readCursor.load();
+}
+
+unsigned long long SharedMemoryLogRing::droppedRecordCount() const
+{
+	return _header->droppedCount.load();
+}
+
+unsigned long long SharedMemoryLogRing::lostRecordCount() const
+{
+	return _header->lostCount.load();
+}
+
+bool SharedMemoryLogRing::reserveRecord(unsigned long long length, uint64_t& position, PublisherSlot*& slot)
+{
+	// Claim a publisher slot, dropping the record rather than waiting when they are all taken
+	slot = NULL;
+	unsigned int& slot_index = threadPublisherSlot();
+	for (unsigned int i = 0; i < PUBLISHER_SLOT_COUNT && !slot; ++i)
+	{
+		PublisherSlot* candidate = &_header->publishers[(slot_index + i) % PUBLISHER_SLOT_COUNT];
+		uint64_t free_process = 0;
+		if (candidate->processId.load(boost::memory_order_relaxed) == 0 &&
+			candidate->processId.compare_exchange_strong(free_process, _processId, boost::memory_order_acquire))
+		{
+			slot_index = (slot_index + i) % PUBLISHER_SLOT_COUNT;
+			slot = candidate;
+		}
+	}
+
+	if (!slot)
+	{
+		_header->droppedCount.fetch_add(1, boost::memory_order_relaxed);
+		return false;
+	}
+
+	// Reserve room for the record, dropping it rather than waiting when the ring is full. Every attempt
+	// is announced in the slot first, so the consumer can tell whose record it is before it has a length.
+	unsigned long long size = recordSize(length);
+	position = _header->reserveCursor.load(boost::memory_order_relaxed);
+	do
+	{
+		if (size > _capacity || position + size - _header->readCursor.load(boost::memory_order_acquire) > _capacity)
+		{
+			slot->processId.store(0, boost::memory_order_release);
+			_header->droppedCount.fetch_add(1, boost::memory_order_relaxed);
+			return false;
+		}
+
+		slot->position.store(position, boost::memory_order_relaxed);
+	}
+	while (!_header->reserveCursor.compare_exchange_weak(position, position + size, boost::memory_order_release,
+		boost::memory_order_relaxed));
+
+	return true;
+}
+
+void SharedMemoryLogRing::writeRecord(uint64_t position, PublisherSlot* slot, unsigned long long length,
+	const LogSink::Buffer* buffers, unsigned int bufferCount)
+{
+	// The length and process go in together and before any of the record, so the consumer can
+	// check on the publisher of a stalled record and always knows where the record ends. Only
+	// then is the slot freed, the record itself says whose it is from now on.
+	size_t offset = static_cast<size_t>(position % _capacity);
+	uint64_t* record_header = reinterpret_cast<uint64_t*>(_records + offset);
+	uint64_t length_and_process = (static_cast<uint64_t>(_processId) << 32) | length;
+	boost::ipc_atomic_ref<uint64_t>(record_header[1]).store(length_and_process, boost::memory_order_relaxed);
+	boost::atomic_thread_fence(boost::memory_order_release);
+	slot->processId.store(0, boost::memory_order_relaxed);
+
+	// Copy the buffers in pieces that wrap around the end of the ring
+	offset = (offset + RECORD_HEADER_SIZE) % _capacity;
+	for (unsigned int i = 0; i < bufferCount; ++i)
+	{
+		const char* data = buffers[i].data;
+		size_t remaining = buffers[i].size;
+		while (remaining > 0)
+		{
+			size_t piece_size = std::min(remaining, _capacity - offset);
+			std::memcpy(_records + offset, data, piece_size);
+			data += piece_size;
+			remaining -= piece_size;
+			offset = (offset + piece_size) % _capacity;
+		}
+	}
+
+	boost::ipc_atomic_ref<uint64_t>(record_header[0]).store(position + 1, boost::memory_order_release);
+}
+
+bool SharedMemoryLogRing::isPublisherRunning(unsigned long long position)
+{
+	// The slot announcing the position can't have been freed without the length being stored first,
+	// and slots that announced it before losing the reservation to another publisher are checked too
+	bool is_announced = false;
+	for (unsigned int i = 0; i < PUBLISHER_SLOT_COUNT; ++i)
+	{
+		PublisherSlot& slot = _header->publishers[i];
+		if (slot.position.load(boost::memory_order_relaxed) != position)
+		{
+			continue;
+		}
+
+		uint32_t process_id = static_cast<uint32_t>(slot.processId.load(boost::memory_order_acquire));
+		if (process_id != 0)
+		{
+			is_announced = true;
+			if (isProcessRunning(process_id))
+			{
+				return true;
+			}
+
+			freePublisherSlots(process_id);
+		}
+	}
+
+	// Nobody announced it only when the length has been stored since, which the caller rereads
+	return !is_announced;
+}
+
+void SharedMemoryLogRing::freePublisherSlots(uint32_t processId)
+{
+	for (unsigned int i = 0; i < PUBLISHER_SLOT_COUNT; ++i)
+	{
+		uint64_t process_id = processId;
+		_header->publishers[i].processId.compare_exchange_strong(process_id, 0, boost::memory_order_relaxed);
+	}
+}
+
+unsigned long long SharedMemoryLogRing::findNextRecord(unsigned long long position, unsigned long long reserved) const
+{
+	// A length is stored before any of its record is copied, so a word found further on could still be
+	// part of a record whose length wasn't in yet. It is only the next record once the room in front of
+	// it is still zeroed after finding it.
+	unsigned long long next_position = position;
+	unsigned long long end = reserved;
+	while (true)
+	{
+		unsigned long long found_position = end;
+		for (unsigned long long scan_position = position + RECORD_HEADER_SIZE; scan_position < end;
+			scan_position += RECORD_HEADER_SIZE)
+		{
+			uint64_t* record_header = reinterpret_cast<uint64_t*>(_records + scan_position % _capacity);
+			if (boost::ipc_atomic_ref<uint64_t>(record_header[1]).load(boost::memory_order_acquire) != 0)
+			{
+				found_position = scan_position;
+				break;
+			}
+		}
+
+		if (found_position == end)
+		{
+			return next_position;
+		}
+
+		next_position = found_position;
+		end = found_position;
+	}
+}
+
+void SharedMemoryLogRing::clearRange(unsigned long long start, unsigned long long end)
+{
+	if (end - start >= _capacity)
+	{
+		std::memset(_records, 0, _capacity);
+		return;
+	}
+
+	size_t offset = static_cast<size_t>(start % _capacity);
+	size_t size = static_cast<size_t>(end - start);
+	size_t first_size = std::min(size, _capacity - offset);
+	std::memset(_records + offset, 0, first_size);
+	std::memset(_records, 0, size - first_size);
+}
+
+}	// End of bump namespace
@@ -0,0 +1,118 @@
+//
+//	SharedMemoryLogRing_unix.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/FileSystemError.h>
+#include <bump/SharedMemoryLogRing.h>
+
+// Unix headers
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bump {
+
+namespace // local
+{
+	// POSIX shared memory objects are named like files in the root directory
+	String segmentPath(const String& name)
+	{
+		return String("/") + name;
+	}
+
+}	// End of local namespace
+
+uint32_t SharedMemoryLogRing::currentProcessId()
+{
+	return static_cast<uint32_t>(::getpid());
+}
+
+bool SharedMemoryLogRing::isProcessRunning(uint32_t processId)
+{
+	// Signal 0 only checks the process exists, a process of another user still does
+	return ::kill(static_cast<pid_t>(processId), 0) == 0 || errno != ESRCH;
+}
+
+void SharedMemoryLogRing::createSegment(size_t size)
+{
+	// A segment left behind by a crashed owner is replaced, publishers still mapping it keep their copy
+	String path = segmentPath(_name);
+	::shm_unlink(path.c_str());
+	int segment_descriptor = ::shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0660);
+	void* data = MAP_FAILED;
+	if (segment_descriptor >= 0 && ::ftruncate(segment_descriptor, static_cast<off_t>(size)) == 0)
+	{
+		data = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, segment_descriptor, 0);
+	}
+
+	if (data == MAP_FAILED)
+	{
+		if (segment_descriptor >= 0)
+		{
+			::close(segment_descriptor);
+			::shm_unlink(path.c_str());
+		}
+
+		String msg = String("The following shared memory segment could not be created: %1").arg(_name);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	_segmentHandle = segment_descriptor;
+	_segment = static_cast<char*>(data);
+}
+
+void SharedMemoryLogRing::openSegment(size_t& size)
+{
+	int segment_descriptor = ::shm_open(segmentPath(_name).c_str(), O_RDWR | O_CLOEXEC, 0);
+	struct stat segment_status;
+	void* data = MAP_FAILED;
+	if (segment_descriptor >= 0 && ::fstat(segment_descriptor, &segment_status) == 0 && segment_status.st_size > 0)
+	{
+		size = static_cast<size_t>(segment_status.st_size);
+		data = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, segment_descriptor, 0);
+	}
+
+	if (data == MAP_FAILED)
+	{
+		if (segment_descriptor >= 0)
+		{
+			::close(segment_descriptor);
+		}
+
+		String msg = String("The following shared memory segment could not be opened: %1").arg(_name);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	_segmentHandle = segment_descriptor;
+	_segment = static_cast<char*>(data);
+}
+
+void SharedMemoryLogRing::closeSegment()
+{
+	if (_segment)
+	{
+		::munmap(_segment, _segmentSize);
+		_segment = NULL;
+	}
+
+	if (_segmentHandle >= 0)
+	{
+		::close(static_cast<int>(_segmentHandle));
+		_segmentHandle = -1;
+	}
+
+	if (_isOwner)
+	{
+		::shm_unlink(segmentPath(_name).c_str());
+	}
+}
+
+}	// End of bump namespace
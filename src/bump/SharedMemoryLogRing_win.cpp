@@ -0,0 +1,114 @@
+//
+//	SharedMemoryLogRing_win.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/FileSystemError.h>
+#include <bump/SharedMemoryLogRing.h>
+
+// Windows headers
+#include <windows.h>
+
+namespace bump {
+
+namespace // local
+{
+	// Named file mappings of the session namespace don't need any privileges
+	String mappingName(const String& name)
+	{
+		return String("Local\\") + name;
+	}
+
+}	// End of local namespace
+
+uint32_t SharedMemoryLogRing::currentProcessId()
+{
+	return static_cast<uint32_t>(::GetCurrentProcessId());
+}
+
+bool SharedMemoryLogRing::isProcessRunning(uint32_t processId)
+{
+	// A process that can't be opened for lack of rights is still running
+	HANDLE process = ::OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(processId));
+	if (!process)
+	{
+		return ::GetLastError() != ERROR_INVALID_PARAMETER;
+	}
+
+	bool is_running = ::WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+	::CloseHandle(process);
+	return is_running;
+}
+
+void SharedMemoryLogRing::createSegment(size_t size)
+{
+	// The mapping goes away with its last handle, so there is never one left behind to replace
+	unsigned long long mapping_size = size;
+	HANDLE mapping = ::CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, static_cast<DWORD>(mapping_size >> 32),
+		static_cast<DWORD>(mapping_size & 0xFFFFFFFF), mappingName(_name).c_str());
+	void* data = NULL;
+	if (mapping && ::GetLastError() != ERROR_ALREADY_EXISTS)
+	{
+		data = ::MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+	}
+
+	if (!data)
+	{
+		if (mapping)
+		{
+			::CloseHandle(mapping);
+		}
+
+		String msg = String("The following shared memory segment could not be created: %1").arg(_name);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	_segmentHandle = reinterpret_cast<intptr_t>(mapping);
+	_segment = static_cast<char*>(data);
+}
+
+void SharedMemoryLogRing::openSegment(size_t& size)
+{
+	HANDLE mapping = ::OpenFileMappingA(FILE_MAP_WRITE, FALSE, mappingName(_name).c_str());
+	void* data = mapping ? ::MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0) : NULL;
+	MEMORY_BASIC_INFORMATION info;
+	if (!data || ::VirtualQuery(data, &info, sizeof(info)) == 0)
+	{
+		if (data)
+		{
+			::UnmapViewOfFile(data);
+		}
+		if (mapping)
+		{
+			::CloseHandle(mapping);
+		}
+
+		String msg = String("The following shared memory segment could not be opened: %1").arg(_name);
+		throw FileSystemError(msg, BUMP_LOCATION);
+	}
+
+	_segmentHandle = reinterpret_cast<intptr_t>(mapping);
+	_segment = static_cast<char*>(data);
+	size = static_cast<size_t>(info.RegionSize);
+}
+
+void SharedMemoryLogRing::closeSegment()
+{
+	if (_segment)
+	{
+		::UnmapViewOfFile(_segment);
+		_segment = NULL;
+	}
+
+	if (_segmentHandle != -1)
+	{
+		::CloseHandle(reinterpret_cast<HANDLE>(_segmentHandle));
+		_segmentHandle = -1;
+	}
+}
+
+}	// End of bump namespace
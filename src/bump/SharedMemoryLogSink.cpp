@@ -0,0 +1,50 @@
+//
+//	SharedMemoryLogSink.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/SharedMemoryLogSink.h>
+
+namespace bump {
+
+SharedMemoryLogSink::SharedMemoryLogSink(const String& name) :
+	_ring(name),
+	_droppedWriteCount(0)
+{
+	;
+}
+
+SharedMemoryLogSink::~SharedMemoryLogSink()
+{
+	// Write out what is left in the stream while write() can still be called
+	stream().flush();
+}
+
+void SharedMemoryLogSink::write(const Buffer* buffers, unsigned int bufferCount)
+{
+	if (!_ring.publish(buffers, bufferCount))
+	{
+		++_droppedWriteCount;
+	}
+}
+
+bool SharedMemoryLogSink::isThreadSafe() const
+{
+	return true;
+}
+
+const SharedMemoryLogRing& SharedMemoryLogSink::ring() const
+{
+	return _ring;
+}
+
+unsigned long long SharedMemoryLogSink::droppedWriteCount() const
+{
+	return _droppedWriteCount;
+}
+
+}	// End of bump namespace
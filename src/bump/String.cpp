@@ -7,8 +7,10 @@
 //
 
 // C++ headers
+#include <cstring>
 #include <iomanip>
 #include <limits>
+#include <locale>
 #include <sstream>
 
 // Boost headers
@@ -16,18 +18,701 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/regex.hpp>
 #include <boost/algorithm/string/trim.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/regex.hpp>
 
 // Bump headers
+#include <bump/Cpu.h>
 #include <bump/InvalidArgumentError.h>
 #include <bump/OutOfRangeError.h>
 #include <bump/String.h>
 #include <bump/StringSearchError.h>
 #include <bump/TypeCastError.h>
 
+// SIMD intrinsics headers
+#ifdef BUMP_CPU_X86
+	#include <immintrin.h>
+#endif
+
 namespace bump {
 
+//====================================================================================
+//                                  Scalar Kernels
+//====================================================================================
+
+namespace // local
+{
+	// Returns whether the 8 bytes starting at data are all ASCII
+	inline bool isAsciiWord(const unsigned char* data)
+	{
+		boost::uint64_t word;
+		std::memcpy(&word, data, sizeof(word));
+		return (word & 0x8080808080808080ULL) == 0;
+	}
+
+	// Returns the number of leading ASCII bytes in data, checked a word at a time
+	inline size_t asciiPrefixLength(const unsigned char* data, size_t length)
+	{
+		size_t position = 0;
+		for (; position + 8 <= length && isAsciiWord(data + position); position += 8);
+		return position;
+	}
+
+	// Validates UTF-8 one sequence at a time following the well-formed byte sequence
+	// table of the Unicode Standard (Table 3-7), skipping over runs of ASCII.
+	bool validateUtf8Scalar(const unsigned char* data, size_t length)
+	{
+		size_t position = 0;
+		while (position < length)
+		{
+			// Skip all the ASCII we can in blocks
+			position += asciiPrefixLength(data + position, length - position);
+			if (position >= length)
+			{
+				break;
+			}
+
+			unsigned char lead = data[position];
+			if (lead < 0x80)
+			{
+				++position;
+				continue;
+			}
+
+			// Figure out the sequence length from the lead byte
+			size_t sequence_length = 0;
+			if (lead >= 0xC2 && lead <= 0xDF)
+			{
+				sequence_length = 2;
+			}
+			else if (lead >= 0xE0 && lead <= 0xEF)
+			{
+				sequence_length = 3;
+			}
+			else if (lead >= 0xF0 && lead <= 0xF4)
+			{
+				sequence_length = 4;
+			}
+			else
+			{
+				return false;
+			}
+
+			if (position + sequence_length > length)
+			{
+				return false;
+			}
+
+			// The second byte has a restricted range for a few lead bytes to reject overlong
+			// encodings, surrogates and code points larger than U+10FFFF
+			unsigned char second = data[position + 1];
+			unsigned char second_min = 0x80;
+			unsigned char second_max = 0xBF;
+			if (lead == 0xE0)
+			{
+				second_min = 0xA0;
+			}
+			else if (lead == 0xED)
+			{
+				second_max = 0x9F;
+			}
+			else if (lead == 0xF0)
+			{
+				second_min = 0x90;
+			}
+			else if (lead == 0xF4)
+			{
+				second_max = 0x8F;
+			}
+
+			if (second < second_min || second > second_max)
+			{
+				return false;
+			}
+
+			for (size_t i = 2; i < sequence_length; ++i)
+			{
+				if ((data[position + i] & 0xC0) != 0x80)
+				{
+					return false;
+				}
+			}
+
+			position += sequence_length;
+		}
+
+		return true;
+	}
+
+	// Counts every byte that is not a UTF-8 continuation byte (10______)
+	size_t countCodePointsScalar(const unsigned char* data, size_t length)
+	{
+		size_t count = 0;
+		for (size_t position = 0; position < length; ++position)
+		{
+			if ((data[position] & 0xC0) != 0x80)
+			{
+				++count;
+			}
+		}
+
+		return count;
+	}
+
+	// Toggles the case of every ASCII letter in the 26 letter range starting at first. Passing
+	// 'A' lowers the data and 'a' uppers it since both only differ by the 0x20 bit.
+	void convertCaseScalar(char* data, size_t length, char first)
+	{
+		for (size_t position = 0; position < length; ++position)
+		{
+			if ((unsigned char)(data[position] - first) < 26)
+			{
+				data[position] ^= 0x20;
+			}
+		}
+	}
+
+}	// End of local namespace
+
+#ifdef BUMP_CPU_X86
+
+//====================================================================================
+//                                   SIMD Kernels
+//====================================================================================
+
+namespace // local
+{
+	// Error classes of the lookup algorithm from "Validating UTF-8 In Less Than One Instruction
+	// Per Byte" (Keiser and Lemire). Every pair of adjacent bytes is classified by the high
+	// nibble of the first byte, the low nibble of the first byte and the high nibble of the
+	// second byte. ANDing the three lookups together leaves only the errors that all agree.
+	const char UTF8_TOO_SHORT		= 1 << 0;	// 11______ 0_______ or 11______ 11______
+	const char UTF8_TOO_LONG		= 1 << 1;	// 0_______ 10______
+	const char UTF8_OVERLONG_3		= 1 << 2;	// 11100000 100_____
+	const char UTF8_TOO_LARGE		= 1 << 3;	// 11110100 1001____ or 11110101+ 10______
+	const char UTF8_SURROGATE		= 1 << 4;	// 11101101 101_____
+	const char UTF8_OVERLONG_2		= 1 << 5;	// 1100000_ 10______
+	const char UTF8_TOO_LARGE_1000	= 1 << 6;	// 11110101+ 1000____
+	const char UTF8_OVERLONG_4		= 1 << 6;	// 11110000 1000____
+	const char UTF8_TWO_CONTS		= char(1 << 7);	// 10______ 10______
+	const char UTF8_CARRY			= UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS;
+
+	// The 16 entry lookup tables shared by the 128 and 256-bit kernels
+	#define BUMP_UTF8_BYTE_1_HIGH_TABLE \
+		/* 0_______ ________ <ASCII in byte 1> */ \
+		UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, \
+		UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, \
+		/* 10______ ________ <continuation in byte 1> */ \
+		UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, \
+		/* 1100____ ________ <two byte lead in byte 1> */ \
+		UTF8_TOO_SHORT | UTF8_OVERLONG_2, \
+		/* 1101____ ________ <two byte lead in byte 1> */ \
+		UTF8_TOO_SHORT, \
+		/* 1110____ ________ <three byte lead in byte 1> */ \
+		UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE, \
+		/* 1111____ ________ <four+ byte lead in byte 1> */ \
+		UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+
+	#define BUMP_UTF8_BYTE_1_LOW_TABLE \
+		/* ____0000 ________ */ \
+		UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4, \
+		/* ____0001 ________ */ \
+		UTF8_CARRY | UTF8_OVERLONG_2, \
+		/* ____001_ ________ */ \
+		UTF8_CARRY, \
+		UTF8_CARRY, \
+		/* ____0100 ________ */ \
+		UTF8_CARRY | UTF8_TOO_LARGE, \
+		/* ____0101 ________ */ \
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+		/* ____011_ ________ */ \
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+		/* ____1___ ________ */ \
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+		/* ____1101 ________ */ \
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE, \
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+
+	#define BUMP_UTF8_BYTE_2_HIGH_TABLE \
+		/* ________ 0_______ <ASCII in byte 2> */ \
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, \
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, \
+		/* ________ 1000____ */ \
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4, \
+		/* ________ 1001____ */ \
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE, \
+		/* ________ 101_____ */ \
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE, \
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE, \
+		/* ________ 11______ */ \
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+
+	// The largest values of the last three bytes of a block that do not start a sequence
+	// running into the next block
+	#define BUMP_UTF8_INCOMPLETE_TABLE \
+		char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), \
+		char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1)
+
+	//////////////////////////////////////////////////////////////////////////////////
+	//                                   SSE4.2
+	//////////////////////////////////////////////////////////////////////////////////
+
+	// Returns the input shifted back by N bytes with the tail of the previous block shifted in
+	template <int N>
+	BUMP_TARGET_SSE42 inline __m128i previousBytesSse42(__m128i input, __m128i previousInput)
+	{
+		return _mm_alignr_epi8(input, previousInput, 16 - N);
+	}
+
+	// Returns a non-zero byte for every byte of the input that is part of a UTF-8 error
+	BUMP_TARGET_SSE42 inline __m128i utf8ErrorsSse42(__m128i input, __m128i previousInput)
+	{
+		const __m128i byte_1_high_table = _mm_setr_epi8(BUMP_UTF8_BYTE_1_HIGH_TABLE);
+		const __m128i byte_1_low_table = _mm_setr_epi8(BUMP_UTF8_BYTE_1_LOW_TABLE);
+		const __m128i byte_2_high_table = _mm_setr_epi8(BUMP_UTF8_BYTE_2_HIGH_TABLE);
+		const __m128i low_nibble_mask = _mm_set1_epi8(0x0F);
+
+		// Classify every pair of adjacent bytes
+		__m128i previous_1 = previousBytesSse42<1>(input, previousInput);
+		__m128i byte_1_high = _mm_shuffle_epi8(byte_1_high_table, _mm_and_si128(_mm_srli_epi16(previous_1, 4), low_nibble_mask));
+		__m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(previous_1, low_nibble_mask));
+		__m128i byte_2_high = _mm_shuffle_epi8(byte_2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble_mask));
+		__m128i special_cases = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+		// The third and fourth bytes of a sequence must be continuations, which only the
+		// two and three byte lookbacks can tell us. Saturating subtraction leaves the high
+		// bit set only for 111_____ and 1111____ lead bytes respectively.
+		__m128i previous_2 = previousBytesSse42<2>(input, previousInput);
+		__m128i previous_3 = previousBytesSse42<3>(input, previousInput);
+		__m128i is_third_byte = _mm_subs_epu8(previous_2, _mm_set1_epi8(char(0xE0 - 0x80)));
+		__m128i is_fourth_byte = _mm_subs_epu8(previous_3, _mm_set1_epi8(char(0xF0 - 0x80)));
+		__m128i must_be_continuation = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(UTF8_TWO_CONTS));
+
+		return _mm_xor_si128(must_be_continuation, special_cases);
+	}
+
+	// Validates UTF-8 16 bytes at a time using the lookup algorithm
+	BUMP_TARGET_SSE42 bool validateUtf8Sse42(const unsigned char* data, size_t length)
+	{
+		const __m128i incomplete_table = _mm_setr_epi8(BUMP_UTF8_INCOMPLETE_TABLE);
+		__m128i error = _mm_setzero_si128();
+		__m128i previous_input = _mm_setzero_si128();
+		__m128i previous_incomplete = _mm_setzero_si128();
+
+		size_t position = 0;
+		for (; position + 16 <= length; position += 16)
+		{
+			__m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+			if (_mm_movemask_epi8(input) == 0)
+			{
+				// Pure ASCII only needs to check whether the last block was left incomplete
+				error = _mm_or_si128(error, previous_incomplete);
+			}
+			else
+			{
+				error = _mm_or_si128(error, utf8ErrorsSse42(input, previous_input));
+				previous_incomplete = _mm_subs_epu8(input, incomplete_table);
+			}
+			previous_input = input;
+		}
+
+		// Always run a final zero padded block through the full check. The trailing zeros
+		// are ASCII, so any sequence left incomplete at the end of the data is flagged.
+		unsigned char tail[16] = { 0 };
+		std::memcpy(tail, data + position, length - position);
+		__m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tail));
+		error = _mm_or_si128(error, utf8ErrorsSse42(input, previous_input));
+
+		return _mm_testz_si128(error, error) != 0;
+	}
+
+	// Counts the lead bytes 16 at a time. As signed bytes, the continuation bytes are exactly
+	// the values below -64. Every comparison result is -1 for a lead byte, so subtracting
+	// accumulates the counts per byte lane which are then summed with a SAD against zero
+	// before they can overflow.
+	BUMP_TARGET_SSE42 size_t countCodePointsSse42(const unsigned char* data, size_t length)
+	{
+		const __m128i continuation_max = _mm_set1_epi8(-65);
+		size_t count = 0;
+		size_t position = 0;
+		while (position + 16 <= length)
+		{
+			__m128i counts = _mm_setzero_si128();
+			for (int i = 0; i < 255 && position + 16 <= length; ++i, position += 16)
+			{
+				__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+				counts = _mm_sub_epi8(counts, _mm_cmpgt_epi8(block, continuation_max));
+			}
+			__m128i sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+			count += _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+		}
+
+		return count + countCodePointsScalar(data + position, length - position);
+	}
+
+	// Toggles the case of the ASCII letters 16 bytes at a time. Subtracting the first letter
+	// moves the range to [0, 25] which an unsigned minimum can test for.
+	BUMP_TARGET_SSE42 void convertCaseSse42(char* data, size_t length, char first)
+	{
+		const __m128i first_letter = _mm_set1_epi8(first);
+		const __m128i last_offset = _mm_set1_epi8(25);
+		const __m128i case_bit = _mm_set1_epi8(0x20);
+		size_t position = 0;
+		for (; position + 16 <= length; position += 16)
+		{
+			__m128i* block_pointer = reinterpret_cast<__m128i*>(data + position);
+			__m128i block = _mm_loadu_si128(block_pointer);
+			__m128i offset = _mm_sub_epi8(block, first_letter);
+			__m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(offset, last_offset), offset);
+			_mm_storeu_si128(block_pointer, _mm_xor_si128(block, _mm_and_si128(is_letter, case_bit)));
+		}
+
+		convertCaseScalar(data + position, length - position, first);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////
+	//                                    AVX2
+	//////////////////////////////////////////////////////////////////////////////////
+
+	// Returns the input shifted back by N bytes with the tail of the previous block shifted in
+	template <int N>
+	BUMP_TARGET_AVX2 inline __m256i previousBytesAvx2(__m256i input, __m256i previousInput)
+	{
+		return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previousInput, input, 0x21), 16 - N);
+	}
+
+	// Returns a non-zero byte for every byte of the input that is part of a UTF-8 error
+	BUMP_TARGET_AVX2 inline __m256i utf8ErrorsAvx2(__m256i input, __m256i previousInput)
+	{
+		const __m256i byte_1_high_table = _mm256_setr_epi8(BUMP_UTF8_BYTE_1_HIGH_TABLE, BUMP_UTF8_BYTE_1_HIGH_TABLE);
+		const __m256i byte_1_low_table = _mm256_setr_epi8(BUMP_UTF8_BYTE_1_LOW_TABLE, BUMP_UTF8_BYTE_1_LOW_TABLE);
+		const __m256i byte_2_high_table = _mm256_setr_epi8(BUMP_UTF8_BYTE_2_HIGH_TABLE, BUMP_UTF8_BYTE_2_HIGH_TABLE);
+		const __m256i low_nibble_mask = _mm256_set1_epi8(0x0F);
+
+		// Classify every pair of adjacent bytes
+		__m256i previous_1 = previousBytesAvx2<1>(input, previousInput);
+		__m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(previous_1, 4), low_nibble_mask));
+		__m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(previous_1, low_nibble_mask));
+		__m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble_mask));
+		__m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+		// Check the third and fourth bytes the same way as the SSE4.2 kernel
+		__m256i previous_2 = previousBytesAvx2<2>(input, previousInput);
+		__m256i previous_3 = previousBytesAvx2<3>(input, previousInput);
+		__m256i is_third_byte = _mm256_subs_epu8(previous_2, _mm256_set1_epi8(char(0xE0 - 0x80)));
+		__m256i is_fourth_byte = _mm256_subs_epu8(previous_3, _mm256_set1_epi8(char(0xF0 - 0x80)));
+		__m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(UTF8_TWO_CONTS));
+
+		return _mm256_xor_si256(must_be_continuation, special_cases);
+	}
+
+	// Validates UTF-8 32 bytes at a time using the lookup algorithm
+	BUMP_TARGET_AVX2 bool validateUtf8Avx2(const unsigned char* data, size_t length)
+	{
+		const __m256i incomplete_table = _mm256_setr_epi8(
+			char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+			char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+			BUMP_UTF8_INCOMPLETE_TABLE);
+		__m256i error = _mm256_setzero_si256();
+		__m256i previous_input = _mm256_setzero_si256();
+		__m256i previous_incomplete = _mm256_setzero_si256();
+
+		size_t position = 0;
+		for (; position + 32 <= length; position += 32)
+		{
+			__m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position));
+			if (_mm256_movemask_epi8(input) == 0)
+			{
+				// Pure ASCII only needs to check whether the last block was left incomplete
+				error = _mm256_or_si256(error, previous_incomplete);
+			}
+			else
+			{
+				error = _mm256_or_si256(error, utf8ErrorsAvx2(input, previous_input));
+				previous_incomplete = _mm256_subs_epu8(input, incomplete_table);
+			}
+			previous_input = input;
+		}
+
+		// Always run a final zero padded block through the full check
+		unsigned char tail[32] = { 0 };
+		std::memcpy(tail, data + position, length - position);
+		__m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail));
+		error = _mm256_or_si256(error, utf8ErrorsAvx2(input, previous_input));
+
+		return _mm256_testz_si256(error, error) != 0;
+	}
+
+	// Counts the lead bytes 32 at a time the same way as the SSE4.2 kernel
+	BUMP_TARGET_AVX2 size_t countCodePointsAvx2(const unsigned char* data, size_t length)
+	{
+		const __m256i continuation_max = _mm256_set1_epi8(-65);
+		size_t count = 0;
+		size_t position = 0;
+		while (position + 32 <= length)
+		{
+			__m256i counts = _mm256_setzero_si256();
+			for (int i = 0; i < 255 && position + 32 <= length; ++i, position += 32)
+			{
+				__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position));
+				counts = _mm256_sub_epi8(counts, _mm256_cmpgt_epi8(block, continuation_max));
+			}
+			__m256i sums = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+			__m128i lane_sums = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+			count += _mm_cvtsi128_si32(lane_sums) + _mm_cvtsi128_si32(_mm_srli_si128(lane_sums, 8));
+		}
+
+		return count + countCodePointsScalar(data + position, length - position);
+	}
+
+	// Toggles the case of the ASCII letters 32 bytes at a time
+	BUMP_TARGET_AVX2 void convertCaseAvx2(char* data, size_t length, char first)
+	{
+		const __m256i first_letter = _mm256_set1_epi8(first);
+		const __m256i last_offset = _mm256_set1_epi8(25);
+		const __m256i case_bit = _mm256_set1_epi8(0x20);
+		size_t position = 0;
+		for (; position + 32 <= length; position += 32)
+		{
+			__m256i* block_pointer = reinterpret_cast<__m256i*>(data + position);
+			__m256i block = _mm256_loadu_si256(block_pointer);
+			__m256i offset = _mm256_sub_epi8(block, first_letter);
+			__m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, last_offset), offset);
+			_mm256_storeu_si256(block_pointer, _mm256_xor_si256(block, _mm256_and_si256(is_letter, case_bit)));
+		}
+
+		convertCaseScalar(data + position, length - position, first);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////
+	//                                   AVX-512
+	//////////////////////////////////////////////////////////////////////////////////
+
+	// Toggles the case of the ASCII letters 64 bytes at a time, using a masked load and
+	// store for the tail so no scalar loop is needed
+	BUMP_TARGET_AVX512 void convertCaseAvx512(char* data, size_t length, char first)
+	{
+		const __m512i first_letter = _mm512_set1_epi8(first);
+		const __m512i letter_count = _mm512_set1_epi8(26);
+		const __m512i case_bit = _mm512_set1_epi8(0x20);
+		size_t position = 0;
+		for (; position + 64 <= length; position += 64)
+		{
+			__m512i block = _mm512_loadu_si512(data + position);
+			__mmask64 is_letter = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(block, first_letter), letter_count);
+			_mm512_storeu_si512(data + position, _mm512_xor_si512(block, _mm512_maskz_mov_epi8(is_letter, case_bit)));
+		}
+
+		if (position < length)
+		{
+			__mmask64 tail_mask = (__mmask64)(~0ULL >> (64 - (length - position)));
+			__m512i block = _mm512_maskz_loadu_epi8(tail_mask, data + position);
+			__mmask64 is_letter = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(block, first_letter), letter_count);
+			_mm512_mask_storeu_epi8(data + position, tail_mask, _mm512_xor_si512(block, _mm512_maskz_mov_epi8(is_letter, case_bit)));
+		}
+	}
+
+	#undef BUMP_UTF8_BYTE_1_HIGH_TABLE
+	#undef BUMP_UTF8_BYTE_1_LOW_TABLE
+	#undef BUMP_UTF8_BYTE_2_HIGH_TABLE
+	#undef BUMP_UTF8_INCOMPLETE_TABLE
+
+}	// End of local namespace
+
+#endif	// End of BUMP_CPU_X86
+
+//====================================================================================
+//                                  Kernel Dispatch
+//====================================================================================
+
+namespace // local
+{
+	// Function pointer types for the kernels with several implementations
+	typedef bool (*ValidateUtf8Kernel)(const unsigned char* data, size_t length);
+	typedef size_t (*CountCodePointsKernel)(const unsigned char* data, size_t length);
+	typedef void (*ConvertCaseKernel)(char* data, size_t length, char first);
+
+	// The table of kernels selected for the host processor
+	struct StringKernels
+	{
+		StringKernels() :
+			validateUtf8(Cpu::selectKernel<ValidateUtf8Kernel>(validateUtf8Scalar,
+				BUMP_CPU_KERNEL(validateUtf8Sse42), BUMP_CPU_KERNEL(validateUtf8Avx2), NULL)),
+			countCodePoints(Cpu::selectKernel<CountCodePointsKernel>(countCodePointsScalar,
+				BUMP_CPU_KERNEL(countCodePointsSse42), BUMP_CPU_KERNEL(countCodePointsAvx2), NULL)),
+			convertCase(Cpu::selectKernel<ConvertCaseKernel>(convertCaseScalar,
+				BUMP_CPU_KERNEL(convertCaseSse42), BUMP_CPU_KERNEL(convertCaseAvx2), BUMP_CPU_KERNEL(convertCaseAvx512)))
+		{
+			;
+		}
+
+		ValidateUtf8Kernel validateUtf8;
+		CountCodePointsKernel countCodePoints;
+		ConvertCaseKernel convertCase;
+	};
+
+	// Returns the kernel table which is filled in the first time it is used
+	inline const StringKernels& stringKernels()
+	{
+		static const StringKernels kernels;
+		return kernels;
+	}
+
+	// Converts the case of the string with the ASCII kernels when the global locale is the
+	// classic one, otherwise falls back to the locale aware conversion
+	inline void convertCase(String& string, char first)
+	{
+		if (string.empty())
+		{
+			return;
+		}
+
+		if (std::locale() == std::locale::classic())
+		{
+			stringKernels().convertCase(&string[0], string.size(), first);
+		}
+		else if (first == 'A')
+		{
+			boost::algorithm::to_lower(string);
+		}
+		else
+		{
+			boost::algorithm::to_upper(string);
+		}
+	}
+
+	// Validates UTF-8 using the fastest kernel available
+	inline bool validateUtf8(const unsigned char* data, size_t length)
+	{
+		return stringKernels().validateUtf8(data, length);
+	}
+
+}	// End of local namespace
+
+//====================================================================================
+//                                UTF-8 Transcoding
+//====================================================================================
+
+namespace // local
+{
+	// Transcodes valid UTF-8 into UTF-16 or UTF-32 returning the number of units written. The
+	// output must have room for at least length units since no sequence produces more units
+	// than bytes.
+	template <typename CharType, bool IsUtf16>
+	size_t transcodeValidUtf8(const unsigned char* data, size_t length, CharType* output)
+	{
+		CharType* start = output;
+		size_t position = 0;
+		while (position < length)
+		{
+			// Widen runs of ASCII directly
+			if (position + 8 <= length && isAsciiWord(data + position))
+			{
+				for (size_t i = 0; i < 8; ++i)
+				{
+					*output++ = CharType(data[position + i]);
+				}
+				position += 8;
+				continue;
+			}
+
+			unsigned char lead = data[position];
+			boost::uint32_t code_point;
+			if (lead < 0x80)
+			{
+				code_point = lead;
+				position += 1;
+			}
+			else if (lead < 0xE0)
+			{
+				code_point = ((lead & 0x1F) << 6) | (data[position + 1] & 0x3F);
+				position += 2;
+			}
+			else if (lead < 0xF0)
+			{
+				code_point = ((lead & 0x0F) << 12) | ((data[position + 1] & 0x3F) << 6) | (data[position + 2] & 0x3F);
+				position += 3;
+			}
+			else
+			{
+				code_point = ((lead & 0x07) << 18) | ((data[position + 1] & 0x3F) << 12) |
+					((data[position + 2] & 0x3F) << 6) | (data[position + 3] & 0x3F);
+				position += 4;
+			}
+
+			if (IsUtf16 && code_point > 0xFFFF)
+			{
+				code_point -= 0x10000;
+				*output++ = CharType(0xD800 + (code_point >> 10));
+				*output++ = CharType(0xDC00 + (code_point & 0x3FF));
+			}
+			else
+			{
+				*output++ = CharType(code_point);
+			}
+		}
+
+		return output - start;
+	}
+
+	// Encodes a single valid code point as UTF-8 returning the position after the last byte
+	inline char* encodeUtf8(boost::uint32_t codePoint, char* output)
+	{
+		if (codePoint < 0x80)
+		{
+			*output++ = char(codePoint);
+		}
+		else if (codePoint < 0x800)
+		{
+			*output++ = char(0xC0 | (codePoint >> 6));
+			*output++ = char(0x80 | (codePoint & 0x3F));
+		}
+		else if (codePoint < 0x10000)
+		{
+			*output++ = char(0xE0 | (codePoint >> 12));
+			*output++ = char(0x80 | ((codePoint >> 6) & 0x3F));
+			*output++ = char(0x80 | (codePoint & 0x3F));
+		}
+		else
+		{
+			*output++ = char(0xF0 | (codePoint >> 18));
+			*output++ = char(0x80 | ((codePoint >> 12) & 0x3F));
+			*output++ = char(0x80 | ((codePoint >> 6) & 0x3F));
+			*output++ = char(0x80 | (codePoint & 0x3F));
+		}
+
+		return output;
+	}
+
+}	// End of local namespace
+
+//====================================================================================
+//                                      String
+//====================================================================================
+
+namespace // local
+{
+	// The accessors inline in String_impl.h that are still exported
+	struct InlineAccessors
+	{
+		const char& (String::*at)(int) const;
+		const char* (String::*cString)() const;
+		const char* (String::*data)() const;
+		bool (String::*isEmpty)() const;
+		int (String::*length)() const;
+	};
+
+	BUMP_KEEP_INLINE_SYMBOLS const InlineAccessors gInlineAccessors = { &String::at, &String::c_str, &String::data, &String::isEmpty, &String::length };
+
+}	// End of local namespace
+
 String::String() : std::string()
 {
 	;
@@ -166,6 +851,54 @@ String String::join(const StringList& strings, const String& separator)
 	return joined;
 }
 
+String String::fromUtf16(const std::u16string& utf16String)
+{
+	// Every UTF-16 code unit produces at most three UTF-8 bytes
+	std::string utf8_string(utf16String.size() * 3, '\0');
+	char* output = &utf8_string[0];
+	for (size_t i = 0; i < utf16String.size(); ++i)
+	{
+		boost::uint32_t code_point = utf16String[i];
+		if (code_point >= 0xD800 && code_point <= 0xDBFF)
+		{
+			// High surrogates must be followed by a low surrogate
+			if (i + 1 >= utf16String.size() || utf16String[i + 1] < 0xDC00 || utf16String[i + 1] > 0xDFFF)
+			{
+				throw TypeCastError("Cannot convert UTF-16 string with an unpaired surrogate to UTF-8", BUMP_LOCATION);
+			}
+			code_point = 0x10000 + ((code_point - 0xD800) << 10) + (utf16String[++i] - 0xDC00);
+		}
+		else if (code_point >= 0xDC00 && code_point <= 0xDFFF)
+		{
+			throw TypeCastError("Cannot convert UTF-16 string with an unpaired surrogate to UTF-8", BUMP_LOCATION);
+		}
+
+		output = encodeUtf8(code_point, output);
+	}
+
+	utf8_string.resize(output - utf8_string.data());
+	return utf8_string;
+}
+
+String String::fromUtf32(const std::u32string& utf32String)
+{
+	std::string utf8_string(utf32String.size() * 4, '\0');
+	char* output = &utf8_string[0];
+	for (size_t i = 0; i < utf32String.size(); ++i)
+	{
+		boost::uint32_t code_point = utf32String[i];
+		if (code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF))
+		{
+			throw TypeCastError("Cannot convert invalid UTF-32 code point to UTF-8", BUMP_LOCATION);
+		}
+
+		output = encodeUtf8(code_point, output);
+	}
+
+	utf8_string.resize(output - utf8_string.data());
+	return utf8_string;
+}
+
 String& String::append(const String& appendString)
 {
 	*this += appendString;
@@ -348,23 +1081,6 @@ String String::arg(const String& a1, const String& a2, const String& a3, const S
 	return replaced;
 }
 
-const char& String::at(int position) const
-{
-	try
-	{
-		return std::string::at(position);
-	}
-	catch (const std::out_of_range& /*e*/)
-	{
-		throw OutOfRangeError("Position is outside string bounds", BUMP_LOCATION);
-	}
-}
-
-const char* String::c_str() const
-{
-	return std::string::c_str();
-}
-
 String& String::capitalize()
 {
 	if (!isEmpty())
@@ -395,6 +1111,11 @@ void String::clear()
 	std::string::clear();
 }
 
+int String::codePointCount() const
+{
+	return int(stringKernels().countCodePoints(reinterpret_cast<const unsigned char*>(std::string::data()), std::string::size()));
+}
+
 bool String::compare(const String& otherString, CaseSensitivity caseSensitivity) const
 {
 	// Make some copies to handle case sensitivity
@@ -479,11 +1200,6 @@ int String::count(const char* containString, CaseSensitivity caseSensitivity) co
 	return this->count(String(containString), caseSensitivity);
 }
 
-const char* String::data() const
-{
-	return std::string::data();
-}
-
 bool String::endsWith(const String& endString, CaseSensitivity caseSensitivity) const
 {
 	if (caseSensitivity == NotCaseSensitive)
@@ -603,11 +1319,6 @@ String& String::insert(const char* insertString, int position)
 	return insert(String(insertString), position);
 }
 
-bool String::isEmpty() const
-{
-	return std::string::empty();
-}
-
 bool String::isNumber() const
 {
 	String this_copy = *this;
@@ -623,6 +1334,11 @@ bool String::isNumber() const
 	}
 }
 
+bool String::isValidUtf8() const
+{
+	return validateUtf8(reinterpret_cast<const unsigned char*>(std::string::data()), std::string::size());
+}
+
 int String::lastIndexOf(String indexString, int startPosition, CaseSensitivity caseSensitivity) const
 {
 	// Make sure the index string passed in is not empty
@@ -680,11 +1396,6 @@ String String::left(int n) const
 	return section(0, n);
 }
 
-int String::length() const
-{
-	return std::string::length();
-}
-
 String& String::padWithString(const String& padString, unsigned int paddedLength)
 {
 	// Simply return if padString is empty
@@ -923,6 +1634,11 @@ bool String::startsWith(const char* startString, CaseSensitivity caseSensitivity
 	return startsWith(String(startString), caseSensitivity);
 }
 
+void String::throwOutOfRangeError()
+{
+	throw OutOfRangeError("Position is outside string bounds", BUMP_LOCATION);
+}
+
 String String::title() const
 {
 	// Split the string by spaces, then capitalize each word
@@ -1016,7 +1732,7 @@ long long String::toLongLong() const
 
 String& String::toLowerCase()
 {
-	boost::algorithm::to_lower(*this);
+	convertCase(*this, 'A');
 	return *this;
 }
 
@@ -1075,7 +1791,7 @@ unsigned long long String::toULongLong() const
 
 String& String::toUpperCase()
 {
-	boost::algorithm::to_upper(*this);
+	convertCase(*this, 'a');
 	return *this;
 }
 
@@ -1091,6 +1807,40 @@ unsigned short String::toUShort() const
 	}
 }
 
+std::u16string String::toUtf16() const
+{
+	const unsigned char* utf8_data = reinterpret_cast<const unsigned char*>(std::string::data());
+	if (!validateUtf8(utf8_data, std::string::size()))
+	{
+		throw TypeCastError("Cannot convert invalid UTF-8 string to UTF-16", BUMP_LOCATION);
+	}
+
+	std::u16string utf16_string(std::string::size(), u'\0');
+	if (!utf16_string.empty())
+	{
+		utf16_string.resize(transcodeValidUtf8<char16_t, true>(utf8_data, std::string::size(), &utf16_string[0]));
+	}
+
+	return utf16_string;
+}
+
+std::u32string String::toUtf32() const
+{
+	const unsigned char* utf8_data = reinterpret_cast<const unsigned char*>(std::string::data());
+	if (!validateUtf8(utf8_data, std::string::size()))
+	{
+		throw TypeCastError("Cannot convert invalid UTF-8 string to UTF-32", BUMP_LOCATION);
+	}
+
+	std::u32string utf32_string(std::string::size(), U'\0');
+	if (!utf32_string.empty())
+	{
+		utf32_string.resize(transcodeValidUtf8<char32_t, false>(utf8_data, std::string::size(), &utf32_string[0]));
+	}
+
+	return utf32_string;
+}
+
 String String::trimmed() const
 {
 	return boost::algorithm::trim_copy_if(static_cast<std::string>(*this), boost::algorithm::is_any_of(" \t\n\v\f\r"));
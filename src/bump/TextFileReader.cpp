@@ -7,15 +7,91 @@
 //
 
 // Bump Headers
+#include <bump/Cpu.h>
 #include <bump/FileSystem.h>
 #include <bump/Log.h>
 #include <bump/TextFileReader.h>
 
 // C++ Headers
+#include <algorithm>
 #include <fstream>
+#include <vector>
+
+// SIMD intrinsics headers
+#ifdef BUMP_CPU_X86
+	#include <immintrin.h>
+#endif
 
 namespace bump {
 
+namespace // local
+{
+	// Counts the newline characters in the data
+	size_t countNewlinesScalar(const char* data, size_t length)
+	{
+		return std::count(data, data + length, '\n');
+	}
+
+#ifdef BUMP_CPU_X86
+
+	// Counts the newline characters 16 bytes at a time. Every comparison result is -1 for a
+	// newline, so subtracting accumulates the counts per byte lane which are then summed with
+	// a SAD against zero before they can overflow.
+	BUMP_TARGET_SSE42 size_t countNewlinesSse42(const char* data, size_t length)
+	{
+		const __m128i newline = _mm_set1_epi8('\n');
+		size_t count = 0;
+		size_t position = 0;
+		while (position + 16 <= length)
+		{
+			__m128i counts = _mm_setzero_si128();
+			for (int i = 0; i < 255 && position + 16 <= length; ++i, position += 16)
+			{
+				__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+				counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(block, newline));
+			}
+			__m128i sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+			count += _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+		}
+
+		return count + countNewlinesScalar(data + position, length - position);
+	}
+
+	// Counts the newline characters 32 bytes at a time the same way as the SSE4.2 kernel
+	BUMP_TARGET_AVX2 size_t countNewlinesAvx2(const char* data, size_t length)
+	{
+		const __m256i newline = _mm256_set1_epi8('\n');
+		size_t count = 0;
+		size_t position = 0;
+		while (position + 32 <= length)
+		{
+			__m256i counts = _mm256_setzero_si256();
+			for (int i = 0; i < 255 && position + 32 <= length; ++i, position += 32)
+			{
+				__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position));
+				counts = _mm256_sub_epi8(counts, _mm256_cmpeq_epi8(block, newline));
+			}
+			__m256i sums = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+			__m128i lane_sums = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+			count += _mm_cvtsi128_si32(lane_sums) + _mm_cvtsi128_si32(_mm_srli_si128(lane_sums, 8));
+		}
+
+		return count + countNewlinesScalar(data + position, length - position);
+	}
+
+#endif
+
+	// Counts the newline characters using the fastest kernel available
+	size_t countNewlines(const char* data, size_t length)
+	{
+		typedef size_t (*CountNewlinesKernel)(const char* data, size_t length);
+		static const CountNewlinesKernel kernel = Cpu::selectKernel<CountNewlinesKernel>(countNewlinesScalar,
+			BUMP_CPU_KERNEL(countNewlinesSse42), BUMP_CPU_KERNEL(countNewlinesAvx2), NULL);
+		return kernel(data, length);
+	}
+
+}	// End of local namespace
+
 namespace TextFileReader {
 
 StringList readFileLines(String fileName, int beginningLine, int numLines)
@@ -165,20 +241,20 @@ int numberOfLines(const String& fileName)
 
 	// Open File
 	std::ifstream input_file;
-	input_file.open(fileName.toStdString().data(), std::ios::in);
+	input_file.open(fileName.toStdString().data(), std::ios::in | std::ios::binary);
 	if (!input_file.is_open())
 	{
 		bumpERROR_P("FileReader: Error opening ", fileName);
 		return -1;
 	}
 
-	std::string line;
-	input_file.seekg(0, std::ios::beg);
-	unsigned int num_lines = 0;
-	while (!input_file.eof())
+	// Scan the file in large blocks counting the newlines. The last line is counted even when
+	// it is empty, the same as reading the file line by line until the end.
+	std::vector<char> buffer(64 * 1024);
+	unsigned int num_lines = 1;
+	while (input_file.read(&buffer[0], buffer.size()) || input_file.gcount() > 0)
 	{
-		std::getline(input_file, line);
-		num_lines++;
+		num_lines += (unsigned int)countNewlines(&buffer[0], (size_t)input_file.gcount());
 	}
 
 	input_file.close();
@@ -10,7 +10,6 @@
 #include <boost/thread/mutex.hpp>
 
 // Bump headers
-#include <bump/String.h>
 #include <bump/Timer.h>
 
 namespace bump {
@@ -58,26 +57,22 @@ void Timer::restart()
 
 double Timer::secondsElapsed() const
 {
-	String elapsed_time = boost::timer::format(_timer.elapsed(), boost::timer::default_places, "%w");
-	return elapsed_time.toDouble();
+	return _timer.elapsed().wall * 1e-9;
 }
 
 double Timer::millisecondsElapsed() const
 {
-	String elapsed_time = boost::timer::format(_timer.elapsed(), boost::timer::default_places, "%w");
-	return elapsed_time.toDouble() * 1e3;
+	return _timer.elapsed().wall * 1e-6;
 }
 
 double Timer::microsecondsElapsed() const
 {
-	String elapsed_time = boost::timer::format(_timer.elapsed(), boost::timer::default_places, "%w");
-	return elapsed_time.toDouble() * 1e6;
+	return _timer.elapsed().wall * 1e-3;
 }
 
 double Timer::nanosecondsElapsed() const
 {
-	String elapsed_time = boost::timer::format(_timer.elapsed(), boost::timer::default_places, "%w");
-	return elapsed_time.toDouble() * 1e9;
+	return (double)_timer.elapsed().wall;
 }
 
 }	// End of bump namespace
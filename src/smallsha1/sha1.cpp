@@ -35,6 +35,14 @@
 // Smallsha1 headers
 #include <smallsha1/sha1.h>
 
+// Bump headers
+#include <bump/Cpu.h>
+
+// SIMD intrinsics headers
+#ifdef BUMP_CPU_X86
+    #include <immintrin.h>
+#endif
+
 namespace sha1
 {
     namespace // local
@@ -114,6 +122,62 @@ namespace sha1
             result[3] += d;
             result[4] += e;
         }
+
+#ifdef BUMP_CPU_X86
+
+        // Hashes complete 64 byte blocks with the SHA extensions. The state is kept as ABCD in
+        // one register and E in the top lane of another, and every step runs four rounds
+        // while the message schedule for the upcoming steps is computed alongside.
+        BUMP_TARGET_SHA void innerHashShaNi(unsigned int* result, const unsigned char* sarray, int blocks)
+        {
+            const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+            __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) result), 0x1B);
+            __m128i e0 = _mm_set_epi32(result[4], 0, 0, 0);
+
+            for (int block = 0; block < blocks; ++block, sarray += 64)
+            {
+                const __m128i abcdSave = abcd;
+                const __m128i e0Save = e0;
+                __m128i previousAbcd = abcd;
+                __m128i e;
+
+                __m128i msg[4];
+                for (int i = 0; i < 4; ++i)
+                {
+                    msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (sarray + i * 16)), byteSwap);
+                }
+
+                // Rounds 4 * step to 4 * step + 3, where the message words of steps 4 and up
+                // are computed from the previous 16 words.
+                #define sha1step(step) \
+                { \
+                    if (step >= 4) \
+                    { \
+                        msg[step % 4] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(msg[step % 4], \
+                            msg[(step + 1) % 4]), msg[(step + 2) % 4]), msg[(step + 3) % 4]); \
+                    } \
+                    e = (step == 0) ? _mm_add_epi32(e0, msg[0]) : _mm_sha1nexte_epu32(previousAbcd, msg[step % 4]); \
+                    previousAbcd = abcd; \
+                    abcd = _mm_sha1rnds4_epu32(abcd, e, step / 5); \
+                }
+
+                sha1step(0)  sha1step(1)  sha1step(2)  sha1step(3)  sha1step(4)
+                sha1step(5)  sha1step(6)  sha1step(7)  sha1step(8)  sha1step(9)
+                sha1step(10) sha1step(11) sha1step(12) sha1step(13) sha1step(14)
+                sha1step(15) sha1step(16) sha1step(17) sha1step(18) sha1step(19)
+
+                #undef sha1step
+
+                e0 = _mm_sha1nexte_epu32(previousAbcd, e0Save);
+                abcd = _mm_add_epi32(abcd, abcdSave);
+            }
+
+            _mm_storeu_si128((__m128i*) result, _mm_shuffle_epi32(abcd, 0x1B));
+            result[4] = (unsigned int) _mm_extract_epi32(e0, 3);
+        }
+
+#endif
     } // namespace
 
     void calc(const void* src, const int bytelength, unsigned char* hash)
@@ -132,6 +196,15 @@ namespace sha1
         int endCurrentBlock;
         int currentBlock = 0;
 
+#ifdef BUMP_CPU_X86
+        // Hash all the complete blocks with the SHA extensions when the processor has them.
+        if (bytelength >= 64 && bump::Cpu::hasFeature(bump::Cpu::SHA_FEATURE))
+        {
+            innerHashShaNi(result, sarray, bytelength / 64);
+            currentBlock = (bytelength / 64) * 64;
+        }
+#endif
+
         while (currentBlock <= endOfFullBlocks)
         {
             endCurrentBlock = currentBlock + 64;
@@ -0,0 +1,115 @@
+//
+//	CpuTest.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Bump headers
+#include <bump/Cpu.h>
+
+// bumpTest headers
+#include "../bumpTest/BaseTest.h"
+
+namespace bumpTest {
+
+/**
+ * This is our main cpu testing class. The SetUp and TearDown methods are
+ * executed before the test runs and after it completes. This is where we can
+ * add any custom set up for each test without having to add this to "every"
+ * test individually.
+ */
+class CpuTest : public BaseTest
+{
+protected:
+
+	/** Run immediately before a test starts. Starts the timer. */
+	void SetUp()
+	{
+		// Call the parent setup method
+		BaseTest::SetUp();
+
+		// Custom set up logic
+	}
+
+	/** Invoked immediately after a test finishes. Stops the timer. */
+	void TearDown()
+	{
+		// Call the parent tear down method
+		BaseTest::TearDown();
+
+		// Custom tear down logic
+	}
+};
+
+// Kernels used to check which candidate gets selected
+int scalarKernel() { return bump::Cpu::SCALAR_KERNEL; }
+int sse42Kernel() { return bump::Cpu::SSE42_KERNEL; }
+int avx2Kernel() { return bump::Cpu::AVX2_KERNEL; }
+int avx512Kernel() { return bump::Cpu::AVX512_KERNEL; }
+typedef int (*Kernel)();
+
+TEST_F(CpuTest, testHasFeature)
+{
+	// Every feature must match the features bitmask
+	unsigned int features = bump::Cpu::features();
+	EXPECT_EQ((features & bump::Cpu::SSE42_FEATURE) != 0, bump::Cpu::hasFeature(bump::Cpu::SSE42_FEATURE));
+	EXPECT_EQ((features & bump::Cpu::AVX2_FEATURE) != 0, bump::Cpu::hasFeature(bump::Cpu::AVX2_FEATURE));
+	EXPECT_EQ((features & bump::Cpu::AVX512_FEATURE) != 0, bump::Cpu::hasFeature(bump::Cpu::AVX512_FEATURE));
+	EXPECT_EQ((features & bump::Cpu::SHA_FEATURE) != 0, bump::Cpu::hasFeature(bump::Cpu::SHA_FEATURE));
+	EXPECT_EQ((features & bump::Cpu::BMI2_FEATURE) != 0, bump::Cpu::hasFeature(bump::Cpu::BMI2_FEATURE));
+
+	// The vector features build on each other
+	if (bump::Cpu::hasFeature(bump::Cpu::AVX512_FEATURE))
+	{
+		EXPECT_TRUE(bump::Cpu::hasFeature(bump::Cpu::AVX2_FEATURE));
+	}
+	if (bump::Cpu::hasFeature(bump::Cpu::SHA_FEATURE))
+	{
+		EXPECT_TRUE(bump::Cpu::hasFeature(bump::Cpu::SSE42_FEATURE));
+	}
+}
+
+TEST_F(CpuTest, testKernelLevel)
+{
+	// The kernel level is the highest vector feature supported
+	bump::Cpu::KernelLevel level = bump::Cpu::kernelLevel();
+	EXPECT_EQ(level >= bump::Cpu::AVX512_KERNEL, bump::Cpu::hasFeature(bump::Cpu::AVX512_FEATURE));
+	EXPECT_EQ(level >= bump::Cpu::AVX2_KERNEL, bump::Cpu::hasFeature(bump::Cpu::AVX2_FEATURE));
+	EXPECT_EQ(level >= bump::Cpu::SSE42_KERNEL, bump::Cpu::hasFeature(bump::Cpu::SSE42_FEATURE));
+}
+
+TEST_F(CpuTest, testFeatureString)
+{
+	// The feature string lists every supported feature
+	bump::String feature_string = bump::Cpu::featureString();
+	EXPECT_EQ(bump::Cpu::hasFeature(bump::Cpu::SSE42_FEATURE), feature_string.contains("SSE4.2"));
+	EXPECT_EQ(bump::Cpu::hasFeature(bump::Cpu::AVX2_FEATURE), feature_string.contains("AVX2"));
+	EXPECT_EQ(bump::Cpu::hasFeature(bump::Cpu::AVX512_FEATURE), feature_string.contains("AVX-512"));
+	EXPECT_EQ(bump::Cpu::hasFeature(bump::Cpu::SHA_FEATURE), feature_string.contains("SHA"));
+	EXPECT_EQ(bump::Cpu::hasFeature(bump::Cpu::BMI2_FEATURE), feature_string.contains("BMI2"));
+	EXPECT_EQ(bump::Cpu::features() == 0, feature_string.isEmpty());
+}
+
+TEST_F(CpuTest, testSelectKernel)
+{
+	// All kernels available
+	int level = bump::Cpu::kernelLevel();
+	Kernel kernel = bump::Cpu::selectKernel<Kernel>(scalarKernel, sse42Kernel, avx2Kernel, avx512Kernel);
+	EXPECT_EQ(level, kernel());
+
+	// Missing AVX-512 kernel falls back to the next best one
+	kernel = bump::Cpu::selectKernel<Kernel>(scalarKernel, sse42Kernel, avx2Kernel, NULL);
+	EXPECT_EQ(std::min(level, int(bump::Cpu::AVX2_KERNEL)), kernel());
+
+	// Missing AVX2 kernel skips straight to SSE4.2
+	kernel = bump::Cpu::selectKernel<Kernel>(scalarKernel, sse42Kernel, NULL, NULL);
+	EXPECT_EQ(std::min(level, int(bump::Cpu::SSE42_KERNEL)), kernel());
+
+	// Only a scalar kernel
+	kernel = bump::Cpu::selectKernel<Kernel>(scalarKernel, NULL, NULL, NULL);
+	EXPECT_EQ(int(bump::Cpu::SCALAR_KERNEL), kernel());
+}
+
+}	// End of bumpTest namespace
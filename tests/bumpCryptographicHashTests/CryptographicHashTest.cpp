@@ -182,6 +182,27 @@ TEST_F(CryptographicHashTest, testResult)
 	hash.setData(reinterpret_cast<char*>(values_short), 10);
 	result = hash.result();
 	EXPECT_STREQ("bc1ed3c73cb98a7c3742a0f41e6e703f4472f679", result.c_str());
+
+	// Padding that spills into a second block case
+	hash = bump::CryptographicHash();
+	data = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+	hash.setData(data);
+	result = hash.result();
+	EXPECT_STREQ("84983e441c3bd26ebaae4aa1f95129e5e54670f1", result.c_str());
+
+	// Multiple complete blocks case
+	hash = bump::CryptographicHash();
+	data = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+	hash.setData(data);
+	result = hash.result();
+	EXPECT_STREQ("a49b2446a02c645bf419f995b67091253a04a259", result.c_str());
+
+	// Large data case
+	hash = bump::CryptographicHash();
+	data = bump::String(std::string(1000000, 'a'));
+	hash.setData(data);
+	result = hash.result();
+	EXPECT_STREQ("34aa973cd4c4daa4f61eeb2bdbad27316534016f", result.c_str());
 }
 
 }	// End of bumpTest namespace
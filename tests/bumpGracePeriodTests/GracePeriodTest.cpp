@@ -0,0 +1,128 @@
+//
+//	GracePeriodTest.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Boost headers
+#include <boost/thread.hpp>
+
+// Bump headers
+#include <bump/GracePeriod.h>
+
+// bumpTest headers
+#include "../bumpTest/BaseTest.h"
+
+namespace bumpTest {
+
+/**
+ * This is our main grace period testing class. The SetUp and TearDown methods are
+ * executed before the test runs and after it completes. This is where we can
+ * add any custom set up for each test without having to add this to "every"
+ * test individually.
+ */
+class GracePeriodTest : public BaseTest
+{
+protected:
+
+	/** Run immediately before a test starts. Starts the timer. */
+	void SetUp()
+	{
+		// Call the parent setup method
+		BaseTest::SetUp();
+
+		// Custom set up logic
+	}
+
+	/** Invoked immediately after a test finishes. Stops the timer. */
+	void TearDown()
+	{
+		// Call the parent tear down method
+		BaseTest::TearDown();
+
+		// Custom tear down logic
+	}
+};
+
+// Keeps reading the current value until stopped, counting any value read after it was retired
+struct ValueReader
+{
+	bump::GracePeriod* gracePeriod;
+	boost::atomic<int*>* value;
+	boost::atomic<bool>* isStopping;
+	boost::atomic<unsigned int>* retiredReadCount;
+
+	void operator()()
+	{
+		while (!*isStopping)
+		{
+			bump::GracePeriod::Reader reader(*gracePeriod);
+			int* current = value->load();
+			boost::this_thread::yield();
+			if (*current != 42)
+			{
+				++*retiredReadCount;
+			}
+		}
+	}
+};
+
+TEST_F(GracePeriodTest, testWithoutReaders)
+{
+	// Nobody holds up the grace period
+	bump::GracePeriod grace_period;
+	EXPECT_TRUE(grace_period.hasElapsed(grace_period.retire()));
+	grace_period.wait();
+}
+
+TEST_F(GracePeriodTest, testLaterReadersDoNotHoldUp)
+{
+	bump::GracePeriod grace_period;
+	unsigned int first_token = grace_period.enter();
+	unsigned long long stamp = grace_period.retire();
+	EXPECT_FALSE(grace_period.hasElapsed(stamp));
+
+	// Only the readers that entered before the grace period started are waited for
+	unsigned int second_token = grace_period.enter();
+	grace_period.leave(first_token);
+	EXPECT_TRUE(grace_period.hasElapsed(stamp));
+
+	// While the later reader holds up the next grace period
+	stamp = grace_period.retire();
+	EXPECT_FALSE(grace_period.hasElapsed(stamp));
+	grace_period.leave(second_token);
+	EXPECT_TRUE(grace_period.hasElapsed(stamp));
+}
+
+TEST_F(GracePeriodTest, testWaitWhileReading)
+{
+	// Four threads keep reading while the value is replaced over and over
+	bump::GracePeriod grace_period;
+	boost::atomic<int*> value(new int(42));
+	boost::atomic<bool> is_stopping(false);
+	boost::atomic<unsigned int> retired_read_count(0);
+	boost::thread_group threads;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		ValueReader reader = { &grace_period, &value, &is_stopping, &retired_read_count };
+		threads.create_thread(reader);
+	}
+
+	// The old value is only spoiled once nobody can still be reading it
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		int* old_value = value.exchange(new int(42));
+		grace_period.wait();
+		*old_value = 0;
+		delete old_value;
+	}
+
+	is_stopping = true;
+	threads.join_all();
+	delete value.load();
+	EXPECT_EQ(0u, retired_read_count.load());
+}
+
+}	// End of bumpTest namespace
@@ -0,0 +1,209 @@
+//
+//	LockFreeQueueTest.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <stdexcept>
+
+// Boost headers
+#include <boost/thread.hpp>
+
+// Bump headers
+#include <bump/LockFreeQueue.h>
+
+// bumpTest headers
+#include "../bumpTest/BaseTest.h"
+
+namespace bumpTest {
+
+/**
+ * This is our main lock-free queue testing class. The SetUp and TearDown methods are
+ * executed before the test runs and after it completes. This is where we can
+ * add any custom set up for each test without having to add this to "every"
+ * test individually.
+ */
+class LockFreeQueueTest : public BaseTest
+{
+protected:
+
+	/** Run immediately before a test starts. Starts the timer. */
+	void SetUp()
+	{
+		// Call the parent setup method
+		BaseTest::SetUp();
+
+		// Custom set up logic
+	}
+
+	/** Invoked immediately after a test finishes. Stops the timer. */
+	void TearDown()
+	{
+		// Call the parent tear down method
+		BaseTest::TearDown();
+
+		// Custom tear down logic
+	}
+};
+
+// Sets the queued value
+struct SetValue
+{
+	int value;
+	void operator()(int& queuedValue) const { queuedValue = value; }
+};
+
+// Fails partway through setting the queued value
+struct ThrowValue
+{
+	void operator()(int& queuedValue) const { queuedValue = -1; throw std::runtime_error("fill failed"); }
+};
+
+// Gets the queued value
+struct GetValue
+{
+	int& value;
+	void operator()(int& queuedValue) const { value = queuedValue; }
+};
+
+// Pushes the values from 1 to count onto the queue
+struct Producer
+{
+	bump::LockFreeQueue<int>* queue;
+	int count;
+
+	void operator()()
+	{
+		for (int i = 1; i <= count; ++i)
+		{
+			SetValue set_value = { i };
+			while (!queue->tryPush(set_value))
+			{
+				boost::this_thread::yield();
+			}
+		}
+	}
+};
+
+// Pops values off the queue and sums them until the expected number has been popped
+struct Consumer
+{
+	bump::LockFreeQueue<int>* queue;
+	boost::atomic<int>* remaining;
+	long long* sum;
+
+	void operator()()
+	{
+		int value = 0;
+		GetValue get_value = { value };
+		while (remaining->load() > 0)
+		{
+			if (queue->tryPop(get_value))
+			{
+				*sum += value;
+				--(*remaining);
+			}
+			else
+			{
+				boost::this_thread::yield();
+			}
+		}
+	}
+};
+
+TEST_F(LockFreeQueueTest, testCapacity)
+{
+	// The capacity is rounded up to a power of two
+	EXPECT_EQ(2u, bump::LockFreeQueue<int>(0).capacity());
+	EXPECT_EQ(2u, bump::LockFreeQueue<int>(2).capacity());
+	EXPECT_EQ(8u, bump::LockFreeQueue<int>(5).capacity());
+	EXPECT_EQ(1024u, bump::LockFreeQueue<int>(1024).capacity());
+}
+
+TEST_F(LockFreeQueueTest, testPushPop)
+{
+	bump::LockFreeQueue<int> queue(4);
+	EXPECT_TRUE(queue.isEmpty());
+	int value = 0;
+	GetValue get_value = { value };
+	EXPECT_FALSE(queue.tryPop(get_value));
+	EXPECT_FALSE(queue.tryDiscard());
+
+	// Fill the queue until it is full
+	for (int i = 0; i < 4; ++i)
+	{
+		SetValue set_value = { i };
+		EXPECT_TRUE(queue.tryPush(set_value));
+	}
+	SetValue overflow_value = { 4 };
+	EXPECT_FALSE(queue.tryPush(overflow_value));
+	EXPECT_EQ(4u, queue.size());
+
+	// Values come out in order, and wrap around the ring
+	EXPECT_TRUE(queue.tryDiscard());
+	EXPECT_TRUE(queue.tryPush(overflow_value));
+	for (int i = 1; i < 5; ++i)
+	{
+		EXPECT_TRUE(queue.tryPop(get_value));
+		EXPECT_EQ(i, value);
+	}
+	EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST_F(LockFreeQueueTest, testThrowingFill)
+{
+	bump::LockFreeQueue<int> queue(4);
+	int value = 0;
+	GetValue get_value = { value };
+
+	// A failed push is passed over instead of stalling the values behind it
+	SetValue first_value = { 1 };
+	SetValue second_value = { 2 };
+	EXPECT_TRUE(queue.tryPush(first_value));
+	EXPECT_THROW(queue.tryPush(ThrowValue()), std::runtime_error);
+	EXPECT_TRUE(queue.tryPush(second_value));
+	EXPECT_TRUE(queue.tryPop(get_value));
+	EXPECT_EQ(1, value);
+	EXPECT_TRUE(queue.tryPop(get_value));
+	EXPECT_EQ(2, value);
+	EXPECT_FALSE(queue.tryPop(get_value));
+
+	// The cell is reused on the next lap
+	for (int i = 0; i < 8; ++i)
+	{
+		SetValue set_value = { i };
+		EXPECT_TRUE(queue.tryPush(set_value));
+		EXPECT_TRUE(queue.tryPop(get_value));
+		EXPECT_EQ(i, value);
+	}
+	EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST_F(LockFreeQueueTest, testConcurrentProducersAndConsumers)
+{
+	// Four producers and two consumers share a small queue
+	bump::LockFreeQueue<int> queue(16);
+	boost::atomic<int> remaining(4 * 10000);
+	long long sums[2] = { 0, 0 };
+	boost::thread_group threads;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		Producer producer = { &queue, 10000 };
+		threads.create_thread(producer);
+	}
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		Consumer consumer = { &queue, &remaining, &sums[i] };
+		threads.create_thread(consumer);
+	}
+	threads.join_all();
+
+	// Every value arrived exactly once
+	EXPECT_EQ(4LL * 10000 * 10001 / 2, sums[0] + sums[1]);
+	EXPECT_TRUE(queue.isEmpty());
+}
+
+}	// End of bumpTest namespace
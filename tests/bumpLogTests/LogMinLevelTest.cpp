@@ -0,0 +1,94 @@
+//
+//	LogMinLevelTest.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// Only compile in ALWAYS_LVL, ERROR_LVL and WARNING_LVL for this file
+#undef BUMP_LOG_MIN_LEVEL
+#define BUMP_LOG_MIN_LEVEL 2
+
+// C++ headers
+#include <sstream>
+
+// Bump headers
+#include <bump/Log.h>
+
+// bumpTest headers
+#include "../bumpTest/BaseTest.h"
+
+namespace bumpTest {
+
+/**
+ * Tests the log macros compiled with the INFO_LVL and DEBUG_LVL ones stripped out.
+ */
+class LogMinLevelTest : public BaseTest
+{
+protected:
+
+	/** Run immediately before a test starts. Lets every level through at runtime. */
+	void SetUp()
+	{
+		// Call the parent setup method
+		BaseTest::SetUp();
+
+		_log = bump::Log::instance();
+		_log->setLogStream(_stream);
+		_log->setLogLevel(bump::Log::DEBUG_LVL);
+	}
+
+	/** Invoked immediately after a test finishes. Restores the default log settings. */
+	void TearDown()
+	{
+		// Call the parent tear down method
+		BaseTest::TearDown();
+
+		_log->setLogStream(std::cout);
+		_log->setLogLevel(bump::Log::WARNING_LVL);
+	}
+
+	// Instance member variables
+	bump::Log*				_log;
+	std::ostringstream		_stream;
+};
+
+// Counts how many times a stripped or compiled log argument was evaluated
+int gStrippedEvaluationCount = 0;
+bump::String evaluateMessage(const char* message)
+{
+	++gStrippedEvaluationCount;
+	return message;
+}
+
+TEST_F(LogMinLevelTest, testStrippedLevels)
+{
+	static_assert(BUMP_LOG_IS_COMPILED(bump::Log::WARNING_LVL), "WARNING_LVL should be compiled in");
+	static_assert(!BUMP_LOG_IS_COMPILED(bump::Log::INFO_LVL), "INFO_LVL should be stripped");
+
+	// The stripped levels neither evaluate their arguments nor write anything
+	gStrippedEvaluationCount = 0;
+	BUMP_LOG_DEBUG("debug %1", evaluateMessage("argument"));
+	BUMP_LOG_INFO_P("[test] ", "info %1", evaluateMessage("argument"));
+	BUMP_LOG_INFO_EVERY_N(1, "info %1", evaluateMessage("argument"));
+	BUMP_LOG_INFO_NO_REPEATS("info %1", evaluateMessage("argument"));
+	EXPECT_EQ(0, gStrippedEvaluationCount);
+	EXPECT_EQ("", _stream.str());
+
+	// The runtime level check is unaffected and the compiled in levels still log
+	EXPECT_TRUE(_log->isLogLevelEnabled(bump::Log::DEBUG_LVL));
+	bumpWARNING(evaluateMessage("warning"));
+	BUMP_LOG_ERROR("error %1", evaluateMessage("argument"));
+	EXPECT_EQ(2, gStrippedEvaluationCount);
+	EXPECT_EQ("warning\nerror argument\n", _stream.str());
+
+	// The log functions are never stripped, so they can still be called by their qualified names
+	_stream.str("");
+	::bumpDEBUG(evaluateMessage("debug"));
+	::bumpINFO_P("[test] ", evaluateMessage("info"));
+	EXPECT_EQ(4, gStrippedEvaluationCount);
+	EXPECT_EQ("debug\n[test] info\n", _stream.str());
+}
+
+}	// End of bumpTest namespace
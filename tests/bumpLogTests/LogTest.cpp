@@ -0,0 +1,1451 @@
+//
+//	LogTest.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+// Boost headers
+#include <boost/thread.hpp>
+
+// Bump headers
+#include <bump/BinaryLogReader.h>
+#include <bump/FileDescriptorLogSink.h>
+#include <bump/FileInfo.h>
+#include <bump/FileSystem.h>
+#include <bump/FileSystemError.h>
+#include <bump/Log.h>
+#include <bump/LogIndexWriter.h>
+#include <bump/LogReader.h>
+#include <bump/Logger.h>
+#include <bump/MappedFileLogSink.h>
+#include <bump/RingBufferLogSink.h>
+#include <bump/RotatingFileLogSink.h>
+#include <bump/SharedMemoryLogAggregator.h>
+#include <bump/SharedMemoryLogSink.h>
+
+// bumpTest headers
+#include "../bumpTest/BaseTest.h"
+
+namespace bumpTest {
+
+/**
+ * This is our main log testing class. The SetUp and TearDown methods are
+ * executed before the test runs and after it completes. This is where we can
+ * add any custom set up for each test without having to add this to "every"
+ * test individually.
+ */
+class LogTest : public BaseTest
+{
+protected:
+
+	/** Run immediately before a test starts. Starts the timer. */
+	void SetUp()
+	{
+		// Call the parent setup method
+		BaseTest::SetUp();
+
+		// Capture the log output with the default settings
+		_log = bump::Log::instance();
+		_log->setLogStream(_stream);
+		_log->setIsLogEnabled(true);
+		_log->setLogLevel(bump::Log::WARNING_LVL);
+		_log->setIsTimestampingEnabled(false);
+		_log->setTimestampFormat(bump::Log::DATE_TIME_WITH_AM_PM_TIMESTAMP);
+		_log->setTimestampPrecision(bump::Log::SECONDS_PRECISION);
+		_log->setIsUtcTimestampingEnabled(false);
+	}
+
+	/** Invoked immediately after a test finishes. Stops the timer. */
+	void TearDown()
+	{
+		// Call the parent tear down method
+		BaseTest::TearDown();
+
+		// Restore the default log settings
+		_log->disableAsynchronousLogging();
+		_log->disableBufferedLogging();
+		_log->disableFlightRecorder();
+		_log->setLogStream(std::cout);
+		_log->setIsLogEnabled(true);
+		_log->setLogLevel(bump::Log::WARNING_LVL);
+		_log->setIsTimestampingEnabled(false);
+		_log->setTimestampFormat(bump::Log::DATE_TIME_WITH_AM_PM_TIMESTAMP);
+		_log->setTimestampPrecision(bump::Log::SECONDS_PRECISION);
+		_log->setIsUtcTimestampingEnabled(false);
+	}
+
+	// Instance member variables
+	bump::Log*				_log;
+	std::ostringstream		_stream;
+};
+
+// Writes the given number of warning messages and filtered out debug messages
+struct LogWriter
+{
+	unsigned int count;
+
+	LogWriter(unsigned int messageCount) : count(messageCount) {}
+
+	void operator()()
+	{
+		bump::String message = "message";
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			bumpDEBUG(message);
+			bumpWARNING(message);
+		}
+	}
+};
+
+// A stream buffer that blocks writes while the gate is locked, used to stall the writer thread
+class GatedStringBuffer : public std::stringbuf
+{
+public:
+
+	GatedStringBuffer(boost::mutex& gate) : _gate(gate) {}
+
+protected:
+
+	std::streamsize xsputn(const char* characters, std::streamsize count)
+	{
+		boost::mutex::scoped_lock lock(_gate);
+		return std::stringbuf::xsputn(characters, count);
+	}
+
+	boost::mutex& _gate;
+};
+
+// Counts how many times a log argument was evaluated
+int gEvaluationCount = 0;
+int evaluate(int value)
+{
+	++gEvaluationCount;
+	return value;
+}
+
+// Formats the arguments with Log::formatMessage()
+template <typename... Arguments>
+bump::String formatMessage(const char* format, const Arguments&... arguments)
+{
+	const bump::LogArgument log_arguments[] = { bump::LogArgument(arguments)... };
+	bump::String buffer;
+	bump::Log::formatMessage(buffer, format, log_arguments, sizeof...(Arguments));
+	return buffer;
+}
+
+// Splits the log output into lines
+std::vector<std::string> splitLines(const std::string& output)
+{
+	std::vector<std::string> lines;
+	std::istringstream stream(output);
+	std::string line;
+	while (std::getline(stream, line))
+	{
+		lines.push_back(line);
+	}
+
+	return lines;
+}
+
+// Recurses until the stack overflows, the padding keeps it from becoming a loop
+unsigned long long overflowStack(unsigned long long depth)
+{
+	volatile char padding[1024];
+	padding[0] = static_cast<char>(depth);
+	return depth == ~0ull ? depth : overflowStack(depth + 1) + padding[0];
+}
+
+// A log ring that can stop between reserving a record and writing it like a stalled publisher,
+// and that can make its consumer give up waiting on a stalled record right away
+class StallingLogRing : public bump::SharedMemoryLogRing
+{
+public:
+
+	StallingLogRing(const bump::String& name) : bump::SharedMemoryLogRing(name), _position(0), _slot(NULL) {}
+	StallingLogRing(const bump::String& name, size_t capacity) : bump::SharedMemoryLogRing(name, capacity), _position(0), _slot(NULL) {}
+
+	bool reserve(const std::string& record)
+	{
+		return reserveRecord(record.size(), _position, _slot);
+	}
+
+	void write(const std::string& record)
+	{
+		bump::LogSink::Buffer buffer = { record.data(), record.size() };
+		writeRecord(_position, _slot, record.size(), &buffer, 1);
+	}
+
+	void expireStall()
+	{
+		_stallStart -= 60LL * 1000000;
+	}
+
+protected:
+
+	uint64_t		_position;
+	PublisherSlot*	_slot;
+};
+
+TEST_F(LogTest, testLogLevel)
+{
+	// Every level up to and including the log level is enabled
+	_log->setLogLevel(bump::Log::INFO_LVL);
+	EXPECT_EQ(bump::Log::INFO_LVL, _log->logLevel());
+	EXPECT_TRUE(_log->isLogLevelEnabled(bump::Log::ALWAYS_LVL));
+	EXPECT_TRUE(_log->isLogLevelEnabled(bump::Log::ERROR_LVL));
+	EXPECT_TRUE(_log->isLogLevelEnabled(bump::Log::WARNING_LVL));
+	EXPECT_TRUE(_log->isLogLevelEnabled(bump::Log::INFO_LVL));
+	EXPECT_FALSE(_log->isLogLevelEnabled(bump::Log::DEBUG_LVL));
+
+	// Only ALWAYS messages are enabled at the lowest level
+	_log->setLogLevel(bump::Log::ALWAYS_LVL);
+	EXPECT_EQ(bump::Log::ALWAYS_LVL, _log->logLevel());
+	EXPECT_TRUE(_log->isLogLevelEnabled(bump::Log::ALWAYS_LVL));
+	EXPECT_FALSE(_log->isLogLevelEnabled(bump::Log::ERROR_LVL));
+
+	// Everything is enabled at the highest level
+	_log->setLogLevel(bump::Log::DEBUG_LVL);
+	EXPECT_TRUE(_log->isLogLevelEnabled(bump::Log::DEBUG_LVL));
+}
+
+TEST_F(LogTest, testIsLogEnabled)
+{
+	// Disabling the log disables every level
+	_log->setLogLevel(bump::Log::DEBUG_LVL);
+	_log->setIsLogEnabled(false);
+	EXPECT_FALSE(_log->isLogEnabled());
+	EXPECT_FALSE(_log->isLogLevelEnabled(bump::Log::ALWAYS_LVL));
+	EXPECT_FALSE(_log->isLogLevelEnabled(bump::Log::DEBUG_LVL));
+
+	// Changing the level while disabled keeps the log disabled
+	_log->setLogLevel(bump::Log::INFO_LVL);
+	EXPECT_FALSE(_log->isLogLevelEnabled(bump::Log::ALWAYS_LVL));
+
+	// Enabling the log restores the log level
+	_log->setIsLogEnabled(true);
+	EXPECT_TRUE(_log->isLogEnabled());
+	EXPECT_TRUE(_log->isLogLevelEnabled(bump::Log::INFO_LVL));
+	EXPECT_FALSE(_log->isLogLevelEnabled(bump::Log::DEBUG_LVL));
+}
+
+TEST_F(LogTest, testFilteredMessages)
+{
+	// Filtered out messages are not written
+	bumpDEBUG("debug");
+	bumpINFO_P("[prefix] ", "info");
+	bumpDEBUG_F("debug");
+	EXPECT_EQ("", _stream.str());
+
+	// Enabled messages are written
+	bumpWARNING("warning");
+	bumpERROR_P("[prefix] ", "error");
+	bumpALWAYS_F("always");
+	EXPECT_EQ("warning\n[prefix] error\nalways", _stream.str());
+
+	// Nothing is written when the log is disabled
+	_stream.str("");
+	_log->setIsLogEnabled(false);
+	bumpALWAYS("always");
+	bumpNEWLINE();
+	EXPECT_EQ("", _stream.str());
+}
+
+TEST_F(LogTest, testConcurrentLogging)
+{
+	// Log from several threads at once
+	boost::thread_group threads;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		threads.create_thread(LogWriter(1000));
+	}
+	threads.join_all();
+
+	// Every warning message is written on its own line and every debug message is filtered out
+	std::istringstream lines(_stream.str());
+	std::string line;
+	unsigned int line_count = 0;
+	while (std::getline(lines, line))
+	{
+		EXPECT_EQ("message", line);
+		++line_count;
+	}
+	EXPECT_EQ(4000u, line_count);
+}
+
+TEST_F(LogTest, testFormatMessage)
+{
+	// Numbers and bools are written just like the bump::String constructors write them
+	short short_value = -12;
+	unsigned long long unsigned_value = 18446744073709551615ULL;
+	float float_value = 3.14159274f;
+	double double_value = 98.047384;
+	EXPECT_EQ(bump::String("%1 %2 %3").arg(short_value, 42u, unsigned_value), formatMessage("%1 %2 %3", short_value, 42u, unsigned_value));
+	EXPECT_EQ(bump::String("%1 %2").arg(float_value, double_value), formatMessage("%1 %2", float_value, double_value));
+	EXPECT_EQ(bump::String("%1").arg(1.0 / 3.0), formatMessage("%1", 1.0 / 3.0));
+	EXPECT_EQ(bump::String("%1 %2").arg(true, false), formatMessage("%1 %2", true, false));
+	EXPECT_EQ(bump::String("%1").arg('A'), formatMessage("%1", 'A'));
+
+	// Strings of every kind
+	std::string std_string = "std";
+	bump::String bump_string = "bump";
+	const char* null_string = NULL;
+	EXPECT_EQ("c std bump (null)", formatMessage("%1 %2 %3 %4", "c", std_string, bump_string, null_string));
+
+	// Markers can repeat, come in any order and go up to %99
+	EXPECT_EQ("b a b", formatMessage("%2 %1 %2", "a", "b"));
+	EXPECT_EQ("1 2 3 4 5 6 7 8 9 10 11", formatMessage("%1 %2 %3 %4 %5 %6 %7 %8 %9 %10 %11", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11));
+
+	// Markers without arguments and lone percent signs are left alone
+	EXPECT_EQ("100% of a %2 %0 %", formatMessage("100% of %1 %2 %0 %", "a"));
+	EXPECT_EQ("%1", formatMessage("%1"));
+	EXPECT_EQ("", formatMessage(""));
+}
+
+TEST_F(LogTest, testDeferredArgumentMacros)
+{
+	// Filtered out messages never evaluate their arguments
+	gEvaluationCount = 0;
+	BUMP_LOG_DEBUG("%1", evaluate(1));
+	BUMP_LOG_INFO_P("[prefix] ", "%1 %2", evaluate(1), evaluate(2));
+	EXPECT_EQ(0, gEvaluationCount);
+	EXPECT_EQ("", _stream.str());
+
+	// Enabled messages are formatted and written on their own line
+	BUMP_LOG_WARNING("%1 of %2", evaluate(3), 4);
+	BUMP_LOG_ERROR_P("[prefix] ", "value: %1", 2.5);
+	BUMP_LOG_ALWAYS("no arguments");
+	EXPECT_EQ(1, gEvaluationCount);
+	EXPECT_EQ("3 of 4\n[prefix] value: 2.5\nno arguments\n", _stream.str());
+
+	// They also go through the asynchronous writer thread
+	_stream.str("");
+	_log->setLogLevel(bump::Log::DEBUG_LVL);
+	_log->enableAsynchronousLogging(16);
+	BUMP_LOG_DEBUG("%1 %2", "async", 1);
+	BUMP_LOG_INFO_P("[prefix] ", "async %1", 2);
+	_log->flush();
+	EXPECT_EQ("async 1\n[prefix] async 2\n", _stream.str());
+}
+
+TEST_F(LogTest, testLimitedMacros)
+{
+	// The rate limiter lets a burst through, then refuses messages without evaluating them
+	gEvaluationCount = 0;
+	for (int i = 0; i < 11; ++i)
+	{
+		if (i == 10)
+		{
+			boost::this_thread::sleep(boost::posix_time::milliseconds(200));
+		}
+		BUMP_LOG_WARNING_RATE_LIMITED(20.0, 3, "limited %1", evaluate(i));
+	}
+	EXPECT_EQ(4, gEvaluationCount);
+	EXPECT_EQ("limited 0\nlimited 1\nlimited 2\n7 messages suppressed by the rate limit\nlimited 10\n", _stream.str());
+
+	// Sampling logs the first message and one in every n after it
+	_stream.str("");
+	gEvaluationCount = 0;
+	for (int i = 0; i < 10; ++i)
+	{
+		BUMP_LOG_MESSAGE_EVERY_N(bump::Log::ERROR_LVL, "[prefix] ", 3, "sampled %1", evaluate(i));
+	}
+	EXPECT_EQ(4, gEvaluationCount);
+	EXPECT_EQ("[prefix] sampled 0\n[prefix] sampled 3\n[prefix] sampled 6\n[prefix] sampled 9\n", _stream.str());
+
+	// Repeats are counted and reported before the next different message
+	_stream.str("");
+	const char* messages[] = { "a", "a", "a", "a", "a", "b", "b", "a" };
+	for (int i = 0; i < 8; ++i)
+	{
+		BUMP_LOG_WARNING_NO_REPEATS("repeated %1", messages[i]);
+	}
+	EXPECT_EQ("repeated a\nLast message repeated 4 times\nrepeated b\nLast message repeated 1 times\nrepeated a\n", _stream.str());
+
+	// Filtered out levels never reach the limiters
+	_stream.str("");
+	gEvaluationCount = 0;
+	BUMP_LOG_DEBUG_RATE_LIMITED(1.0, 1, "%1", evaluate(1));
+	BUMP_LOG_INFO_EVERY_N(1, "%1", evaluate(1));
+	BUMP_LOG_DEBUG_NO_REPEATS("%1", evaluate(1));
+	EXPECT_EQ(0, gEvaluationCount);
+	EXPECT_EQ("", _stream.str());
+
+	// A message that keeps repeating is reported once per interval
+	bump::LogRepeatSuppressor suppressor(0);
+	unsigned long long repeat_count = 0;
+	EXPECT_TRUE(suppressor.filter(1, repeat_count));
+	EXPECT_EQ(0u, repeat_count);
+	EXPECT_FALSE(suppressor.filter(1, repeat_count));
+	EXPECT_EQ(1u, repeat_count);
+	EXPECT_TRUE(suppressor.filter(2, repeat_count));
+	EXPECT_EQ(0u, repeat_count);
+}
+
+TEST_F(LogTest, testLoggers)
+{
+	// Levels are inherited down the dot separated hierarchy, but not by look-alike names
+	EXPECT_TRUE(_log->setLogLevels("WARNING_LVL, bump=INFO_LVL, bump.fs=DEBUG_LVL"));
+	bump::Logger& fs_logger = _log->logger("bump.fs");
+	bump::Logger& watch_logger = _log->logger("bump.fs.watch");
+	bump::Logger& notify_logger = _log->logger("bump.notify");
+	bump::Logger& bumpy_logger = _log->logger("bumpy");
+	EXPECT_EQ(&fs_logger, &_log->logger("bump.fs"));
+	EXPECT_EQ("[bump.fs] ", fs_logger.prefix());
+	EXPECT_EQ(bump::Log::DEBUG_LVL, fs_logger.logLevel());
+	EXPECT_EQ(bump::Log::DEBUG_LVL, watch_logger.logLevel());
+	EXPECT_EQ(bump::Log::INFO_LVL, notify_logger.logLevel());
+	EXPECT_EQ(bump::Log::WARNING_LVL, bumpy_logger.logLevel());
+
+	// Turning on DEBUG_LVL for one module leaves the log and the other modules alone
+	gEvaluationCount = 0;
+	EXPECT_FALSE(_log->isLogLevelEnabled(bump::Log::DEBUG_LVL));
+	BUMP_LOGGER_DEBUG(fs_logger, "Copying %1", evaluate(1));
+	BUMP_LOGGER_DEBUG(notify_logger, "Posting %1", evaluate(2));
+	BUMP_LOGGER_INFO(notify_logger, "Posted");
+	bumpy_logger.writeMessage(bump::Log::INFO_LVL, "filtered");
+	bumpy_logger.writeMessage(bump::Log::WARNING_LVL, "warning");
+	bumpDEBUG("filtered");
+	EXPECT_EQ(1, gEvaluationCount);
+	EXPECT_EQ("[bump.fs] Copying 1\n[bump.notify] Posted\n[bumpy] warning\n", _stream.str());
+
+	// Clearing a level goes back to the parent's, and the log level is at the top
+	fs_logger.clearLogLevel();
+	EXPECT_EQ(bump::Log::INFO_LVL, watch_logger.logLevel());
+	_log->clearLoggerLevel("bump");
+	_log->setLogLevel(bump::Log::ERROR_LVL);
+	EXPECT_EQ(bump::Log::ERROR_LVL, watch_logger.logLevel());
+	EXPECT_FALSE(watch_logger.isLogLevelEnabled(bump::Log::WARNING_LVL));
+	watch_logger.setLogLevel(bump::Log::INFO_LVL);
+	EXPECT_EQ(bump::Log::ERROR_LVL, fs_logger.logLevel());
+	EXPECT_TRUE(watch_logger.isLogLevelEnabled(bump::Log::INFO_LVL));
+	watch_logger.clearLogLevel();
+
+	// Sinks and disabling the log apply to the loggers as well
+	bump::RingBufferLogSink sink;
+	_log->addLogSink(sink);
+	EXPECT_TRUE(bumpy_logger.isLogLevelEnabled(bump::Log::DEBUG_LVL));
+	EXPECT_TRUE(_log->removeLogSink(sink));
+	EXPECT_FALSE(bumpy_logger.isLogLevelEnabled(bump::Log::WARNING_LVL));
+	_log->setIsLogEnabled(false);
+	EXPECT_FALSE(bumpy_logger.isLogLevelEnabled(bump::Log::ALWAYS_LVL));
+
+	// Entries that can't be understood are reported, the others are still set
+	EXPECT_FALSE(_log->setLogLevels("bump.fs=NOPE,LOUD,bump.notify=DEBUG_LVL"));
+	EXPECT_EQ(bump::Log::DEBUG_LVL, notify_logger.logLevel());
+	_log->clearLoggerLevel("bump.notify");
+}
+
+TEST_F(LogTest, testTimestampFormats)
+{
+	// 2013-01-14 22:51:33.123456 UTC
+	const long long time = 1358203893123456LL;
+	_log->setIsUtcTimestampingEnabled(true);
+
+	_log->setTimestampFormat(bump::Log::DATE_TIME_TIMESTAMP);
+	EXPECT_EQ("2013-01-14 22:51:33:", _log->formatTimestamp(time));
+	_log->setTimestampFormat(bump::Log::DATE_TIME_WITH_AM_PM_TIMESTAMP);
+	EXPECT_EQ("2013-01-14 10:51:33 PM:", _log->formatTimestamp(time));
+	_log->setTimestampFormat(bump::Log::TIME_TIMESTAMP);
+	EXPECT_EQ("10:51:33 PM:", _log->formatTimestamp(time));
+	_log->setTimestampFormat(bump::Log::TIME_WITHOUT_AM_PM_TIMESTAMP);
+	EXPECT_EQ("22:51:33:", _log->formatTimestamp(time));
+	_log->setTimestampFormat(bump::Log::ISO_8601_TIMESTAMP);
+	EXPECT_EQ("2013-01-14T22:51:33Z", _log->formatTimestamp(time));
+
+	// Fractions of a second
+	_log->setTimestampPrecision(bump::Log::MILLISECONDS_PRECISION);
+	EXPECT_EQ("2013-01-14T22:51:33.123Z", _log->formatTimestamp(time));
+	_log->setTimestampPrecision(bump::Log::MICROSECONDS_PRECISION);
+	EXPECT_EQ("2013-01-14T22:51:33.123456Z", _log->formatTimestamp(time));
+	_log->setTimestampFormat(bump::Log::TIME_TIMESTAMP);
+	EXPECT_EQ("10:51:33.123456 PM:", _log->formatTimestamp(time));
+
+	// The cached text is patched within a second and reformatted across seconds
+	EXPECT_EQ("10:51:33.999999 PM:", _log->formatTimestamp(time + 876543));
+	EXPECT_EQ("10:51:34.000000 PM:", _log->formatTimestamp(time + 876544));
+	EXPECT_EQ("10:51:33.000001 PM:", _log->formatTimestamp(time - 123455));
+
+	// Midnight and noon on the 12-hour clock
+	const long long midnight = 1358121600000000LL;
+	_log->setTimestampPrecision(bump::Log::SECONDS_PRECISION);
+	EXPECT_EQ("12:00:00 AM:", _log->formatTimestamp(midnight));
+	EXPECT_EQ("12:00:00 PM:", _log->formatTimestamp(midnight + 12 * 3600000000LL));
+	EXPECT_EQ("11:59:59 PM:", _log->formatTimestamp(midnight - 1));
+
+	// Local ISO 8601 timestamps end with the UTC offset instead
+	_log->setIsUtcTimestampingEnabled(false);
+	_log->setTimestampFormat(bump::Log::ISO_8601_TIMESTAMP);
+	bump::String local_time = _log->formatTimestamp(time);
+	ASSERT_EQ(25, local_time.length());
+	EXPECT_TRUE(local_time[19] == '+' || local_time[19] == '-');
+	EXPECT_EQ(':', local_time[22]);
+}
+
+TEST_F(LogTest, testTimestamping)
+{
+	_log->setIsUtcTimestampingEnabled(true);
+	_log->setTimestampFormat(bump::Log::ISO_8601_TIMESTAMP);
+	_log->setTimestampPrecision(bump::Log::MILLISECONDS_PRECISION);
+	_log->setIsTimestampingEnabled(true);
+
+	// Timestamps are written in front of the prefix on both the synchronous and asynchronous paths
+	bumpWARNING_P("[prefix] ", "synchronous");
+	_log->enableAsynchronousLogging(16);
+	bumpWARNING("asynchronous");
+	_log->flush();
+
+	std::vector<std::string> lines = splitLines(_stream.str());
+	ASSERT_EQ(2u, lines.size());
+	EXPECT_EQ(" [prefix] synchronous", lines[0].substr(24));
+	EXPECT_EQ(" asynchronous", lines[1].substr(24));
+	for (size_t i = 0; i < lines.size(); ++i)
+	{
+		EXPECT_EQ('T', lines[i][10]);
+		EXPECT_EQ('.', lines[i][19]);
+		EXPECT_EQ('Z', lines[i][23]);
+	}
+}
+
+TEST_F(LogTest, testAsynchronousLogging)
+{
+	// Messages are written by the writer thread in order
+	_log->enableAsynchronousLogging(16);
+	EXPECT_TRUE(_log->isAsynchronousLoggingEnabled());
+	bumpWARNING("first");
+	bumpERROR_P("[prefix] ", "second");
+	bumpDEBUG("filtered");
+	bumpALWAYS_F("third");
+	bumpNEWLINE();
+	_log->flush();
+	EXPECT_EQ("first\n[prefix] second\nthird\n", _stream.str());
+
+	// Blocking producers never lose messages even with a tiny queue
+	boost::thread_group threads;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		threads.create_thread(LogWriter(1000));
+	}
+	threads.join_all();
+	_log->flush();
+	EXPECT_EQ(4003u, splitLines(_stream.str()).size());
+	EXPECT_EQ(0u, _log->droppedMessageCount());
+
+	// Disabling goes back to writing on the logging thread
+	_log->disableAsynchronousLogging();
+	EXPECT_FALSE(_log->isAsynchronousLoggingEnabled());
+	_stream.str("");
+	bumpWARNING("synchronous");
+	EXPECT_EQ("synchronous\n", _stream.str());
+}
+
+TEST_F(LogTest, testDisableWritesQueuedMessages)
+{
+	// Stall the writer thread so the messages stay queued
+	boost::mutex gate;
+	GatedStringBuffer buffer(gate);
+	std::ostream stream(&buffer);
+	_log->setLogStream(stream);
+	_log->enableAsynchronousLogging(64);
+	{
+		boost::mutex::scoped_lock lock(gate);
+		for (unsigned int i = 0; i < 50; ++i)
+		{
+			bumpWARNING("queued");
+		}
+	}
+
+	// Disabling must write every queued message
+	_log->disableAsynchronousLogging();
+	EXPECT_EQ(50u, splitLines(buffer.str()).size());
+	_log->setLogStream(_stream);
+}
+
+TEST_F(LogTest, testDropNewestOverflow)
+{
+	boost::mutex gate;
+	GatedStringBuffer buffer(gate);
+	std::ostream stream(&buffer);
+	_log->setLogStream(stream);
+	_log->enableAsynchronousLogging(4, bump::Log::DROP_NEWEST_OVERFLOW);
+	unsigned long long dropped_count = _log->droppedMessageCount();
+
+	// Overflow the queue while the writer thread is stalled
+	{
+		boost::mutex::scoped_lock lock(gate);
+		for (int i = 0; i < 100; ++i)
+		{
+			bumpWARNING(bump::String(i));
+		}
+	}
+	_log->flush();
+
+	// The first messages are kept, the newest are dropped and every message is accounted for
+	std::vector<std::string> lines = splitLines(buffer.str());
+	dropped_count = _log->droppedMessageCount() - dropped_count;
+	EXPECT_LT(0u, dropped_count);
+	EXPECT_EQ(100u, lines.size() + dropped_count);
+	ASSERT_FALSE(lines.empty());
+	EXPECT_EQ("0", lines.front());
+	EXPECT_NE("99", lines.back());
+	_log->setLogStream(_stream);
+}
+
+TEST_F(LogTest, testDropOldestOverflow)
+{
+	boost::mutex gate;
+	GatedStringBuffer buffer(gate);
+	std::ostream stream(&buffer);
+	_log->setLogStream(stream);
+	_log->enableAsynchronousLogging(4, bump::Log::DROP_OLDEST_OVERFLOW);
+	unsigned long long dropped_count = _log->droppedMessageCount();
+
+	// Overflow the queue while the writer thread is stalled
+	{
+		boost::mutex::scoped_lock lock(gate);
+		for (int i = 0; i < 100; ++i)
+		{
+			bumpWARNING(bump::String(i));
+		}
+	}
+	_log->flush();
+
+	// The newest messages are kept, the oldest are dropped and every message is accounted for
+	std::vector<std::string> lines = splitLines(buffer.str());
+	dropped_count = _log->droppedMessageCount() - dropped_count;
+	EXPECT_LT(0u, dropped_count);
+	EXPECT_EQ(100u, lines.size() + dropped_count);
+	ASSERT_FALSE(lines.empty());
+	EXPECT_EQ("99", lines.back());
+	_log->setLogStream(_stream);
+}
+
+TEST_F(LogTest, testBufferedLogging)
+{
+	bump::Log::FlushPolicy policy;
+	policy.byteThreshold = 1 << 20;
+	policy.intervalMilliseconds = 0;
+	_log->enableBufferedLogging(policy);
+	EXPECT_TRUE(_log->isBufferedLoggingEnabled());
+
+	// Warnings stay in the thread buffer until something writes them
+	bumpWARNING("first");
+	bumpWARNING_P("[prefix] ", "second");
+	EXPECT_EQ("", _stream.str());
+	_log->flush();
+	EXPECT_EQ("first\n[prefix] second\n", _stream.str());
+
+	// Errors are written immediately along with everything buffered before them
+	_stream.str("");
+	bumpWARNING("third");
+	bumpERROR("error");
+	EXPECT_EQ("third\nerror\n", _stream.str());
+
+	// So is a buffer reaching the byte threshold
+	_stream.str("");
+	policy.byteThreshold = 16;
+	policy.immediateLevel = bump::Log::ALWAYS_LVL;
+	_log->enableBufferedLogging(policy);
+	bumpWARNING("short");
+	EXPECT_EQ("", _stream.str());
+	bumpWARNING("long enough");
+	EXPECT_EQ("short\nlong enough\n", _stream.str());
+
+	// Disabling writes whatever is left
+	_stream.str("");
+	bumpWARNING("left over");
+	_log->disableBufferedLogging();
+	EXPECT_FALSE(_log->isBufferedLoggingEnabled());
+	EXPECT_EQ("left over\n", _stream.str());
+}
+
+TEST_F(LogTest, testConcurrentBufferedLogging)
+{
+	bump::Log::FlushPolicy policy;
+	policy.byteThreshold = 1024;
+	policy.intervalMilliseconds = 1;
+	_log->enableBufferedLogging(policy);
+
+	// Every thread's messages make it out, including what exiting threads left behind
+	boost::thread_group threads;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		threads.create_thread(LogWriter(1000));
+	}
+	threads.join_all();
+	_log->flush();
+
+	std::vector<std::string> lines = splitLines(_stream.str());
+	EXPECT_EQ(4000u, lines.size());
+	for (size_t i = 0; i < lines.size(); ++i)
+	{
+		EXPECT_EQ("message", lines[i]);
+	}
+}
+
+TEST_F(LogTest, testFileDescriptorLogSink)
+{
+	bump::String filepath = bump::FileSystem::currentPath() + "/unittest_log.txt";
+	bump::FileSystem::removeFile(filepath);
+	{
+		bump::FileDescriptorLogSink sink(filepath);
+		_log->setLogSink(sink);
+
+		// A buffered burst of messages is a single write
+		bump::Log::FlushPolicy policy;
+		policy.byteThreshold = 1 << 20;
+		policy.intervalMilliseconds = 0;
+		_log->enableBufferedLogging(policy);
+		for (int i = 0; i < 10000; ++i)
+		{
+			bumpWARNING("buffered");
+		}
+		_log->flush();
+		EXPECT_EQ(1u, sink.writeCallCount());
+
+		// Direct writes to the log stream go through the sink as well
+		_log->disableBufferedLogging();
+		_log->logStream() << "direct" << std::endl;
+		EXPECT_EQ(2u, sink.writeCallCount());
+		_log->setLogStream(_stream);
+	}
+
+	std::ifstream file(filepath.c_str());
+	std::stringstream contents;
+	contents << file.rdbuf();
+	std::vector<std::string> lines = splitLines(contents.str());
+	ASSERT_EQ(10001u, lines.size());
+	EXPECT_EQ("buffered", lines.front());
+	EXPECT_EQ("direct", lines.back());
+	bump::FileSystem::removeFile(filepath);
+
+	// Files that can't be opened throw
+	EXPECT_THROW(bump::FileDescriptorLogSink("/nonexistent_directory/log.txt"), bump::FileSystemError);
+}
+
+TEST_F(LogTest, testLogReader)
+{
+	bump::String filepath = bump::FileSystem::currentPath() + "/unittest_indexed_log.txt";
+	bump::String index_filepath = bump::LogIndexWriter::indexFilepath(filepath);
+	bump::FileSystem::removeFile(filepath);
+	bump::FileSystem::removeFile(index_filepath);
+
+	// A line every 100 ms from 10:00:00 UTC, each followed by a continuation line without a timestamp
+	const long long start_time = 1792404000LL * 1000000;
+	{
+		bump::FileDescriptorLogSink sink(filepath, false, 256);
+		for (int i = 0; i < 1000; ++i)
+		{
+			int milliseconds = i * 100;
+			char line[128];
+			int length = std::snprintf(line, sizeof(line), "2026-10-19T10:%02d:%02d.%03dZ message %d\n  detail %d\n",
+				milliseconds / 60000, milliseconds / 1000 % 60, milliseconds % 1000, i, i);
+			bump::LogSink::Buffer buffer = { line, static_cast<size_t>(length) };
+			sink.write(&buffer, 1);
+		}
+		EXPECT_LT(100u, sink.indexWriter()->entryCount());
+	}
+
+	// The range starts at the first line logged at its start and ends with the continuation of the last one
+	bump::LogReader reader(filepath);
+	EXPECT_TRUE(reader.hasIndex());
+	reader.seekTimeRange(start_time + 10000000, start_time + 12000000);
+	std::vector<std::string> lines;
+	bump::String line;
+	while (reader.readLine(line))
+	{
+		lines.push_back(line);
+	}
+	ASSERT_EQ(42u, lines.size());
+	EXPECT_EQ("2026-10-19T10:00:10.000Z message 100", lines.front());
+	EXPECT_EQ("  detail 120", lines.back());
+
+	// Ranges outside of the log are empty and the reader can seek again
+	reader.seekTimeRange(start_time - 2000000, start_time - 1000000);
+	EXPECT_FALSE(reader.readLine(line));
+	reader.seekTimeRange(start_time + 99900000, start_time + 200000000);
+	ASSERT_TRUE(reader.readLine(line));
+	EXPECT_EQ("2026-10-19T10:01:39.900Z message 999", line);
+
+	// Rebuilding in a single pass gives the index written while logging
+	std::ifstream index_file(index_filepath.c_str(), std::ios::binary);
+	std::stringstream index_contents;
+	index_contents << index_file.rdbuf();
+	index_file.close();
+	bump::FileSystem::removeFile(index_filepath);
+	EXPECT_FALSE(bump::LogReader(filepath).hasIndex());
+	EXPECT_LT(100u, bump::LogIndexWriter::rebuild(filepath, 256));
+	std::ifstream rebuilt_index_file(index_filepath.c_str(), std::ios::binary);
+	std::stringstream rebuilt_index_contents;
+	rebuilt_index_contents << rebuilt_index_file.rdbuf();
+	EXPECT_EQ(index_contents.str(), rebuilt_index_contents.str());
+
+	// The timestamp formats with a date are understood, whatever the precision
+	long long time = 0;
+	EXPECT_TRUE(bump::LogReader::parseTimestamp("2013-01-14T22:51:33+01:00 message", 33, time));
+	EXPECT_EQ(1358200293LL * 1000000, time);
+	EXPECT_TRUE(bump::LogReader::parseTimestamp("{\"time\":1358200293000001,\"level\":\"INFO\"}", 40, time));
+	EXPECT_EQ(1358200293000001LL, time);
+	long long twelve_hour_time = 0;
+	EXPECT_TRUE(bump::LogReader::parseTimestamp("2013-01-14 10:51:33.123 PM: message", 35, twelve_hour_time));
+	EXPECT_TRUE(bump::LogReader::parseTimestamp("2013-01-14 22:51:33.123456: message", 35, time));
+	EXPECT_EQ(twelve_hour_time + 456, time);
+	EXPECT_FALSE(bump::LogReader::parseTimestamp("10:51:33 PM: message", 20, time));
+	EXPECT_FALSE(bump::LogReader::parseTimestamp("2013-13-14 22:51:33: message", 28, time));
+
+	bump::FileSystem::removeFile(filepath);
+	bump::FileSystem::removeFile(index_filepath);
+	EXPECT_THROW(bump::LogReader("/nonexistent_directory/log.txt"), bump::FileSystemError);
+}
+
+TEST_F(LogTest, testRotatingFileLogSink)
+{
+	bump::String directory = bump::FileSystem::currentPath() + "/unittest_rotating_logs";
+	bump::String filepath = directory + "/unittest_log.txt";
+	bump::FileSystem::removeDirectoryAndContents(directory);
+	bump::FileSystem::createDirectory(directory);
+
+	// Size rotation keeps every message, in order, with no file over the limit
+	bump::RotatingFileLogSink::RotationPolicy policy;
+	policy.maxFileSize = 1000;
+	policy.retentionCount = 0;
+	policy.preallocationSize = 4096;
+	policy.isCompressionEnabled = false;
+	unsigned int rotation_count = 0;
+	{
+		bump::RotatingFileLogSink sink(filepath, policy);
+		_log->setLogSink(sink);
+		for (int i = 0; i < 100; ++i)
+		{
+			bumpWARNING(bump::String("Rotating message number %1 with some padding").arg(i));
+		}
+		_log->setLogStream(_stream);
+		sink.waitForBackgroundWork();
+		rotation_count = sink.rotationCount();
+	}
+	EXPECT_LE(4u, rotation_count);
+
+	std::stringstream contents;
+	for (unsigned int i = 1; i <= rotation_count + 1; ++i)
+	{
+		bump::String path = i <= rotation_count ? bump::String("%1.%2").arg(filepath, i) : filepath;
+		ASSERT_TRUE(bump::FileSystem::isFile(path));
+		std::ifstream file(path.c_str());
+		contents << file.rdbuf();
+		if (i <= rotation_count)
+		{
+			EXPECT_GE(1000u, bump::FileInfo(path).fileSize());
+		}
+	}
+	std::vector<std::string> lines = splitLines(contents.str());
+	ASSERT_EQ(100u, lines.size());
+	EXPECT_EQ("Rotating message number 0 with some padding", lines.front());
+	EXPECT_EQ("Rotating message number 99 with some padding", lines.back());
+
+	// The next file is prepared ahead of time without any contents
+	EXPECT_TRUE(bump::FileSystem::isFile(filepath + ".next"));
+	EXPECT_EQ(0u, bump::FileInfo(filepath + ".next").fileSize());
+
+	// A new sink continues the indices and prunes the oldest files past the retention count
+	policy.retentionCount = 2;
+	policy.isCompressionEnabled = true;
+	{
+		bump::RotatingFileLogSink sink(filepath, policy);
+		sink.rotate();
+		sink.waitForBackgroundWork();
+		EXPECT_EQ(1u, sink.rotationCount());
+	}
+	bump::String newest = bump::String("%1.%2").arg(filepath, rotation_count + 1);
+	bump::String compressed_suffix = bump::RotatingFileLogSink::isCompressionSupported() ? ".gz" : "";
+	EXPECT_TRUE(bump::FileSystem::isFile(newest + compressed_suffix));
+	EXPECT_TRUE(bump::FileSystem::isFile(bump::String("%1.%2").arg(filepath, rotation_count) + compressed_suffix));
+	EXPECT_FALSE(bump::FileSystem::exists(bump::String("%1.%2").arg(filepath, rotation_count - 1)));
+	EXPECT_FALSE(bump::FileSystem::exists(bump::String("%1.1").arg(filepath)));
+	if (bump::RotatingFileLogSink::isCompressionSupported())
+	{
+		EXPECT_FALSE(bump::FileSystem::exists(newest));
+	}
+
+	// Interval rotation starts a new file for each interval
+	bump::FileSystem::removeDirectoryAndContents(directory);
+	bump::FileSystem::createDirectory(directory);
+	policy = bump::RotatingFileLogSink::RotationPolicy();
+	policy.maxFileSize = 0;
+	policy.intervalSeconds = 1;
+	{
+		bump::RotatingFileLogSink sink(filepath, policy);
+		_log->setLogSink(sink);
+		bumpWARNING("first interval");
+		boost::this_thread::sleep(boost::posix_time::milliseconds(1100));
+		bumpWARNING("second interval");
+		_log->setLogStream(_stream);
+		EXPECT_EQ(1u, sink.rotationCount());
+	}
+
+	bump::FileSystem::removeDirectoryAndContents(directory);
+}
+
+TEST_F(LogTest, testSetLogFile)
+{
+	bump::String filepath1 = bump::FileSystem::currentPath() + "/unittest_log1.txt";
+	bump::String filepath2 = bump::FileSystem::currentPath() + "/unittest_log2.txt";
+
+	// Switching away from a log file closes it with everything written out
+	EXPECT_TRUE(_log->setLogFile(filepath1));
+	bumpWARNING("first file");
+	EXPECT_TRUE(_log->setLogFile(filepath2));
+	bumpWARNING("second file");
+	_log->setLogStream(_stream);
+
+	std::ifstream file1(filepath1.c_str());
+	std::stringstream contents1;
+	contents1 << file1.rdbuf();
+	EXPECT_EQ("first file\n", contents1.str());
+	std::ifstream file2(filepath2.c_str());
+	std::stringstream contents2;
+	contents2 << file2.rdbuf();
+	EXPECT_EQ("second file\n", contents2.str());
+
+	// Files that can't be opened leave the log stream alone
+	EXPECT_FALSE(_log->setLogFile("/nonexistent_directory/log.txt"));
+	bumpWARNING("still here");
+	EXPECT_EQ("still here\n", _stream.str());
+
+	bump::FileSystem::removeFile(filepath1);
+	bump::FileSystem::removeFile(filepath2);
+}
+
+TEST_F(LogTest, testLogSinks)
+{
+	// Everything, network messages at INFO_LVL and errors on a worker thread
+	bump::RingBufferLogSink everything_sink;
+	bump::RingBufferLogSink network_sink;
+	bump::RingBufferLogSink error_sink;
+	bump::Log::SinkOptions network_options;
+	network_options.logLevel = bump::Log::INFO_LVL;
+	network_options.prefixFilter = "[net] ";
+	bump::Log::SinkOptions error_options;
+	error_options.logLevel = bump::Log::ERROR_LVL;
+	error_options.isThreaded = true;
+	_log->addLogSink(everything_sink);
+	_log->addLogSink(network_sink, network_options);
+	_log->addLogSink(error_sink, error_options);
+	EXPECT_TRUE(_log->isLogLevelEnabled(bump::Log::DEBUG_LVL));
+	EXPECT_EQ(bump::Log::WARNING_LVL, _log->logLevel());
+
+	bumpDEBUG("debug");
+	bumpINFO_P("[net] ", "info");
+	bumpWARNING("warning");
+	bumpERROR_P("[net] ", "error");
+	BUMP_LOG_DEBUG_P("[net] ", "formatted %1", 7);
+	BUMP_LOG_INFO_P("[net] ", "formatted %1", 8);
+	_log->flush();
+
+	// The log stream keeps its own level while each sink gets what it asked for
+	EXPECT_EQ("warning\n[net] error\n", _stream.str());
+	EXPECT_EQ("debug\n[net] info\nwarning\n[net] error\n[net] formatted 7\n[net] formatted 8\n", everything_sink.contents());
+	EXPECT_EQ("[net] info\n[net] error\n[net] formatted 8\n", network_sink.contents());
+	EXPECT_EQ("[net] error\n", error_sink.contents());
+
+	// Adding a sink again replaces its options
+	error_options.logLevel = bump::Log::WARNING_LVL;
+	_log->addLogSink(error_sink, error_options);
+	bumpWARNING("second warning");
+	_log->flush();
+	EXPECT_EQ("[net] error\nsecond warning\n", error_sink.contents());
+
+	// Removed sinks stop receiving messages and the levels go back to the log stream's
+	EXPECT_TRUE(_log->removeLogSink(everything_sink));
+	EXPECT_TRUE(_log->removeLogSink(network_sink));
+	EXPECT_TRUE(_log->removeLogSink(error_sink));
+	EXPECT_FALSE(_log->removeLogSink(error_sink));
+	EXPECT_FALSE(_log->isLogLevelEnabled(bump::Log::INFO_LVL));
+	bumpERROR("after removal");
+	EXPECT_EQ("[net] error\nsecond warning\n", error_sink.contents());
+}
+
+TEST_F(LogTest, testStructuredFields)
+{
+	// One JSON sink written on the logging thread and one on a worker thread next to a text sink
+	bump::RingBufferLogSink json_sink;
+	bump::RingBufferLogSink threaded_json_sink;
+	bump::RingBufferLogSink text_sink;
+	bump::Log::SinkOptions json_options;
+	json_options.format = bump::Log::JSON_SINK_FORMAT;
+	_log->addLogSink(json_sink, json_options);
+	json_options.isThreaded = true;
+	_log->addLogSink(threaded_json_sink, json_options);
+	_log->addLogSink(text_sink);
+
+	bump::String path = "/index \"home\"";
+	BUMP_LOG_WARNING_FIELDS("Slow request", BUMP_LOG_FIELD("path", path), BUMP_LOG_FIELD("status", 200),
+		BUMP_LOG_FIELD("seconds", 1.5), BUMP_LOG_FIELD("cached", false));
+	BUMP_LOG_DEBUG_FIELDS_P("[net] ", "Line\tbreak\n", BUMP_LOG_FIELD("offset", -3LL));
+	bumpINFO("plain");
+	_log->flush();
+
+	// The time is the only part changing between runs
+	std::vector<std::string> lines = splitLines(json_sink.contents());
+	ASSERT_EQ(3u, lines.size());
+	for (size_t i = 0; i < lines.size(); ++i)
+	{
+		ASSERT_EQ(0u, lines[i].find("{\"time\":"));
+		lines[i].erase(1, lines[i].find(','));
+	}
+	EXPECT_EQ("{\"level\":\"WARNING\",\"message\":\"Slow request\",\"path\":\"/index \\\"home\\\"\",\"status\":200,"
+		"\"seconds\":1.5,\"cached\":false}", lines[0]);
+	EXPECT_EQ("{\"level\":\"DEBUG\",\"prefix\":\"[net] \",\"message\":\"Line\\tbreak\\n\",\"offset\":-3}", lines[1]);
+	EXPECT_EQ("{\"level\":\"INFO\",\"message\":\"plain\"}", lines[2]);
+	EXPECT_EQ(json_sink.contents(), threaded_json_sink.contents());
+
+	// The log stream and text sinks get the fields as name=value
+	EXPECT_EQ("Slow request path=\"/index \\\"home\\\"\" status=200 seconds=1.5 cached=false\n", _stream.str());
+	EXPECT_EQ("Slow request path=\"/index \\\"home\\\"\" status=200 seconds=1.5 cached=false\n"
+		"[net] Line\tbreak\n offset=-3\nplain\n", text_sink.contents());
+
+	// Fields of filtered messages are never evaluated
+	EXPECT_TRUE(_log->removeLogSink(json_sink));
+	EXPECT_TRUE(_log->removeLogSink(threaded_json_sink));
+	EXPECT_TRUE(_log->removeLogSink(text_sink));
+	int evaluation_count = 0;
+	BUMP_LOG_DEBUG_FIELDS("filtered", BUMP_LOG_FIELD("count", ++evaluation_count));
+	EXPECT_EQ(0, evaluation_count);
+}
+
+TEST_F(LogTest, testConcurrentThreadedLogSink)
+{
+	// Every message from every thread reaches the worker thread exactly once
+	bump::RingBufferLogSink sink(1 << 20);
+	bump::Log::SinkOptions options;
+	options.logLevel = bump::Log::WARNING_LVL;
+	options.isThreaded = true;
+	options.queueCapacity = 64;
+	_log->addLogSink(sink, options);
+	_log->setLogStream(_stream);
+
+	boost::thread_group threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.create_thread(LogWriter(1000));
+	}
+	threads.join_all();
+	_log->flush();
+	EXPECT_TRUE(_log->removeLogSink(sink));
+
+	std::vector<std::string> lines = splitLines(sink.contents());
+	EXPECT_EQ(4000u, lines.size());
+	EXPECT_EQ(std::count(lines.begin(), lines.end(), "message"), static_cast<long>(lines.size()));
+	EXPECT_EQ(4000u, splitLines(_stream.str()).size());
+}
+
+TEST_F(LogTest, testRingBufferLogSink)
+{
+	bump::RingBufferLogSink sink(16);
+	bump::LogSink::Buffer buffers[] = { { "first\n", 6 }, { "second\n", 7 } };
+	sink.write(buffers, 2);
+	EXPECT_EQ("first\nsecond\n", sink.contents());
+
+	// Once wrapped, the oldest output and the line it cut into are gone
+	bump::LogSink::Buffer third = { "third\n", 6 };
+	sink.write(&third, 1);
+	EXPECT_EQ("second\nthird\n", sink.contents());
+	EXPECT_EQ(19u, sink.totalByteCount());
+
+	// Buffers larger than the ring keep their tail
+	bump::LogSink::Buffer large = { "0123456789abcdef\nlast\n", 22 };
+	sink.write(&large, 1);
+	EXPECT_EQ("last\n", sink.contents());
+
+	sink.clear();
+	EXPECT_EQ("", sink.contents());
+	sink.stream() << "streamed" << std::endl;
+	EXPECT_EQ("streamed\n", sink.contents());
+}
+
+TEST_F(LogTest, testStatistics)
+{
+	// A sink taking only network messages lets DEBUG_LVL through without taking all of it
+	bump::RingBufferLogSink sink;
+	bump::Log::SinkOptions options;
+	options.prefixFilter = "[net] ";
+	_log->addLogSink(sink, options);
+
+	// The log has been counting since it was created, so only the differences are checked
+	bump::Log::Statistics before = _log->statistics();
+	bumpDEBUG("filtered");
+	bumpDEBUG_P("[net] ", "debug");
+	bumpWARNING("warning");
+	BUMP_LOG_ERROR("error %1", 1);
+
+	// The counts of threads that have exited are still there
+	boost::thread_group threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.create_thread(LogWriter(100));
+	}
+	threads.join_all();
+	_log->flush();
+
+	bump::Log::Statistics after = _log->statistics();
+	EXPECT_EQ(402u, after.recordCounts[bump::Log::DEBUG_LVL] - before.recordCounts[bump::Log::DEBUG_LVL]);
+	EXPECT_EQ(401u, after.recordCounts[bump::Log::WARNING_LVL] - before.recordCounts[bump::Log::WARNING_LVL]);
+	EXPECT_EQ(1u, after.recordCounts[bump::Log::ERROR_LVL] - before.recordCounts[bump::Log::ERROR_LVL]);
+	EXPECT_EQ(401u, after.filteredRecordCount - before.filteredRecordCount);
+	EXPECT_EQ(before.droppedRecordCount, after.droppedRecordCount);
+	EXPECT_EQ(_stream.str().size(), after.writtenByteCount - before.writtenByteCount);
+	EXPECT_EQ(402u, after.streamWriteLatency.count - before.streamWriteLatency.count);
+	EXPECT_GE(after.blockedNanoseconds, before.blockedNanoseconds);
+	EXPECT_EQ(0u, after.queuedRecordCount);
+
+	// Only the network message reached the sink
+	ASSERT_EQ(1u, after.sinks.size());
+	EXPECT_EQ(&sink, after.sinks[0].sink);
+	EXPECT_EQ(sink.contents().size(), after.sinks[0].writtenByteCount);
+	EXPECT_EQ(1u, after.sinks[0].writeLatency.count);
+	EXPECT_EQ(0u, after.sinks[0].queuedRecordCount);
+	EXPECT_TRUE(_log->removeLogSink(sink));
+	EXPECT_TRUE(_log->statistics().sinks.empty());
+
+	// Percentiles are rounded up to the bucket limit but never past the slowest write
+	bump::Log::LatencyHistogram histogram;
+	EXPECT_EQ(0.0, histogram.percentileMicroseconds(0.5));
+	histogram.bucketCounts[0] = 90;
+	histogram.bucketCounts[4] = 10;
+	histogram.count = 100;
+	histogram.maxNanoseconds = 12000;
+	EXPECT_EQ(1.0, histogram.percentileMicroseconds(0.5));
+	EXPECT_EQ(1.0, histogram.percentileMicroseconds(0.9));
+	EXPECT_EQ(12.0, histogram.percentileMicroseconds(0.99));
+}
+
+TEST_F(LogTest, testFlightRecorder)
+{
+	bump::String filepath = bump::FileSystem::currentPath() + "/unittest_flight_recorder.txt";
+	bump::FileSystem::removeFile(filepath);
+
+	// Messages below the log level are recorded without reaching the log stream
+	_log->enableFlightRecorder(filepath, 3, bump::Log::DEBUG_LVL, false);
+	EXPECT_TRUE(_log->isFlightRecorderEnabled());
+	EXPECT_TRUE(_log->isLogLevelEnabled(bump::Log::DEBUG_LVL));
+	for (int i = 0; i < 5; ++i)
+	{
+		BUMP_LOG_DEBUG_P("[prefix] ", "Debug %1 of %2 at %3: %4", i, -5, 2.5, "text");
+	}
+	bumpINFO("info message");
+	EXPECT_EQ("", _stream.str());
+
+	// Each thread keeps its own records
+	boost::thread thread([]() { BUMP_LOG_WARNING("warning %1", true); });
+	thread.join();
+	EXPECT_EQ("warning true\n", _stream.str());
+
+	// The dump holds the newest records of each thread after a timestamp and the level
+	EXPECT_TRUE(_log->dumpFlightRecorder());
+	std::ifstream file(filepath.c_str());
+	std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	std::vector<std::string> lines = splitLines(contents);
+	ASSERT_EQ(7u, lines.size());
+	EXPECT_EQ("Flight recorder dump, times in UTC", lines[0]);
+
+	std::vector<std::string> records;
+	for (size_t i = 1; i < lines.size(); ++i)
+	{
+		if (lines[i].compare(0, 7, "Thread ") != 0)
+		{
+			ASSERT_LT(27u, lines[i].size());
+			EXPECT_EQ('.', lines[i][19]);
+			records.push_back(lines[i].substr(27));
+		}
+	}
+	std::sort(records.begin(), records.end());
+	ASSERT_EQ(4u, records.size());
+	EXPECT_EQ("DEBUG [prefix] Debug 3 of -5 at 2.5: text", records[0]);
+	EXPECT_EQ("DEBUG [prefix] Debug 4 of -5 at 2.5: text", records[1]);
+	EXPECT_EQ("INFO info message", records[2]);
+	EXPECT_EQ("WARNING warning true", records[3]);
+
+	// Disabling drops the records and the verbose levels
+	_log->disableFlightRecorder();
+	EXPECT_FALSE(_log->isFlightRecorderEnabled());
+	EXPECT_FALSE(_log->isLogLevelEnabled(bump::Log::DEBUG_LVL));
+	EXPECT_FALSE(_log->dumpFlightRecorder());
+
+#if GTEST_HAS_DEATH_TEST
+	// A fatal signal dumps the records before the process dies
+	bump::FileSystem::removeFile(filepath);
+	_log->enableFlightRecorder(filepath);
+	BUMP_LOG_DEBUG("before the crash");
+	EXPECT_DEATH(std::abort(), "");
+
+	std::ifstream crash_file(filepath.c_str());
+	std::string crash_contents((std::istreambuf_iterator<char>(crash_file)), std::istreambuf_iterator<char>());
+	std::vector<std::string> crash_lines = splitLines(crash_contents);
+	ASSERT_EQ(3u, crash_lines.size());
+	EXPECT_EQ("DEBUG before the crash", crash_lines[2].substr(27));
+
+	// The handler runs on an alternate stack, so a stack overflow is dumped as well
+	bump::FileSystem::removeFile(filepath);
+	BUMP_LOG_DEBUG("before the overflow");
+	EXPECT_DEATH(overflowStack(0), "");
+
+	std::ifstream overflow_file(filepath.c_str());
+	std::string overflow_contents((std::istreambuf_iterator<char>(overflow_file)), std::istreambuf_iterator<char>());
+	std::vector<std::string> overflow_lines = splitLines(overflow_contents);
+	ASSERT_LE(3u, overflow_lines.size());
+	EXPECT_EQ("DEBUG before the overflow", overflow_lines.back().substr(27));
+#endif
+
+	bump::FileSystem::removeFile(filepath);
+}
+
+TEST_F(LogTest, testMappedFileLogSink)
+{
+	bump::String filepath = bump::FileSystem::currentPath() + "/unittest_log.txt";
+	bump::FileSystem::removeFile(filepath);
+
+	// Writes from several threads at once cross segments without losing anything
+	std::string message(1000, 'x');
+	{
+		bump::MappedFileLogSink sink(filepath, 1);
+		EXPECT_EQ(1024u * 1024u, sink.segmentSize());
+		EXPECT_TRUE(sink.isThreadSafe());
+		bump::Log::SinkOptions options;
+		options.logLevel = bump::Log::WARNING_LVL;
+		_log->addLogSink(sink, options);
+
+		boost::thread_group threads;
+		for (int i = 0; i < 4; ++i)
+		{
+			threads.create_thread([&message]() { for (int j = 0; j < 1000; ++j) { bumpWARNING(message); } });
+		}
+		threads.join_all();
+		EXPECT_TRUE(_log->removeLogSink(sink));
+		EXPECT_EQ(4000u * 1001u, sink.size());
+		EXPECT_EQ(0u, sink.droppedWriteCount());
+	}
+
+	// The file is truncated to the output and appending continues after it
+	EXPECT_EQ(4000u * 1001u, bump::FileInfo(filepath).fileSize());
+	{
+		bump::MappedFileLogSink sink(filepath);
+		sink.stream() << "appended" << std::endl;
+	}
+	std::ifstream file(filepath.c_str());
+	std::stringstream contents;
+	contents << file.rdbuf();
+	file.close();
+	std::vector<std::string> lines = splitLines(contents.str());
+	ASSERT_EQ(4001u, lines.size());
+	EXPECT_EQ(4000, std::count(lines.begin(), lines.end(), message));
+	EXPECT_EQ("appended", lines.back());
+
+	// The zero bytes a crash leaves at the end of the last segment are skipped
+	std::ofstream padding(filepath.c_str(), std::ios::app | std::ios::binary);
+	padding << std::string(5000, '\0');
+	padding.close();
+	{
+		bump::MappedFileLogSink sink(filepath);
+		EXPECT_EQ(4000u * 1001u + 9u, sink.size());
+		sink.stream() << "after crash" << std::endl;
+	}
+	std::ifstream crashed_file(filepath.c_str());
+	std::stringstream crashed_contents;
+	crashed_contents << crashed_file.rdbuf();
+	crashed_file.close();
+	EXPECT_EQ(contents.str() + "after crash\n", crashed_contents.str());
+	bump::FileSystem::removeFile(filepath);
+}
+
+TEST_F(LogTest, testBinaryLogging)
+{
+	bump::String filepath = bump::FileSystem::currentPath() + "/unittest_log.binlog";
+	auto log_twice = [](int index) { BUMP_LOG_WARNING("Twice %1", index); };
+	long long start_time = bump::Log::currentTimestamp();
+	_log->enableBinaryLogging(filepath);
+	EXPECT_TRUE(_log->isBinaryLoggingEnabled());
+
+	// Nothing reaches the log stream and filtered out messages aren't recorded
+	std::string name = "file.txt";
+	const char* null_string = NULL;
+	for (int i = 0; i < 3; ++i)
+	{
+		BUMP_LOG_WARNING("Copying file %1 of %2: %3", i, 3u, name);
+	}
+	BUMP_LOG_ERROR_P("[prefix] ", "%1 %2 %3 %4 %5", 2.5, 0.25f, true, -7LL, null_string);
+	BUMP_LOG_DEBUG("filtered %1", 1);
+	bumpWARNING_P("[prefix] ", "convenience function");
+	log_twice(0);
+	_log->disableBinaryLogging();
+	long long end_time = bump::Log::currentTimestamp();
+	EXPECT_EQ("", _stream.str());
+
+	// Every message reads back exactly like the text log would have written it
+	bump::BinaryLogReader reader(filepath);
+	std::vector<bump::BinaryLogMessage> messages;
+	bump::BinaryLogMessage message;
+	while (reader.readMessage(message))
+	{
+		messages.push_back(message);
+	}
+	ASSERT_EQ(6u, messages.size());
+	EXPECT_EQ("Copying file 0 of 3: file.txt", messages[0].text);
+	EXPECT_EQ("Copying file 2 of 3: file.txt", messages[2].text);
+	EXPECT_EQ(bump::String("[prefix] %1 %2 true -7 (null)").arg(2.5, 0.25f), messages[3].text);
+	EXPECT_EQ("[prefix] convenience function", messages[4].text);
+	EXPECT_EQ("Twice 0", messages[5].text);
+
+	// Along with the level, location and time of each message
+	EXPECT_EQ(bump::Log::WARNING_LVL, messages[0].level);
+	EXPECT_EQ(bump::Log::ERROR_LVL, messages[3].level);
+	EXPECT_EQ(bump::Log::WARNING_LVL, messages[4].level);
+	EXPECT_TRUE(messages[0].file.endsWith("LogTest.cpp"));
+	EXPECT_EQ(messages[0].line, messages[2].line);
+	EXPECT_LT(messages[0].line, messages[3].line);
+	EXPECT_EQ("", messages[4].file);
+	for (size_t i = 0; i < messages.size(); ++i)
+	{
+		EXPECT_LE(start_time - 1000, messages[i].time);
+		EXPECT_GE(end_time + 1000, messages[i].time);
+	}
+
+	// Call sites registered for an earlier binary log are written to the next one as well
+	_log->enableBinaryLogging(filepath);
+	log_twice(1);
+	bumpWARNING("again");
+	_log->disableBinaryLogging();
+	bump::BinaryLogReader second_reader(filepath);
+	ASSERT_TRUE(second_reader.readMessage(message));
+	EXPECT_EQ("Twice 1", message.text);
+	ASSERT_TRUE(second_reader.readMessage(message));
+	EXPECT_EQ("again", message.text);
+	EXPECT_FALSE(second_reader.readMessage(message));
+	bump::FileSystem::removeFile(filepath);
+
+	// Other files are rejected
+	EXPECT_THROW(bump::BinaryLogReader("/nonexistent_directory/log.binlog"), bump::FileSystemError);
+}
+
+TEST_F(LogTest, testSharedMemoryLogAggregator)
+{
+	bump::String name = "bump_unittest_log";
+
+	// Publishers can only open a ring created by an aggregator
+	EXPECT_THROW(bump::SharedMemoryLogSink missing_sink(name), bump::FileSystemError);
+
+	// Publishers with their own mappings, like separate processes, never tear each other's lines
+	std::string message(200, 'x');
+	bump::RingBufferLogSink output(16 * 1024 * 1024);
+	{
+		bump::SharedMemoryLogAggregator aggregator(name, output);
+		bump::SharedMemoryLogSink log_sink(name);
+		bump::SharedMemoryLogSink direct_sink(name);
+		EXPECT_TRUE(log_sink.isThreadSafe());
+		bump::Log::SinkOptions options;
+		options.logLevel = bump::Log::WARNING_LVL;
+		_log->addLogSink(log_sink, options);
+
+		boost::thread_group threads;
+		for (int i = 0; i < 4; ++i)
+		{
+			threads.create_thread([&message]() { for (int j = 0; j < 1000; ++j) { bumpWARNING(message); } });
+		}
+		threads.create_thread([&direct_sink]() { for (int j = 0; j < 1000; ++j) { direct_sink.stream() << "direct " << j << std::endl; } });
+		threads.join_all();
+		EXPECT_TRUE(_log->removeLogSink(log_sink));
+
+		aggregator.flush();
+		EXPECT_EQ(0u, log_sink.droppedWriteCount());
+		EXPECT_EQ(0u, direct_sink.droppedWriteCount());
+		EXPECT_EQ(aggregator.ring().reservedSize(), aggregator.ring().consumedSize());
+	}
+
+	std::vector<std::string> lines = splitLines(output.contents());
+	ASSERT_EQ(5000u, lines.size());
+	EXPECT_EQ(4000, std::count(lines.begin(), lines.end(), message));
+	int direct_index = 0;
+	for (size_t i = 0; i < lines.size(); ++i)
+	{
+		if (lines[i] != message)
+		{
+			EXPECT_EQ("direct " + std::to_string(direct_index), lines[i]);
+			++direct_index;
+		}
+	}
+
+	// A full ring drops records rather than waiting, and records wrapping around its end come out whole
+	bump::SharedMemoryLogRing owner(name, 1);
+	bump::SharedMemoryLogRing publisher(name);
+	EXPECT_TRUE(owner.isOwner());
+	EXPECT_FALSE(publisher.isOwner());
+	EXPECT_EQ(64u * 1024u, publisher.capacity());
+
+	std::string record(1499, 'y');
+	record += '\n';
+	bump::LogSink::Buffer buffer = { record.data(), record.size() };
+	bump::RingBufferLogSink ring_output;
+	for (int lap = 0; lap < 2; ++lap)
+	{
+		int published_count = 0;
+		while (publisher.publish(&buffer, 1))
+		{
+			++published_count;
+		}
+		EXPECT_EQ(43, published_count);
+		EXPECT_EQ(lap + 1u, owner.droppedRecordCount());
+
+		size_t consumed_count = 0;
+		for (size_t count = owner.consume(ring_output); count > 0; count = owner.consume(ring_output))
+		{
+			consumed_count += count;
+		}
+		EXPECT_EQ(43u, consumed_count);
+	}
+
+	std::vector<std::string> ring_lines = splitLines(ring_output.contents());
+	ASSERT_EQ(86u, ring_lines.size());
+	EXPECT_EQ(86, std::count(ring_lines.begin(), ring_lines.end(), std::string(1499, 'y')));
+	EXPECT_EQ(0u, owner.lostRecordCount());
+}
+
+TEST_F(LogTest, testSharedMemoryLogRingStall)
+{
+	bump::String name = "bump_unittest_log";
+	StallingLogRing owner(name, 1);
+	bump::SharedMemoryLogRing publisher(name);
+	std::string stalled_record = "stalled\n";
+	std::string record = "after the stall\n";
+	bump::LogSink::Buffer buffer = { record.data(), record.size() };
+	bump::RingBufferLogSink output;
+
+	// A publisher stalled between reserving its record and storing the length is waited on while it runs
+	StallingLogRing stalled_publisher(name);
+	ASSERT_TRUE(stalled_publisher.reserve(stalled_record));
+	EXPECT_TRUE(publisher.publish(&buffer, 1));
+	EXPECT_EQ(0u, owner.consume(output));
+	owner.expireStall();
+	EXPECT_EQ(0u, owner.consume(output));
+	EXPECT_EQ(0u, owner.lostRecordCount());
+
+	stalled_publisher.write(stalled_record);
+	EXPECT_EQ(2u, owner.consume(output));
+	EXPECT_EQ("stalled\nafter the stall\n", output.contents());
+
+	// Once it is gone, its record is skipped up to the one published after it
+	EXPECT_DEATH({ StallingLogRing dying_publisher(name); dying_publisher.reserve(stalled_record); std::abort(); }, "");
+	EXPECT_TRUE(publisher.publish(&buffer, 1));
+	EXPECT_EQ(0u, owner.consume(output));
+	owner.expireStall();
+	EXPECT_EQ(2u, owner.consume(output));
+	EXPECT_EQ(1u, owner.lostRecordCount());
+	EXPECT_EQ("stalled\nafter the stall\nafter the stall\n", output.contents());
+	EXPECT_EQ(owner.reservedSize(), owner.consumedSize());
+}
+
+}	// End of bumpTest namespace
@@ -6,6 +6,13 @@
 //	Copyright (c) 2012 Christian Noon. All rights reserved.
 //
 
+// C++ headers
+#include <vector>
+
+// Boost headers
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
 // Bump headers
 #include <bump/Environment.h>
 #include <bump/NotificationCenter.h>
@@ -132,6 +139,92 @@ protected:
 	unsigned int _redrawRequestCount;
 };
 
+/**
+ * The Volunteer class is a helper class that changes the observers of the NotificationCenter
+ * from inside its callbacks.
+ */
+class Volunteer
+{
+public:
+
+	/**
+	 * Constructor.
+	 */
+	Volunteer(Renderer* recruit = NULL) :
+		_recruit(recruit),
+		_notificationCount(0)
+	{
+		;
+	}
+
+	/**
+	 * Removes the volunteer from the notification center.
+	 */
+	void quit()
+	{
+		++_notificationCount;
+		REMOVE_OBSERVER(this);
+	}
+
+	/**
+	 * Registers the recruit for redraw requests.
+	 */
+	void recruit()
+	{
+		++_notificationCount;
+		ADD_OBSERVER(new bump::KeyObserver<Renderer>(_recruit, &Renderer::requestRedraw, "RequestRedraw"));
+	}
+
+	/**
+	 * Returns the number of notifications received.
+	 *
+	 * @return the number of notifications received.
+	 */
+	unsigned int notificationCount()
+	{
+		return _notificationCount;
+	}
+
+protected:
+
+	/** Instance member variables. */
+	Renderer* _recruit;
+	unsigned int _notificationCount;
+};
+
+/**
+ * The Recorder class is a helper class that records the values it is notified with in order.
+ */
+class Recorder
+{
+public:
+
+	/**
+	 * Appends the value to the recorded values.
+	 *
+	 * @param value the value to record.
+	 */
+	void record(unsigned int value)
+	{
+		_values.push_back(value);
+	}
+
+	/**
+	 * Returns the recorded values.
+	 *
+	 * @return the recorded values.
+	 */
+	const std::vector<unsigned int>& values()
+	{
+		return _values;
+	}
+
+protected:
+
+	/** Instance member variables. */
+	std::vector<unsigned int> _values;
+};
+
 /**
  * This is our main notification center testing class. The SetUp and TearDown
  * methods are executed before the test runs and after it completes. This is
@@ -238,6 +331,76 @@ TEST_F(NotificationTest, testAddObserver3)
 	EXPECT_STREQ("Renderer 3", _r1->name().c_str());
 }
 
+TEST_F(NotificationTest, testChangeObserversFromCallbacks)
+{
+	// Observers can remove themselves while being notified
+	Volunteer quitter;
+	ADD_OBSERVER(new bump::KeyObserver<Volunteer>(&quitter, &Volunteer::quit, "Quit"));
+	ADD_OBSERVER(new bump::KeyObserver<Renderer>(_r1, &Renderer::requestRedraw, "Quit"));
+	EXPECT_EQ(2, POST_NOTIFICATION("Quit"));
+	EXPECT_EQ(1, POST_NOTIFICATION("Quit"));
+	EXPECT_EQ(1u, quitter.notificationCount());
+	EXPECT_FALSE(bump::NotificationCenter::instance()->containsObserver(&quitter));
+
+	// Observers added while being notified are only notified by the next post
+	Volunteer recruiter(_r2);
+	ADD_OBSERVER(new bump::KeyObserver<Volunteer>(&recruiter, &Volunteer::recruit, "RequestRedraw"));
+	EXPECT_EQ(1, POST_NOTIFICATION("RequestRedraw"));
+	EXPECT_EQ(0u, _r2->requestRedrawCount());
+	EXPECT_EQ(2, POST_NOTIFICATION("RequestRedraw"));
+	EXPECT_EQ(1u, _r2->requestRedrawCount());
+	REMOVE_OBSERVER(&recruiter);
+}
+
+TEST_F(NotificationTest, testPostWhileChangingObservers)
+{
+	// Posting threads keep going while another thread adds and removes observers
+	std::vector<Renderer*> renderers;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		renderers.push_back(new Renderer());
+		ADD_OBSERVER(new bump::KeyObserver<Renderer>(renderers.back(), &Renderer::requestRedraw, bump::String("Poll%1").arg(i)));
+	}
+
+	boost::atomic<unsigned int> started_count(0);
+	boost::atomic<bool> is_done(false);
+	boost::thread_group threads;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		threads.create_thread([i, &started_count, &is_done]() {
+			bump::String name = bump::String("Poll%1").arg(i);
+			EXPECT_EQ(1, POST_NOTIFICATION(name));
+			++started_count;
+			while (!is_done)
+			{
+				EXPECT_EQ(1, POST_NOTIFICATION(name));
+			}
+		});
+	}
+	while (started_count < 4)
+	{
+		boost::this_thread::yield();
+	}
+
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		Renderer transient;
+		ADD_OBSERVER(new bump::KeyObserver<Renderer>(&transient, &Renderer::requestRedraw, "Transient"));
+		EXPECT_EQ(1, POST_NOTIFICATION("Transient"));
+		REMOVE_OBSERVER(&transient);
+	}
+	is_done = true;
+	threads.join_all();
+
+	for (unsigned int i = 0; i < renderers.size(); ++i)
+	{
+		EXPECT_LT(0u, renderers[i]->requestRedrawCount());
+		REMOVE_OBSERVER(renderers[i]);
+		delete renderers[i];
+	}
+	EXPECT_EQ(0, POST_NOTIFICATION("Transient"));
+}
+
 TEST_F(NotificationTest, testContainsObserver)
 {
 	// Add some observers
@@ -362,6 +525,113 @@ TEST_F(NotificationTest, testPostNotificationWithObject)
 	EXPECT_THROW(POST_NOTIFICATION_WITH_OBJECT("ChangeNameWithString", 10), bump::NotificationError);
 }
 
+TEST_F(NotificationTest, testPostNotificationToManyNames)
+{
+	// Register renderers for many different notifications
+	std::vector<Renderer*> renderers;
+	for (unsigned int i = 0; i < 200; ++i)
+	{
+		Renderer* renderer = new Renderer();
+		bump::String name = bump::String("RequestRedraw%1").arg(i % 50);
+		ADD_OBSERVER(new bump::KeyObserver<Renderer>(renderer, &Renderer::requestRedraw, name));
+		ADD_OBSERVER(new bump::ObjectObserver<Renderer, unsigned int>(renderer, &Renderer::updateNumRenderPasses, name));
+		renderers.push_back(renderer);
+	}
+
+	// Only the observers of the posted notification are notified
+	EXPECT_EQ(4, POST_NOTIFICATION("RequestRedraw7"));
+	EXPECT_EQ(4, POST_NOTIFICATION_WITH_OBJECT("RequestRedraw7", 5u));
+	EXPECT_EQ(0, POST_NOTIFICATION("RequestRedraw"));
+	for (unsigned int i = 0; i < renderers.size(); ++i)
+	{
+		EXPECT_EQ(i % 50 == 7 ? 1u : 0u, renderers[i]->requestRedrawCount());
+		EXPECT_EQ(i % 50 == 7 ? 5u : 2u, renderers[i]->numRenderPasses());
+	}
+
+	// Removing every observer of a notification leaves none to notify
+	for (unsigned int i = 7; i < renderers.size(); i += 50)
+	{
+		REMOVE_OBSERVER(renderers[i]);
+	}
+	EXPECT_EQ(0, POST_NOTIFICATION("RequestRedraw7"));
+	EXPECT_EQ(4, POST_NOTIFICATION("RequestRedraw8"));
+
+	for (unsigned int i = 0; i < renderers.size(); ++i)
+	{
+		REMOVE_OBSERVER(renderers[i]);
+		delete renderers[i];
+	}
+}
+
+TEST_F(NotificationTest, testPostNotificationAsync)
+{
+	ADD_OBSERVER(new bump::KeyObserver<Renderer>(_r1, &Renderer::requestRedraw, "RequestRedraw"));
+	ADD_OBSERVER(new bump::KeyObserver<Renderer>(_r2, &Renderer::requestRedraw, "RequestRedraw"));
+	ADD_OBSERVER(new bump::ObjectObserver<Renderer, bump::String>(&_r3, &Renderer::changeNameWithString, "ChangeNameWithString"));
+
+	// The futures resolve to the number of observers notified
+	boost::unique_future<unsigned int> redraw = POST_NOTIFICATION_ASYNC("RequestRedraw");
+	boost::unique_future<unsigned int> change_name = POST_NOTIFICATION_WITH_OBJECT_ASYNC("ChangeNameWithString", bump::String("Renderer 4"));
+	boost::unique_future<unsigned int> unobserved = POST_NOTIFICATION_ASYNC("UpdateNumRenderPasses");
+	EXPECT_EQ(2, redraw.get());
+	EXPECT_EQ(1, change_name.get());
+	EXPECT_EQ(0, unobserved.get());
+	EXPECT_EQ(1, _r1->requestRedrawCount());
+	EXPECT_STREQ("Renderer 4", _r3.name().c_str());
+
+	// Waiting for the posts delivers everything queued so far
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		POST_NOTIFICATION_ASYNC("RequestRedraw", bump::NotificationCenter::FIFO_DELIVERY);
+	}
+	bump::NotificationCenter::instance()->waitForAsyncPosts();
+	EXPECT_EQ(101, _r1->requestRedrawCount());
+	EXPECT_EQ(101, _r2->requestRedrawCount());
+
+	// Observer exceptions are handed over to the future
+	boost::unique_future<unsigned int> wrong_type = POST_NOTIFICATION_WITH_OBJECT_ASYNC("ChangeNameWithString", 10);
+	EXPECT_THROW(wrong_type.get(), bump::NotificationError);
+}
+
+TEST_F(NotificationTest, testPostNotificationAsyncInOrder)
+{
+	// A small queue shared by many workers makes the posters wait for room
+	bump::NotificationCenter::instance()->setAsyncPostingLimits(8, 16);
+
+	Recorder recorders[4];
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		bump::String name = bump::String("Record%1").arg(i);
+		ADD_OBSERVER(new bump::ObjectObserver<Recorder, unsigned int>(&recorders[i], &Recorder::record, name));
+	}
+
+	// The ordered posts of each notification are delivered in the order they were made
+	std::vector<boost::unique_future<unsigned int> > futures;
+	for (unsigned int value = 0; value < 1000; ++value)
+	{
+		bump::String name = bump::String("Record%1").arg(value % 4);
+		futures.push_back(POST_NOTIFICATION_WITH_OBJECT_ASYNC(name, value, bump::NotificationCenter::FIFO_DELIVERY));
+	}
+
+	// Stopping the pool delivers everything still queued
+	bump::NotificationCenter::instance()->stopAsyncPosting();
+	for (unsigned int i = 0; i < futures.size(); ++i)
+	{
+		EXPECT_EQ(1, futures[i].get());
+	}
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		ASSERT_EQ(250, recorders[i].values().size());
+		for (unsigned int j = 0; j < 250; ++j)
+		{
+			EXPECT_EQ(j * 4 + i, recorders[i].values()[j]);
+		}
+		REMOVE_OBSERVER(&recorders[i]);
+	}
+
+	bump::NotificationCenter::instance()->setAsyncPostingLimits(4, 1024);
+}
+
 TEST_F(NotificationTest, testRemoveObserver)
 {
 	// Add some observers
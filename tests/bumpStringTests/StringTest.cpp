@@ -311,6 +311,38 @@ TEST_F(StringTest, testJoin)
 	EXPECT_STREQ("", bump::String::join(strings, " ").c_str());
 }
 
+TEST_F(StringTest, testFromUtf16)
+{
+	// Regular cases
+	EXPECT_STREQ("", bump::String::fromUtf16(u"").c_str());
+	EXPECT_STREQ("ascii only", bump::String::fromUtf16(u"ascii only").c_str());
+	EXPECT_STREQ("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80", bump::String::fromUtf16(u"caf\u00E9 \u20AC \U0001F600").c_str());
+
+	// Unpaired surrogates
+	std::u16string utf16_string(1, char16_t(0xD83D));
+	EXPECT_THROW(bump::String::fromUtf16(utf16_string), bump::TypeCastError);
+	utf16_string = std::u16string(1, char16_t(0xDE00));
+	EXPECT_THROW(bump::String::fromUtf16(utf16_string), bump::TypeCastError);
+	utf16_string = u"a";
+	utf16_string.push_back(char16_t(0xD83D));
+	utf16_string.push_back(u'b');
+	EXPECT_THROW(bump::String::fromUtf16(utf16_string), bump::TypeCastError);
+}
+
+TEST_F(StringTest, testFromUtf32)
+{
+	// Regular cases
+	EXPECT_STREQ("", bump::String::fromUtf32(U"").c_str());
+	EXPECT_STREQ("ascii only", bump::String::fromUtf32(U"ascii only").c_str());
+	EXPECT_STREQ("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80", bump::String::fromUtf32(U"caf\u00E9 \u20AC \U0001F600").c_str());
+
+	// Invalid code points
+	std::u32string utf32_string(1, char32_t(0xD800));
+	EXPECT_THROW(bump::String::fromUtf32(utf32_string), bump::TypeCastError);
+	utf32_string = std::u32string(1, char32_t(0x110000));
+	EXPECT_THROW(bump::String::fromUtf32(utf32_string), bump::TypeCastError);
+}
+
 TEST_F(StringTest, testAppendString)
 {
 	// Normal append
@@ -653,6 +685,19 @@ TEST_F(StringTest, testClear)
 	EXPECT_EQ(0, str.length());
 }
 
+TEST_F(StringTest, testCodePointCount)
+{
+	// Regular cases
+	EXPECT_EQ(0, bump::String().codePointCount());
+	EXPECT_EQ(5, bump::String("ascii").codePointCount());
+	EXPECT_EQ(8, bump::String("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80").codePointCount());
+
+	// Large strings spanning several blocks
+	bump::String str = bump::String("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80").repeated(1000);
+	EXPECT_EQ(10000, str.length());
+	EXPECT_EQ(4000, str.codePointCount());
+}
+
 TEST_F(StringTest, testCompareString)
 {
 	// Test regular strings
@@ -1089,6 +1134,57 @@ TEST_F(StringTest, testIsNumber)
 	EXPECT_FALSE(str.isNumber());
 }
 
+TEST_F(StringTest, testIsValidUtf8)
+{
+	// Valid strings
+	EXPECT_TRUE(bump::String().isValidUtf8());
+	EXPECT_TRUE(bump::String("ascii only").isValidUtf8());
+	EXPECT_TRUE(bump::String("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80").isValidUtf8());
+	EXPECT_TRUE(bump::String("\xED\x9F\xBF \xEE\x80\x80 \xF4\x8F\xBF\xBF").isValidUtf8());
+
+	// Invalid strings
+	EXPECT_FALSE(bump::String("\x80").isValidUtf8());						// Lone continuation
+	EXPECT_FALSE(bump::String("\xC3").isValidUtf8());						// Truncated sequence
+	EXPECT_FALSE(bump::String("\xC3\x28").isValidUtf8());					// Missing continuation
+	EXPECT_FALSE(bump::String("\xC0\xAF").isValidUtf8());					// Overlong 2 byte
+	EXPECT_FALSE(bump::String("\xE0\x80\xAF").isValidUtf8());				// Overlong 3 byte
+	EXPECT_FALSE(bump::String("\xF0\x80\x80\xAF").isValidUtf8());			// Overlong 4 byte
+	EXPECT_FALSE(bump::String("\xED\xA0\x80").isValidUtf8());				// Surrogate
+	EXPECT_FALSE(bump::String("\xF4\x90\x80\x80").isValidUtf8());			// Larger than U+10FFFF
+	EXPECT_FALSE(bump::String("\xF8\x88\x80\x80\x80").isValidUtf8());		// 5 byte sequence
+	EXPECT_FALSE(bump::String("\xE2\x82\xAC\xAC").isValidUtf8());			// Extra continuation
+
+	// Errors and sequences at every offset of a large string to cover the block boundaries
+	bump::String valid = bump::String("0123456789abcdef").repeated(8);
+	const char* sequences[] = { "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80" };
+	const char* errors[] = { "\x80", "\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xED\xA0\x80", "\xC1\xBF" };
+	for (int position = 0; position < valid.length(); ++position)
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			bump::String str = valid;
+			str.std::string::insert(position, sequences[i]);
+			EXPECT_TRUE(str.isValidUtf8());
+		}
+
+		for (unsigned int i = 0; i < 6; ++i)
+		{
+			bump::String str = valid;
+			str.std::string::insert(position, errors[i]);
+			EXPECT_FALSE(str.isValidUtf8());
+		}
+	}
+
+	// Truncated sequences at the very end of the string
+	for (int length = 29; length < 97; ++length)
+	{
+		bump::String str = valid.left(length) + "\xF0\x9F\x98";
+		EXPECT_FALSE(str.isValidUtf8());
+		str += "\x80";
+		EXPECT_TRUE(str.isValidUtf8());
+	}
+}
+
 TEST_F(StringTest, testLastIndexOfString)
 {
 	// Default reverse search
@@ -1923,6 +2019,22 @@ TEST_F(StringTest, testToLowerCase)
 	EXPECT_STREQ("98.985", str.toLowerCase().c_str());
 	str = "";
 	EXPECT_STREQ("", str.toLowerCase().c_str());
+
+	// Every byte value at lengths covering the vector blocks and their tails, where only
+	// the ASCII letters are lowered
+	for (size_t length = 0; length <= 300; ++length)
+	{
+		std::string original;
+		std::string expected;
+		for (size_t i = 0; i < length; ++i)
+		{
+			char c = char((i * 7 + length) % 256);
+			original += c;
+			expected += (c >= 'A' && c <= 'Z') ? char(c ^ 0x20) : c;
+		}
+		str = original;
+		EXPECT_EQ(expected, str.toLowerCase().toStdString());
+	}
 }
 
 TEST_F(StringTest, testToShort)
@@ -2033,6 +2145,22 @@ TEST_F(StringTest, testToUpperCase)
 	EXPECT_STREQ("98.985", str.toUpperCase().c_str());
 	str = "";
 	EXPECT_STREQ("", str.toUpperCase().c_str());
+
+	// Every byte value at lengths covering the vector blocks and their tails, where only
+	// the ASCII letters are uppered
+	for (size_t length = 0; length <= 300; ++length)
+	{
+		std::string original;
+		std::string expected;
+		for (size_t i = 0; i < length; ++i)
+		{
+			char c = char((i * 7 + length) % 256);
+			original += c;
+			expected += (c >= 'a' && c <= 'z') ? char(c ^ 0x20) : c;
+		}
+		str = original;
+		EXPECT_EQ(expected, str.toUpperCase().toStdString());
+	}
 }
 
 TEST_F(StringTest, testToUShort)
@@ -2056,6 +2184,42 @@ TEST_F(StringTest, testToUShort)
 	EXPECT_THROW(str.toUShort(), bump::TypeCastError);
 }
 
+TEST_F(StringTest, testToUtf16)
+{
+	// Regular cases
+	EXPECT_TRUE(bump::String().toUtf16().empty());
+	EXPECT_TRUE(bump::String("ascii only").toUtf16() == u"ascii only");
+	EXPECT_TRUE(bump::String("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80").toUtf16() == u"caf\u00E9 \u20AC \U0001F600");
+
+	// Round trip a large string
+	bump::String str = bump::String("abcdefgh\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80").repeated(500);
+	std::u16string utf16_string = str.toUtf16();
+	EXPECT_EQ(6000u, utf16_string.size());
+	EXPECT_STREQ(str.c_str(), bump::String::fromUtf16(utf16_string).c_str());
+
+	// Invalid usage tests
+	EXPECT_THROW(bump::String("\xC3\x28").toUtf16(), bump::TypeCastError);
+	EXPECT_THROW(bump::String("\xED\xA0\x80").toUtf16(), bump::TypeCastError);
+}
+
+TEST_F(StringTest, testToUtf32)
+{
+	// Regular cases
+	EXPECT_TRUE(bump::String().toUtf32().empty());
+	EXPECT_TRUE(bump::String("ascii only").toUtf32() == U"ascii only");
+	EXPECT_TRUE(bump::String("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80").toUtf32() == U"caf\u00E9 \u20AC \U0001F600");
+
+	// Round trip a large string
+	bump::String str = bump::String("abcdefgh\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80").repeated(500);
+	std::u32string utf32_string = str.toUtf32();
+	EXPECT_EQ(5500u, utf32_string.size());
+	EXPECT_STREQ(str.c_str(), bump::String::fromUtf32(utf32_string).c_str());
+
+	// Invalid usage tests
+	EXPECT_THROW(bump::String("\xF4\x90\x80\x80").toUtf32(), bump::TypeCastError);
+	EXPECT_THROW(bump::String("\xE2\x82").toUtf32(), bump::TypeCastError);
+}
+
 TEST_F(StringTest, testTrimmed)
 {
 	// Regular cases
@@ -325,6 +325,22 @@ TEST_F(TextFileReaderTest, testNumberOfLines)
 	// With a valid file path, invalids are taken care of in testValidityOfFile()
 	int numLines = bump::TextFileReader::numberOfLines(_validFileName);
 	EXPECT_EQ(10, numLines);
+
+	// Empty file, which still has a single empty line
+	bump::FileSystem::createFile("unittest/empty.txt");
+	numLines = bump::TextFileReader::numberOfLines("unittest/empty.txt");
+	EXPECT_EQ(1, numLines);
+
+	// Large file spanning many read blocks with a trailing newline which starts an empty last line
+	std::ofstream large_file;
+	large_file.open("unittest/large.txt");
+	for (int i = 0; i < 200000; ++i)
+	{
+		large_file << "Line number " << i << "\n";
+	}
+	large_file.close();
+	numLines = bump::TextFileReader::numberOfLines("unittest/large.txt");
+	EXPECT_EQ(200001, numLines);
 }
 
 }	// End of bumpTest namespace
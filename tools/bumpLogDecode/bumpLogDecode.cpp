@@ -0,0 +1,109 @@
+//
+//	bumpLogDecode.cpp
+//	Bump
+//
+//	Created by Christian Noon on 10/19/26.
+//	Copyright (c) 2026 Christian Noon. All rights reserved.
+//
+
+// C++ headers
+#include <cstring>
+#include <iostream>
+
+// Bump headers
+#include <bump/BinaryLogReader.h>
+#include <bump/FileSystemError.h>
+#include <bump/Log.h>
+
+/**
+ * Prints how to use the tool.
+ */
+void printUsage()
+{
+	std::cerr << "Usage: bumpLogDecode [--local] [--location] <binary log>" << std::endl;
+	std::cerr << "  Writes the messages of a binary log as text, one per line." << std::endl;
+	std::cerr << "  --local       Writes the timestamps in local time instead of UTC" << std::endl;
+	std::cerr << "  --location    Writes the file and line of each call site" << std::endl;
+}
+
+/**
+ * Returns the name of the given log level.
+ */
+const char* logLevelName(bump::Log::LogLevel logLevel)
+{
+	switch (logLevel)
+	{
+		case bump::Log::ALWAYS_LVL:		return "ALWAYS";
+		case bump::Log::ERROR_LVL:		return "ERROR";
+		case bump::Log::WARNING_LVL:	return "WARNING";
+		case bump::Log::INFO_LVL:		return "INFO";
+		case bump::Log::DEBUG_LVL:		return "DEBUG";
+	}
+
+	return "UNKNOWN";
+}
+
+/**
+ * Decodes the binary log given on the command line to stdout.
+ */
+int main(int argc, char** argv)
+{
+	bool is_local_time = false;
+	bool is_location_enabled = false;
+	const char* filepath = NULL;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--local") == 0)
+		{
+			is_local_time = true;
+		}
+		else if (std::strcmp(argv[i], "--location") == 0)
+		{
+			is_location_enabled = true;
+		}
+		else if (!filepath && argv[i][0] != '-')
+		{
+			filepath = argv[i];
+		}
+		else
+		{
+			printUsage();
+			return 1;
+		}
+	}
+
+	if (!filepath)
+	{
+		printUsage();
+		return 1;
+	}
+
+	// Format the timestamps as ISO 8601 down to the microsecond
+	bump::Log* log = bump::Log::instance();
+	log->setTimestampFormat(bump::Log::ISO_8601_TIMESTAMP);
+	log->setTimestampPrecision(bump::Log::MICROSECONDS_PRECISION);
+	log->setIsUtcTimestampingEnabled(!is_local_time);
+
+	try
+	{
+		bump::BinaryLogReader reader(filepath);
+		bump::BinaryLogMessage message;
+		while (reader.readMessage(message))
+		{
+			std::cout << log->formatTimestamp(message.time) << " [" << logLevelName(message.level) << "] ";
+			if (is_location_enabled && !message.file.empty())
+			{
+				std::cout << message.file << ":" << message.line << " ";
+			}
+			std::cout << message.text << '\n';
+		}
+	}
+	catch (const bump::FileSystemError& e)
+	{
+		std::cerr << e.description() << std::endl;
+		return 1;
+	}
+
+	std::cout << std::flush;
+	return 0;
+}